@@ -0,0 +1,61 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ main ]                                                                  |
+| FILE:       Config_Resources.h                                                        |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    Resource table of the kernel objects that `main` creates before the scheduler      |
+|    starts: tasks, queues, semaphores, event groups and software timers. All of them   |
+|    are statically allocated, so their memory, task stacks included, is reserved at    |
+|    link time and nothing is allocated from the FreeRTOS heap.                         |
+\*=====================================================================================*/
+
+#ifndef CONFIG_RESOURCES_H_
+#define CONFIG_RESOURCES_H_
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+// Tasks: entry function, name, stack depth in words, priority, handle. Tasks that format text with
+// snprintf, directly or through the commands they dispatch, keep 250 words
+#define RESOURCE_TASKS(TASK) \
+	TASK(main_menu_task,		"main_menu_task",		250,	2,							handle_main_menu_task) \
+	TASK(message_handler_task,	"msg_task",				250,	2,							handle_message_handler_task) \
+	TASK(print_task,			"print_task",			128,	2,							handle_print_task) \
+	TASK(led_task,				"led_task",				160,	2,							handle_led_task) \
+	TASK(rtc_task,				"rtc_task",				250,	2,							handle_rtc_task) \
+	TASK(acc_task,				"accelerometer_task",	250,	2,							handle_acc_task) \
+	TASK(motor_task,			"motor_task",			250,	2,							handle_motor_task) \
+	TASK(motor_control_task,	"motor_control_task",	192,	configMAX_PRIORITIES - 1,	handle_motor_control_task)
+
+// Stack depth the tasks above are created with, in words. The host build scales the depths up in its
+// FreeRTOSConfig.h; the target uses them as they are
+#ifndef RESOURCE_STACK_DEPTH
+#define RESOURCE_STACK_DEPTH(depth)	(depth)
+#endif
+
+// Queues: handle, length, item size
+#define RESOURCE_QUEUES(QUEUE) \
+	QUEUE(q_print,				10,		sizeof(size_t))
+
+// Binary semaphores: handle
+#define RESOURCE_SEMAPHORES(SEMAPHORE) \
+	SEMAPHORE(rtcSemaphore) \
+	SEMAPHORE(ledOffSemaphore)
+
+// Event groups: handle
+#define RESOURCE_EVENT_GROUPS(EVENT_GROUP) \
+	EVENT_GROUP(ledEventGroup)
+
+// Software timers: handle, name, period in ms, auto reload, timer ID, callback. One LED timer per
+// effect, NUM_LED_TIMERS in total, identified by the effect index
+#define RESOURCE_TIMERS(TIMER) \
+	TIMER(handle_led_timer[0],	"led_timer",			500,	pdTRUE,	0,	led_callback) \
+	TIMER(handle_led_timer[1],	"led_timer",			500,	pdTRUE,	1,	led_callback) \
+	TIMER(handle_led_timer[2],	"led_timer",			500,	pdTRUE,	2,	led_callback) \
+	TIMER(handle_led_timer[3],	"led_timer",			500,	pdTRUE,	3,	led_callback) \
+	TIMER(motor_report_timer,	"motor_report_timer",	1000,	pdTRUE,	0,	(TimerCallbackFunction_t)motor_report_callback)
+
+#endif /* CONFIG_RESOURCES_H_ */
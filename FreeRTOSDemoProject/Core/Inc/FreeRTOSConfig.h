@@ -45,6 +45,9 @@
 #if defined( __ICCARM__) || defined(__GNUC__) || defined(__CC_ARM)
 	#include <stdint.h>
 	extern uint32_t SystemCoreClock;
+	void stats_clock_init(void);
+	uint32_t stats_run_time(void);
+	void stats_task_switched_out(uint32_t task_number);
 #endif
 
 #define configUSE_PREEMPTION			1
@@ -54,19 +57,29 @@
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES			( 5 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 100  * 1024 ) )
+// Kernel objects are statically allocated from the resource table of Config_Resources.h. The small heap, placed
+// in CCM RAM by main.c, only remains for objects created at run time
+#define configSUPPORT_STATIC_ALLOCATION	1
+#define configSUPPORT_DYNAMIC_ALLOCATION	1
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 2  * 1024 ) )
+#define configAPPLICATION_ALLOCATED_HEAP	1
 #define configMAX_TASK_NAME_LEN			( 10 )
 #define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES				1
 #define configQUEUE_REGISTRY_SIZE		8
-#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configCHECK_FOR_STACK_OVERFLOW	2 // Stack end and fill pattern checked on every context switch, see vApplicationStackOverflowHook
 #define configUSE_RECURSIVE_MUTEXES		1
-#define configUSE_MALLOC_FAILED_HOOK	0
+#define configUSE_MALLOC_FAILED_HOOK	1
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
-#define configGENERATE_RUN_TIME_STATS	0
+#define configGENERATE_RUN_TIME_STATS	1
+
+/* Run time statistics, counted in DWT cycles by the StatsManager module. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	stats_clock_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()			stats_run_time()
+#define traceTASK_SWITCHED_OUT()					stats_task_switched_out( pxCurrentTCB->uxTCBNumber )
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
@@ -92,6 +105,7 @@ to exclude the API function. */
 #define INCLUDE_pxTaskGetStackStart		1
 
 #define INCLUDE_xTaskGetHandle 1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle 1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -69,16 +69,18 @@ extern xTaskHandle handle_led_task;
 extern xTaskHandle handle_rtc_task;
 extern xTaskHandle handle_acc_task;
 extern xTaskHandle handle_motor_task;
+extern xTaskHandle handle_motor_control_task;
 
 // Queue handles
 extern QueueHandle_t q_print;
-extern QueueHandle_t q_data;
 
 // Timer handles
 extern TimerHandle_t handle_led_timer[4];
 extern TimerHandle_t motor_report_timer;
 extern RTC_HandleTypeDef hrtc;
 extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim7;
+extern TIM_HandleTypeDef htim2;
 
 // Event group handles
 extern EventGroupHandle_t ledEventGroup;
@@ -93,6 +95,12 @@ extern SPI_HandleTypeDef hspi1;
 // UART handles
 extern UART_HandleTypeDef huart2;
 
+// DMA handles
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
+extern DMA_HandleTypeDef hdma_spi1_rx;
+extern DMA_HandleTypeDef hdma_spi1_tx;
+
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
@@ -103,6 +111,23 @@ extern UART_HandleTypeDef huart2;
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
 
+// Places a hot-path function in SRAM, where it runs without flash wait states or ART cache misses. The
+// startup code copies it along with .data. Building with RAM_FUNC_ENABLE=0 keeps all code in flash
+#ifndef RAM_FUNC_ENABLE
+#define RAM_FUNC_ENABLE 1
+#endif
+#if RAM_FUNC_ENABLE
+#define RAM_FUNC __attribute__((section(".RamFunc")))
+#else
+#define RAM_FUNC
+#endif
+
+// Places data in the 64 KB CCM RAM, which the CPU reaches without sharing the bus matrix with DMA. DMA cannot
+// access it, so DMA buffers must stay in SRAM. CCM_DATA is for initialized variables, copied at startup like
+// .data, and CCM_BSS for the others, cleared like .bss
+#define CCM_DATA __attribute__((section(".ccmram")))
+#define CCM_BSS __attribute__((section(".ccmbss")))
+
 /* USER CODE END EM */
 
 void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim);
@@ -193,6 +218,10 @@ void Error_Handler(void);
 #define MEMS_INT2_GPIO_Port GPIOE
 
 /* USER CODE BEGIN Private defines */
+// Accelerometer INT1, FIFO watermark or data-ready. EXTI line 0 is taken over from B1 (PA0), whose interrupt is not used
+#define MEMS_INT1_Pin GPIO_PIN_0
+#define MEMS_INT1_GPIO_Port GPIOE
+#define MEMS_INT1_EXTI_IRQn EXTI0_IRQn
 
 /* USER CODE END Private defines */
 
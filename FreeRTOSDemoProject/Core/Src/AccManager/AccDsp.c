@@ -0,0 +1,483 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccDsp.c                                                                  |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccDsp` kernels reduce high-rate accelerometer samples to low-rate            |
+|    features: a q15 decimating FIR low-pass, a q31 biquad high-pass, window            |
+|    statistics for RMS and peak-to-peak, and tilt angles. The filters follow           |
+|    the CMSIS-DSP conventions and run on the Cortex-M4 DSP instructions, or            |
+|    on the CMSIS-DSP library itself when `ACC_DSP_USE_CMSIS_DSP` is set.               |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "AccDsp.h"
+#include "main.h"
+#include <math.h>
+#include <string.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define ACC_DSP_PI					3.14159265f
+#define ACC_DSP_Q15_ONE				32768.0f
+#define ACC_DSP_Q30_ONE				1073741824.0f
+#define ACC_DSP_BUTTERWORTH_Q		0.70710678f // Quality factor of a maximally flat second-order section
+#define ACC_DSP_HIGHPASS_MIN_RATIO	1000 // Lowest high-pass cutoff as a fraction of the sample rate
+
+// The portable kernels use the dual 16-bit multiply-accumulate instructions where the core has them
+#if defined(__ARM_FEATURE_DSP) && (1 == __ARM_FEATURE_DSP)
+#define ACC_DSP_SIMD				1
+#else
+#define ACC_DSP_SIMD				0
+#endif
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static int16_t acc_dsp_sat_q15(int64_t value);
+static int16_t acc_dsp_to_q15(float value);
+static int32_t acc_dsp_to_q30(float value);
+#if !ACC_DSP_USE_CMSIS_DSP
+static int64_t acc_dsp_dot_q15(const int16_t *x, const int16_t *coeffs, uint16_t taps);
+#endif
+#if ACC_DSP_SIMD && !ACC_DSP_USE_CMSIS_DSP
+static uint32_t acc_dsp_read_q15x2(const int16_t *pair);
+#endif
+static uint32_t acc_dsp_isqrt(uint64_t value);
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Designs a linear phase low-pass FIR in q15.                                                  *
+ *                                                                                                     *
+ * The taps are a Hamming windowed sinc normalized to unity DC gain. They are symmetric, so the time   *
+ * reversed order CMSIS-DSP expects is the same as the natural order.                                  *
+ *                                                                                                     *
+ * @param coeffs [int16_t*] Output taps.                                                               *
+ * @param taps [uint16_t] Number of taps, at least 2.                                                  *
+ * @param cutoff_mhz [uint32_t] Cutoff frequency (mHz), below half the sample rate.                    *
+ * @param fs_mhz [uint32_t] Sample rate (mHz).                                                         *
+ * @return int 0 on success, -1 if the cutoff does not fit the sample rate.                            *
+ ******************************************************************************************************/
+int acc_dsp_design_lowpass(int16_t *coeffs, uint16_t taps, uint32_t cutoff_mhz, uint32_t fs_mhz)
+{
+	float fc = (float)cutoff_mhz / (float)fs_mhz;
+	float center = (float)(taps - 1) / 2.0f;
+	float sum = 0.0f;
+
+	if((taps < 2) || (0 == cutoff_mhz) || ((2 * (uint64_t)cutoff_mhz) >= fs_mhz)) {
+		return -1;
+	}
+
+	// Two passes, the first finds the DC gain so that no float copy of the taps is needed
+	for(int pass = 0; pass < 2; pass++) {
+		for(uint16_t n = 0; n < taps; n++) {
+			float m = (float)n - center;
+			float sinc = (0.0f == m) ? (2.0f * fc) : (sinf(2.0f * ACC_DSP_PI * fc * m) / (ACC_DSP_PI * m));
+			float h = sinc * (0.54f - (0.46f * cosf((2.0f * ACC_DSP_PI * (float)n) / (float)(taps - 1))));
+
+			if(0 == pass) {
+				sum += h;
+			}
+			else {
+				coeffs[n] = acc_dsp_to_q15(h / sum);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Designs a second-order Butterworth high-pass biquad in Q30.                                  *
+ *                                                                                                     *
+ * The section follows the audio EQ cookbook high-pass. The coefficients are laid out for              *
+ * `arm_biquad_cascade_df1_q31` with a post shift of `ACC_DSP_BIQUAD_POST_SHIFT`. The feed-forward     *
+ * coefficients are derived from the quantized b0 so that they sum to exactly zero, and no             *
+ * gravity leaks through the quantization.                                                             *
+ *                                                                                                     *
+ * @param coeffs [int32_t*] Output coefficients, `ACC_DSP_BIQUAD_COEFFS` values.                       *
+ * @param cutoff_mhz [uint32_t] Cutoff frequency (mHz), between 1/1000 and 1/2 of the sample rate.     *
+ * @param fs_mhz [uint32_t] Sample rate (mHz).                                                         *
+ * @return int 0 on success, -1 if the cutoff does not fit the sample rate.                            *
+ ******************************************************************************************************/
+int acc_dsp_design_highpass(int32_t *coeffs, uint32_t cutoff_mhz, uint32_t fs_mhz)
+{
+	if(((ACC_DSP_HIGHPASS_MIN_RATIO * (uint64_t)cutoff_mhz) < fs_mhz) || ((2 * (uint64_t)cutoff_mhz) >= fs_mhz)) {
+		return -1;
+	}
+
+	float w0 = (2.0f * ACC_DSP_PI * (float)cutoff_mhz) / (float)fs_mhz;
+	float cos_w0 = cosf(w0);
+	float alpha = sinf(w0) / (2.0f * ACC_DSP_BUTTERWORTH_Q);
+	float a0 = 1.0f + alpha;
+	int32_t b0 = acc_dsp_to_q30(((1.0f + cos_w0) / 2.0f) / a0);
+
+	coeffs[0] = b0;
+	coeffs[1] = -2 * b0;
+	coeffs[2] = b0;
+	coeffs[3] = acc_dsp_to_q30((2.0f * cos_w0) / a0);
+	coeffs[4] = acc_dsp_to_q30(-(1.0f - alpha) / a0);
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Initializes a decimating FIR, as `arm_fir_decimate_init_q15` does.                           *
+ *                                                                                                     *
+ * @param fir [acc_fir_t*] Filter instance.                                                            *
+ * @param coeffs [const int16_t*] Taps in time reversed order.                                         *
+ * @param taps [uint16_t] Number of taps.                                                              *
+ * @param decimation [uint8_t] Input samples per output sample.                                        *
+ * @param state [int16_t*] State buffer of `taps + block_size - 1` samples, cleared here.              *
+ * @param block_size [uint32_t] Input samples per call, a multiple of the decimation.                  *
+ * @return int 0 on success, -1 if the block size is not a multiple of the decimation.                 *
+ ******************************************************************************************************/
+int acc_fir_decimate_init(acc_fir_t *fir, const int16_t *coeffs, uint16_t taps, uint8_t decimation,
+						  int16_t *state, uint32_t block_size)
+{
+	if((0 == decimation) || (0 != (block_size % decimation))) {
+		return -1;
+	}
+
+	fir->coeffs = coeffs;
+	fir->state = state;
+	fir->taps = taps;
+	fir->decimation = decimation;
+	memset(state, 0, (taps + block_size - 1) * sizeof(int16_t));
+
+#if ACC_DSP_USE_CMSIS_DSP
+	if(ARM_MATH_SUCCESS != arm_fir_decimate_init_q15(&fir->arm, taps, decimation, (q15_t*)coeffs, state, block_size)) {
+		return -1;
+	}
+#endif
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Low-pass filters and decimates one block of samples.                                         *
+ *                                                                                                     *
+ * The output matches `arm_fir_decimate_q15`: for every `decimation` input samples, the first of them  *
+ * and the `taps - 1` before it are multiplied by the taps in a 64-bit accumulator, which is shifted   *
+ * back to q15 and saturated. The portable version accumulates two taps per SMLALD instruction.        *
+ *                                                                                                     *
+ * @param fir [acc_fir_t*] Filter instance.                                                            *
+ * @param in [const int16_t*] `block_size` input samples.                                              *
+ * @param out [int16_t*] `block_size / decimation` output samples.                                     *
+ * @param block_size [uint32_t] Input samples, the block size given at initialization.                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_fir_decimate(acc_fir_t *fir, const int16_t *in, int16_t *out, uint32_t block_size)
+{
+#if ACC_DSP_USE_CMSIS_DSP
+	arm_fir_decimate_q15(&fir->arm, (const q15_t*)in, out, block_size);
+#else
+	uint16_t history = fir->taps - 1;
+
+	// New samples go after the past inputs, the window of each output starts M samples after the last
+	memcpy(&fir->state[history], in, block_size * sizeof(int16_t));
+	for(uint32_t n = 0; n < block_size; n += fir->decimation) {
+		*out++ = acc_dsp_sat_q15(acc_dsp_dot_q15(&fir->state[n], fir->coeffs, fir->taps) >> 15);
+	}
+	memmove(fir->state, &fir->state[block_size], history * sizeof(int16_t));
+#endif
+}
+
+/*******************************************************************************************************
+ * @brief Initializes a single stage biquad, as `arm_biquad_cascade_df1_init_q31` does.                *
+ *                                                                                                     *
+ * @param biquad [acc_biquad_t*] Filter instance.                                                      *
+ * @param coeffs [const int32_t*] `ACC_DSP_BIQUAD_COEFFS` coefficients from `acc_dsp_design_highpass`. *
+ * @param state [int32_t*] State buffer of `ACC_DSP_BIQUAD_STATE` samples, cleared here.               *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_biquad_init(acc_biquad_t *biquad, const int32_t *coeffs, int32_t *state)
+{
+	biquad->coeffs = coeffs;
+	biquad->state = state;
+	memset(state, 0, ACC_DSP_BIQUAD_STATE * sizeof(int32_t));
+
+#if ACC_DSP_USE_CMSIS_DSP
+	arm_biquad_cascade_df1_init_q31(&biquad->arm, 1, (q31_t*)coeffs, state, ACC_DSP_BIQUAD_POST_SHIFT);
+#endif
+}
+
+/*******************************************************************************************************
+ * @brief Filters a block of samples through the biquad.                                               *
+ *                                                                                                     *
+ * The output matches `arm_biquad_cascade_df1_q31`: the direct form I sum is accumulated in 64 bits    *
+ * and shifted by `31 - ACC_DSP_BIQUAD_POST_SHIFT` without saturation, so the input keeps the headroom *
+ * of `ACC_DSP_BIQUAD_INPUT_SHIFT`. A q15 biquad would not do at low cutoffs: its poles are so close   *
+ * to one that the truncation of each output, fed back, adds an offset of hundreds of counts. Each     *
+ * product is a single cycle SMLAL on the Cortex-M4.                                                   *
+ *                                                                                                     *
+ * @param biquad [acc_biquad_t*] Filter instance.                                                      *
+ * @param in [const int32_t*] Input samples.                                                           *
+ * @param out [int32_t*] Output samples, may be the input buffer.                                      *
+ * @param block_size [uint32_t] Number of samples.                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_biquad(acc_biquad_t *biquad, const int32_t *in, int32_t *out, uint32_t block_size)
+{
+#if ACC_DSP_USE_CMSIS_DSP
+	arm_biquad_cascade_df1_q31(&biquad->arm, (const q31_t*)in, out, block_size);
+#else
+	const int32_t *c = biquad->coeffs;
+	int32_t x1 = biquad->state[0];
+	int32_t x2 = biquad->state[1];
+	int32_t y1 = biquad->state[2];
+	int32_t y2 = biquad->state[3];
+
+	for(uint32_t n = 0; n < block_size; n++) {
+		int32_t x0 = in[n];
+		int64_t acc = ((int64_t)c[0] * x0) + ((int64_t)c[1] * x1) + ((int64_t)c[2] * x2)
+					+ ((int64_t)c[3] * y1) + ((int64_t)c[4] * y2);
+
+		x2 = x1;
+		x1 = x0;
+		y2 = y1;
+		y1 = (int32_t)(acc >> (31 - ACC_DSP_BIQUAD_POST_SHIFT));
+		out[n] = y1;
+	}
+
+	biquad->state[0] = x1;
+	biquad->state[1] = x2;
+	biquad->state[2] = y1;
+	biquad->state[3] = y2;
+#endif
+}
+
+/*******************************************************************************************************
+ * @brief Empties a statistics window.                                                                 *
+ *                                                                                                     *
+ * @param window [acc_window_t*] Window to reset.                                                      *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_window_reset(acc_window_t *window)
+{
+	window->sum = 0;
+	window->sum_squares = 0;
+	window->min = INT16_MAX;
+	window->max = INT16_MIN;
+	window->count = 0;
+}
+
+/*******************************************************************************************************
+ * @brief Adds a block of samples to a statistics window.                                              *
+ *                                                                                                     *
+ * @param window [acc_window_t*] Window to update.                                                     *
+ * @param in [const int16_t*] Samples.                                                                 *
+ * @param block_size [uint32_t] Number of samples.                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_window_update(acc_window_t *window, const int16_t *in, uint32_t block_size)
+{
+	int32_t sum = 0;
+	uint64_t sum_squares = 0;
+	int16_t min = window->min;
+	int16_t max = window->max;
+
+	for(uint32_t n = 0; n < block_size; n++) {
+		sum += in[n];
+		sum_squares += (uint32_t)((int32_t)in[n] * in[n]);
+		min = (in[n] < min) ? in[n] : min;
+		max = (in[n] > max) ? in[n] : max;
+	}
+
+	window->sum += sum;
+	window->sum_squares += sum_squares;
+	window->min = min;
+	window->max = max;
+	window->count += block_size;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the mean of a statistics window, rounded to the nearest count.                       *
+ *                                                                                                     *
+ * @param window [const acc_window_t*] Window.                                                         *
+ * @return int32_t Mean, 0 for an empty window.                                                        *
+ ******************************************************************************************************/
+int32_t acc_window_mean(const acc_window_t *window)
+{
+	int64_t half = window->count / 2;
+
+	if(0 == window->count) {
+		return 0;
+	}
+
+	return (int32_t)((window->sum >= 0) ? ((window->sum + half) / window->count) : -((-window->sum + half) / window->count));
+}
+
+/*******************************************************************************************************
+ * @brief Returns the root mean square of a statistics window, as `arm_rms_q15` does in counts.        *
+ *                                                                                                     *
+ * @param window [const acc_window_t*] Window.                                                         *
+ * @return uint32_t RMS, 0 for an empty window.                                                        *
+ ******************************************************************************************************/
+uint32_t acc_window_rms(const acc_window_t *window)
+{
+	return (0 != window->count) ? acc_dsp_isqrt(window->sum_squares / window->count) : 0;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the peak-to-peak amplitude of a statistics window.                                   *
+ *                                                                                                     *
+ * @param window [const acc_window_t*] Window.                                                         *
+ * @return uint32_t Largest minus smallest sample, 0 for an empty window.                              *
+ ******************************************************************************************************/
+uint32_t acc_window_p2p(const acc_window_t *window)
+{
+	return (0 != window->count) ? (uint32_t)((int32_t)window->max - window->min) : 0;
+}
+
+/*******************************************************************************************************
+ * @brief Computes the tilt of the board from the gravity vector.                                      *
+ *                                                                                                     *
+ * Pitch is the angle of the X-axis above the horizontal and roll the rotation about the X-axis, both  *
+ * from the low-passed mean of each axis. Any scale works as only the ratios of the axes matter.       *
+ *                                                                                                     *
+ * @param axis [const int32_t*] X, Y and Z acceleration.                                               *
+ * @param pitch_cdeg [int32_t*] Pitch, -9000 to 9000 hundredths of a degree.                           *
+ * @param roll_cdeg [int32_t*] Roll, -18000 to 18000 hundredths of a degree.                           *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_dsp_tilt(const int32_t *axis, int32_t *pitch_cdeg, int32_t *roll_cdeg)
+{
+	float x = (float)axis[0];
+	float y = (float)axis[1];
+	float z = (float)axis[2];
+	float to_cdeg = 18000.0f / ACC_DSP_PI;
+
+	*pitch_cdeg = (int32_t)lroundf(atan2f(x, sqrtf((y * y) + (z * z))) * to_cdeg);
+	*roll_cdeg = (int32_t)lroundf(atan2f(y, z) * to_cdeg);
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Saturates an accumulator to the q15 range.                                                   *
+ *                                                                                                     *
+ * @param value [int64_t] Accumulator already shifted back to q15.                                     *
+ * @return int16_t Saturated value.                                                                    *
+ ******************************************************************************************************/
+static int16_t acc_dsp_sat_q15(int64_t value)
+{
+	if(value > INT16_MAX) {
+		return INT16_MAX;
+	}
+	if(value < INT16_MIN) {
+		return INT16_MIN;
+	}
+
+	return (int16_t)value;
+}
+
+/*******************************************************************************************************
+ * @brief Converts a coefficient to q15, rounded and saturated.                                        *
+ *                                                                                                     *
+ * @param value [float] Coefficient.                                                                   *
+ * @return int16_t q15 coefficient.                                                                    *
+ ******************************************************************************************************/
+static int16_t acc_dsp_to_q15(float value)
+{
+	return acc_dsp_sat_q15(lroundf(value * ACC_DSP_Q15_ONE));
+}
+
+/*******************************************************************************************************
+ * @brief Converts a coefficient to Q30, rounded.                                                      *
+ *                                                                                                     *
+ * @param value [float] Coefficient, between -2 and 2.                                                 *
+ * @return int32_t Q30 coefficient.                                                                    *
+ ******************************************************************************************************/
+static int32_t acc_dsp_to_q30(float value)
+{
+	int64_t fixed = llroundf(value * ACC_DSP_Q30_ONE);
+
+	return (int32_t)((fixed > INT32_MAX) ? INT32_MAX : ((fixed < INT32_MIN) ? INT32_MIN : fixed));
+}
+
+#if !ACC_DSP_USE_CMSIS_DSP
+/*******************************************************************************************************
+ * @brief Multiplies a window of samples by the FIR taps.                                              *
+ *                                                                                                     *
+ * @param x [const int16_t*] Oldest sample of the window.                                              *
+ * @param coeffs [const int16_t*] Taps in time reversed order.                                         *
+ * @param taps [uint16_t] Number of taps.                                                              *
+ * @return int64_t Sum of the products in q30.                                                         *
+ ******************************************************************************************************/
+static int64_t acc_dsp_dot_q15(const int16_t *x, const int16_t *coeffs, uint16_t taps)
+{
+	int64_t acc = 0;
+	uint16_t k = 0;
+
+#if ACC_DSP_SIMD
+	for(; (k + 1) < taps; k += 2) {
+		acc = (int64_t)__SMLALD(acc_dsp_read_q15x2(&x[k]), acc_dsp_read_q15x2(&coeffs[k]), (uint64_t)acc);
+	}
+#endif
+	for(; k < taps; k++) {
+		acc += (int32_t)x[k] * coeffs[k];
+	}
+
+	return acc;
+}
+#endif
+
+#if ACC_DSP_SIMD && !ACC_DSP_USE_CMSIS_DSP
+/*******************************************************************************************************
+ * @brief Reads two consecutive q15 values as one word, the first in the low half.                     *
+ *                                                                                                     *
+ * The Cortex-M4 allows unaligned word loads, so the window may start on any sample.                   *
+ *                                                                                                     *
+ * @param pair [const int16_t*] First of the two values.                                               *
+ * @return uint32_t Packed values.                                                                     *
+ ******************************************************************************************************/
+static uint32_t acc_dsp_read_q15x2(const int16_t *pair)
+{
+	uint32_t word;
+
+	memcpy(&word, pair, sizeof(word));
+	return word;
+}
+#endif
+
+/*******************************************************************************************************
+ * @brief Integer square root.                                                                         *
+ *                                                                                                     *
+ * @param value [uint64_t] Value, below 2^62.                                                          *
+ * @return uint32_t Largest integer whose square does not exceed the value.                            *
+ ******************************************************************************************************/
+static uint32_t acc_dsp_isqrt(uint64_t value)
+{
+	uint64_t root = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while(bit > value) {
+		bit >>= 2;
+	}
+	while(0 != bit) {
+		if(value >= (root + bit)) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)root;
+}
@@ -0,0 +1,89 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccDsp.h                                                                  |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccDsp` kernels reduce high-rate accelerometer samples to low-rate            |
+|    features: a q15 decimating FIR low-pass, a q31 biquad high-pass, window            |
+|    statistics for RMS and peak-to-peak, and tilt angles. The filters follow           |
+|    the CMSIS-DSP conventions and run on the Cortex-M4 DSP instructions, or            |
+|    on the CMSIS-DSP library itself when `ACC_DSP_USE_CMSIS_DSP` is set.               |
+\*=====================================================================================*/
+
+#ifndef ACCDSP_H_
+#define ACCDSP_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+#include "Config_AccManager.h"
+#if ACC_DSP_USE_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define ACC_DSP_BIQUAD_COEFFS		5 // b0, b1, b2, a1, a2
+#define ACC_DSP_BIQUAD_STATE		4 // x[n-1], x[n-2], y[n-1], y[n-2]
+#define ACC_DSP_BIQUAD_POST_SHIFT	1 // Biquad coefficients are Q30 so that |a1| up to 2 fits in 32 bits
+#define ACC_DSP_BIQUAD_INPUT_SHIFT	14 // q15 samples enter the q31 biquad with 2 bits of headroom
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+#if ACC_DSP_USE_CMSIS_DSP
+	arm_fir_decimate_instance_q15 arm;	// Library instance sharing the coefficients and state below
+#endif
+	const int16_t *coeffs;		// Taps in time reversed order, as CMSIS-DSP stores them
+	int16_t *state;				// taps - 1 past inputs followed by room for one input block
+	uint16_t taps;
+	uint8_t decimation;			// Input samples per output sample
+} acc_fir_t;
+
+typedef struct
+{
+#if ACC_DSP_USE_CMSIS_DSP
+	arm_biquad_casd_df1_inst_q31 arm;	// Library instance sharing the coefficients and state below
+#endif
+	const int32_t *coeffs;		// ACC_DSP_BIQUAD_COEFFS in Q30, the feedback coefficients negated
+	int32_t *state;				// ACC_DSP_BIQUAD_STATE past inputs and outputs
+} acc_biquad_t;
+
+typedef struct
+{
+	int64_t sum;				// Sum of the samples
+	uint64_t sum_squares;		// Sum of the squared samples
+	int16_t min;
+	int16_t max;
+	uint32_t count;				// Samples in the window
+} acc_window_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+int acc_dsp_design_lowpass(int16_t *coeffs, uint16_t taps, uint32_t cutoff_mhz, uint32_t fs_mhz);
+int acc_dsp_design_highpass(int32_t *coeffs, uint32_t cutoff_mhz, uint32_t fs_mhz);
+int acc_fir_decimate_init(acc_fir_t *fir, const int16_t *coeffs, uint16_t taps, uint8_t decimation,
+						  int16_t *state, uint32_t block_size);
+void acc_fir_decimate(acc_fir_t *fir, const int16_t *in, int16_t *out, uint32_t block_size);
+void acc_biquad_init(acc_biquad_t *biquad, const int32_t *coeffs, int32_t *state);
+void acc_biquad(acc_biquad_t *biquad, const int32_t *in, int32_t *out, uint32_t block_size);
+void acc_window_reset(acc_window_t *window);
+void acc_window_update(acc_window_t *window, const int16_t *in, uint32_t block_size);
+int32_t acc_window_mean(const acc_window_t *window);
+uint32_t acc_window_rms(const acc_window_t *window);
+uint32_t acc_window_p2p(const acc_window_t *window);
+void acc_dsp_tilt(const int32_t *axis, int32_t *pitch_cdeg, int32_t *roll_cdeg);
+
+#endif /* ACCDSP_H_ */
@@ -18,34 +18,94 @@
 
 #include "AccManager.h"
 #include "Config_AccManager.h"
+#include "AccSensor.h"
+#include "AccStream.h"
+#include "AccPipeline.h"
+#include "Config_UartManager.h"
+#include "Command.h"
 #include "main.h"
 #include <string.h>
 #include <stdio.h>
+#include <inttypes.h>
 #include <stdlib.h>
+#include <ctype.h>
 
 /****************************************************
  *  Function prototypes                             *
  ****************************************************/
 
-void accelerometer_read(int16_t *acc_data);
 void show_acc_data(int16_t *acc_data, char *acc_flag);
-void split_integer(int value, char* sign, int *thousands_part, int *hundreds_part);
+void split_integer(int value, char* sign, int *units_part, int *hundredths_part);
+static void acc_show_axes(uint8_t axes);
+static void acc_cmd_x(const char *args);
+static void acc_cmd_y(const char *args);
+static void acc_cmd_z(const char *args);
+static void acc_cmd_all(const char *args);
+static void acc_cmd_stream(const char *args);
+static void acc_cmd_sensor(const char *args);
+static void acc_cmd_odr(const char *args);
+static void acc_cmd_range(const char *args);
+static void acc_cmd_filter(const char *args);
+static void acc_show_filter(void);
+static int parse_milli(const char *text, uint32_t *value);
+static int format_odr(char *buf, size_t size, uint32_t odr_mhz);
+static void print_stream_report(const acc_features_t *features, uint32_t rate, uint32_t seconds);
+static void print_stream_summary(uint32_t seconds);
+static void acc_cmd_main(const char *args);
 
 /****************************************************
  *  Messages                                        *
  ****************************************************/
 
 const char *msg_inv_acc = "\n***** Invalid accelerometer option ******\n";
+const char *msg_no_acc = "\n***** No accelerometer detected *****\n";
+const char *msg_acc_busy = "\n***** Not available while streaming *****\n";
+const char *msg_inv_odr = "\n***** Unsupported output data rate *****\n";
+const char *msg_inv_range = "\n***** Unsupported full scale *****\n";
+const char *msg_valid_odr = "\n Confirmed: output data rate updated\n";
+const char *msg_valid_range = "\n Confirmed: full scale updated\n";
+const char *msg_inv_filter = "\n***** Invalid filter settings for the output data rate *****\n";
+const char *msg_valid_filter = "\n Confirmed: stream filters updated\n";
+const char *msg_filter_reset = "\n***** Filters reset to fit the output data rate *****\n";
+const char *msg_stream_header = "\n************************************\n"
+								"*        STREAM STATISTICS         *\n"
+								"*                                  *\n";
+const char *msg_stream_footer = "*                                  *\n"
+								"************************************\n";
 const char *msg_acc_menu = "\n======================================\n"
 				  		     "|         Accelerometer Menu         |\n"
 						     "======================================\n\n"
-							 " X    ---> Read X-axis\n"
-							 " Y    ---> Read Y-axis\n"
-							 " Z    ---> Read Z-axis\n"
-							 " All  ---> Read all axes\n"
-							 " Main ---> Return to main menu\n\n"
+							 " X      ---> Read X-axis\n"
+							 " Y      ---> Read Y-axis\n"
+							 " Z      ---> Read Z-axis\n"
+							 " All    ---> Read all axes\n"
+							 " Stream ---> Stream samples at the sensor data rate\n"
+							 " Sensor ---> Show the sensor and its settings\n"
+							 " Odr    ---> Change output data rate (Odr Hz)\n"
+							 " Range  ---> Change full scale (Range g)\n"
+							 " Filter ---> Change stream filters (Filter M LP HP)\n"
+							 " Main   ---> Return to main menu\n\n"
 							 " Enter your selection here: ";
 
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Accelerometer menu commands
+static const command_t acc_commands[] = {
+	{ "X",		acc_cmd_x,		0 },
+	{ "Y",		acc_cmd_y,		0 },
+	{ "Z",		acc_cmd_z,		0 },
+	{ "All",	acc_cmd_all,	0 },
+	{ "Stream",	acc_cmd_stream,	0 },
+	{ "Sensor",	acc_cmd_sensor,	0 },
+	{ "Odr",	acc_cmd_odr,	1 },
+	{ "Range",	acc_cmd_range,	1 },
+	{ "Filter",	acc_cmd_filter,	1 },
+	{ "Main",	acc_cmd_main,	0 },
+};
+static command_table_t acc_command_table = COMMAND_TABLE(acc_commands);
+
 /****************************************************
  *  Public functions                                *
  ****************************************************/
@@ -53,7 +113,7 @@ const char *msg_acc_menu = "\n======================================\n"
 /*******************************************************************************************************
  * @brief Task to manage accelerometer operations in the system.									   *
  *																									   *
- * This task handles user interactions for reading accelerometer data from various axes (X, Y, Z, 	   *
+ * This task handles user interactions for reading accelerometer data from various axes (X, Y, Z,      *
  * or all three) and displays the data to the user. It waits for notifications to start processing,    *
  * displays the accelerometer menu, processes user commands, reads accelerometer data, updates flags,  *
  * and synchronizes with the LED task via event groups. 											   *
@@ -69,161 +129,434 @@ const char *msg_acc_menu = "\n======================================\n"
 
 void acc_task(void* param)
 {
-	uint32_t msg_addr;
 	message_t *msg;
-	int16_t acc_data[3];		// Array to hold accelerometer values
-	char acc_flag[3] = {0};		// Array to hold new data flags
+
+	// Build the hash index of the command table
+	int status = command_table_init(&acc_command_table);
+	configASSERT(0 == status);
 
 	while(1) {
 		// Wait for notification from another task
 		xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
 
 		// Display Accelerometer menu for the user
-		xQueueSend(q_print, &msg_acc_menu, portMAX_DELAY);
+		print_interactive(msg_acc_menu);
 
 		// Wait for the user to make a selection
-		xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-		msg = (message_t*)msg_addr;
+		msg = uart_wait_message();
 
-		// Set all new data flags to 0
-		for(int i=0; i<3; i++) {
-			acc_flag[i] = 0;
+		// Process command, notify user of invalid response
+		if(!command_dispatch(&acc_command_table, (char*)msg->payload)) {
+			print_error(msg_inv_acc);
 		}
 
-		// Process command
-		if(msg->len <= 4) {
-			if(!strcmp((char*)msg->payload, "X")) {
-				// Read accelerometer for X-axis only
-				accelerometer_read(acc_data);						// Read data
-				acc_flag[0] = 1; 									// Set X-axis new data flag
-				show_acc_data(acc_data, acc_flag);					// Show data
-				xEventGroupSetBits(ledEventGroup, ACCEL_READ_X_BIT);	// Set X-axis event group bit for LED task synchronization
-			}
-			else if(!strcmp((char*)msg->payload, "Y")) {
-				// Read accelerometer for X-axis only
-				accelerometer_read(acc_data);						// Read data
-				acc_flag[1] = 1; 									// Set Y-axis new data flag
-				show_acc_data(acc_data, acc_flag);					// Show data
-				xEventGroupSetBits(ledEventGroup, ACCEL_READ_Y_BIT); 	// Set Y-axis event group bit for LED task synchronization
-			}
-			else if(!strcmp((char*)msg->payload, "Z")) {
-				// Read accelerometer for X-axis only
-				accelerometer_read(acc_data);						// Read data
-				acc_flag[2] = 1; 									// Set Z-axis new data flag
-				show_acc_data(acc_data, acc_flag);					// Show data
-				xEventGroupSetBits(ledEventGroup, ACCEL_READ_Z_BIT);	// Set Z-axis event group bit for LED task synchronization
-			}
-			else if(!strcmp((char*)msg->payload, "All")) {
-				accelerometer_read(acc_data);						// Read data
-				for(int i=0; i<3; i++) acc_flag[i] = 1; 			// Set new data flags for all axes
-				show_acc_data(acc_data, acc_flag);					// Show data
-				// Set all event group bits for LED task synchronization
-				xEventGroupSetBits(ledEventGroup, ACCEL_READ_X_BIT);
-				xEventGroupSetBits(ledEventGroup, ACCEL_READ_Y_BIT);
-				xEventGroupSetBits(ledEventGroup, ACCEL_READ_Z_BIT);
-			}
-			else if (!strcmp((char*)msg->payload, "Main")) {
-				// Update the system state
-				curr_sys_state = sMainMenu;
+		// Notify self / accelerometer task if not returning to the main menu
+		if (sAccMenu == curr_sys_state)
+			xTaskNotify(handle_acc_task, 0, eNoAction);
+	}
+}
 
-				// Set event group bit to turn off all LEDs upon exiting accelerometer menu
-				xEventGroupSetBits(ledEventGroup, TURN_OFF_LEDS_BIT);
+/*******************************************************************************************************
+ * @brief Initializes the accelerometer.                                                               *
+ *                                                                                                     *
+ * The sensor is identified from its WHO_AM_I register and set to `ACC_DEFAULT_ODR_MHZ` and            *
+ * `ACC_DEFAULT_RANGE_G`. If no supported sensor answers, the readings are zero and the `Sensor`       *
+ * command reports it.                                                                                 *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called before the scheduler starts.                                                           *
+ ******************************************************************************************************/
 
-				// Notify the main menu task
-				xTaskNotify(handle_main_menu_task, 0, eNoAction);
-			}
-			else {
-				xQueueSend(q_print, &msg_inv_acc, portMAX_DELAY);
-			}
+void accelerometer_init(void)
+{
+	acc_sensor_init();
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Reads the accelerometer and shows the selected axes.                                         *
+ *                                                                                                     *
+ * This function also sets the event group bit of each selected axis, so the LED task can light the    *
+ * matching LED.                                                                                       *
+ *                                                                                                     *
+ * @param axes [uint8_t] Bit 0 selects the X-axis, bit 1 the Y-axis and bit 2 the Z-axis.              *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void acc_show_axes(uint8_t axes)
+{
+	int16_t acc_data[3];		// Array to hold accelerometer values
+	char acc_flag[3];			// Array to hold new data flags
+	const EventBits_t axis_bits[3] = { ACCEL_READ_X_BIT, ACCEL_READ_Y_BIT, ACCEL_READ_Z_BIT };
+
+	// Read data and set the new data flag of each selected axis
+	accelerometer_read(acc_data);
+	for(int i = 0; i < 3; i++) {
+		acc_flag[i] = (axes >> i) & 1;
+	}
+	show_acc_data(acc_data, acc_flag);
+
+	// Set the event group bits for LED task synchronization
+	for(int i = 0; i < 3; i++) {
+		if(acc_flag[i]) {
+			xEventGroupSetBits(ledEventGroup, axis_bits[i]);
 		}
-		else {
-			// If user input is longer than 4 characters, notify user of invalid response
-			xQueueSend(q_print, &msg_inv_acc, portMAX_DELAY);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Accelerometer menu `X`, `Y`, `Z` and `All` commands.                                         *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void acc_cmd_x(const char *args)
+{
+	acc_show_axes(0x1);
+}
+
+static void acc_cmd_y(const char *args)
+{
+	acc_show_axes(0x2);
+}
+
+static void acc_cmd_z(const char *args)
+{
+	acc_show_axes(0x4);
+}
+
+static void acc_cmd_all(const char *args)
+{
+	acc_show_axes(0x7);
+}
+
+/*******************************************************************************************************
+ * @brief Accelerometer menu `Stream` command: streams samples until the user presses a key.           *
+ *                                                                                                     *
+ * The accelerometer task is the consumer of the stream. It waits for blocks of samples on the stream  *
+ * queue, never on SPI1, and runs each block through the filter pipeline, so that only the features    *
+ * of every `ACC_STREAM_REPORT_MS` window are printed: the sample rates, the mean and tilt, and the    *
+ * RMS and peak-to-peak vibration. Any input stops the stream and prints the stream counters.          *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void acc_cmd_stream(const char *args)
+{
+	acc_stream_stats_t stats;
+	acc_pipeline_config_t config;
+	acc_features_t features;
+	uint32_t last_samples = 0;
+	uint32_t seconds = 0;
+	TickType_t start;
+	TickType_t last_report;
+	TickType_t last_rate;
+	char odr[16];
+	char out_rate[16];
+
+	if(NULL == acc_sensor_get()) {
+		print_error(msg_no_acc);
+		return;
+	}
+
+	// The filters are designed for the output data rate, which may have changed since they were set
+	acc_pipeline_get_config(&config);
+	if(0 != acc_pipeline_configure(&config, acc_sensor_odr())) {
+		config.lowpass_mhz = 0;
+		config.highpass_mhz = 0;
+		acc_pipeline_configure(&config, acc_sensor_odr());
+		print_error(msg_filter_reset);
+	}
+
+	char *showstart = print_pool_alloc(portMAX_DELAY);
+	format_odr(odr, sizeof(odr), acc_sensor_odr());
+	format_odr(out_rate, sizeof(out_rate), acc_sensor_odr() / config.decimation);
+	snprintf(showstart, PRINT_POOL_BLOCK_SIZE, "\n Starting accelerometer streaming at %s Hz, filtered to %s Hz. Press any key to stop...\n\n", odr, out_rate);
+	print_pool_send(showstart);
+
+	start = xTaskGetTickCount();
+	last_report = start;
+	last_rate = start;
+	acc_stream_start();
+
+	// Consume blocks until the user enters anything
+	while(NULL == uart_poll_message(0)) {
+		acc_block_t *block = acc_stream_receive(pdMS_TO_TICKS(ACC_STREAM_POLL_MS));
+		if(NULL != block) {
+			acc_pipeline_process(block);
+			acc_stream_release(block);
 		}
 
-		// Notify self / accelerometer task if not returning to the main menu
-		if (sAccMenu == curr_sys_state)
-			xTaskNotify(handle_acc_task, 0, eNoAction);
+		if((xTaskGetTickCount() - last_report) >= pdMS_TO_TICKS(ACC_STREAM_REPORT_MS)) {
+			last_report += pdMS_TO_TICKS(ACC_STREAM_REPORT_MS);
+			seconds += ACC_STREAM_REPORT_MS / 1000;
+
+			// The rate comes from the sample counter over the actual interval, blocks complete at their own pace
+			TickType_t now = xTaskGetTickCount();
+			acc_stream_get_stats(&stats);
+			acc_pipeline_features(&features);
+			print_stream_report(&features, (stats.samples - last_samples) * configTICK_RATE_HZ / (now - last_rate), seconds);
+			last_samples = stats.samples;
+			last_rate = now;
+		}
 	}
+
+	acc_stream_stop();
+	print_stream_summary((xTaskGetTickCount() - start) / configTICK_RATE_HZ);
 }
 
 /*******************************************************************************************************
- * @brief Initializes the accelerometer with specific settings.										   *
- *																									   *
- * This function configures the accelerometer by setting it to operate at 100Hz in normal power 	   *
- * mode with all axes enabled. It uses the SPI interface to transmit the configuration settings 	   *
- * to the accelerometer.																			   *
- *																									   *
- * @note The function performs the following steps:													   *
- * - Pulls the chip select (CS) pin low to select the device.										   *
- * - Sends the address of the control register (CTRL_REG1_A) over SPI.								   *
- * - Sends the configuration data over SPI to set the desired settings.								   *
- * - Pulls the chip select (CS) pin high to de-select the device.									   *
+ * @brief Accelerometer menu `Sensor` command: shows the detected sensor and its settings.             *
+ *                                                                                                     *
+ * The supported output data rates and full scales are listed after the selected ones.                 *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
  ******************************************************************************************************/
 
-void accelerometer_init(void)
+static void acc_cmd_sensor(const char *args)
 {
-	// Configure CTRL_REG1_A: 100Hz, normal power mode, all axes enabled
-	uint8_t configData = 0x57; // 0b01010111: 100Hz, normal power mode, all axes enabled
+	const acc_sensor_t *sensor = acc_sensor_get();
+	char odr[16];
+	int len;
+
+	if(NULL == sensor) {
+		print_error(msg_no_acc);
+		return;
+	}
 
-	// Pull CS low to select the device
-	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_RESET);
+	char *showsensor = print_pool_alloc(portMAX_DELAY);
+	format_odr(odr, sizeof(odr), acc_sensor_odr());
+	len = snprintf(showsensor, PRINT_POOL_BLOCK_SIZE, "\n Sensor: %s\n Output data rate: %s Hz (", sensor->name, odr);
+	for(uint32_t i = 0; (i < sensor->num_odrs) && (len < PRINT_POOL_BLOCK_SIZE); i++) {
+		format_odr(odr, sizeof(odr), sensor->odrs[i].odr_mhz);
+		len += snprintf(showsensor + len, PRINT_POOL_BLOCK_SIZE - len, (0 == i) ? "%s" : ", %s", odr);
+	}
+	if(len < PRINT_POOL_BLOCK_SIZE) {
+		len += snprintf(showsensor + len, PRINT_POOL_BLOCK_SIZE - len, ")\n Full scale: +/- %" PRIu32 " g (", acc_sensor_range());
+	}
+	for(uint32_t i = 0; (i < sensor->num_ranges) && (len < PRINT_POOL_BLOCK_SIZE); i++) {
+		len += snprintf(showsensor + len, PRINT_POOL_BLOCK_SIZE - len, (0 == i) ? "%u" : ", %u", sensor->ranges[i].range_g);
+	}
+	if(len < PRINT_POOL_BLOCK_SIZE) {
+		snprintf(showsensor + len, PRINT_POOL_BLOCK_SIZE - len, ")\n");
+	}
+	print_pool_send(showsensor);
+}
+
+/*******************************************************************************************************
+ * @brief Accelerometer menu `Odr` command: changes the output data rate.                              *
+ *                                                                                                     *
+ * The rate is given in Hz and must be one of the rates listed by `Sensor`, e.g. `Odr 1600` or         *
+ * `Odr 3.125`. Without a rate, the sensor settings are shown.                                         *
+ *                                                                                                     *
+ * @param args [const char*] Output data rate (Hz).                                                    *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
 
-	// Send the register address
-	uint8_t reg = LSM303DLHC_CTRL_REG1_A;
-	HAL_SPI_Transmit(&hspi1, &reg, 1, HAL_MAX_DELAY);
+static void acc_cmd_odr(const char *args)
+{
+	uint32_t odr_mhz;
 
-	// Send the configuration data
-	HAL_SPI_Transmit(&hspi1, &configData, 1, HAL_MAX_DELAY);
+	if('\0' == args[0]) {
+		acc_cmd_sensor(args);
+		return;
+	}
+	if(acc_stream_active()) {
+		print_error(msg_acc_busy);
+		return;
+	}
+	if(NULL == acc_sensor_get()) {
+		print_error(msg_no_acc);
+		return;
+	}
+	if((0 != parse_milli(args, &odr_mhz)) || (0 != acc_sensor_set_odr(odr_mhz))) {
+		print_error(msg_inv_odr);
+		return;
+	}
 
-	// Pull CS high to deselect the device
-	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+	print_interactive(msg_valid_odr);
 }
 
-/****************************************************
- *  Private functions                               *
- ****************************************************/
+/*******************************************************************************************************
+ * @brief Accelerometer menu `Range` command: changes the full scale.                                  *
+ *                                                                                                     *
+ * The full scale is given in g and must be one of the ranges listed by `Sensor`, e.g. `Range 4`.      *
+ * Without a range, the sensor settings are shown.                                                     *
+ *                                                                                                     *
+ * @param args [const char*] Full scale (+/- g).                                                       *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void acc_cmd_range(const char *args)
+{
+	uint32_t range_mg;
+
+	if('\0' == args[0]) {
+		acc_cmd_sensor(args);
+		return;
+	}
+	if(acc_stream_active()) {
+		print_error(msg_acc_busy);
+		return;
+	}
+	if(NULL == acc_sensor_get()) {
+		print_error(msg_no_acc);
+		return;
+	}
+	if((0 != parse_milli(args, &range_mg)) || (0 != (range_mg % 1000)) || (0 != acc_sensor_set_range(range_mg / 1000))) {
+		print_error(msg_inv_range);
+		return;
+	}
+
+	print_interactive(msg_valid_range);
+}
 
 /*******************************************************************************************************
- * @brief Reads accelerometer data from the sensor.													   *
- *																									   *
- * This function reads the accelerometer data for the X, Y, and Z axes. It uses the SPI interface 	   *
- * to communicate with the accelerometer and retrieves the sensor readings, which are then stored 	   *
- * in the provided array.																			   *
- *																									   *
- * @param acc_data Pointer to an array of three 16-bit integers where the accelerometer data for 	   *
- * the X, Y, and Z axes will be stored.																   *
- *																									   *
- * @note The function performs the following steps:													   *
- * - Pulls the chip select (CS) pin low to select the device.										   *
- * - Sends the address of the register from which to start reading.									   *
- * - Receives 6 bytes of data from the sensor, corresponding to the readings for the X, Y, and Z axes. *
- * - Pulls the chip select (CS) pin high to deselect the device.									   *
- * - Converts the received byte data to 16-bit integer values for each axis and stores them in the 	   *
- *   provided array.																				   *
+ * @brief Accelerometer menu `Filter` command: changes the filters applied to the stream.              *
+ *                                                                                                     *
+ * The arguments are the decimation factor and the low-pass and high-pass cutoffs in Hz, e.g.          *
+ * `Filter 8 80 1`. Trailing arguments may be left out to keep their current values. A low-pass cutoff *
+ * of 0 selects `ACC_DSP_AUTO_LOWPASS_PCT` of the decimated rate, and a high-pass cutoff of 0 bypasses *
+ * the high-pass. Without arguments, the filters are shown.                                            *
+ *                                                                                                     *
+ * @param args [const char*] Decimation factor, low-pass cutoff (Hz) and high-pass cutoff (Hz).        *
+ * @return void                                                                                        *
  ******************************************************************************************************/
 
-void accelerometer_read(int16_t *acc_data)
+static void acc_cmd_filter(const char *args)
 {
-	uint8_t sensor_reading[6];
-	uint8_t reg = ACC_X_ADDR;
+	acc_pipeline_config_t config;
+	char field[4][12];
+	uint32_t value[3];
+	int fields;
+
+	if(NULL == acc_sensor_get()) {
+		print_error(msg_no_acc);
+		return;
+	}
+	if('\0' == args[0]) {
+		acc_show_filter();
+		return;
+	}
+	if(acc_stream_active()) {
+		print_error(msg_acc_busy);
+		return;
+	}
 
-	// Pull CS low to select the device
-	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_RESET);
+	// Up to three numbers, the fourth field only catches extra arguments
+	fields = sscanf(args, "%11s %11s %11s %1s", field[0], field[1], field[2], field[3]);
+	if((fields < 1) || (fields > 3)) {
+		print_error(msg_inv_filter);
+		return;
+	}
+	for(int i = 0; i < fields; i++) {
+		if(0 != parse_milli(field[i], &value[i])) {
+			print_error(msg_inv_filter);
+			return;
+		}
+	}
+	if((0 != (value[0] % 1000)) || ((value[0] / 1000) > ACC_STREAM_BLOCK_SAMPLES)) {
+		print_error(msg_inv_filter);
+		return;
+	}
 
-	// Send the register address
-	HAL_SPI_Transmit(&hspi1, &reg, 1, HAL_MAX_DELAY);
+	acc_pipeline_get_config(&config);
+	config.decimation = (uint8_t)(value[0] / 1000);
+	if(fields > 1) {
+		config.lowpass_mhz = value[1];
+	}
+	if(fields > 2) {
+		config.highpass_mhz = value[2];
+	}
+	if(0 != acc_pipeline_configure(&config, acc_sensor_odr())) {
+		print_error(msg_inv_filter);
+		return;
+	}
+
+	print_interactive(msg_valid_filter);
+}
+
+/*******************************************************************************************************
+ * @brief Shows the filters applied to the stream at the selected output data rate.                    *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void acc_show_filter(void)
+{
+	acc_pipeline_config_t config;
+	char odr[16];
+	char out_rate[16];
+	char lowpass[16];
+	char highpass[16] = "off";
+
+	acc_pipeline_get_config(&config);
+	format_odr(odr, sizeof(odr), acc_sensor_odr());
+	format_odr(out_rate, sizeof(out_rate), acc_sensor_odr() / config.decimation);
+	format_odr(lowpass, sizeof(lowpass), acc_pipeline_lowpass_mhz(&config, acc_sensor_odr()));
+	if(0 != config.highpass_mhz) {
+		int len = format_odr(highpass, sizeof(highpass), config.highpass_mhz);
+		snprintf(highpass + len, sizeof(highpass) - len, " Hz");
+	}
+
+	char *showfilter = print_pool_alloc(portMAX_DELAY);
+	snprintf(showfilter, PRINT_POOL_BLOCK_SIZE, "\n Decimation: %u (%s Hz to %s Hz)\n Low-pass: %s Hz%s\n High-pass: %s\n",
+			 config.decimation, odr, out_rate, lowpass, (0 == config.lowpass_mhz) ? " (auto)" : "", highpass);
+	print_pool_send(showfilter);
+}
 
-	// Receive the data
-	HAL_SPI_Receive(&hspi1, sensor_reading, 6, HAL_MAX_DELAY);
+/*******************************************************************************************************
+ * @brief Accelerometer menu `Main` command: returns to the main menu.                                 *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void acc_cmd_main(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sMainMenu;
 
-	// Pull CS high to de-select the device
-	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+	// Set event group bit to turn off all LEDs upon exiting accelerometer menu
+	xEventGroupSetBits(ledEventGroup, TURN_OFF_LEDS_BIT);
 
-	// Convert the sensor reading
-	acc_data[0] = (int16_t)(sensor_reading[1] << 8 | sensor_reading[0]); // x
-	acc_data[1] = (int16_t)(sensor_reading[3] << 8 | sensor_reading[2]); // y
-	acc_data[2] = (int16_t)(sensor_reading[5] << 8 | sensor_reading[4]); // z
+	// Notify the main menu task
+	xTaskNotify(handle_main_menu_task, 0, eNoAction);
+}
+
+/*******************************************************************************************************
+ * @brief Reads accelerometer data from the sensor.                                                    *
+ *                                                                                                     *
+ * This function reads the X, Y and Z axes in one burst read of the output registers. The counts are   *
+ * left justified to 16 bits whatever the sensor, `acc_sensor_to_mg` converts them at the selected     *
+ * full scale.                                                                                         *
+ *                                                                                                     *
+ * @param acc_data Pointer to an array of three 16-bit integers where the accelerometer data for       *
+ * the X, Y, and Z axes will be stored, zero if no sensor was detected.                                *
+ *                                                                                                     *
+ * @note The accelerometer task and the binary protocol both read the sensor. The driver locks the     *
+ *       scheduler during the transfer so that the two cannot interleave on SPI1.                      *
+ * @note While streaming, the latest streamed sample is returned without accessing SPI1.               *
+ ******************************************************************************************************/
+
+void accelerometer_read(int16_t *acc_data)
+{
+	acc_sample_t sample;
+
+	// The stream owns SPI1 and already holds a fresh sample. The driver rejects the read if streaming
+	// started after this check, and the streamed sample is used instead
+	if(acc_stream_active() || ((0 != acc_sensor_read(&sample)) && acc_stream_active())) {
+		acc_stream_latest(&sample);
+	}
+
+	memcpy(acc_data, sample.axis, sizeof(sample.axis));
 }
 
 /*******************************************************************************************************
@@ -246,14 +579,13 @@ void accelerometer_read(int16_t *acc_data)
 
 void show_acc_data(int16_t *acc_data, char *acc_flag)
 {
-	// Set up buffer
-	static char showacc[80];
-	static char* acc = showacc;
+	// Borrow a buffer from the print message pool
+	char *showacc = print_pool_alloc(portMAX_DELAY);
 
-	// Convert from raw sensor value to milli-g's [mg], using +/- 2g sensitivity
-	int16_t x_mg = acc_data[0] * 2000 / 32768;
-	int16_t y_mg = acc_data[1] * 2000 / 32768;
-	int16_t z_mg = acc_data[2] * 2000 / 32768;
+	// Convert from raw sensor value to milli-g's [mg] at the selected full scale
+	int x_mg = acc_sensor_to_mg(acc_data[0]);
+	int y_mg = acc_sensor_to_mg(acc_data[1]);
+	int z_mg = acc_sensor_to_mg(acc_data[2]);
 
 	// Variables to simulate floating point numbers
 	int x_i, x_d, y_i, y_d, z_i, z_d;
@@ -267,67 +599,198 @@ void show_acc_data(int16_t *acc_data, char *acc_flag)
 		split_integer(x_mg, x_s, &x_i, &x_d);
 		split_integer(y_mg, y_s, &y_i, &y_d);
 		split_integer(z_mg, z_s, &z_i, &z_d);
-		sprintf((char*)showacc, "\nAccelerometer reading: X = %s%d.%d g, Y = %s%d.%d g, Z = %s%d.%d g\r\n", x_s, x_i, x_d, y_s, y_i, y_d, z_s, z_i, z_d);
+		snprintf(showacc, PRINT_POOL_BLOCK_SIZE, "\nAccelerometer reading: X = %s%d.%02d g, Y = %s%d.%02d g, Z = %s%d.%02d g\r\n", x_s, x_i, x_d, y_s, y_i, y_d, z_s, z_i, z_d);
 	}
 	// X-axis only
 	else if (acc_flag[0] == 1) {
 		split_integer(x_mg, x_s, &x_i, &x_d);
-		sprintf((char*)showacc, "\nAccelerometer reading: X = %s%d.%d g\r\n", x_s, x_i, x_d);
+		snprintf(showacc, PRINT_POOL_BLOCK_SIZE, "\nAccelerometer reading: X = %s%d.%02d g\r\n", x_s, x_i, x_d);
 	}
 	// Y-axis only
 	else if (acc_flag[1] == 1) {
 		split_integer(y_mg, y_s, &y_i, &y_d);
-		sprintf((char*)showacc, "\nAccelerometer reading: Y = %s%d.%d g\r\n", y_s, y_i, y_d);
+		snprintf(showacc, PRINT_POOL_BLOCK_SIZE, "\nAccelerometer reading: Y = %s%d.%02d g\r\n", y_s, y_i, y_d);
 	}
 	// Z-axis only
 	else if (acc_flag[2] == 1) {
 		split_integer(z_mg, z_s, &z_i, &z_d);
-		sprintf((char*)showacc, "\nAccelerometer reading: Z = %s%d.%d g\r\n", z_s, z_i, z_d);
+		snprintf(showacc, PRINT_POOL_BLOCK_SIZE, "\nAccelerometer reading: Z = %s%d.%02d g\r\n", z_s, z_i, z_d);
 	}
 
-	// Populate the print queue
-	xQueueSend(q_print, &acc, portMAX_DELAY);
+	// Hand the buffer to the print task
+	print_pool_send(showacc);
 }
 
 /*******************************************************************************************************
- * @brief Splits an integer into its thousands and hundreds parts with sign.						   *
- *																									   *
- * This helper function takes an integer value and splits it into its thousands and hundreds parts,    *
- * adjusting for the sign. It determines the sign of the value, calculates the absolute value of 	   *
- * the thousands part, and the hundreds part, then adjusts if rounding up results in exactly 1000.	   *
- *																									   *
- * @param value The integer value to be split.														   *
- * @param sign Pointer to a character array where the sign ('+' or '-') will be stored.				   *
- * @param thousands_part Pointer to an integer where the thousands part will be stored.				   *
- * @param hundreds_part Pointer to an integer where the hundreds part will be stored.				   *
- *																									   *
- * @note The function handles negative values by setting the sign appropriately and ensures that 	   *
- * the hundreds part is always positive. If the hundreds part rounds up to exactly 1000, the 		   *
- * thousands part is incremented and the hundreds part is reset to 0.								   *
+ * @brief Prints the stream report of one window.                                                      *
+ *                                                                                                     *
+ * The first line holds the sample rates and the low-passed mean of each axis, the second the tilt and *
+ * the RMS and peak-to-peak of each axis after the high-pass.                                          *
+ *                                                                                                     *
+ * @param features [const acc_features_t*] Features of the window.                                     *
+ * @param rate [uint32_t] Samples acquired per second.                                                 *
+ * @param seconds [uint32_t] Time since the stream was started.                                        *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void print_stream_report(const acc_features_t *features, uint32_t rate, uint32_t seconds)
+{
+	int i[3];
+	int d[3];
+	char sign[3][2];
+	int32_t angle[2] = { features->pitch_cdeg, features->roll_cdeg };
+
+	// Convert the mean of each axis to milli-g's [mg] at the selected full scale
+	for(int axis = 0; axis < 3; axis++) {
+		split_integer(acc_sensor_to_mg(features->mean[axis]), sign[axis], &i[axis], &d[axis]);
+	}
+
+	char *showstream = print_pool_alloc(portMAX_DELAY);
+	snprintf(showstream, PRINT_POOL_BLOCK_SIZE, " [%03" PRIu32 "s] %4" PRIu32 " samples/s, %4" PRIu32 " filtered/s, mean X = %s%d.%02d g, Y = %s%d.%02d g, Z = %s%d.%02d g\n",
+			 seconds, rate, features->samples * 1000 / ACC_STREAM_REPORT_MS, sign[0], i[0], d[0], sign[1], i[1], d[1], sign[2], i[2], d[2]);
+	print_pool_send(showstream);
+
+	// Angles in hundredths of a degree
+	for(int a = 0; a < 2; a++) {
+		strcpy(sign[a], (angle[a] < 0) ? "-" : "+");
+		i[a] = abs(angle[a]) / 100;
+		d[a] = abs(angle[a]) % 100;
+	}
+
+	char *showvibration = print_pool_alloc(portMAX_DELAY);
+	snprintf(showvibration, PRINT_POOL_BLOCK_SIZE, "        pitch %s%d.%02d deg, roll %s%d.%02d deg, RMS X %" PRId32 " Y %" PRId32 " Z %" PRId32 " mg, p2p X %" PRId32 " Y %" PRId32 " Z %" PRId32 " mg\n",
+			 sign[0], i[0], d[0], sign[1], i[1], d[1],
+			 acc_sensor_to_mg(features->rms[0]), acc_sensor_to_mg(features->rms[1]), acc_sensor_to_mg(features->rms[2]),
+			 acc_sensor_to_mg(features->p2p[0]), acc_sensor_to_mg(features->p2p[1]), acc_sensor_to_mg(features->p2p[2]));
+	print_pool_send(showvibration);
+}
+
+/*******************************************************************************************************
+ * @brief Prints the stream counters once the stream is stopped.                                       *
+ *                                                                                                     *
+ * @param seconds [uint32_t] Duration of the stream.                                                   *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void print_stream_summary(uint32_t seconds)
+{
+	acc_stream_stats_t stats;
+	acc_pipeline_stats_t dsp;
+
+	acc_stream_get_stats(&stats);
+	acc_pipeline_get_stats(&dsp);
+
+	xQueueSend(q_print, &msg_stream_header, portMAX_DELAY);
+	char *showstats = print_pool_alloc(portMAX_DELAY);
+	snprintf(showstats, PRINT_POOL_BLOCK_SIZE, "* Elapsed time:       %06" PRIu32 " sec   *"
+											 "\n* Samples:            %08" PRIu32 "     *"
+											 "\n* Blocks:             %08" PRIu32 "     *"
+											 "\n* Dropped blocks:     %08" PRIu32 "     *\n",
+											 seconds, stats.samples, stats.blocks, stats.dropped_blocks);
+	print_pool_send(showstats);
+
+	// The SPI and processing counters do not fit in the same print block
+	char *showreads = print_pool_alloc(portMAX_DELAY);
+	snprintf(showreads, PRINT_POOL_BLOCK_SIZE, "* Burst reads:        %08" PRIu32 "     *"
+											 "\n* Deferred reads:     %08" PRIu32 "     *"
+											 "\n* SPI errors:         %08" PRIu32 "     *"
+											 "\n* DSP cycles/block:   %08" PRIu32 "     *"
+											 "\n* DSP max cycles:     %08" PRIu32 "     *\n",
+											 stats.reads, stats.deferred_reads, stats.spi_errors,
+											 (0 != dsp.blocks) ? (dsp.cycles / dsp.blocks) : 0, dsp.max_cycles);
+	print_pool_send(showreads);
+	xQueueSend(q_print, &msg_stream_footer, portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Splits a value in milli-g into g and hundredths of g with sign.                              *
+ *                                                                                                     *
+ * The value is rounded to the nearest hundredth before it is split, so 999 mg shows as 1.00 g, and a  *
+ * value that rounds to zero shows with a `+` sign.                                                    *
+ *                                                                                                     *
+ * @param value The value to be split (mg).                                                            *
+ * @param sign Pointer to a character array where the sign ('+' or '-') will be stored.                *
+ * @param units_part Pointer to an integer where the whole g will be stored.                           *
+ * @param hundredths_part Pointer to an integer where the hundredths of g (0 to 99) will be stored.    *
  ******************************************************************************************************/
 
-void split_integer(int value, char* sign, int *thousands_part, int *hundreds_part)
+void split_integer(int value, char* sign, int *units_part, int *hundredths_part)
 {
-	// Evaluate the sign
-	if(value < 0) {
+	// Round the magnitude to hundredths of g
+	int hundredths = (abs(value) + 5) / 10;
+
+	// Evaluate the sign, zero is shown as positive
+	if((value < 0) && (0 != hundredths)) {
 		strcpy(sign, "-");
 	}
 	else {
 		strcpy(sign, "+");
 	}
 
-	// Calculate how many thousands
-    *thousands_part = abs(value / 1000);
+	*units_part = hundredths / 100;
+	*hundredths_part = hundredths % 100;
+}
+
+/*******************************************************************************************************
+ * @brief Parses a decimal number into thousandths.                                                    *
+ *                                                                                                     *
+ * @param text [const char*] Digits with an optional point followed by up to three decimals.           *
+ * @param value [uint32_t*] Parsed value times 1000.                                                   *
+ * @return int 0 on success, -1 if the text is not such a number or is too large.                      *
+ ******************************************************************************************************/
+
+static int parse_milli(const char *text, uint32_t *value)
+{
+	uint32_t whole = 0;
+	uint32_t fraction = 0;
+	uint32_t scale = 1000;
+	int digits = 0;
+
+	for(; ('\0' != *text) && ('.' != *text); text++, digits++) {
+		if(!isdigit((unsigned char)*text) || (digits >= 6)) {
+			return -1;
+		}
+		whole = (whole * 10) + (uint32_t)(*text - '0');
+	}
+	if('.' == *text) {
+		for(text++; '\0' != *text; text++) {
+			if(!isdigit((unsigned char)*text) || (scale <= 1)) {
+				return -1;
+			}
+			scale /= 10;
+			fraction += (uint32_t)(*text - '0') * scale;
+			digits++;
+		}
+	}
+	if(0 == digits) {
+		return -1;
+	}
+
+	*value = (whole * 1000) + fraction;
+	return 0;
+}
 
-    // Calculate the remaining hundreds
-    int remainder = value % 1000;
+/*******************************************************************************************************
+ * @brief Formats an output data rate in Hz without trailing zeros, e.g. `3.125`, `12.5` or `1600`.    *
+ *                                                                                                     *
+ * @param buf [char*] Output string.                                                                   *
+ * @param size [size_t] Size of the output string.                                                     *
+ * @param odr_mhz [uint32_t] Output data rate (mHz).                                                   *
+ * @return int Length of the formatted string.                                                         *
+ ******************************************************************************************************/
+
+static int format_odr(char *buf, size_t size, uint32_t odr_mhz)
+{
+	uint32_t fraction = odr_mhz % 1000;
+	int decimals = 3;
 
-    // Ensure hundreds_part is positive
-    *hundreds_part = abs((int)(remainder / 100.0));
+	if(0 == fraction) {
+		return snprintf(buf, size, "%" PRIu32, odr_mhz / 1000);
+	}
+	while(0 == (fraction % 10)) {
+		fraction /= 10;
+		decimals--;
+	}
 
-    // Adjust thousands_part if rounding up results in exactly 1000
-    if (*hundreds_part == 10) {
-        *thousands_part += 1;
-        *hundreds_part = 0;
-    }
+	return snprintf(buf, size, "%" PRIu32 ".%0*" PRIu32, odr_mhz / 1000, decimals, fraction);
 }
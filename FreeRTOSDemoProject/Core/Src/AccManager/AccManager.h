@@ -28,5 +28,6 @@
 
 void acc_task(void* param);
 void accelerometer_init(void);
+void accelerometer_read(int16_t *acc_data);
 
 #endif /* ACCMANAGER_H_ */
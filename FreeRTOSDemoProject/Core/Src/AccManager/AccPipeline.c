@@ -0,0 +1,240 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccPipeline.c                                                             |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccPipeline` utility reduces the streamed blocks to features before           |
+|    anything is printed: each axis is low-pass filtered and decimated, then            |
+|    optionally high-pass filtered, and every report window yields the mean,            |
+|    RMS and peak-to-peak of each axis and the tilt of the board.                       |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "AccPipeline.h"
+#include "AccDsp.h"
+#include "Config_AccManager.h"
+#include <string.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void acc_pipeline_reset(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static acc_pipeline_config_t acc_config = {
+	ACC_DSP_DEFAULT_DECIMATION, ACC_DSP_DEFAULT_LOWPASS_MHZ, ACC_DSP_DEFAULT_HIGHPASS_MHZ
+};
+
+// Filters, one instance and state per axis sharing the coefficients
+static int16_t acc_fir_coeffs[ACC_DSP_FIR_TAPS];
+static int32_t acc_hp_coeffs[ACC_DSP_BIQUAD_COEFFS];
+static int16_t acc_fir_state[3][ACC_DSP_FIR_TAPS + ACC_STREAM_BLOCK_SAMPLES - 1];
+static int32_t acc_hp_state[3][ACC_DSP_BIQUAD_STATE];
+static acc_fir_t acc_firs[3];
+static acc_biquad_t acc_hps[3];
+
+// Report window of the low-passed and of the high-passed samples
+static acc_window_t acc_lp_windows[3];
+static acc_window_t acc_hp_windows[3];
+
+static acc_pipeline_stats_t acc_stats;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Validates a filter configuration against an output data rate, designs the filters and resets *
+ * the pipeline.                                                                                       *
+ *                                                                                                     *
+ * The low-pass cutoff may not exceed half the decimated rate, so that nothing aliases, and the        *
+ * high-pass cutoff must lie below the low-pass one and between 1/1000 and 1/2 of the decimated rate.  *
+ * The previous configuration is kept if the new one does not fit.                                     *
+ *                                                                                                     *
+ * @param config [const acc_pipeline_config_t*] Filter configuration.                                  *
+ * @param odr_mhz [uint32_t] Output data rate of the sensor (mHz).                                     *
+ * @return int 0 on success, -1 if the configuration does not fit the output data rate.                *
+ *                                                                                                     *
+ * @note Not to be called while `acc_pipeline_process` may run, i.e. while streaming.                  *
+ ******************************************************************************************************/
+int acc_pipeline_configure(const acc_pipeline_config_t *config, uint32_t odr_mhz)
+{
+	int16_t fir_coeffs[ACC_DSP_FIR_TAPS];
+	int32_t hp_coeffs[ACC_DSP_BIQUAD_COEFFS];
+	uint32_t out_mhz;
+	uint32_t lowpass_mhz;
+
+	if((0 == odr_mhz) || (0 == config->decimation) || (0 != (ACC_STREAM_BLOCK_SAMPLES % config->decimation))) {
+		return -1;
+	}
+	out_mhz = odr_mhz / config->decimation;
+	lowpass_mhz = acc_pipeline_lowpass_mhz(config, odr_mhz);
+
+	// The low-pass runs at the sensor rate, the high-pass after decimation
+	if(((2 * (uint64_t)lowpass_mhz) > out_mhz) || (0 != acc_dsp_design_lowpass(fir_coeffs, ACC_DSP_FIR_TAPS, lowpass_mhz, odr_mhz))) {
+		return -1;
+	}
+	if(0 != config->highpass_mhz) {
+		if((config->highpass_mhz >= lowpass_mhz) || (0 != acc_dsp_design_highpass(hp_coeffs, config->highpass_mhz, out_mhz))) {
+			return -1;
+		}
+		memcpy(acc_hp_coeffs, hp_coeffs, sizeof(acc_hp_coeffs));
+	}
+
+	memcpy(acc_fir_coeffs, fir_coeffs, sizeof(acc_fir_coeffs));
+	acc_config = *config;
+	acc_pipeline_reset();
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the filter configuration.                                                            *
+ *                                                                                                     *
+ * @param config [acc_pipeline_config_t*] Output configuration.                                        *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_pipeline_get_config(acc_pipeline_config_t *config)
+{
+	*config = acc_config;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the low-pass cutoff a configuration gives at an output data rate.                    *
+ *                                                                                                     *
+ * @param config [const acc_pipeline_config_t*] Filter configuration.                                  *
+ * @param odr_mhz [uint32_t] Output data rate of the sensor (mHz).                                     *
+ * @return uint32_t Cutoff (mHz), `ACC_DSP_AUTO_LOWPASS_PCT` of the decimated rate if not set.         *
+ ******************************************************************************************************/
+uint32_t acc_pipeline_lowpass_mhz(const acc_pipeline_config_t *config, uint32_t odr_mhz)
+{
+	if(0 != config->lowpass_mhz) {
+		return config->lowpass_mhz;
+	}
+
+	return (uint32_t)(((uint64_t)odr_mhz * ACC_DSP_AUTO_LOWPASS_PCT) / (100 * (uint32_t)config->decimation));
+}
+
+/*******************************************************************************************************
+ * @brief Runs one block of samples through the pipeline.                                              *
+ *                                                                                                     *
+ * Each axis is low-pass filtered and decimated, and the output goes to the mean window. It is then    *
+ * high-pass filtered, unless the high-pass is bypassed, and goes to the RMS and peak-to-peak window.  *
+ * The filter states start from the first sample of the stream rather than from zero, so that          *
+ * gravity does not show as a step in the first report.                                                *
+ *                                                                                                     *
+ * @param block [const acc_block_t*] Block received from the stream.                                   *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from the accelerometer task.                                                           *
+ ******************************************************************************************************/
+void acc_pipeline_process(const acc_block_t *block)
+{
+	int16_t in[ACC_STREAM_BLOCK_SAMPLES];
+	int16_t out[ACC_STREAM_BLOCK_SAMPLES];
+	int32_t hp[ACC_STREAM_BLOCK_SAMPLES];
+	uint32_t outputs = ACC_STREAM_BLOCK_SAMPLES / acc_config.decimation;
+	uint32_t start = DWT->CYCCNT;
+
+	for(int axis = 0; axis < 3; axis++) {
+		for(uint32_t i = 0; i < ACC_STREAM_BLOCK_SAMPLES; i++) {
+			in[i] = block->samples[i].axis[axis];
+		}
+
+		// Prime the past inputs of the low-pass with the first sample
+		if(0 == acc_stats.blocks) {
+			for(uint32_t i = 0; i < (ACC_DSP_FIR_TAPS - 1); i++) {
+				acc_fir_state[axis][i] = in[0];
+			}
+		}
+		acc_fir_decimate(&acc_firs[axis], in, out, ACC_STREAM_BLOCK_SAMPLES);
+		acc_window_update(&acc_lp_windows[axis], out, outputs);
+
+		if(0 != acc_config.highpass_mhz) {
+			for(uint32_t i = 0; i < outputs; i++) {
+				hp[i] = (int32_t)out[i] << ACC_DSP_BIQUAD_INPUT_SHIFT;
+			}
+
+			// A constant input leaves the high-pass at rest with zero output
+			if(0 == acc_stats.blocks) {
+				acc_hp_state[axis][0] = hp[0];
+				acc_hp_state[axis][1] = hp[0];
+			}
+			acc_biquad(&acc_hps[axis], hp, hp, outputs);
+
+			// Back to counts, rounded
+			for(uint32_t i = 0; i < outputs; i++) {
+				int32_t count = (hp[i] + (1 << (ACC_DSP_BIQUAD_INPUT_SHIFT - 1))) >> ACC_DSP_BIQUAD_INPUT_SHIFT;
+				out[i] = (int16_t)((count > INT16_MAX) ? INT16_MAX : ((count < INT16_MIN) ? INT16_MIN : count));
+			}
+		}
+		acc_window_update(&acc_hp_windows[axis], out, outputs);
+	}
+
+	uint32_t cycles = DWT->CYCCNT - start;
+	acc_stats.blocks++;
+	acc_stats.cycles += cycles;
+	acc_stats.max_cycles = (cycles > acc_stats.max_cycles) ? cycles : acc_stats.max_cycles;
+}
+
+/*******************************************************************************************************
+ * @brief Computes the features of the report window and starts a new window.                          *
+ *                                                                                                     *
+ * @param features [acc_features_t*] Output features, zero if no block was processed in the window.    *
+ * @return uint32_t Output samples in the window.                                                      *
+ ******************************************************************************************************/
+uint32_t acc_pipeline_features(acc_features_t *features)
+{
+	features->samples = acc_lp_windows[0].count;
+	for(int axis = 0; axis < 3; axis++) {
+		features->mean[axis] = acc_window_mean(&acc_lp_windows[axis]);
+		features->rms[axis] = acc_window_rms(&acc_hp_windows[axis]);
+		features->p2p[axis] = acc_window_p2p(&acc_hp_windows[axis]);
+		acc_window_reset(&acc_lp_windows[axis]);
+		acc_window_reset(&acc_hp_windows[axis]);
+	}
+	acc_dsp_tilt(features->mean, &features->pitch_cdeg, &features->roll_cdeg);
+
+	return features->samples;
+}
+
+/*******************************************************************************************************
+ * @brief Copies the processing counters.                                                              *
+ *                                                                                                     *
+ * @param stats [acc_pipeline_stats_t*] Output counters.                                               *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_pipeline_get_stats(acc_pipeline_stats_t *stats)
+{
+	*stats = acc_stats;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Clears the filter states, the report windows and the counters.                               *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void acc_pipeline_reset(void)
+{
+	for(int axis = 0; axis < 3; axis++) {
+		acc_fir_decimate_init(&acc_firs[axis], acc_fir_coeffs, ACC_DSP_FIR_TAPS, acc_config.decimation,
+							  acc_fir_state[axis], ACC_STREAM_BLOCK_SAMPLES);
+		acc_biquad_init(&acc_hps[axis], acc_hp_coeffs, acc_hp_state[axis]);
+		acc_window_reset(&acc_lp_windows[axis]);
+		acc_window_reset(&acc_hp_windows[axis]);
+	}
+	memset(&acc_stats, 0, sizeof(acc_stats));
+}
@@ -0,0 +1,63 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccPipeline.h                                                             |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccPipeline` utility reduces the streamed blocks to features before           |
+|    anything is printed: each axis is low-pass filtered and decimated, then            |
+|    optionally high-pass filtered, and every report window yields the mean,            |
+|    RMS and peak-to-peak of each axis and the tilt of the board.                       |
+\*=====================================================================================*/
+
+#ifndef ACCPIPELINE_H_
+#define ACCPIPELINE_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "AccStream.h"
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	uint8_t decimation;			// Input samples per output sample, a divisor of ACC_STREAM_BLOCK_SAMPLES
+	uint32_t lowpass_mhz;		// Low-pass cutoff (mHz), 0 for ACC_DSP_AUTO_LOWPASS_PCT of the output rate
+	uint32_t highpass_mhz;		// High-pass cutoff (mHz), 0 to bypass the high-pass
+} acc_pipeline_config_t;
+
+typedef struct
+{
+	uint32_t samples;			// Output samples in the window
+	int32_t mean[3];			// Mean of the low-passed X, Y and Z (counts)
+	uint32_t rms[3];			// RMS of the high-passed X, Y and Z (counts)
+	uint32_t p2p[3];			// Peak-to-peak of the high-passed X, Y and Z (counts)
+	int32_t pitch_cdeg;			// Angle of the X-axis above the horizontal (hundredths of a degree)
+	int32_t roll_cdeg;			// Rotation about the X-axis (hundredths of a degree)
+} acc_features_t;
+
+typedef struct
+{
+	uint32_t blocks;			// Blocks processed
+	uint32_t cycles;			// Cycles spent processing them
+	uint32_t max_cycles;		// Longest block
+} acc_pipeline_stats_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+int acc_pipeline_configure(const acc_pipeline_config_t *config, uint32_t odr_mhz);
+void acc_pipeline_get_config(acc_pipeline_config_t *config);
+uint32_t acc_pipeline_lowpass_mhz(const acc_pipeline_config_t *config, uint32_t odr_mhz);
+void acc_pipeline_process(const acc_block_t *block);
+uint32_t acc_pipeline_features(acc_features_t *features);
+void acc_pipeline_get_stats(acc_pipeline_stats_t *stats);
+
+#endif /* ACCPIPELINE_H_ */
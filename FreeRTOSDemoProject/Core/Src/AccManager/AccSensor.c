@@ -0,0 +1,437 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccSensor.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccSensor` driver talks to the accelerometer on SPI1. It identifies the       |
+|    sensor from its WHO_AM_I register (LIS3DSH on current boards, LIS302DL on          |
+|    the MB997B revision), sets its output data rate and full scale, converts           |
+|    counts to milli-g, and configures the INT1 signal used for streaming.              |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "AccSensor.h"
+#include "AccStream.h"
+#include "Config_AccManager.h"
+#include "main.h"
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void acc_bus_init(void);
+static void acc_lock(void);
+static void acc_unlock(void);
+static void acc_reg_write(uint8_t reg, uint8_t value);
+static void acc_bus_read(uint8_t cmd, uint8_t *data, uint16_t len);
+static void acc_apply_config(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// LIS3DSH: CTRL_REG4 ODR[3:0] and CTRL_REG5 FSCALE[2:0], datasheet tables 55 and 63
+static const acc_odr_t lis3dsh_odrs[] = {
+	{ 3125, 0x10 }, { 6250, 0x20 }, { 12500, 0x30 }, { 25000, 0x40 }, { 50000, 0x50 },
+	{ 100000, 0x60 }, { 400000, 0x70 }, { 800000, 0x80 }, { 1600000, 0x90 },
+};
+static const acc_range_t lis3dsh_ranges[] = {
+	{ 2, 0x00, 61 }, { 4, 0x08, 122 }, { 6, 0x10, 183 }, { 8, 0x18, 244 }, { 16, 0x20, 732 },
+};
+
+// LIS302DL: CTRL_REG1 DR and FS, 18 and 72 mg per 8-bit count (nominally +/- 2.3 g and 9.2 g)
+static const acc_odr_t lis302dl_odrs[] = {
+	{ 100000, 0x00 }, { 400000, 0x80 },
+};
+static const acc_range_t lis302dl_ranges[] = {
+	{ 2, 0x00, 70 }, { 8, 0x20, 281 },
+};
+
+static const acc_sensor_t acc_sensors[] = {
+	{ "LIS3DSH", LIS3DSH_WHO_AM_I, ACC_SPI_READ | LIS3DSH_OUT_X_L, 6, LIS3DSH_FIFO_DEPTH,
+	  lis3dsh_odrs, sizeof(lis3dsh_odrs) / sizeof(lis3dsh_odrs[0]),
+	  lis3dsh_ranges, sizeof(lis3dsh_ranges) / sizeof(lis3dsh_ranges[0]) },
+	{ "LIS302DL", LIS302DL_WHO_AM_I, ACC_SPI_READ | LIS302DL_SPI_INC | LIS302DL_OUT_X, 5, 0,
+	  lis302dl_odrs, sizeof(lis302dl_odrs) / sizeof(lis302dl_odrs[0]),
+	  lis302dl_ranges, sizeof(lis302dl_ranges) / sizeof(lis302dl_ranges[0]) },
+};
+
+static const acc_sensor_t *acc_sensor = NULL;	// Detected sensor, NULL if none answered
+static const acc_odr_t *acc_odr;				// Selected output data rate
+static const acc_range_t *acc_range;			// Selected full scale
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Identifies the accelerometer and applies the default configuration.                          *
+ *                                                                                                     *
+ * The SPI1 clock is first set to the fastest the sensors accept at the current APB2 clock. The        *
+ * WHO_AM_I register is at the same address on both supported sensors. The sensor found is set to      *
+ * `ACC_DEFAULT_ODR_MHZ` and `ACC_DEFAULT_RANGE_G`, or to its closest supported settings.              *
+ *                                                                                                     *
+ * @return int 0 if a supported sensor answered, -1 otherwise.                                         *
+ ******************************************************************************************************/
+int acc_sensor_init(void)
+{
+	uint8_t who_am_i = 0;
+
+	acc_bus_init();
+	acc_lock();
+	acc_bus_read(ACC_SPI_READ | ACC_REG_WHO_AM_I, &who_am_i, 1);
+	acc_unlock();
+
+	acc_sensor = NULL;
+	for(uint32_t i = 0; i < (sizeof(acc_sensors) / sizeof(acc_sensors[0])); i++) {
+		if(acc_sensors[i].who_am_i == who_am_i) {
+			acc_sensor = &acc_sensors[i];
+		}
+	}
+	if(NULL == acc_sensor) {
+		return -1;
+	}
+
+	// Start from the slowest rate and smallest range, then move up to the defaults
+	acc_odr = &acc_sensor->odrs[0];
+	acc_range = &acc_sensor->ranges[0];
+	for(uint32_t i = 0; i < acc_sensor->num_odrs; i++) {
+		if(acc_sensor->odrs[i].odr_mhz <= ACC_DEFAULT_ODR_MHZ) {
+			acc_odr = &acc_sensor->odrs[i];
+		}
+	}
+	for(uint32_t i = 0; i < acc_sensor->num_ranges; i++) {
+		if(acc_sensor->ranges[i].range_g <= ACC_DEFAULT_RANGE_G) {
+			acc_range = &acc_sensor->ranges[i];
+		}
+	}
+
+	acc_apply_config();
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the description of the detected sensor.                                              *
+ *                                                                                                     *
+ * @return const acc_sensor_t* Detected sensor, NULL if `acc_sensor_init` found none.                  *
+ ******************************************************************************************************/
+const acc_sensor_t *acc_sensor_get(void)
+{
+	return acc_sensor;
+}
+
+/*******************************************************************************************************
+ * @brief Sets the output data rate.                                                                   *
+ *                                                                                                     *
+ * @param odr_mhz [uint32_t] Output data rate (mHz), one of the rates of the sensor.                   *
+ * @return int 0 on success, -1 if there is no sensor or it does not support the rate.                 *
+ *                                                                                                     *
+ * @note Must not be called while streaming.                                                           *
+ ******************************************************************************************************/
+int acc_sensor_set_odr(uint32_t odr_mhz)
+{
+	if(NULL == acc_sensor) {
+		return -1;
+	}
+
+	for(uint32_t i = 0; i < acc_sensor->num_odrs; i++) {
+		if(acc_sensor->odrs[i].odr_mhz == odr_mhz) {
+			acc_odr = &acc_sensor->odrs[i];
+			acc_apply_config();
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/*******************************************************************************************************
+ * @brief Sets the full scale.                                                                         *
+ *                                                                                                     *
+ * @param range_g [uint32_t] Full scale (+/- g), one of the ranges of the sensor.                      *
+ * @return int 0 on success, -1 if there is no sensor or it does not support the range.                *
+ *                                                                                                     *
+ * @note Must not be called while streaming.                                                           *
+ ******************************************************************************************************/
+int acc_sensor_set_range(uint32_t range_g)
+{
+	if(NULL == acc_sensor) {
+		return -1;
+	}
+
+	for(uint32_t i = 0; i < acc_sensor->num_ranges; i++) {
+		if(acc_sensor->ranges[i].range_g == range_g) {
+			acc_range = &acc_sensor->ranges[i];
+			acc_apply_config();
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the output data rate.                                                                *
+ *                                                                                                     *
+ * @return uint32_t Output data rate (mHz), 0 without sensor.                                          *
+ ******************************************************************************************************/
+uint32_t acc_sensor_odr(void)
+{
+	return (NULL != acc_sensor) ? acc_odr->odr_mhz : 0;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the full scale.                                                                      *
+ *                                                                                                     *
+ * @return uint32_t Full scale (+/- g), 0 without sensor.                                              *
+ ******************************************************************************************************/
+uint32_t acc_sensor_range(void)
+{
+	return (NULL != acc_sensor) ? acc_range->range_g : 0;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the current sample of the three axes.                                                  *
+ *                                                                                                     *
+ * @param sample [acc_sample_t*] Output sample, zero if there is no sensor or while streaming.         *
+ * @return int 0 on success, -1 if there is no sensor or while streaming.                              *
+ *                                                                                                     *
+ * @note While streaming the stream owns SPI1. Streaming is checked again under the lock, as it may    *
+ *       have started since the caller checked it, and the read is then rejected.                      *
+ ******************************************************************************************************/
+int acc_sensor_read(acc_sample_t *sample)
+{
+	uint8_t raw[ACC_SAMPLE_MAX_SIZE];
+
+	sample->axis[0] = sample->axis[1] = sample->axis[2] = 0;
+	if(NULL == acc_sensor) {
+		return -1;
+	}
+
+	// Streaming cannot start while the scheduler is locked, and INT1 only starts reads once it has started
+	acc_lock();
+	if(acc_stream_active()) {
+		acc_unlock();
+		return -1;
+	}
+	acc_bus_read(acc_sensor->out_cmd, raw, acc_sensor->sample_size);
+	acc_unlock();
+
+	acc_sensor_decode(raw, sample);
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Converts one sample as read from the output registers.                                       *
+ *                                                                                                     *
+ * The LIS3DSH sends each axis as a 16-bit little-endian value. The LIS302DL sends one byte per axis   *
+ * with an unused register in between; its counts are left justified so both sensors share a scale.    *
+ *                                                                                                     *
+ * @param raw [const uint8_t*] `sample_size` bytes read from the first output register.                *
+ * @param sample [acc_sample_t*] Output sample.                                                        *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from the SPI DMA interrupt while streaming.                                            *
+ ******************************************************************************************************/
+void acc_sensor_decode(const uint8_t *raw, acc_sample_t *sample)
+{
+	for(int i = 0; i < 3; i++) {
+		if(6 == acc_sensor->sample_size) {
+			sample->axis[i] = (int16_t)(raw[(2 * i) + 1] << 8 | raw[2 * i]);
+		}
+		else {
+			sample->axis[i] = (int16_t)(raw[2 * i] << 8);
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Converts a count to milli-g at the selected full scale.                                      *
+ *                                                                                                     *
+ * @param count [int32_t] Counts of one axis, or a difference or RMS of counts.                        *
+ * @return int32_t Acceleration (mg), rounded to the nearest mg.                                       *
+ ******************************************************************************************************/
+int32_t acc_sensor_to_mg(int32_t count)
+{
+	int32_t ug = (NULL != acc_sensor) ? (int32_t)count * acc_range->ug_per_lsb : 0;
+
+	return (ug >= 0) ? ((ug + 500) / 1000) : -((-ug + 500) / 1000);
+}
+
+/*******************************************************************************************************
+ * @brief Routes the acquisition interrupt to INT1 for streaming.                                      *
+ *                                                                                                     *
+ * With a FIFO, the sensor buffers samples in stream mode and raises INT1 while at least `burst`       *
+ * samples are stored, so that they can be read in one transfer: the output registers return the       *
+ * oldest sample and roll back from the last to the first output register. Without a FIFO, INT1 is     *
+ * data-ready and a single sample is read per interrupt. In both cases INT1 stays high until enough    *
+ * samples are read, so a late read delays the stream instead of stalling it.                          *
+ *                                                                                                     *
+ * @param burst [uint32_t] Samples wanted per transfer, limited to the FIFO depth.                     *
+ * @return uint32_t Samples to read per INT1 interrupt, 0 if there is no sensor.                       *
+ ******************************************************************************************************/
+uint32_t acc_sensor_stream_enable(uint32_t burst)
+{
+	if(NULL == acc_sensor) {
+		return 0;
+	}
+
+	acc_lock();
+	if(0 == acc_sensor->fifo_depth) {
+		burst = 1;
+		acc_reg_write(LIS302DL_CTRL_REG3, LIS302DL_CTRL3_DRDY_INT1);
+	}
+	else {
+		burst = (burst > acc_sensor->fifo_depth) ? acc_sensor->fifo_depth : ((0 == burst) ? 1 : burst);
+
+		// Going through bypass mode empties the FIFO, the watermark is the sample count minus one
+		acc_reg_write(LIS3DSH_FIFO_CTRL, 0x00);
+		acc_reg_write(LIS3DSH_CTRL_REG6, LIS3DSH_CTRL6_FIFO_WTM);
+		acc_reg_write(LIS3DSH_FIFO_CTRL, LIS3DSH_FIFO_STREAM | (uint8_t)(burst - 1));
+		acc_reg_write(LIS3DSH_CTRL_REG3, LIS3DSH_CTRL3_INT1);
+	}
+	acc_unlock();
+
+	return burst;
+}
+
+/*******************************************************************************************************
+ * @brief Turns INT1 off and returns the output registers to the current sample.                       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note SPI1 must be idle, see `acc_stream_stop`.                                                     *
+ ******************************************************************************************************/
+void acc_sensor_stream_disable(void)
+{
+	if(NULL == acc_sensor) {
+		return;
+	}
+
+	acc_lock();
+	if(0 == acc_sensor->fifo_depth) {
+		acc_reg_write(LIS302DL_CTRL_REG3, 0x00);
+	}
+	else {
+		acc_reg_write(LIS3DSH_CTRL_REG3, 0x00);
+		acc_reg_write(LIS3DSH_FIFO_CTRL, 0x00);
+		acc_reg_write(LIS3DSH_CTRL_REG6, LIS3DSH_CTRL6_ADD_INC);
+	}
+	acc_unlock();
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Keeps other tasks off SPI1 during a register access.                                         *
+ *                                                                                                     *
+ * The accelerometer task and the binary protocol both access the sensor. Once the scheduler runs, it  *
+ * is locked during the transfer; before, as in `acc_sensor_init`, there is nothing to lock out.       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void acc_lock(void)
+{
+	if(taskSCHEDULER_NOT_STARTED != xTaskGetSchedulerState()) {
+		vTaskSuspendAll();
+	}
+}
+
+static void acc_unlock(void)
+{
+	if(taskSCHEDULER_NOT_STARTED != xTaskGetSchedulerState()) {
+		xTaskResumeAll();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sets the SPI1 clock to the fastest that does not exceed `ACC_SPI_MAX_HZ`.                    *
+ *                                                                                                     *
+ * The prescaler generated by CubeMX divides APB2 by 2, which is only within the limit of the sensors  *
+ * while APB2 runs at 20 MHz or less.                                                                  *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void acc_bus_init(void)
+{
+	uint32_t pclk2 = HAL_RCC_GetPCLK2Freq();
+	uint32_t divider_log2 = 1;
+
+	// SPI1 divides APB2 by a power of two from 2 to 256
+	while(((pclk2 >> divider_log2) > ACC_SPI_MAX_HZ) && (divider_log2 < 8)) {
+		divider_log2++;
+	}
+
+	hspi1.Init.BaudRatePrescaler = (divider_log2 - 1) << SPI_CR1_BR_Pos;
+	if(HAL_OK != HAL_SPI_Init(&hspi1)) {
+		Error_Handler();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Writes one register.                                                                         *
+ *                                                                                                     *
+ * @param reg [uint8_t] Register address.                                                              *
+ * @param value [uint8_t] Value to write.                                                              *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void acc_reg_write(uint8_t reg, uint8_t value)
+{
+	uint8_t data[2] = { reg, value };
+
+	// Pull CS low to select the device
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_RESET);
+
+	// Send the register address followed by the value
+	HAL_SPI_Transmit(&hspi1, data, 2, HAL_MAX_DELAY);
+
+	// Pull CS high to deselect the device
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+}
+
+/*******************************************************************************************************
+ * @brief Reads consecutive bytes from the sensor.                                                     *
+ *                                                                                                     *
+ * @param cmd [uint8_t] SPI address byte, with the read bit and, if needed, the increment bit.         *
+ * @param data [uint8_t*] Buffer for the received bytes.                                               *
+ * @param len [uint16_t] Number of bytes.                                                              *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void acc_bus_read(uint8_t cmd, uint8_t *data, uint16_t len)
+{
+	// Pull CS low to select the device
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_RESET);
+
+	// Send the address byte, then clock the data in
+	HAL_SPI_Transmit(&hspi1, &cmd, 1, HAL_MAX_DELAY);
+	HAL_SPI_Receive(&hspi1, data, len, HAL_MAX_DELAY);
+
+	// Pull CS high to deselect the device
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+}
+
+/*******************************************************************************************************
+ * @brief Writes the selected output data rate and full scale to the sensor.                           *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void acc_apply_config(void)
+{
+	acc_lock();
+	if(LIS3DSH_WHO_AM_I == acc_sensor->who_am_i) {
+		acc_reg_write(LIS3DSH_CTRL_REG4, acc_odr->bits | LIS3DSH_CTRL4_XYZ);
+		acc_reg_write(LIS3DSH_CTRL_REG5, acc_range->bits);
+		acc_reg_write(LIS3DSH_CTRL_REG6, LIS3DSH_CTRL6_ADD_INC);
+	}
+	else {
+		acc_reg_write(LIS302DL_CTRL_REG1, acc_odr->bits | acc_range->bits | LIS302DL_CTRL1_ON);
+	}
+	acc_unlock();
+}
@@ -0,0 +1,107 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccSensor.h                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccSensor` driver talks to the accelerometer on SPI1. It identifies the       |
+|    sensor from its WHO_AM_I register (LIS3DSH on current boards, LIS302DL on          |
+|    the MB997B revision), sets its output data rate and full scale, converts           |
+|    counts to milli-g, and configures the INT1 signal used for streaming.              |
+\*=====================================================================================*/
+
+#ifndef ACCSENSOR_H_
+#define ACCSENSOR_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define ACC_REG_WHO_AM_I			0x0F // Identification register, common to both sensors
+#define ACC_SPI_READ				0x80 // Read bit of the SPI address byte
+#define ACC_SAMPLE_MAX_SIZE			6 // Largest sample on the bus, X to Z (bytes)
+
+// LIS3DSH
+#define LIS3DSH_WHO_AM_I			0x3F
+#define LIS3DSH_CTRL_REG4			0x20 // ODR[3:0] | BDU | ZEN | YEN | XEN
+#define LIS3DSH_CTRL_REG3			0x23 // DR_EN | IEA | IEL | INT2_EN | INT1_EN | VFILT | - | STRT
+#define LIS3DSH_CTRL_REG5			0x24 // BW[2:1] | FSCALE[2:0] | ST[2:1] | SIM
+#define LIS3DSH_CTRL_REG6			0x25 // BOOT | FIFO_EN | WTM_EN | ADD_INC | P1_EMPTY | P1_WTM | P1_OVR | -
+#define LIS3DSH_OUT_X_L				0x28 // X_L to Z_H, FIFO reads roll back here from 0x2D
+#define LIS3DSH_FIFO_CTRL			0x2E // FMODE[2:0] | WTMP[4:0]
+#define LIS3DSH_CTRL4_XYZ			0x0F // Block data update, all axes enabled
+#define LIS3DSH_CTRL3_INT1			0x48 // INT1 enabled, active high
+#define LIS3DSH_CTRL6_ADD_INC		0x10
+#define LIS3DSH_CTRL6_FIFO_WTM		0x54 // FIFO_EN | ADD_INC | P1_WTM, the FIFO keeps its full depth
+#define LIS3DSH_FIFO_STREAM			0x40 // Stream mode, the oldest sample is overwritten when full
+#define LIS3DSH_FIFO_DEPTH			32
+
+// LIS302DL
+#define LIS302DL_WHO_AM_I			0x3B
+#define LIS302DL_CTRL_REG1			0x20 // DR | PD | FS | STP | STM | ZEN | YEN | XEN
+#define LIS302DL_CTRL_REG3			0x22 // IHL | PP_OD | I2CFG[2:0] | I1CFG[2:0]
+#define LIS302DL_OUT_X				0x29 // OUT_X, -, OUT_Y, -, OUT_Z
+#define LIS302DL_SPI_INC			0x40 // Address increment bit of the SPI address byte
+#define LIS302DL_CTRL1_ON			0x47 // Powered up, all axes enabled
+#define LIS302DL_CTRL3_DRDY_INT1	0x04 // Data-ready on INT1, active high
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	int16_t axis[3];			// Counts of the X, Y and Z axes, left justified to 16 bits
+} acc_sample_t;
+
+typedef struct
+{
+	uint32_t odr_mhz;			// Output data rate (mHz)
+	uint8_t bits;				// Register bits selecting the rate
+} acc_odr_t;
+
+typedef struct
+{
+	uint8_t range_g;			// Full scale (+/- g)
+	uint8_t bits;				// Register bits selecting the range
+	uint16_t ug_per_lsb;		// Sensitivity of one 16-bit count (ug)
+} acc_range_t;
+
+typedef struct
+{
+	const char *name;
+	uint8_t who_am_i;			// WHO_AM_I register value
+	uint8_t out_cmd;			// SPI address byte reading the output registers with address increment
+	uint8_t sample_size;		// Bytes of one sample on the bus, X to Z
+	uint8_t fifo_depth;			// Samples held by the FIFO, 0 without FIFO
+	const acc_odr_t *odrs;		// Output data rates, slowest first
+	uint8_t num_odrs;
+	const acc_range_t *ranges;	// Full scales, smallest first
+	uint8_t num_ranges;
+} acc_sensor_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+int acc_sensor_init(void);
+const acc_sensor_t *acc_sensor_get(void);
+int acc_sensor_set_odr(uint32_t odr_mhz);
+int acc_sensor_set_range(uint32_t range_g);
+uint32_t acc_sensor_odr(void);
+uint32_t acc_sensor_range(void);
+int acc_sensor_read(acc_sample_t *sample);
+void acc_sensor_decode(const uint8_t *raw, acc_sample_t *sample);
+int32_t acc_sensor_to_mg(int32_t count);
+uint32_t acc_sensor_stream_enable(uint32_t burst);
+void acc_sensor_stream_disable(void);
+
+#endif /* ACCSENSOR_H_ */
@@ -0,0 +1,358 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccStream.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccStream` utility acquires accelerometer samples continuously: the           |
+|    sensor INT1 interrupt starts an SPI DMA burst read of the samples buffered by      |
+|    the sensor, and the samples are gathered in a double buffered ring of blocks       |
+|    that the consumer task receives from a queue, without any task waiting on SPI1.    |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "AccStream.h"
+#include "queue.h"
+#include <string.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void acc_stream_read(void);
+static void acc_stream_store(const uint8_t *raw, BaseType_t *xHigherPriorityTaskWoken);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Block ring: the interrupt fills one block while the consumer owns the others
+static acc_block_t acc_blocks[ACC_STREAM_BLOCK_COUNT];
+static volatile uint8_t acc_block_busy[ACC_STREAM_BLOCK_COUNT];	// Set while queued or held by the consumer
+static uint32_t acc_fill_block = 0;		// Block being filled by the interrupt
+static uint32_t acc_fill_count = 0;		// Samples already in the block being filled
+static uint32_t acc_sequence = 0;		// Sequence number of the block being filled
+static QueueHandle_t acc_block_queue;	// Full blocks, oldest first
+static CCM_BSS StaticQueue_t acc_block_queue_buffer;
+static CCM_BSS uint8_t acc_block_queue_storage[ACC_STREAM_BLOCK_COUNT * sizeof(acc_block_t*)];
+
+// SPI DMA transfer: output register address, followed by a burst of samples
+static uint8_t acc_dma_tx[1 + (ACC_STREAM_BURST_SAMPLES * ACC_SAMPLE_MAX_SIZE)];
+static uint8_t acc_dma_rx[1 + (ACC_STREAM_BURST_SAMPLES * ACC_SAMPLE_MAX_SIZE)];
+static uint16_t acc_xfer_size;			// Bytes of one transfer, address included
+static uint8_t acc_sample_size;			// Bytes of one sample on the bus
+static uint32_t acc_burst;				// Samples per transfer
+
+static volatile uint8_t acc_streaming = 0;	// Set while the stream owns SPI1
+static volatile uint8_t acc_reading = 0;	// Set while INT1 starts new reads
+static acc_sample_t acc_latest;
+static acc_stream_stats_t acc_stats;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Creates the queue of full sample blocks.                                                     *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called once before the scheduler starts.                                              *
+ ******************************************************************************************************/
+void acc_stream_init(void)
+{
+	acc_block_queue = xQueueCreateStatic(ACC_STREAM_BLOCK_COUNT, sizeof(acc_block_t*), acc_block_queue_storage, &acc_block_queue_buffer);
+	configASSERT(NULL != acc_block_queue);
+}
+
+/*******************************************************************************************************
+ * @brief Starts streaming at the output data rate of the sensor.                                      *
+ *                                                                                                     *
+ * The ring and the counters are reset, the sensor is set to raise INT1 once a burst of up to          *
+ * `ACC_STREAM_BURST_SAMPLES` samples is buffered (every sample without FIFO), and the EXTI0 interrupt *
+ * is enabled. From then on the samples are read in bursts by SPI DMA and no task may access SPI1;     *
+ * `accelerometer_read` returns the latest streamed sample instead.                                    *
+ *                                                                                                     *
+ * @return int 0 on success, -1 if no sensor was detected.                                             *
+ ******************************************************************************************************/
+int acc_stream_start(void)
+{
+	const acc_sensor_t *sensor = acc_sensor_get();
+
+	if(NULL == sensor) {
+		return -1;
+	}
+	if(acc_streaming) {
+		return 0;
+	}
+
+	xQueueReset(acc_block_queue);
+	memset((void*)acc_block_busy, 0, sizeof(acc_block_busy));
+	memset(&acc_stats, 0, sizeof(acc_stats));
+	acc_fill_block = 0;
+	acc_fill_count = 0;
+	acc_sequence = 0;
+
+	// Size the burst for ACC_STREAM_READ_HZ reads per second, so slow rates are not delayed by a full burst
+	uint32_t burst = acc_sensor_odr() / (ACC_STREAM_READ_HZ * 1000);
+	burst = (burst > ACC_STREAM_BURST_SAMPLES) ? ACC_STREAM_BURST_SAMPLES : burst;
+
+	// One transfer reads the address byte and a burst of samples
+	acc_burst = acc_sensor_stream_enable(burst);
+	acc_sample_size = sensor->sample_size;
+	acc_xfer_size = 1 + (acc_burst * acc_sample_size);
+	acc_dma_tx[0] = sensor->out_cmd;
+
+	acc_streaming = 1;
+	acc_reading = 1;
+	HAL_NVIC_EnableIRQ(MEMS_INT1_EXTI_IRQn);
+
+	// INT1 is level triggered, an edge raised before EXTI0 was enabled would never be seen again
+	taskENTER_CRITICAL();
+	if(GPIO_PIN_SET == HAL_GPIO_ReadPin(MEMS_INT1_GPIO_Port, MEMS_INT1_Pin)) {
+		acc_stream_read();
+	}
+	taskEXIT_CRITICAL();
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Stops streaming.                                                                             *
+ *                                                                                                     *
+ * No read is started once EXTI0 is disabled, and the read in flight, if any, is allowed to complete   *
+ * before INT1 is turned off, so SPI1 is idle when this function returns. Blocks still in the queue    *
+ * are discarded.                                                                                      *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_stream_stop(void)
+{
+	if(!acc_streaming) {
+		return;
+	}
+
+	HAL_NVIC_DisableIRQ(MEMS_INT1_EXTI_IRQn);
+	acc_reading = 0;
+
+	// Wait for the transfer started by the last INT1 interrupt
+	while(HAL_SPI_STATE_READY != hspi1.State) {
+		vTaskDelay(1);
+	}
+	acc_streaming = 0;
+
+	acc_sensor_stream_disable();
+	xQueueReset(acc_block_queue);
+}
+
+/*******************************************************************************************************
+ * @brief Tells whether the accelerometer is streaming.                                                *
+ *                                                                                                     *
+ * @return int Non-zero while streaming.                                                               *
+ ******************************************************************************************************/
+int acc_stream_active(void)
+{
+	return acc_streaming;
+}
+
+/*******************************************************************************************************
+ * @brief Waits for the next full block of samples.                                                    *
+ *                                                                                                     *
+ * The block belongs to the caller until it is handed back with `acc_stream_release`. The ring holds   *
+ * `ACC_STREAM_BLOCK_COUNT` blocks, so a consumer keeping one block lets the interrupt fill the other  *
+ * for one block period; samples arriving while every other block is held are dropped.                 *
+ *                                                                                                     *
+ * @param wait [TickType_t] Ticks to wait for a block.                                                 *
+ * @return acc_block_t* Oldest full block, or NULL on timeout.                                         *
+ ******************************************************************************************************/
+acc_block_t *acc_stream_receive(TickType_t wait)
+{
+	acc_block_t *block;
+
+	if(pdTRUE != xQueueReceive(acc_block_queue, &block, wait)) {
+		return NULL;
+	}
+
+	return block;
+}
+
+/*******************************************************************************************************
+ * @brief Hands a block back to the interrupt for filling.                                             *
+ *                                                                                                     *
+ * @param block [acc_block_t*] Block returned by `acc_stream_receive`.                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_stream_release(acc_block_t *block)
+{
+	acc_block_busy[block - acc_blocks] = 0;
+}
+
+/*******************************************************************************************************
+ * @brief Copies the latest streamed sample.                                                           *
+ *                                                                                                     *
+ * @param sample [acc_sample_t*] Output sample.                                                        *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_stream_latest(acc_sample_t *sample)
+{
+	// The sample is written by the SPI DMA interrupt
+	taskENTER_CRITICAL();
+	*sample = acc_latest;
+	taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************************************
+ * @brief Copies the stream counters.                                                                  *
+ *                                                                                                     *
+ * @param stats [acc_stream_stats_t*] Output counters.                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void acc_stream_get_stats(acc_stream_stats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = acc_stats;
+	taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************************************
+ * @brief Starts the SPI DMA read of a burst of samples.                                               *
+ *                                                                                                     *
+ * Called on the rising edge of the sensor INT1 pin. If the previous read is still in flight the new   *
+ * read is deferred: INT1 is still high when that read completes, and the completion starts the next.  *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Executes in the EXTI0 interrupt context.                                                      *
+ ******************************************************************************************************/
+void acc_stream_drdy_callback(void)
+{
+	if(acc_reading) {
+		acc_stream_read();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Stores the samples read by SPI DMA and starts the next read if INT1 is still high.           *
+ *                                                                                                     *
+ * @param hspi [SPI_HandleTypeDef*] SPI handle of the completed transfer.                              *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Executes in the SPI DMA interrupt context.                                                    *
+ ******************************************************************************************************/
+void acc_stream_spi_callback(SPI_HandleTypeDef *hspi)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if(&hspi1 != hspi) {
+		return;
+	}
+
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+	acc_stats.reads++;
+
+	// The first received byte was clocked in while the address was sent
+	for(uint32_t i = 0; i < acc_burst; i++) {
+		acc_stream_store(&acc_dma_rx[1 + (i * acc_sample_size)], &xHigherPriorityTaskWoken);
+	}
+
+	// The sensor buffered another burst during the read, no new edge will announce it
+	if(acc_reading && (GPIO_PIN_SET == HAL_GPIO_ReadPin(MEMS_INT1_GPIO_Port, MEMS_INT1_Pin))) {
+		acc_stream_read();
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*******************************************************************************************************
+ * @brief Ends a failed SPI DMA read; the burst is lost and the next one is read if INT1 is high.      *
+ *                                                                                                     *
+ * @param hspi [SPI_HandleTypeDef*] SPI handle of the failed transfer.                                 *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Executes in the SPI DMA interrupt context.                                                    *
+ ******************************************************************************************************/
+void acc_stream_spi_error_callback(SPI_HandleTypeDef *hspi)
+{
+	if(&hspi1 != hspi) {
+		return;
+	}
+
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+	acc_stats.spi_errors++;
+
+	// INT1 stays high while the burst is unread
+	if(acc_reading && (GPIO_PIN_SET == HAL_GPIO_ReadPin(MEMS_INT1_GPIO_Port, MEMS_INT1_Pin))) {
+		acc_stream_read();
+	}
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Starts an SPI DMA read of one burst, or defers it while the previous read is in flight.      *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Executes in interrupt context or with interrupts masked.                                      *
+ ******************************************************************************************************/
+static void acc_stream_read(void)
+{
+	if(HAL_SPI_STATE_READY != hspi1.State) {
+		acc_stats.deferred_reads++;
+		return;
+	}
+
+	HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_RESET);
+	if(HAL_OK != HAL_SPI_TransmitReceive_DMA(&hspi1, acc_dma_tx, acc_dma_rx, acc_xfer_size)) {
+		HAL_GPIO_WritePin(CS_I2C_SPI_GPIO_Port, CS_I2C_SPI_Pin, GPIO_PIN_SET);
+		acc_stats.spi_errors++;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Stores one sample and queues the block once it is full.                                      *
+ *                                                                                                     *
+ * When the next block of the ring is still held by the consumer the full block is not queued; it is   *
+ * counted as dropped and filled again, so the consumer receives the blocks in order, with gaps        *
+ * visible in the sequence numbers.                                                                    *
+ *                                                                                                     *
+ * @param raw [const uint8_t*] Sample as read from the output registers.                               *
+ * @param xHigherPriorityTaskWoken [BaseType_t*] Set if queuing the block woke the consumer.           *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Executes in the SPI DMA interrupt context.                                                    *
+ ******************************************************************************************************/
+static void acc_stream_store(const uint8_t *raw, BaseType_t *xHigherPriorityTaskWoken)
+{
+	acc_block_t *block = &acc_blocks[acc_fill_block];
+	acc_sample_t *sample = &block->samples[acc_fill_count];
+
+	acc_sensor_decode(raw, sample);
+	acc_latest = *sample;
+	acc_stats.samples++;
+
+	if(++acc_fill_count < ACC_STREAM_BLOCK_SAMPLES) {
+		return;
+	}
+
+	// The block is full: queue it if the next one is free, otherwise refill it
+	uint32_t next = (acc_fill_block + 1) % ACC_STREAM_BLOCK_COUNT;
+	block->sequence = acc_sequence++;
+	block->timestamp = DWT->CYCCNT;
+	acc_fill_count = 0;
+	if(acc_block_busy[next]) {
+		acc_stats.dropped_blocks++;
+		return;
+	}
+
+	acc_block_busy[acc_fill_block] = 1;
+	xQueueSendFromISR(acc_block_queue, &block, xHigherPriorityTaskWoken);
+	acc_fill_block = next;
+	acc_stats.blocks++;
+}
@@ -0,0 +1,64 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ AccManager ]                                                            |
+| FILE:       AccStream.h                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `AccStream` utility acquires accelerometer samples continuously: the           |
+|    sensor INT1 interrupt starts an SPI DMA burst read of the samples buffered by      |
+|    the sensor, and the samples are gathered in a double buffered ring of blocks       |
+|    that the consumer task receives from a queue, without any task waiting on SPI1.    |
+\*=====================================================================================*/
+
+#ifndef ACCSTREAM_H_
+#define ACCSTREAM_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "FreeRTOS.h"
+#include "main.h"
+#include "Config_AccManager.h"
+#include "AccSensor.h"
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	acc_sample_t samples[ACC_STREAM_BLOCK_SAMPLES];
+	uint32_t sequence;			// Block number since the stream was started, gaps are dropped blocks
+	uint32_t timestamp;			// Cycle counter when the last sample was received
+} acc_block_t;
+
+typedef struct
+{
+	uint32_t samples;			// Samples received
+	uint32_t blocks;			// Blocks queued to the consumer
+	uint32_t dropped_blocks;	// Blocks discarded because the consumer held every other block
+	uint32_t reads;				// SPI DMA burst reads completed
+	uint32_t deferred_reads;	// INT1 interrupts raised while the previous read was in flight
+	uint32_t spi_errors;		// SPI DMA transfers that ended in error
+} acc_stream_stats_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void acc_stream_init(void);
+int acc_stream_start(void);
+void acc_stream_stop(void);
+int acc_stream_active(void);
+acc_block_t *acc_stream_receive(TickType_t wait);
+void acc_stream_release(acc_block_t *block);
+void acc_stream_latest(acc_sample_t *sample);
+void acc_stream_get_stats(acc_stream_stats_t *stats);
+void acc_stream_drdy_callback(void);
+void acc_stream_spi_callback(SPI_HandleTypeDef *hspi);
+void acc_stream_spi_error_callback(SPI_HandleTypeDef *hspi);
+
+#endif /* ACCSTREAM_H_ */
@@ -19,15 +19,28 @@
  *  Macros                                          *
  ****************************************************/
 
-// LSM303DLHC Accelerometer I2C address
-#define ACC_I2C_ADDRESS			0x32
-
-// LSM303DLHC Registers
-#define LSM303DLHC_CTRL_REG1_A 	0x20
-#define LSM303DLHC_OUT_X_L_A   	0x28 | 0x80  // Auto-increment enabled
-#define ACC_X_ADDR				LSM303DLHC_OUT_X_L_A
-#define ACC_Y_ADDR				LSM303DLHC_OUT_Y_L_A
-#define ACC_Z_ADDR				LSM303DLHC_OUT_Z_L_A
+// Sensor configuration applied at start-up, or the closest lower setting the sensor supports
+#define ACC_DEFAULT_ODR_MHZ		100000	// Output data rate (mHz)
+#define ACC_DEFAULT_RANGE_G		2		// Full scale (+/- g)
+
+// SPI bus
+#define ACC_SPI_MAX_HZ			10000000	// Fastest SPI clock of the LIS3DSH and LIS302DL (Hz)
+
+// Streaming acquisition
+#define ACC_STREAM_BLOCK_COUNT		2	// Blocks in the ring: one filled by the interrupt, one held by the consumer
+#define ACC_STREAM_BLOCK_SAMPLES	32	// Samples per block handed to the consumer
+#define ACC_STREAM_BURST_SAMPLES	16	// Most samples per SPI DMA read, the FIFO watermark of the sensor
+#define ACC_STREAM_READ_HZ			100	// Burst reads per second the burst is sized for, below the burst limit
+#define ACC_STREAM_REPORT_MS		1000 // Period of the stream report printed by the `Stream` command
+#define ACC_STREAM_POLL_MS		100	// Longest wait for a block before checking for user input
+
+// Stream processing, the blocks are reduced to features before anything is printed
+#define ACC_DSP_USE_CMSIS_DSP		0	// 1 to run the filters on the CMSIS-DSP library (arm_math.h, ARM_MATH_CM4, libarm_cortexM4lf_math)
+#define ACC_DSP_FIR_TAPS			32	// Low-pass FIR length
+#define ACC_DSP_DEFAULT_DECIMATION	8	// Input samples per output sample, a divisor of ACC_STREAM_BLOCK_SAMPLES
+#define ACC_DSP_DEFAULT_LOWPASS_MHZ	0	// Low-pass cutoff (mHz), 0 for ACC_DSP_AUTO_LOWPASS_PCT of the output rate
+#define ACC_DSP_DEFAULT_HIGHPASS_MHZ	1000 // High-pass cutoff (mHz), 0 to bypass the high-pass
+#define ACC_DSP_AUTO_LOWPASS_PCT	40	// Default low-pass cutoff, in percent of the decimated rate
 
 // Event group bits for synchronization
 #define ACCEL_READ_X_BIT 		(1 << 0)
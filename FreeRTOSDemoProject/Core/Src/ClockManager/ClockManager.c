@@ -0,0 +1,356 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ ClockManager ]                                                          |
+| FILE:       ClockManager.c                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `ClockManager` module sets up the clock tree from one of several               |
+|    profiles, with the matching regulator scale, flash wait states and ART             |
+|    accelerator, and benchmarks the code run from flash with the `Clock`               |
+|    command.                                                                           |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_ClockManager.h"
+#include "Config_UartManager.h"
+#include "ClockManager.h"
+#include "MotorManager.h"
+#include "UartManager.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "main.h"
+#include <stdio.h>
+#include <inttypes.h>
+
+#if ((HSE_VALUE % CLOCK_PLL_INPUT_HZ) != 0)
+#error "CLOCK_PLL_INPUT_HZ must divide the HSE frequency"
+#endif
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// PLL and bus settings of a clock profile, for a CLOCK_PLL_INPUT_HZ PLL input
+typedef struct
+{
+	uint32_t sysclk_hz;			// System and AHB clock
+	uint32_t plln;				// VCO multiplier, the VCO runs between 100 and 432 MHz
+	uint32_t pllp;				// VCO divider for the system clock
+	uint32_t pllq;				// VCO divider for the 48 MHz domain, which may not exceed 48 MHz
+	uint32_t voltage_scale;		// Regulator output, scale 2 is limited to 144 MHz
+	uint32_t apb1_divider;		// APB1 at or below 42 MHz
+	uint32_t apb2_divider;		// APB2 at or below 84 MHz
+} clock_profile_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void clock_set_latency(uint32_t latency);
+static void clock_set_art(uint32_t enable);
+static void clock_bench(uint32_t latency, uint32_t art, uint32_t *control, uint32_t *format);
+static uint32_t clock_bench_format(void);
+
+/****************************************************
+ *  Messages                                        *
+ ****************************************************/
+
+const char *msg_clock_header = "\n************************************\n"
+							   "*          CLOCK SETTINGS          *\n"
+							   "*                                  *\n";
+const char *msg_clock_bench = "*                                  *\n"
+							  "* Profile  WS  ART  Control Format *\n";
+const char *msg_clock_footer = "*                                  *\n"
+							   "************************************\n";
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const clock_profile_t clock_profiles[CLOCK_PROFILE_COUNT] = {
+	{  25000000, 100, RCC_PLLP_DIV8, 5, PWR_REGULATOR_VOLTAGE_SCALE2, RCC_HCLK_DIV4, RCC_HCLK_DIV2 },
+	{  84000000, 168, RCC_PLLP_DIV4, 7, PWR_REGULATOR_VOLTAGE_SCALE2, RCC_HCLK_DIV2, RCC_HCLK_DIV1 },
+	{ 168000000, 168, RCC_PLLP_DIV2, 7, PWR_REGULATOR_VOLTAGE_SCALE1, RCC_HCLK_DIV4, RCC_HCLK_DIV2 },
+};
+
+// Formatted by the benchmark, kept so the formatting cannot be optimized away
+static char clock_bench_line[PRINT_POOL_BLOCK_SIZE];
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Switches the clock tree to the profile selected by `CLOCK_PROFILE`.                          *
+ *                                                                                                     *
+ * This function overrides the clock configuration generated by CubeMX. The system clock moves to the  *
+ * HSI while the PLL is stopped, the regulator scale is set, and the PLL is started again from the HSE *
+ * crystal. `HAL_RCC_ClockConfig` then raises the flash wait states before switching to the faster     *
+ * clock, and the ART accelerator is enabled once the wait states are set. `SystemCoreClock`, the HAL  *
+ * time base and every peripheral initialized afterwards follow the new clocks.                        *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called from `main` right after `SystemClock_Config`, before the peripherals are       *
+ *       initialized.                                                                                  *
+ ******************************************************************************************************/
+
+void clock_init(void)
+{
+	const clock_profile_t *profile = &clock_profiles[CLOCK_PROFILE];
+	RCC_OscInitTypeDef osc = {0};
+	RCC_ClkInitTypeDef clk = {0};
+
+	// The PLL cannot be changed while it drives the system clock
+	clk.ClockType = RCC_CLOCKTYPE_SYSCLK;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+	if(HAL_OK != HAL_RCC_ClockConfig(&clk, __HAL_FLASH_GET_LATENCY())) {
+		Error_Handler();
+	}
+
+	// Stop the PLL while the regulator scale changes, as some STM32F4 devices require
+	osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	osc.PLL.PLLState = RCC_PLL_OFF;
+	if(HAL_OK != HAL_RCC_OscConfig(&osc)) {
+		Error_Handler();
+	}
+	__HAL_RCC_PWR_CLK_ENABLE();
+	__HAL_PWR_VOLTAGESCALING_CONFIG(profile->voltage_scale);
+
+	osc.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+	osc.HSEState = RCC_HSE_ON;
+	osc.PLL.PLLState = RCC_PLL_ON;
+	osc.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+	osc.PLL.PLLM = HSE_VALUE / CLOCK_PLL_INPUT_HZ;
+	osc.PLL.PLLN = profile->plln;
+	osc.PLL.PLLP = profile->pllp;
+	osc.PLL.PLLQ = profile->pllq;
+	if(HAL_OK != HAL_RCC_OscConfig(&osc)) {
+		Error_Handler();
+	}
+
+	clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = profile->apb1_divider;
+	clk.APB2CLKDivider = profile->apb2_divider;
+	if(HAL_OK != HAL_RCC_ClockConfig(&clk, clock_flash_latency(profile->sysclk_hz))) {
+		Error_Handler();
+	}
+
+	clock_set_art(CLOCK_ART_ENABLE);
+	configASSERT(SystemCoreClock == profile->sysclk_hz);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the clock feeding the APB1 timers, TIM2 to TIM7.                                     *
+ *                                                                                                     *
+ * @return uint32_t APB1 timer clock in Hz, twice PCLK1 whenever the APB1 prescaler is not 1.          *
+ ******************************************************************************************************/
+
+uint32_t clock_apb1_timer_hz(void)
+{
+	uint32_t timer_clock = HAL_RCC_GetPCLK1Freq();
+
+	// APB1 timers run at twice PCLK1 whenever the APB1 prescaler is not 1
+	if((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+		timer_clock *= 2;
+	}
+
+	return timer_clock;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the flash wait states needed at a given HCLK.                                        *
+ *                                                                                                     *
+ * @param hclk_hz [uint32_t] AHB clock in Hz.                                                          *
+ * @return uint32_t Wait states, one per `CLOCK_FLASH_WS_HZ` started, equal to the `FLASH_LATENCY_x`   *
+ *         value.                                                                                      *
+ ******************************************************************************************************/
+
+uint32_t clock_flash_latency(uint32_t hclk_hz)
+{
+	return (hclk_hz - 1) / CLOCK_FLASH_WS_HZ;
+}
+
+/*******************************************************************************************************
+ * @brief Prints the clock settings and benchmarks the control step and the console formatting.        *
+ *                                                                                                     *
+ * The settings show the bus clocks, the flash wait states and the ART accelerator state, and the      *
+ * rates derived from them: the TIM3 PWM frequency, the TIM7 control loop rate, the USART2 baud rate   *
+ * and the SPI1 clock of the accelerometer.                                                            *
+ *                                                                                                     *
+ * The benchmark then runs `motor_control_step` and the formatting of a report line with the flash     *
+ * wait states of each profile, with and without the ART accelerator, and prints the fastest run of    *
+ * each in CPU cycles. Both run from flash, so their cycle counts depend on the wait states and the    *
+ * ART state but not on the clock: running at the current clock with the wait states of a faster       *
+ * profile gives the cycle counts of that profile. Profiles needing fewer wait states than the current *
+ * clock are shown without counts.                                                                     *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note All interrupts are masked while each setting is measured, for a few milliseconds at most with *
+ *       the default `CLOCK_BENCH_RUNS`.                                                               *
+ ******************************************************************************************************/
+
+void print_clock_report(void)
+{
+	uint32_t latency = __HAL_FLASH_GET_LATENCY();
+	uint32_t min_latency = clock_flash_latency(SystemCoreClock);
+	uint32_t timer_hz = clock_apb1_timer_hz();
+	uint32_t pwm_hz = timer_hz / ((htim3.Instance->PSC + 1) * (htim3.Instance->ARR + 1));
+	uint32_t loop_hz = timer_hz / ((htim7.Instance->PSC + 1) * (htim7.Instance->ARR + 1));
+	uint32_t baud = (0 != huart2.Instance->BRR) ? (HAL_RCC_GetPCLK1Freq() / huart2.Instance->BRR) : 0;
+	uint32_t spi_hz = HAL_RCC_GetPCLK2Freq() >> (((hspi1.Init.BaudRatePrescaler & SPI_CR1_BR) >> SPI_CR1_BR_Pos) + 1);
+
+	// Send clock settings header message
+	xQueueSend(q_print, &msg_clock_header, portMAX_DELAY);
+
+	// Print the bus clocks and the flash settings
+	char *showclock = print_pool_alloc(portMAX_DELAY);
+	snprintf(showclock, PRINT_POOL_BLOCK_SIZE, "* SYSCLK:             %6" PRIu32 " kHz   *"
+											 "\n* APB1:               %6" PRIu32 " kHz   *"
+											 "\n* APB2:               %6" PRIu32 " kHz   *"
+											 "\n* Flash wait states:  %" PRIu32 "            *"
+											 "\n* ART accelerator:    %-3s          *\n",
+											 SystemCoreClock / 1000, HAL_RCC_GetPCLK1Freq() / 1000,
+											 HAL_RCC_GetPCLK2Freq() / 1000, latency,
+											 (0 != (FLASH->ACR & FLASH_ACR_ICEN)) ? "on" : "off");
+	print_pool_send(showclock);
+
+	// Print the peripheral rates derived from the clocks
+	char *showrates = print_pool_alloc(portMAX_DELAY);
+	snprintf(showrates, PRINT_POOL_BLOCK_SIZE, "* TIM3 PWM:           %6" PRIu32 " Hz    *"
+											 "\n* TIM7 control loop:  %6" PRIu32 " Hz    *"
+											 "\n* USART2:             %6" PRIu32 " baud  *"
+											 "\n* SPI1:               %6" PRIu32 " kHz   *\n",
+											 pwm_hz, loop_hz, baud, spi_hz / 1000);
+	print_pool_send(showrates);
+
+	// Benchmark each profile, without and with the ART accelerator
+	xQueueSend(q_print, &msg_clock_bench, portMAX_DELAY);
+	for(int i = 0; i < CLOCK_PROFILE_COUNT; i++) {
+		uint32_t profile_latency = clock_flash_latency(clock_profiles[i].sysclk_hz);
+		for(uint32_t art = 0; art < 2; art++) {
+			char *showbench = print_pool_alloc(portMAX_DELAY);
+			if(profile_latency < min_latency) {
+				snprintf(showbench, PRINT_POOL_BLOCK_SIZE, "* %3" PRIu32 " MHz   %" PRIu32 "  %-3s        -      - *\n",
+						 clock_profiles[i].sysclk_hz / 1000000, profile_latency, art ? "on" : "off");
+			}
+			else {
+				uint32_t control;
+				uint32_t format;
+				clock_bench(profile_latency, art, &control, &format);
+				snprintf(showbench, PRINT_POOL_BLOCK_SIZE, "* %3" PRIu32 " MHz   %" PRIu32 "  %-3s  %7" PRIu32 " %6" PRIu32 " *\n",
+						 clock_profiles[i].sysclk_hz / 1000000, profile_latency, art ? "on" : "off",
+						 control, format);
+			}
+			print_pool_send(showbench);
+		}
+	}
+
+	// Send clock settings footer message
+	xQueueSend(q_print, &msg_clock_footer, portMAX_DELAY);
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Sets the flash wait states.                                                                  *
+ *                                                                                                     *
+ * @param latency [uint32_t] `FLASH_LATENCY_x` value.                                                  *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note The new value is read back before returning, as the reference manual requires before the      *
+ *       clock is raised.                                                                              *
+ ******************************************************************************************************/
+
+static void clock_set_latency(uint32_t latency)
+{
+	MODIFY_REG(FLASH->ACR, FLASH_ACR_LATENCY, latency);
+	while(READ_BIT(FLASH->ACR, FLASH_ACR_LATENCY) != latency) {
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Enables or disables the ART accelerator.                                                     *
+ *                                                                                                     *
+ * The instruction and data caches are reset whenever they are disabled, so that they never return     *
+ * lines fetched with other settings.                                                                  *
+ *                                                                                                     *
+ * @param enable [uint32_t] 1 to enable the prefetch buffer and both caches, 0 to disable them.        *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void clock_set_art(uint32_t enable)
+{
+	// The caches may only be reset while they are disabled
+	__HAL_FLASH_PREFETCH_BUFFER_DISABLE();
+	__HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+	__HAL_FLASH_DATA_CACHE_DISABLE();
+	__HAL_FLASH_INSTRUCTION_CACHE_RESET();
+	__HAL_FLASH_DATA_CACHE_RESET();
+
+	if(enable) {
+		__HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+		__HAL_FLASH_DATA_CACHE_ENABLE();
+		__HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Times the control step and the formatting with given flash settings.                         *
+ *                                                                                                     *
+ * @param latency [uint32_t] Flash wait states to run with, at least those the current clock needs.    *
+ * @param art [uint32_t] 1 to run with the ART accelerator, 0 without it.                              *
+ * @param control [uint32_t*] Fastest control step in CPU cycles.                                      *
+ * @param format [uint32_t*] Fastest formatting of a report line in CPU cycles.                        *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note PRIMASK is set rather than entering a critical section, which would leave the interrupts      *
+ *       above `configMAX_SYSCALL_INTERRUPT_PRIORITY` running. The flash settings and PRIMASK are      *
+ *       restored before returning.                                                                    *
+ ******************************************************************************************************/
+
+static void clock_bench(uint32_t latency, uint32_t art, uint32_t *control, uint32_t *format)
+{
+	uint32_t saved_latency = __HAL_FLASH_GET_LATENCY();
+	uint32_t saved_art = (0 != (FLASH->ACR & FLASH_ACR_ICEN)) ? 1 : 0;
+
+	*control = UINT32_MAX;
+	*format = UINT32_MAX;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	clock_set_latency(latency);
+	clock_set_art(art);
+	for(int i = 0; i < CLOCK_BENCH_RUNS; i++) {
+		uint32_t cycles = motor_control_step_cycles();
+		*control = (cycles < *control) ? cycles : *control;
+		cycles = clock_bench_format();
+		*format = (cycles < *format) ? cycles : *format;
+	}
+	clock_set_art(saved_art);
+	clock_set_latency(saved_latency);
+	__set_PRIMASK(primask);
+}
+
+/*******************************************************************************************************
+ * @brief Formats a line of the CPU usage report, as a sample of the console formatting.               *
+ *                                                                                                     *
+ * @return uint32_t CPU cycles taken.                                                                  *
+ ******************************************************************************************************/
+
+static uint32_t clock_bench_format(void)
+{
+	uint32_t start = DWT->CYCCNT;
+	snprintf(clock_bench_line, sizeof(clock_bench_line), "* %-12.12s %3" PRIu32 ".%" PRIu32 " %%   %08" PRIu32 "  *\n",
+			 "motor_task", (uint32_t)12, (uint32_t)5, (uint32_t)123456);
+	return DWT->CYCCNT - start;
+}
@@ -0,0 +1,32 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ ClockManager ]                                                          |
+| FILE:       ClockManager.h                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `ClockManager` module sets up the clock tree from one of several               |
+|    profiles, with the matching regulator scale, flash wait states and ART             |
+|    accelerator, and benchmarks the code run from flash with the `Clock`               |
+|    command.                                                                           |
+\*=====================================================================================*/
+
+#ifndef CLOCKMANAGER_H_
+#define CLOCKMANAGER_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void clock_init(void);
+uint32_t clock_apb1_timer_hz(void);
+uint32_t clock_flash_latency(uint32_t hclk_hz);
+void print_clock_report(void);
+
+#endif /* CLOCKMANAGER_H_ */
@@ -0,0 +1,36 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ ClockManager ]                                                          |
+| FILE:       Config_ClockManager.h                                                     |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `ClockManager` module sets up the clock tree from one of several               |
+|    profiles, with the matching regulator scale, flash wait states and ART             |
+|    accelerator, and benchmarks the code run from flash with the `Clock`               |
+|    command.                                                                           |
+\*=====================================================================================*/
+
+#ifndef CONFIG_CLOCKMANAGER_H_
+#define CONFIG_CLOCKMANAGER_H_
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+// Clock profiles, the PLL runs from the 8 MHz HSE crystal of the discovery board in all of them
+#define CLOCK_PROFILE_25MHZ			0 // Low power: 25 MHz at voltage scale 2, flash without wait states
+#define CLOCK_PROFILE_84MHZ			1 // 84 MHz at voltage scale 2, APB2 undivided
+#define CLOCK_PROFILE_168MHZ		2 // Full speed: 168 MHz at voltage scale 1
+#define CLOCK_PROFILE_COUNT			3
+#define CLOCK_PROFILE				CLOCK_PROFILE_168MHZ
+
+// Clock tree
+#define CLOCK_PLL_INPUT_HZ			2000000 // PLL input after the HSE divider, 2 MHz for the lowest jitter
+#define CLOCK_FLASH_WS_HZ			30000000 // HCLK covered by each flash wait state at VDD 2.7 V to 3.6 V
+#define CLOCK_ART_ENABLE			1 // 1 to enable the ART accelerator: flash prefetch, instruction and data caches
+
+// Benchmark of the `Clock` command
+#define CLOCK_BENCH_RUNS			8 // Runs of each benchmarked function per setting, the fastest is reported
+
+#endif /* CONFIG_CLOCKMANAGER_H_ */
@@ -20,6 +20,7 @@
 #include "Config_LedManager.h"
 #include "main.h"
 #include "Config_AccManager.h"
+#include "Command.h"
 #include <string.h>
 #include <ctype.h>
 
@@ -33,6 +34,17 @@ void control_led_group(int led_mode);
 void execute_led_effect(int effect);
 int parse_freq_string(message_t *msg, int *freq_Hz);
 int freq_str_to_int(message_t *msg, int len);
+static void led_cmd_none(const char *args);
+static void led_cmd_e1(const char *args);
+static void led_cmd_e2(const char *args);
+static void led_cmd_e3(const char *args);
+static void led_cmd_e4(const char *args);
+static void led_toggle(GPIO_TypeDef *port, uint16_t pin);
+static void led_cmd_tor(const char *args);
+static void led_cmd_tgr(const char *args);
+static void led_cmd_tbl(const char *args);
+static void led_cmd_tre(const char *args);
+static void led_cmd_main(const char *args);
 
 /****************************************************
  *  Messages                                        *
@@ -64,6 +76,21 @@ const char *msg_led_menu = "\n======================================\n"
 
 led_state_t curr_led_state = sNone;
 
+// LED menu commands, the FXX frequency command is parsed separately
+static const command_t led_commands[] = {
+	{ "None",	led_cmd_none,	0 },
+	{ "E1",		led_cmd_e1,		0 },
+	{ "E2",		led_cmd_e2,		0 },
+	{ "E3",		led_cmd_e3,		0 },
+	{ "E4",		led_cmd_e4,		0 },
+	{ "Tor",	led_cmd_tor,	0 },
+	{ "Tgr",	led_cmd_tgr,	0 },
+	{ "Tbl",	led_cmd_tbl,	0 },
+	{ "Tre",	led_cmd_tre,	0 },
+	{ "Main",	led_cmd_main,	0 },
+};
+static command_table_t led_command_table = COMMAND_TABLE(led_commands);
+
 /****************************************************
  *  Public functions                                *
  ****************************************************/
@@ -87,7 +114,6 @@ led_state_t curr_led_state = sNone;
 void led_task(void *param)
 {
 	// Communication variables
-	uint32_t msg_addr;
 	message_t *msg;
 
 	// LED timer parameters
@@ -99,92 +125,42 @@ void led_task(void *param)
 	uint32_t notificationValue;
 	EventBits_t eventBits;
 
+	// Build the hash index of the command table
+	int status = command_table_init(&led_command_table);
+	configASSERT(0 == status);
+
 	while(1) {
 		// Wait for task notification or timeout =========================================================================
 		if (xTaskNotifyWait(0, 0, &notificationValue, xTicksToWait) == pdPASS) {										//
 																														//
 			// Display LED menu for the user																			//
-			xQueueSend(q_print, &msg_led_menu, portMAX_DELAY);															//
+			print_interactive(msg_led_menu);																			//
 																														//
 			// Wait for the user to select their desired LED effect														//
-			xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);															//
-			msg = (message_t*)msg_addr;																					//
+			msg = uart_wait_message();																					//
 																														//
 			// Process command, adjust LED state, and set software timers accordingly									//
-			if(msg->len <= 4) {																							//
-				if(!strcmp((char*)msg->payload, "None"))			// No effect										//
-				{																										//
-					set_led_timer(effectNone);																			//
-					curr_led_state = sNone;																				//
-					control_all_leds(LED_OFF);																			//
-				}																										//
-				else if (!strcmp((char*)msg->payload, "E1")) {		// E1 effect										//
-					curr_led_state = sEffectE1;																			//
-					set_led_timer(effectE1);																			//
-				}																										//
-				else if (!strcmp((char*)msg->payload, "E2")) {		// E2 effect										//
-					curr_led_state = sEffectE2;																			//
-					set_led_timer(effectE2);																			//
-				}																										//
-				else if (!strcmp((char*)msg->payload, "E3")) {		// E3 effect										//
-					curr_led_state = sEffectE3;																			//
-					set_led_timer(effectE3);																			//
-				}																										//
-				else if (!strcmp((char*)msg->payload, "E4")) {		// E4 effect										//
-					curr_led_state = sEffectE4;																			//
-					set_led_timer(effectE4);																			//
-				}																										//
-				else if (!strcmp((char*)msg->payload, "Tor")) {		// Toggle orange LED								//
-					set_led_timer(effectNone);																			//
-					curr_led_state = sNone;																				//
-					HAL_GPIO_TogglePin(ORANGE_LED_PORT, ORANGE_LED_PIN);												//
-				}																										// N
-				else if (!strcmp((char*)msg->payload, "Tgr")) {		// Toggle green LED									// O
-					set_led_timer(effectNone);																			// T
-					curr_led_state = sNone;																				// I
-					HAL_GPIO_TogglePin(GREEN_LED_PORT, GREEN_LED_PIN);													// F
-				}																										// I
-				else if (!strcmp((char*)msg->payload, "Tbl")) {		// Toggle blue LED									// C
-					set_led_timer(effectNone);																			// A
-					curr_led_state = sNone;																				// T
-					HAL_GPIO_TogglePin(BLUE_LED_PORT, BLUE_LED_PIN);													// I
-				}																										// O
-				else if (!strcmp((char*)msg->payload, "Tre")) {		// Toggle red LED									// N
-					set_led_timer(effectNone);																			//
-					curr_led_state = sNone;																				//
-					HAL_GPIO_TogglePin(RED_LED_PORT, RED_LED_PIN);														//
-				}																										//
-				else if (parse_freq_string(msg, &freq)) {			// Frequency adjustment								//
-					// Check that there is an active effect																//
-					if(sNone == curr_led_state) {																		//
-						xQueueSend(q_print, &msg_no_active_effect, portMAX_DELAY);										//
-					}																									//
-					// Check that frequency is between 1 and 10 Hz														//
-					else if(freq > 10) {																				//
-						xQueueSend(q_print, &msg_inv_freq, portMAX_DELAY);												//
-					}																									//
-					// Change timer frequency																			//
-					else {																								//
-						period = (1.0 / freq) * 1000;																	//
-						if (xTimerChangePeriod(handle_led_timer[curr_led_state], pdMS_TO_TICKS(period), 0) != pdPASS) {	//
+			if (!command_dispatch(&led_command_table, (char*)msg->payload)) {											//
+				if (parse_freq_string(msg, &freq)) {				// Frequency adjustment								//
+					// Check that there is an active effect																// N
+					if(sNone == curr_led_state) {																		// O
+						print_error(msg_no_active_effect);																// T
+					}																									// I
+					// Check that frequency is between 1 and 10 Hz														// F
+					else if(freq > 10) {																				// I
+						print_error(msg_inv_freq);																		// C
+					}																									// A
+					// Change timer frequency																			// T
+					else {																								// I
+						period = (1.0 / freq) * 1000;																	// O
+						if (xTimerChangePeriod(handle_led_timer[curr_led_state], pdMS_TO_TICKS(period), 0) != pdPASS) {	// N
 							// If frequency update was not successful, notify the user									//
-							xQueueSend(q_print, &msg_err_freq, portMAX_DELAY);											//
+							print_error(msg_err_freq);																	//
 						}																								//
 					}																									//
 				}																										//
-				else if (!strcmp((char*)msg->payload, "Main")) {	// Back to main menu								//
-					// Update the system state																			//
-					curr_sys_state = sMainMenu;																			//
-																														//
-					// Notify the main menu task																		//
-					xTaskNotify(handle_main_menu_task, 0, eNoAction);													//
-				}																										//
 				else												// Invalid response									//
-					xQueueSend(q_print, &msg_inv_led, portMAX_DELAY);													//
-			}																											//
-			else {																										//
-				// If user input is longer than 4 characters, notify user of invalid response							//
-				xQueueSend(q_print, &msg_inv_led, portMAX_DELAY);														//
+					print_error(msg_inv_led);																			//
 			}																											//
 																														//
 			// Notify self / led task if not returning to the main menu													//
@@ -272,17 +248,145 @@ void led_task(void *param)
 void led_callback(TimerHandle_t xTimer)
 {
 	// Get timer ID
-	int id = (uint32_t)pvTimerGetTimerID(xTimer);
+	int id = (int)(uintptr_t)pvTimerGetTimerID(xTimer);
 
 	// LED effects correspond to timer ID's
 	int effect = id;
 	execute_led_effect(effect);
 }
 
+/*******************************************************************************************************
+ * @brief Starts an LED effect, or stops the active one and turns all LEDs off.                        *
+ *                                                                                                     *
+ * @param effect [led_effect_t] Effect to start, `effectNone` to turn the LEDs off.                    *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Used by the LED menu and by the binary protocol. Must be called from task context.            *
+ ******************************************************************************************************/
+
+void led_set_effect(led_effect_t effect)
+{
+	// The effects and the LED states are numbered alike
+	curr_led_state = (led_state_t)effect;
+	set_led_timer(effect);
+
+	if(effectNone == effect) {
+		control_all_leds(LED_OFF);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Reads the active LED effect.                                                                 *
+ *                                                                                                     *
+ * @return led_effect_t Active effect, `effectNone` if the LEDs are off or toggled by hand.            *
+ ******************************************************************************************************/
+
+led_effect_t led_get_effect(void)
+{
+	return (led_effect_t)curr_led_state;
+}
+
 /****************************************************
  *  Private functions                               *
  ****************************************************/
 
+/*******************************************************************************************************
+ * @brief LED menu `None` command: stops the active effect and turns all LEDs off.                     *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void led_cmd_none(const char *args)
+{
+	led_set_effect(effectNone);
+}
+
+/*******************************************************************************************************
+ * @brief LED menu `E1` to `E4` commands: starts an LED effect.                                        *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void led_cmd_e1(const char *args)
+{
+	led_set_effect(effectE1);
+}
+
+static void led_cmd_e2(const char *args)
+{
+	led_set_effect(effectE2);
+}
+
+static void led_cmd_e3(const char *args)
+{
+	led_set_effect(effectE3);
+}
+
+static void led_cmd_e4(const char *args)
+{
+	led_set_effect(effectE4);
+}
+
+/*******************************************************************************************************
+ * @brief Stops the active effect and toggles one LED.                                                 *
+ *                                                                                                     *
+ * @param port [GPIO_TypeDef*] GPIO port of the LED.                                                   *
+ * @param pin [uint16_t] GPIO pin of the LED.                                                          *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void led_toggle(GPIO_TypeDef *port, uint16_t pin)
+{
+	set_led_timer(effectNone);
+	curr_led_state = sNone;
+	HAL_GPIO_TogglePin(port, pin);
+}
+
+/*******************************************************************************************************
+ * @brief LED menu `Tor`, `Tgr`, `Tbl` and `Tre` commands: toggles the orange, green, blue or red LED. *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void led_cmd_tor(const char *args)
+{
+	led_toggle(ORANGE_LED_PORT, ORANGE_LED_PIN);
+}
+
+static void led_cmd_tgr(const char *args)
+{
+	led_toggle(GREEN_LED_PORT, GREEN_LED_PIN);
+}
+
+static void led_cmd_tbl(const char *args)
+{
+	led_toggle(BLUE_LED_PORT, BLUE_LED_PIN);
+}
+
+static void led_cmd_tre(const char *args)
+{
+	led_toggle(RED_LED_PORT, RED_LED_PIN);
+}
+
+/*******************************************************************************************************
+ * @brief LED menu `Main` command: returns to the main menu.                                           *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void led_cmd_main(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sMainMenu;
+
+	// Notify the main menu task
+	xTaskNotify(handle_main_menu_task, 0, eNoAction);
+}
+
 /*******************************************************************************************************
  * @brief Sets the timer for the specified LED effect.												   *
  * 																									   *
@@ -22,13 +22,6 @@
 #include "FreeRTOS.h"
 #include "timers.h"
 
-/****************************************************
- *  Public functions                                *
- ****************************************************/
-
-void led_task(void *param);
-void led_callback(TimerHandle_t xTimer);
-
 /****************************************************
  *  Variables                                       *
  ****************************************************/
@@ -50,4 +43,13 @@ typedef enum {
 	sNone
 } led_state_t;
 
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void led_task(void *param);
+void led_callback(TimerHandle_t xTimer);
+void led_set_effect(led_effect_t effect);
+led_effect_t led_get_effect(void);
+
 #endif /* LEDMANAGER_H_ */
@@ -30,6 +30,41 @@
 #define ENCODER_B_GPIO_Port			GPIOE
 #define ENCODER_B_GPIO_Pin			GPIO_PIN_6
 
+// Encoder acquisition
+#define ENCODER_BACKEND_EXTI		0 // Decode A/B edges in software from the EXTI interrupts (A = PE4, B = PE6)
+#define ENCODER_BACKEND_TIMER		1 // Decode A/B in hardware with TIM2 in encoder interface mode (A = PA15, B = PA1)
+#define ENCODER_BACKEND				ENCODER_BACKEND_TIMER
+#define ENCODER_TIMER_INPUT_FILTER	6 // Digital filter applied to both TIM2 encoder inputs (0 - 15)
+
+// Control loop rate
+#ifndef CONTROL_LOOP_RATE_HZ
+#define CONTROL_LOOP_RATE_HZ		100 // TIM7 control loop rate, set to 1000 or 2000 for tighter regulation
+#endif
+#define CONTROL_TIMER_COUNT_HZ		100000 // TIM7 counter clock, must divide the APB1 timer clock and be a multiple of the loop rate
+#define CONTROL_LOOP_DT				( 1.0f / CONTROL_LOOP_RATE_HZ ) // Control loop period in seconds
+#define SPEED_WINDOW_MS				10 // Window the speed is estimated over, must be a whole number of loop periods
+#define SPEED_WINDOW_PERIODS		( CONTROL_LOOP_RATE_HZ * SPEED_WINDOW_MS / 1000 )
+#define SPEED_RPM_PER_COUNT			( 60000.0f / ((float)ENCODER_COUNTS_PER_REV * ENCODER_QUADRATURE * SPEED_WINDOW_MS) )
+
+// Motor PWM
+#define PWM_FREQUENCY_HZ			500 // TIM3 PWM frequency driving the H-bridge
+#define PWM_TIMER_COUNT_HZ			500000 // TIM3 counter clock, must divide the APB1 timer clock; sets the duty cycle resolution
+
+// Control law arithmetic
+#define MOTOR_MATH_FLOAT			0 // Single precision float on the FPU
+#define MOTOR_MATH_Q15				1 // 16-bit fixed point with saturation
+#define MOTOR_MATH_Q31				2 // 32-bit fixed point with saturation
+#ifndef MOTOR_MATH
+#define MOTOR_MATH					MOTOR_MATH_FLOAT // The host benchmark builds set it on the command line
+#endif
+#define MOTOR_SPEED_FULL_SCALE		512.0f // Speed in RPM represented by 1.0 in fixed point, must exceed MAX_MOTOR_SPEED
+#define PID_INITIAL_DUTY_CYCLE		50.0f // Duty cycle (%) the PID controller starts from after a reset
+#define PID_GAIN_SHIFT				8 // Fixed-point gains are stored divided by 2^PID_GAIN_SHIFT for headroom
+
+// Control loop timing
+#define CONTROL_HIST_BINS			8 // Latency and jitter histogram bins, the last bin collects everything above it
+#define CONTROL_HIST_BIN_WIDTH_US	10 // Width of each histogram bin in microseconds
+
 // sMotorMenu
 #define MOTOR_INACTIVE				0
 #define MOTOR_ACTIVE				1
@@ -37,8 +72,17 @@
 #define MOTOR_INVALID_INPUT			3
 
 // Parameter initialization
-#define MIN_SPEED_INITIALIZATION	1000
-#define MAX_SPEED_INITIALIZATION	0
 #define MAX_MOTOR_SPEED				275
 
+// Telemetry
+#define MOTOR_TELEMETRY				1 // 1 to stream a binary frame per control cycle over SEGGER RTT, 0 to disable
+#define TELEMETRY_RTT_BUFFER_SIZE	2048 // RTT up buffer for telemetry frames, frames that do not fit are dropped
+#define TELEMETRY_SYNC_0			0xA5 // First frame sync byte
+#define TELEMETRY_SYNC_1			0x5A // Second frame sync byte
+
+// Speed statistics
+#define SPEED_STATS_PERCENTILES		1 // 1 to also report the median and 95th percentile speed, 0 to save the histogram RAM
+#define SPEED_STATS_BIN_RPM			2.0f // Percentile histogram bin width, which sets the percentile resolution
+#define SPEED_STATS_BINS			256 // Percentile histogram bins, covering 0 to SPEED_STATS_BINS * SPEED_STATS_BIN_RPM
+
 #endif /* CONFIG_MOTORMANAGER_H_ */
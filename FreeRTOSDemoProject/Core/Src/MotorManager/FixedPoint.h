@@ -0,0 +1,96 @@
+
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MotorManager ]                                                          |
+| FILE:       FixedPoint.h                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `FixedPoint` layer provides the Q15 / Q31 arithmetic used by the motor speed   |
+|    estimator and PID controller when `MOTOR_MATH` selects a fixed-point format. The   |
+|    same `Q_*` macros expand to 16-bit or 32-bit types, so the control law is written  |
+|    once for both formats. All additions and products saturate instead of wrapping.    |
+\*=====================================================================================*/
+
+#ifndef FIXEDPOINT_H_
+#define FIXEDPOINT_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_MotorManager.h"
+#include <stdint.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#if (MOTOR_MATH == MOTOR_MATH_Q15)
+
+typedef int16_t q_t;			// Q15 value, range [-1, 1)
+typedef int32_t q_acc_t;		// Accumulator wide enough for a Q15 x Q15 product
+#define Q_FRAC_BITS				15
+#define Q_MAX					INT16_MAX
+#define Q_MIN					INT16_MIN
+
+#elif (MOTOR_MATH == MOTOR_MATH_Q31)
+
+typedef int32_t q_t;			// Q31 value, range [-1, 1)
+typedef int64_t q_acc_t;		// Accumulator wide enough for a Q31 x Q31 product
+#define Q_FRAC_BITS				31
+#define Q_MAX					INT32_MAX
+#define Q_MIN					INT32_MIN
+
+#endif
+
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+
+#define Q_ONE					( (q_acc_t)1 << Q_FRAC_BITS )
+#define Q_SAT(x)				q_sat((q_acc_t)(x))
+#define Q_FROM_FLOAT(f)			Q_SAT( (f) * (float)Q_ONE )
+#define Q_TO_FLOAT(q)			( (float)(q) / (float)Q_ONE )
+#define Q_ADD(a, b)				Q_SAT( (q_acc_t)(a) + (q_acc_t)(b) )
+#define Q_SUB(a, b)				Q_SAT( (q_acc_t)(a) - (q_acc_t)(b) )
+
+// Gains and time steps are Q31 in both formats, so Q15 builds keep their precision
+#define Q31_ONE					( (int64_t)1 << 31 )
+#define Q31_FROM_FLOAT(f)		q31_from_float(f)
+// Product of a Q31 value and a Q value, shifted left by `shift` bits, in the Q format without saturating
+#define Q31_MUL_SHL(c, q, shift)	( ((int64_t)(c) * (int64_t)(q)) >> (31 - (shift)) )
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Saturates an accumulator value to the range of the selected Q format.                        *
+ *                                                                                                     *
+ * @param x [q_acc_t] Value in the accumulator format.                                                 *
+ * @return q_t Value clamped to [`Q_MIN`, `Q_MAX`].                                                    *
+ ******************************************************************************************************/
+
+static inline q_t q_sat(q_acc_t x)
+{
+	if(x > Q_MAX) return Q_MAX;
+	if(x < Q_MIN) return Q_MIN;
+	return (q_t)x;
+}
+
+/*******************************************************************************************************
+ * @brief Converts a float to Q31, saturating.                                                         *
+ *                                                                                                     *
+ * @param f [float] Value to convert.                                                                  *
+ * @return int32_t Value in Q31, clamped to [`INT32_MIN`, `INT32_MAX`].                                *
+ ******************************************************************************************************/
+
+static inline int32_t q31_from_float(float f)
+{
+	if(f >= 1.0f) return INT32_MAX;
+	if(f < -1.0f) return INT32_MIN;
+	return (int32_t)(f * (float)Q31_ONE);
+}
+
+#endif
+
+#endif /* FIXEDPOINT_H_ */
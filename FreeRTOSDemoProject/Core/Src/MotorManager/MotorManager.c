@@ -17,15 +17,55 @@
  ****************************************************/
 
 #include "Config_MotorManager.h"
+#include "Config_UartManager.h"
 #include "MotorManager.h"
+#include "FixedPoint.h"
+#include "RunningStats.h"
+#include "Telemetry.h"
+#include "ClockManager.h"
+#include "Command.h"
 #include "FreeRTOS.h"
+#include "task.h"
 #include "main.h"
 #include <string.h>
 #include <stdio.h>
+#include <inttypes.h>
 #include <math.h>
 #include <stdlib.h>
 #include <ctype.h>
 
+#if (SPEED_WINDOW_PERIODS < 1) || ((CONTROL_LOOP_RATE_HZ * SPEED_WINDOW_MS) % 1000 != 0)
+#error "SPEED_WINDOW_MS must be a whole number of control loop periods"
+#endif
+#if (CONTROL_TIMER_COUNT_HZ % CONTROL_LOOP_RATE_HZ != 0)
+#error "CONTROL_TIMER_COUNT_HZ must be a multiple of CONTROL_LOOP_RATE_HZ"
+#endif
+#if (PWM_TIMER_COUNT_HZ % PWM_FREQUENCY_HZ != 0)
+#error "PWM_TIMER_COUNT_HZ must be a multiple of PWM_FREQUENCY_HZ"
+#endif
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Encoder sample captured by the TIM7 interrupt
+typedef struct
+{
+	uint32_t timestamp;			// DWT cycle counter at the time of capture
+	int32_t encoder_count;		// Encoder position at the time of capture
+} control_sample_t;
+
+// Control loop timing statistics
+typedef struct
+{
+	uint32_t cycles;							// Control law executions
+	uint32_t overruns;							// Releases missed because the previous cycle was still pending
+	uint32_t max_latency_us;					// Worst case interrupt to task latency
+	uint32_t max_jitter_us;						// Worst case deviation from the nominal period
+	uint32_t latency_hist[CONTROL_HIST_BINS];	// Interrupt to task latency histogram
+	uint32_t jitter_hist[CONTROL_HIST_BINS];	// Period jitter histogram
+} control_timing_t;
+
 /****************************************************
  *  Function prototypes                             *
  ****************************************************/
@@ -34,12 +74,29 @@ void print_motor_speed(void);
 void initialize_parameters(void);
 void print_motor_on_report(void);
 void print_summary_report(void);
-void calculate_average(float data[], int len);
-void calculate_sd(float data[], int len);
+void print_control_timing_report(void);
+static void control_hist_add(uint32_t *hist, uint32_t *max, uint32_t cycles);
+static uint32_t control_period_cycles(void);
 void split_float_into_ints(int *int_val, int *dec_val, float float_val, int dec_places);
 void set_pwm_duty_cycle(TIM_HandleTypeDef *htim, uint32_t channel, uint8_t duty_cycle_percent);
 float pid_controller(float setpoint, float measured_value);
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+static q_t speed_estimate_q(int32_t delta_count);
+static q_t pid_controller_q(q_t setpoint, q_t measured_value);
+#endif
 int isNumeric(const char *str);
+static void motor_cmd_start(const char *args);
+static void motor_cmd_stop(const char *args);
+static void motor_cmd_algo(const char *args);
+static void motor_cmd_param(const char *args);
+static void motor_cmd_rec(const char *args);
+static void motor_cmd_speed(const char *args);
+static void motor_cmd_loop(const char *args);
+static void motor_cmd_main(const char *args);
+static void motor_algo_none(const char *args);
+static void motor_algo_pid(const char *args);
+static void motor_select_algo(const char *text);
+static void motor_set_speed(const char *text);
 int parse_param_string(message_t *msg);
 
 /****************************************************
@@ -56,10 +113,11 @@ const char *msg_motor_menu = "\n======================================\n"
 						       "======================================\n\n"
 							   " Start ---> Start the motor\n"
 							   " Stop  ---> Stop the motor\n"
-		 	 	 	 	 	   " Algo  ---> Change motion control algorithm\n"
+		 	 	 	 	 	   " Algo  ---> Change motion control algorithm (or Algo N)\n"
 							   " Param ---> Change algorithm parameter\n"
 							   " Rec   ---> Start motor speed reporting\n"
-							   " Speed ---> Change target speed\n"
+							   " Speed ---> Change target speed (or Speed RPM)\n"
+							   " Loop  ---> Show control loop timing\n"
 							   " Main  ---> Return to main menu\n\n"
 							   " Enter your selection here: ";
 
@@ -90,35 +148,80 @@ const char *msg_motor_on_header = "\n************************************\n"
 									"*                                  *\n";
 const char *msg_motor_on_footer =   "*                                  *\n"
 									"************************************\n";
+const char *msg_loop_header = "\n************************************\n"
+							  "*       CONTROL LOOP TIMING        *\n"
+							  "*                                  *\n";
+const char *msg_loop_footer = "*                                  *\n"
+							  "************************************\n";
 
 /****************************************************
  *  Variables                                       *
  ****************************************************/
 
-volatile int32_t encoder_count = 0;
-volatile float motor_speed = 0.0f; // Global variable to store speed
-volatile uint8_t last_a = 0, last_b = 0;
+CCM_DATA volatile int32_t encoder_count = 0;
+CCM_DATA volatile float motor_speed = 0.0f; // Global variable to store speed
+CCM_DATA volatile uint8_t last_a = 0, last_b = 0;
 static int curr_motor_state = MOTOR_INACTIVE;
 static int report_counter = 0;
+static float report_speed = 0.0f; // Speed sampled by the last expiry of the motor report timer
 
 // Summary statistics
-static float min_speed = MIN_SPEED_INITIALIZATION;
-static float max_speed = MAX_SPEED_INITIALIZATION;
-static int duration = 0;
-static float average = 0.0;
-float standard_dev = 0.0;
-float speed_values[1000] = {0};
-
-// PID parameters
-static float Kp = 0.5;
-static float Ki = 0.000;
-static float Kd = 0.000;
-static float duty_cycle = 50.0f; // Initial duty cycle (in percentage)
-static volatile float target_speed = 225.0; // Desired motor speed in RPM
-static float integral = 0.0;
-static float last_error = 0.0;
-static float dt = 0.01; // Time step in seconds (adjust as needed)
-static volatile motor_algo_t motor_algo = 1; // 0 for no algorithm, 1 for PID
+static running_stats_t speed_stats;
+#if (SPEED_STATS_PERCENTILES)
+static uint32_t speed_hist_bins[SPEED_STATS_BINS];
+static quantile_sketch_t speed_hist;
+#endif
+
+// PID parameters and state, read every control cycle, in CCM RAM
+static CCM_DATA float Kp = 0.5;
+static CCM_DATA float Ki = 0.000;
+static CCM_DATA float Kd = 0.000;
+static CCM_DATA float duty_cycle = PID_INITIAL_DUTY_CYCLE; // Duty cycle (in percentage)
+static CCM_DATA volatile float target_speed = 225.0; // Desired motor speed in RPM
+static CCM_DATA float integral = 0.0;
+static CCM_DATA float last_error = 0.0;
+static CCM_DATA float dt = CONTROL_LOOP_DT; // Time step in seconds, derived from the control loop rate
+static CCM_DATA volatile motor_algo_t motor_algo = 1; // 0 for no algorithm, 1 for PID
+
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+// Fixed-point PID parameters and state, see pid_update_params
+static CCM_BSS volatile q_t target_speed_q;
+static CCM_BSS volatile int32_t Kp_q31, Ki_q31, Kd_q31, dt_q31;
+static CCM_BSS q_t duty_cycle_q;
+static CCM_DATA int64_t integral_q31 = 0; // Sum of the error * dt products, with 31 more fraction bits than q_t
+static CCM_DATA q_t last_error_q = 0;
+
+// Encoder counts per period to normalized speed, in Q31 so Q15 builds keep the precision of the constant
+static const int32_t speed_scale_q31 = (int32_t)( (double)SPEED_RPM_PER_COUNT / MOTOR_SPEED_FULL_SCALE * 2147483648.0 );
+#endif
+
+// Speed window, the encoder positions of the last SPEED_WINDOW_PERIODS control cycles
+static CCM_BSS int32_t count_history[SPEED_WINDOW_PERIODS];
+static CCM_DATA uint32_t history_index = 0;
+
+// Control loop timing
+static CCM_BSS volatile control_sample_t control_sample;
+static CCM_BSS control_timing_t control_timing;
+
+// Motor menu commands
+static const command_t motor_commands[] = {
+	{ "Start",	motor_cmd_start,	0 },
+	{ "Stop",	motor_cmd_stop,		0 },
+	{ "Algo",	motor_cmd_algo,		1 },
+	{ "Param",	motor_cmd_param,	0 },
+	{ "Rec",	motor_cmd_rec,		0 },
+	{ "Speed",	motor_cmd_speed,	1 },
+	{ "Loop",	motor_cmd_loop,		0 },
+	{ "Main",	motor_cmd_main,		0 },
+};
+static command_table_t motor_command_table = COMMAND_TABLE(motor_commands);
+
+// Algorithm selection
+static const command_t motor_algos[] = {
+	{ "0",		motor_algo_none,	0 },	// None
+	{ "1",		motor_algo_pid,		0 },	// PID control
+};
+static command_table_t motor_algo_table = COMMAND_TABLE(motor_algos);
 
 /****************************************************
  *  Public functions                                *
@@ -140,9 +243,18 @@ static volatile motor_algo_t motor_algo = 1; // 0 for no algorithm, 1 for PID
 
 void motor_task(void *param)
 {
-	uint32_t msg_addr;
 	message_t *msg;
 
+	// Build the hash index of the command tables
+	int status = command_table_init(&motor_command_table);
+	status |= command_table_init(&motor_algo_table);
+	configASSERT(0 == status);
+
+#if (SPEED_STATS_PERCENTILES)
+	// Attach the bins to the percentile histogram before the first recording
+	quantile_sketch_init(&speed_hist, speed_hist_bins, SPEED_STATS_BINS, SPEED_STATS_BIN_RPM);
+#endif
+
 	while(1) {
 		// Wait for notification from another task
 		xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
@@ -151,80 +263,19 @@ void motor_task(void *param)
 
 			case sMotorMenu:
 				// Display motor manager menu for the user
-				xQueueSend(q_print, &msg_motor_menu, portMAX_DELAY);
+				print_interactive(msg_motor_menu);
 
 				// Wait for the user to make a selection
-				xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-				msg = (message_t*)msg_addr;
+				msg = uart_wait_message();
 
 				// Process command
-				if(msg->len <= 5) {
-					if(!strcmp((char*)msg->payload, "Start")) {
-						// Set the motor state
-						curr_motor_state = MOTOR_ACTIVE;
-						// Configure the H-bridge for forward rotation
-						HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin, GPIO_PIN_SET);
-						HAL_GPIO_WritePin(MOTOR_IN2_GPIO_Port, MOTOR_IN2_Pin, GPIO_PIN_RESET);
-					}
-					else if(!strcmp((char*)msg->payload, "Stop")) {
-						// Set the motor state
-						curr_motor_state = MOTOR_INACTIVE;
-						// Pull both IN1 and IN2 low to stop current flow to the motor
-						HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin|MOTOR_IN2_Pin, GPIO_PIN_RESET);
-					}
-					else if(!strcmp((char*)msg->payload, "Algo")) {
-						// Update the system state
-						curr_sys_state = sMotorAlgo;
-						// Prompt user for algorithm selection
-						xQueueSend(q_print, &msg_motor_algo, portMAX_DELAY);
-					}
-					else if(!strcmp((char*)msg->payload, "Param")) {
-						// Update the system state
-						curr_sys_state = sMotorParam;
-						// Prompt user for algorithm selection
-						xQueueSend(q_print, &msg_motor_param, portMAX_DELAY);
-					}
-					else if(!strcmp((char*)msg->payload, "Rec")) {
-						// Set the motor state
-						curr_motor_state = MOTOR_SPEED_REPORTING;
-						// Display parameters
-						print_motor_on_report();
-						// Notify user of reporting
-						xQueueSend(q_print, &msg_speed_report, portMAX_DELAY);
-						// Initialize report time counter
-						report_counter = 1;
-						// Start the motor report timer
-						xTimerStart(motor_report_timer, portMAX_DELAY);
-					}
-					else if(!strcmp((char*)msg->payload, "Speed")) {
-						// Update the system state
-						curr_sys_state = sMotorSpeed;
-						// Prompt user for new speed
-						xQueueSend(q_print, &msg_motor_speed, portMAX_DELAY);
-					}
-					else if (!strcmp((char*)msg->payload, "Main")) {
-						// Update the system state
-						curr_sys_state = sMainMenu;
-
-						// Notify the main menu task
-						xTaskNotify(handle_main_menu_task, 0, eNoAction);
-					}
-					else {
-						// Update the system state
-						curr_sys_state = sMotorMenu;
-						curr_motor_state = MOTOR_INVALID_INPUT;
-
-						// Notify user of invalid input
-						xQueueSend(q_print, &msg_inv_motor, portMAX_DELAY);
-					}
-				}
-				else {
+				if(!command_dispatch(&motor_command_table, (char*)msg->payload)) {
 					// Update the system state
 					curr_sys_state = sMotorMenu;
 					curr_motor_state = MOTOR_INVALID_INPUT;
 
-					// If user input is longer than 5 characters, notify user of invalid response
-					xQueueSend(q_print, &msg_inv_motor, portMAX_DELAY);
+					// Notify user of invalid input
+					print_error(msg_inv_motor);
 				}
 
 				// Notify self / motor task if not returning to the main menu
@@ -232,7 +283,7 @@ void motor_task(void *param)
 					// Check if speed reporting is active
 					if(MOTOR_SPEED_REPORTING == curr_motor_state) {
 						// Wait for cancellation from the user before allowing next user input
-						xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
+						uart_wait_message();
 						// Stop the motor report timer
 						xTimerStop(motor_report_timer, portMAX_DELAY);
 						// Report statistics and reset parameters
@@ -247,29 +298,11 @@ void motor_task(void *param)
 				break;
 			case sMotorAlgo:
 				// Wait for the user to make a selection
-				xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-				msg = (message_t*)msg_addr;
+				msg = uart_wait_message();
 
 				// Process command
-				if(msg->len <= 1) {
-					if(!strcmp((char*)msg->payload, "0")) { 					// None
-						// Disable all algorithms control
-						motor_algo = 0;
-						xQueueSend(q_print, &msg_valid_algo, portMAX_DELAY);
-					}
-					else if(!strcmp((char*)msg->payload, "1")) { 				// PID control
-						// Enable PID control
-						motor_algo = 1;
-						xQueueSend(q_print, &msg_valid_algo, portMAX_DELAY);
-					}
-					else {
-						xQueueSend(q_print, &msg_inv_algo, portMAX_DELAY);
-					}
-				}
-				else {
-					// If something longer than 1 digit is entered, this is incorrect
-					xQueueSend(q_print, &msg_inv_algo, portMAX_DELAY);
-				}
+				motor_select_algo((char*)msg->payload);
+
 				// Update system state
 				curr_sys_state = sMotorMenu;
 				// Send control back to motor task main menu
@@ -277,16 +310,16 @@ void motor_task(void *param)
 				break;
 			case sMotorParam:
 				// Wait for the user to make a selection
-				xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-				msg = (message_t*)msg_addr;
+				msg = uart_wait_message();
 
 				// Process command
 				if(parse_param_string(msg)) {
-					xQueueSend(q_print, &msg_valid_param, portMAX_DELAY);
+					pid_update_params();
+					print_interactive(msg_valid_param);
 				}
 				else {
 					// If invalid entry, notify the user
-					xQueueSend(q_print, &msg_inv_param, portMAX_DELAY);
+					print_error(msg_inv_param);
 				}
 				// Update system state
 				curr_sys_state = sMotorMenu;
@@ -295,38 +328,11 @@ void motor_task(void *param)
 				break;
 			case sMotorSpeed:
 				// Wait for the user to make a selection
-				xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-				msg = (message_t*)msg_addr;
+				msg = uart_wait_message();
 
 				// Process command
-				if(msg->len <= 6) {
-					if(isNumeric((char*)msg->payload)) {
-						// Convert speed from string to int
-						target_speed = strtof((char*)msg->payload, NULL);
-						if(target_speed > MAX_MOTOR_SPEED) {
-							// Set motor speed to configured threshold
-							target_speed = MAX_MOTOR_SPEED;
-							// Notify user that selection exceeds maximum RPM threshold
-							xQueueSend(q_print, &msg_motor_speed_max, portMAX_DELAY);
-							// Notify user of current threshold
-							static char maxspeed[40];
-							static char *max_speed = maxspeed;
-							// Display speed in RPM
-							sprintf((char*)max_speed, " Motor speed set to: %03d RPM\n", (int)MAX_MOTOR_SPEED);
-							xQueueSend(q_print, &max_speed, portMAX_DELAY);
-						}
-						else {
-							xQueueSend(q_print, &msg_valid_speed, portMAX_DELAY);
-						}
-					}
-					else {
-						xQueueSend(q_print, &msg_inv_speed, portMAX_DELAY);
-					}
-				}
-				else {
-					// If something longer than 6 digits is entered, this is incorrect
-					xQueueSend(q_print, &msg_inv_speed, portMAX_DELAY);
-				}
+				motor_set_speed((char*)msg->payload);
+
 				// Update system state
 				curr_sys_state = sMotorMenu;
 				// Send control back to motor task main menu
@@ -338,18 +344,315 @@ void motor_task(void *param)
 	}
 }
 
+/*******************************************************************************************************
+ * @brief Task to run the motor speed control law.                                                     *
+ *                                                                                                     *
+ * This FreeRTOS task runs at the highest application priority and is released by the TIM7 interrupt   *
+ * through a direct-to-task notification. Each cycle it reads the encoder sample captured by the       *
+ * interrupt, calculates the motor speed, runs the PID controller and updates the PWM duty cycle. It   *
+ * also records the release latency (interrupt to task) and the period jitter of every cycle.          *
+ *                                                                                                     *
+ * @param param [void*] Parameter passed during task creation (not used in this task).                 *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note TIM7 sets the loop period in hardware, so the task never drifts with the RTOS tick.           *
+ * @note If the task is released more than once before it runs, the extra releases are counted as      *
+ *       overruns.                                                                                     *
+ ******************************************************************************************************/
+
+RAM_FUNC void motor_control_task(void *param)
+{
+	uint32_t last_release = 0;
+	uint8_t first_cycle = 1;
+	control_sample_t sample;
+
+	// Nominal control loop period for the jitter measurement
+	uint32_t period_cycles = control_period_cycles();
+
+#if (MOTOR_TELEMETRY)
+	// Open the RTT channel for the per-cycle telemetry frames
+	telemetry_init();
+#endif
+
+	// Start the speed window from the current encoder position, and load the fixed-point parameters
+	motor_control_reset(read_encoder_count());
+
+	while(1) {
+		// Wait for the TIM7 interrupt to capture the next sample
+		uint32_t releases = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		uint32_t release = DWT->CYCCNT;
+
+		// Copy the sample so the next interrupt cannot change it mid-read
+		taskENTER_CRITICAL();
+		sample = control_sample;
+		taskEXIT_CRITICAL();
+
+		// Speed estimate, PID control and PWM update
+		float new_duty_cycle = motor_control_step(sample.encoder_count);
+#if (MOTOR_TELEMETRY)
+		telemetry_send(sample.timestamp, sample.encoder_count, motor_speed, target_speed - motor_speed, new_duty_cycle);
+#else
+		(void)new_duty_cycle;
+#endif
+
+		// Record latency from the interrupt, and jitter against the nominal period
+		taskENTER_CRITICAL();
+		control_timing.cycles++;
+		control_timing.overruns += releases - 1;
+		control_hist_add(control_timing.latency_hist, &control_timing.max_latency_us, release - sample.timestamp);
+		if(!first_cycle && releases == 1) {
+			uint32_t period = release - last_release;
+			uint32_t jitter = (period > period_cycles) ? (period - period_cycles) : (period_cycles - period);
+			control_hist_add(control_timing.jitter_hist, &control_timing.max_jitter_us, jitter);
+		}
+		taskEXIT_CRITICAL();
+
+		last_release = release;
+		first_cycle = 0;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Runs one cycle of the motor speed control law.                                               *
+ *                                                                                                     *
+ * This function estimates the motor speed from the encoder counts over the speed window, runs the PID *
+ * controller selected by `MOTOR_MATH` and updates the TIM3 PWM duty cycle. It holds no RTOS objects,  *
+ * so the host benchmark can drive it directly against the motor plant model.                          *
+ *                                                                                                     *
+ * @param encoder_count [int32_t] Encoder position captured at the start of the cycle.                 *
+ * @return float New duty cycle percentage (0-100).                                                    *
+ *                                                                                                     *
+ * @note Must be called once per control loop period, after `motor_control_reset`.                     *
+ ******************************************************************************************************/
+
+RAM_FUNC float motor_control_step(int32_t encoder_count)
+{
+	// Encoder counts over the speed window, replacing the oldest sample in the history
+	int32_t delta_count = encoder_count - count_history[history_index];
+	count_history[history_index] = encoder_count;
+	history_index = (history_index + 1) % SPEED_WINDOW_PERIODS;
+
+#if (MOTOR_MATH == MOTOR_MATH_FLOAT)
+	// Calculate motor speed in RPM
+	motor_speed = delta_count * SPEED_RPM_PER_COUNT;
+
+	// PID control
+	float new_duty_cycle = pid_controller(target_speed, motor_speed);
+	set_pwm_duty_cycle(&htim3, TIM_CHANNEL_1, (uint8_t)new_duty_cycle);
+
+	return new_duty_cycle;
+#else
+	// Calculate normalized motor speed, and keep the RPM value for reporting only
+	q_t speed_q = speed_estimate_q(delta_count);
+	motor_speed = Q_TO_FLOAT(speed_q) * MOTOR_SPEED_FULL_SCALE;
+
+	// PID control, converting the normalized duty cycle to a rounded percentage
+	q_t new_duty_cycle_q = pid_controller_q(target_speed_q, speed_q);
+	set_pwm_duty_cycle(&htim3, TIM_CHANNEL_1, (uint8_t)(((q_acc_t)new_duty_cycle_q * 100 + (Q_ONE >> 1)) >> Q_FRAC_BITS));
+
+	return Q_TO_FLOAT(new_duty_cycle_q) * 100.0f;
+#endif
+}
+
+/*******************************************************************************************************
+ * @brief Resets the motor speed control law.                                                          *
+ *                                                                                                     *
+ * This function fills the speed window with the given encoder position, clears the PID integral and   *
+ * derivative state, restarts from `PID_INITIAL_DUTY_CYCLE` and loads the fixed-point parameters.      *
+ *                                                                                                     *
+ * @param encoder_count [int32_t] Current encoder position.                                            *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must not run concurrently with `motor_control_step`.                                          *
+ ******************************************************************************************************/
+
+void motor_control_reset(int32_t encoder_count)
+{
+	for(int i = 0; i < SPEED_WINDOW_PERIODS; i++) {
+		count_history[i] = encoder_count;
+	}
+	history_index = 0;
+
+	duty_cycle = PID_INITIAL_DUTY_CYCLE;
+	integral = 0.0f;
+	last_error = 0.0f;
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+	duty_cycle_q = Q_FROM_FLOAT(PID_INITIAL_DUTY_CYCLE / 100.0f);
+	integral_q31 = 0;
+	last_error_q = 0;
+#endif
+
+	pid_update_params();
+}
+
+/*******************************************************************************************************
+ * @brief Times one run of the motor speed control law.                                                *
+ *                                                                                                     *
+ * This function runs `motor_control_step` on the current encoder position and returns its duration.   *
+ * The speed window, the PID state and the TIM3 compare value are saved before and restored after the  *
+ * run, so the control loop carries on as if the step had not been taken.                              *
+ *                                                                                                     *
+ * @return uint32_t Duration of the control step in CPU cycles.                                        *
+ *                                                                                                     *
+ * @note Runs in a critical section, so the control task cannot step the control law meanwhile.        *
+ ******************************************************************************************************/
+
+uint32_t motor_control_step_cycles(void)
+{
+	int32_t saved_history[SPEED_WINDOW_PERIODS];
+
+	taskENTER_CRITICAL();
+	memcpy(saved_history, count_history, sizeof(saved_history));
+	uint32_t saved_index = history_index;
+	float saved_speed = motor_speed;
+	float saved_duty_cycle = duty_cycle;
+	float saved_integral = integral;
+	float saved_last_error = last_error;
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+	q_t saved_duty_cycle_q = duty_cycle_q;
+	int64_t saved_integral_q31 = integral_q31;
+	q_t saved_last_error_q = last_error_q;
+#endif
+	uint32_t saved_compare = __HAL_TIM_GET_COMPARE(&htim3, TIM_CHANNEL_1);
+
+	int32_t count = read_encoder_count();
+	uint32_t start = DWT->CYCCNT;
+	(void)motor_control_step(count);
+	uint32_t cycles = DWT->CYCCNT - start;
+
+	memcpy(count_history, saved_history, sizeof(count_history));
+	history_index = saved_index;
+	motor_speed = saved_speed;
+	duty_cycle = saved_duty_cycle;
+	integral = saved_integral;
+	last_error = saved_last_error;
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+	duty_cycle_q = saved_duty_cycle_q;
+	integral_q31 = saved_integral_q31;
+	last_error_q = saved_last_error_q;
+#endif
+	__HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, saved_compare);
+	taskEXIT_CRITICAL();
+
+	return cycles;
+}
+
+/*******************************************************************************************************
+ * @brief Sets the TIM7 control loop period from `CONTROL_LOOP_RATE_HZ`.                               *
+ *                                                                                                     *
+ * This function overrides the prescaler and period generated by CubeMX. The prescaler brings the      *
+ * APB1 timer clock down to `CONTROL_TIMER_COUNT_HZ`, and the period divides that down to the loop     *
+ * rate. Because the values are derived from the clock tree at run time, the loop rate does not        *
+ * depend on the system clock configuration.                                                           *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called after `MX_TIM7_Init` and before the TIM7 interrupt is started.                 *
+ ******************************************************************************************************/
+
+void control_timer_init(void)
+{
+	uint32_t timer_clock = clock_apb1_timer_hz();
+
+	// The counter clock must be an exact division of the timer clock
+	configASSERT((timer_clock % CONTROL_TIMER_COUNT_HZ) == 0);
+
+	htim7.Init.Prescaler = (timer_clock / CONTROL_TIMER_COUNT_HZ) - 1;
+	htim7.Init.Period = (CONTROL_TIMER_COUNT_HZ / CONTROL_LOOP_RATE_HZ) - 1;
+	if (HAL_TIM_Base_Init(&htim7) != HAL_OK) {
+		Error_Handler();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sets the TIM3 PWM frequency from `PWM_FREQUENCY_HZ`.                                         *
+ *                                                                                                     *
+ * This function overrides the prescaler and period generated by CubeMX, as `control_timer_init` does  *
+ * for TIM7. The prescaler brings the APB1 timer clock down to `PWM_TIMER_COUNT_HZ`, and the period    *
+ * divides that down to the PWM frequency, so the frequency and the duty cycle resolution do not       *
+ * depend on the clock profile. The channel configuration is left as generated.                        *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called after `MX_TIM3_Init` and before the PWM output is started.                     *
+ ******************************************************************************************************/
+
+void motor_pwm_timer_init(void)
+{
+	uint32_t timer_clock = clock_apb1_timer_hz();
+
+	// The counter clock must be an exact division of the timer clock
+	configASSERT((timer_clock % PWM_TIMER_COUNT_HZ) == 0);
+
+	htim3.Init.Prescaler = (timer_clock / PWM_TIMER_COUNT_HZ) - 1;
+	htim3.Init.Period = (PWM_TIMER_COUNT_HZ / PWM_FREQUENCY_HZ) - 1;
+	if (HAL_TIM_PWM_Init(&htim3) != HAL_OK) {
+		Error_Handler();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Initializes the encoder acquisition backend.                                                 *
+ *                                                                                                     *
+ * With `ENCODER_BACKEND_TIMER`, TIM2 is configured in encoder interface mode (TI1 and TI2, both edges *
+ * of both channels) and started. The timer counts the quadrature signal in hardware, so the EXTI edge *
+ * interrupts for the encoder pins are disabled. With `ENCODER_BACKEND_EXTI`, the EXTI interrupts      *
+ * configured in `MX_GPIO_Init` are left enabled and `motor_gpio_callback` decodes the edges.          *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called from `main` after the GPIO initialization and before the TIM7 control loop     *
+ *       timer is started.                                                                             *
+ ******************************************************************************************************/
+
+void encoder_init(void)
+{
+#if (ENCODER_BACKEND == ENCODER_BACKEND_TIMER)
+	TIM_Encoder_InitTypeDef sConfig = {0};
+
+	// Quadrature is decoded by the timer, keep the encoder edge interrupts off
+	HAL_NVIC_DisableIRQ(ENCODER_A_EXTI_IRQn);
+	HAL_NVIC_DisableIRQ(ENCODER_B_EXTI_IRQn);
+
+	// Count both edges of both channels over the full 32-bit range
+	htim2.Instance = TIM2;
+	htim2.Init.Prescaler = 0;
+	htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+	htim2.Init.Period = 0xFFFFFFFF;
+	htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+	sConfig.EncoderMode = TIM_ENCODERMODE_TI12;
+	sConfig.IC1Polarity = TIM_ICPOLARITY_RISING;
+	sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+	sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
+	sConfig.IC1Filter = ENCODER_TIMER_INPUT_FILTER;
+	sConfig.IC2Polarity = TIM_ICPOLARITY_RISING;
+	sConfig.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+	sConfig.IC2Prescaler = TIM_ICPSC_DIV1;
+	sConfig.IC2Filter = ENCODER_TIMER_INPUT_FILTER;
+	if (HAL_TIM_Encoder_Init(&htim2, &sConfig) != HAL_OK) {
+		Error_Handler();
+	}
+
+	HAL_TIM_Encoder_Start(&htim2, TIM_CHANNEL_ALL);
+#endif
+}
+
 /*******************************************************************************************************
  * @brief Callback for motor GPIO interrupt.														   *
  * 																									   *
  * This function handles the GPIO interrupt for motor encoders. It reads the encoder pins and updates  *
  * the encoder count based on the state changes. This is used to keep track of the motor's speed.	   *
  * 																									   *
+ * @note Only used with `ENCODER_BACKEND_EXTI`. With the timer backend the encoder interrupts are off. *
+ * 																									   *
  * @param GPIO_Pin The pin that triggered the interrupt.											   *
  * @return void																						   *
  ******************************************************************************************************/
 
-void motor_gpio_callback(uint16_t GPIO_Pin)
+RAM_FUNC void motor_gpio_callback(uint16_t GPIO_Pin)
 {
+#if (ENCODER_BACKEND == ENCODER_BACKEND_EXTI)
     uint8_t a = HAL_GPIO_ReadPin(ENCODER_A_GPIO_Port, ENCODER_A_GPIO_Pin);
     uint8_t b = HAL_GPIO_ReadPin(ENCODER_B_GPIO_Port, ENCODER_B_GPIO_Pin);
 
@@ -372,62 +675,77 @@ void motor_gpio_callback(uint16_t GPIO_Pin)
             last_b = b;
         }
     }
+#endif
 }
 
 /*******************************************************************************************************
- * @brief Callback for motor timer interrupt.														   *
- * 																									   *
- * This function runs every 10 ms and handles the timer interrupt for motor control. It calculates     *
- * the motor speed based on the encoder count and updates the PWM duty cycle using a PID controller    *
- * to achieve the target speed.																		   *
- * 																									   *
- * @param htim Pointer to the timer handle.															   *
- * @return void																						   *
+ * @brief Callback for motor timer interrupt.                                                          *
+ *                                                                                                     *
+ * This function runs once per TIM7 period. It only captures the encoder count and a DWT cycle         *
+ * timestamp, then notifies the motor control task, which runs the control law outside the interrupt.  *
+ *                                                                                                     *
+ * @param htim Pointer to the timer handle.                                                            *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note TIM7 must be at or below `configMAX_SYSCALL_INTERRUPT_PRIORITY` to use the FreeRTOS API.      *
  ******************************************************************************************************/
 
-void motor_timer_callback(TIM_HandleTypeDef *htim)
+RAM_FUNC void motor_timer_callback(TIM_HandleTypeDef *htim)
 {
     if (htim->Instance == TIM7) {
-		static int32_t last_encoder_count = 0;
-		int32_t delta_count = encoder_count - last_encoder_count;
-
-		// Calculate motor speed in RPM
-		motor_speed = (delta_count / (float)ENCODER_COUNTS_PER_REV) * 6000.0 * (1 / (float)ENCODER_QUADRATURE);
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-		// Update last encoder count for the next period
-		last_encoder_count = encoder_count;
+		// Capture the sample, the control law runs in the motor control task
+		control_sample.timestamp = DWT->CYCCNT;
+		control_sample.encoder_count = read_encoder_count();
 
-		// PID control
-		float new_duty_cycle = pid_controller(target_speed, motor_speed);
-		set_pwm_duty_cycle(&htim3, TIM_CHANNEL_1, (uint8_t)new_duty_cycle);
+		vTaskNotifyGiveFromISR(handle_motor_control_task, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 	}
 }
 
 /*******************************************************************************************************
- * @brief Callback for motor report.																   *
- * 																									   *
- * This function runs every 1 sec to update motor statistics. It checks and updates the minimum and    *
- * maximum motor speeds, adds the current speed to an array for statistical analysis, and prints the   *
- * current motor speed.																				   *
- * 																									   *
- * @return void																						   *
+ * @brief Callback for motor report.                                                                   *
+ *                                                                                                     *
+ * This function runs every 1 sec to update motor statistics. It adds the current speed to the running *
+ * statistics (count, minimum, maximum, mean and variance) and, if enabled, to the percentile          *
+ * histogram. Each update is O(1) in time and memory, so the recording length is not limited. Printing *
+ * waits for print pool blocks and queue space, which must not block the timer service task, so the    *
+ * callback only asks the message handler task to print the speed, see `motor_report_print`.           *
+ *                                                                                                     *
+ * @return void                                                                                        *
  ******************************************************************************************************/
 
 void motor_report_callback(void)
 {
-	// Check for min speed
-	if(motor_speed < min_speed) {
-		min_speed = motor_speed;
-	}
-	// Check for max speed
-	if(motor_speed > max_speed) {
-		max_speed = motor_speed;
-	}
+	float speed = motor_speed;
 
-	// Update time window, add data to array
-	speed_values[duration++] = motor_speed;
+	// Update the running statistics with the latest speed
+	running_stats_add(&speed_stats, speed);
+#if (SPEED_STATS_PERCENTILES)
+	quantile_sketch_add(&speed_hist, speed);
+#endif
+
+	// Have the message handler task print the speed sampled here
+	report_speed = speed;
+	xTaskNotify(handle_message_handler_task, UART_RX_EVT_MOTOR_REPORT, eSetBits);
+}
+
+/*******************************************************************************************************
+ * @brief Prints the motor speed sampled by `motor_report_callback`.                                   *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called by the message handler task. Does nothing if the report was stopped after the timer    *
+ *       expired, so no speed is printed after the summary report.                                     *
+ ******************************************************************************************************/
+
+void motor_report_print(void)
+{
+	if(pdFALSE == xTimerIsTimerActive(motor_report_timer)) {
+		return;
+	}
 
-	// Print current speed
 	print_motor_speed();
 }
 
@@ -435,10 +753,216 @@ void motor_report_callback(void)
  *  Private functions                               *
  ****************************************************/
 
+/*******************************************************************************************************
+ * @brief Motor menu `Start` command: drives the H-bridge for forward rotation.                        *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_start(const char *args)
+{
+	// Set the motor state
+	curr_motor_state = MOTOR_ACTIVE;
+	// Configure the H-bridge for forward rotation
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(MOTOR_IN2_GPIO_Port, MOTOR_IN2_Pin, GPIO_PIN_RESET);
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Stop` command: removes the current from the motor.                               *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_stop(const char *args)
+{
+	// Set the motor state
+	curr_motor_state = MOTOR_INACTIVE;
+	// Pull both IN1 and IN2 low to stop current flow to the motor
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin|MOTOR_IN2_Pin, GPIO_PIN_RESET);
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Algo` command: selects the speed control algorithm.                              *
+ *                                                                                                     *
+ * @param args [const char*] Algorithm number, or "" to prompt the user for it.                        *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_algo(const char *args)
+{
+	if('\0' != args[0]) {
+		motor_select_algo(args);
+		return;
+	}
+	// Update the system state
+	curr_sys_state = sMotorAlgo;
+	// Prompt user for algorithm selection
+	print_interactive(msg_motor_algo);
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Param` command: prompts the user for an algorithm parameter.                     *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_param(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sMotorParam;
+	// Prompt user for algorithm selection
+	print_interactive(msg_motor_param);
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Rec` command: starts the periodic motor speed report.                            *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_rec(const char *args)
+{
+	// Set the motor state
+	curr_motor_state = MOTOR_SPEED_REPORTING;
+	// Display parameters
+	print_motor_on_report();
+	// Notify user of reporting
+	print_interactive(msg_speed_report);
+	// Initialize report time counter
+	report_counter = 1;
+	// Start the motor report timer
+	xTimerStart(motor_report_timer, portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Speed` command: changes the target speed.                                        *
+ *                                                                                                     *
+ * @param args [const char*] Target speed in RPM, or "" to prompt the user for it.                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_speed(const char *args)
+{
+	if('\0' != args[0]) {
+		motor_set_speed(args);
+		return;
+	}
+	// Update the system state
+	curr_sys_state = sMotorSpeed;
+	// Prompt user for new speed
+	print_interactive(msg_motor_speed);
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Loop` command: prints and resets the control loop timing statistics.             *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_loop(const char *args)
+{
+	print_control_timing_report();
+}
+
+/*******************************************************************************************************
+ * @brief Motor menu `Main` command: returns to the main menu.                                         *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_cmd_main(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sMainMenu;
+
+	// Notify the main menu task
+	xTaskNotify(handle_main_menu_task, 0, eNoAction);
+}
+
+/*******************************************************************************************************
+ * @brief Algorithm `0` selection: disables speed control.                                             *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_algo_none(const char *args)
+{
+	motor_algo = 0;
+	print_interactive(msg_valid_algo);
+}
+
+/*******************************************************************************************************
+ * @brief Algorithm `1` selection: enables PID speed control.                                          *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_algo_pid(const char *args)
+{
+	motor_algo = 1;
+	print_interactive(msg_valid_algo);
+}
+
+/*******************************************************************************************************
+ * @brief Selects the speed control algorithm from its number.                                         *
+ *                                                                                                     *
+ * @param text [const char*] Algorithm number entered by the user.                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_select_algo(const char *text)
+{
+	if(!command_dispatch(&motor_algo_table, text)) {
+		print_error(msg_inv_algo);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sets the target speed from the text entered by the user.                                     *
+ *                                                                                                     *
+ * The speed is limited to `MAX_MOTOR_SPEED`, and the user is told when the limit applies.             *
+ *                                                                                                     *
+ * @param text [const char*] Target speed in RPM, up to 6 characters.                                  *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_set_speed(const char *text)
+{
+	// Something longer than 6 digits or not numeric is incorrect
+	if((strlen(text) > 6) || !isNumeric(text)) {
+		print_error(msg_inv_speed);
+		return;
+	}
+
+	// Convert speed from string to float, and apply it within the configured threshold
+	float rpm = strtof(text, NULL);
+	if(motor_set_target_speed(rpm) < rpm) {
+		// Notify user that selection exceeds maximum RPM threshold
+		xQueueSend(q_print, &msg_motor_speed_max, portMAX_DELAY);
+		// Notify user of current threshold
+		char *max_speed = print_pool_alloc(portMAX_DELAY);
+		// Display speed in RPM
+		snprintf(max_speed, PRINT_POOL_BLOCK_SIZE, " Motor speed set to: %03d RPM\n", (int)MAX_MOTOR_SPEED);
+		print_pool_send(max_speed);
+	}
+	else {
+		print_interactive(msg_valid_speed);
+	}
+}
+
 /*******************************************************************************************************
  * @brief Prints the motor speed.																	   *
  * 																									   *
- * This function formats the current motor speed into a human-readable string and sends it to the      *
+ * This function formats the sampled motor speed into a human-readable string and sends it to the      *
  * print queue. It separates the floating-point motor speed into integer and decimal components for    *
  * display.																							   *
  * 																									   *
@@ -447,24 +971,24 @@ void motor_report_callback(void)
 
 void print_motor_speed(void)
 {
-	static char showspeed[40];
-	static char *speed = showspeed;
+	// Borrow a buffer from the print message pool
+	char *showspeed = print_pool_alloc(portMAX_DELAY);
 
 	// Separate float into two integers
 	int speed_i = 0;
 	int speed_d = 0;
-	split_float_into_ints(&speed_i, &speed_d, motor_speed, 2);
+	split_float_into_ints(&speed_i, &speed_d, report_speed, 2);
 
 	// Display speed in RPM
-	sprintf((char*)showspeed, " [%03ds] Motor speed: %03d.%02d RPM\n", report_counter++, speed_i, speed_d);
-	xQueueSend(q_print, &speed, portMAX_DELAY);
+	snprintf(showspeed, PRINT_POOL_BLOCK_SIZE, " [%03ds] Motor speed: %03d.%02d RPM\n", report_counter++, speed_i, speed_d);
+	print_pool_send(showspeed);
 }
 
 /*******************************************************************************************************
  * @brief Initializes motor and statistical parameters.												   *
  * 																									   *
- * This function sets the initial values for parameters related to motor statistics, including report  *
- * counter, duration, minimum speed, maximum speed, average speed, and standard deviation.			   *
+ * This function resets the report counter and the running speed statistics (duration, minimum,        *
+ * maximum, average, standard deviation and percentile histogram).                                     *
  * 																									   *
  * @return void																						   *
  ******************************************************************************************************/
@@ -472,11 +996,10 @@ void print_motor_speed(void)
 void initialize_parameters(void)
 {
 	report_counter = 0;
-	duration = 0;
-	min_speed = MIN_SPEED_INITIALIZATION;
-	max_speed = MAX_SPEED_INITIALIZATION;
-	average = 0;
-	standard_dev = 0;
+	running_stats_reset(&speed_stats);
+#if (SPEED_STATS_PERCENTILES)
+	quantile_sketch_reset(&speed_hist);
+#endif
 }
 
 /*******************************************************************************************************
@@ -505,28 +1028,27 @@ void print_motor_on_report(void)
 	split_float_into_ints(&kd_i, &kd_d, Kd, 3);
 
 	// Print results
-	static char showparams[250];
-	static char *params = showparams;
-	sprintf((char*)showparams,   "* Target speed:      %03d.%02d  RPM   *"
-							   "\n* Kp:                  %01d.%03d       *"
-							   "\n* Ki:                  %01d.%03d       *"
-			                   "\n* Kd:                  %01d.%03d       *\n",
-							   target_speed_i, target_speed_d, kp_i, kp_d, ki_i, ki_d, kd_i, kd_d);
-	xQueueSend(q_print, &params, portMAX_DELAY);
+	char *showparams = print_pool_alloc(portMAX_DELAY);
+	snprintf(showparams, PRINT_POOL_BLOCK_SIZE, "* Target speed:      %03d.%02d  RPM   *"
+											  "\n* Kp:                  %01d.%03d       *"
+											  "\n* Ki:                  %01d.%03d       *"
+											  "\n* Kd:                  %01d.%03d       *\n",
+											  target_speed_i, target_speed_d, kp_i, kp_d, ki_i, ki_d, kd_i, kd_d);
+	print_pool_send(showparams);
 
 	// Send statistics footer message
 	xQueueSend(q_print, &msg_motor_on_footer, portMAX_DELAY);
 }
 
 /*******************************************************************************************************
- * @brief Prints a summary report of statistical calculations.										   *
- * 																									   *
- * This function sends a formatted summary report containing elapsed time, minimum speed, maximum 	   *
- * speed, average speed, and standard deviation to the print queue. It first calculates the average	   *
- * and standard deviation of speed values, splits the resulting floats into integer components, and    *
- * then formats and sends the statistics for printing.												   *
- * 																									   *
- * @return void																						   *
+ * @brief Prints a summary report of statistical calculations.                                         *
+ *                                                                                                     *
+ * This function sends a formatted summary report containing elapsed time, minimum speed, maximum      *
+ * speed, average speed, and standard deviation to the print queue. The values come from the running   *
+ * statistics, so no pass over the recorded samples is needed. With `SPEED_STATS_PERCENTILES` the      *
+ * median and 95th percentile speeds are added.                                                        *
+ *                                                                                                     *
+ * @return void                                                                                        *
  ******************************************************************************************************/
 
 void print_summary_report(void)
@@ -534,76 +1056,104 @@ void print_summary_report(void)
 	// Send statistics header message
 	xQueueSend(q_print, &msg_stat_header, portMAX_DELAY);
 
-	// Calculate statistics
-	calculate_average(speed_values, duration);
-	calculate_sd(speed_values, duration);
+	// Read the statistics without the report timer updating them, interrupts stay enabled
+	vTaskSuspendAll();
+	running_stats_t stats = speed_stats;
+#if (SPEED_STATS_PERCENTILES)
+	float median = quantile_sketch_get(&speed_hist, 0.50f);
+	float p95 = quantile_sketch_get(&speed_hist, 0.95f);
+#endif
+	xTaskResumeAll();
 
 	// Convert floats into two integer values for display
 	int min_speed_i = 0, min_speed_d = 0;
 	int max_speed_i = 0, max_speed_d = 0;
 	int average_i = 0, average_d = 0;
 	int standard_dev_i = 0, standard_dev_d = 0;
-	split_float_into_ints(&min_speed_i, &min_speed_d, min_speed, 2);
-	split_float_into_ints(&max_speed_i, &max_speed_d, max_speed, 2);
-	split_float_into_ints(&average_i, &average_d, average, 2);
-	split_float_into_ints(&standard_dev_i, &standard_dev_d, standard_dev, 2);
+	split_float_into_ints(&min_speed_i, &min_speed_d, stats.min, 2);
+	split_float_into_ints(&max_speed_i, &max_speed_d, stats.max, 2);
+	split_float_into_ints(&average_i, &average_d, running_stats_mean(&stats), 2);
+	split_float_into_ints(&standard_dev_i, &standard_dev_d, running_stats_sd(&stats), 2);
 
 	// Print results
-	static char showstats[250];
-	static char *stats = showstats;
-	sprintf((char*)showstats,   "* Elapsed time:       %06d sec   *"
-							  "\n* Min speed:          %03d.%02d RPM   *"
-							  "\n* Max speed:          %03d.%02d RPM   *"
-			                  "\n* Average speed:      %03d.%02d RPM   *"
-			                  "\n* Standard deviation: %03d.%02d RPM   *\n",
-							  duration, min_speed_i, min_speed_d, max_speed_i, max_speed_d, average_i, average_d, standard_dev_i, standard_dev_d);
-	xQueueSend(q_print, &stats, portMAX_DELAY);
+	char *showstats = print_pool_alloc(portMAX_DELAY);
+	snprintf(showstats, PRINT_POOL_BLOCK_SIZE, "* Elapsed time:       %06d sec   *"
+											 "\n* Min speed:          %03d.%02d RPM   *"
+											 "\n* Max speed:          %03d.%02d RPM   *"
+											 "\n* Average speed:      %03d.%02d RPM   *"
+											 "\n* Standard deviation: %03d.%02d RPM   *\n",
+											 (int)stats.count, min_speed_i, min_speed_d, max_speed_i, max_speed_d, average_i, average_d, standard_dev_i, standard_dev_d);
+	print_pool_send(showstats);
+
+#if (SPEED_STATS_PERCENTILES)
+	// Print percentiles from the speed histogram
+	int median_i = 0, median_d = 0;
+	int p95_i = 0, p95_d = 0;
+	split_float_into_ints(&median_i, &median_d, median, 2);
+	split_float_into_ints(&p95_i, &p95_d, p95, 2);
+
+	char *showpercentiles = print_pool_alloc(portMAX_DELAY);
+	snprintf(showpercentiles, PRINT_POOL_BLOCK_SIZE, "* Median speed:       %03d.%02d RPM   *"
+												   "\n* 95th percentile:    %03d.%02d RPM   *\n",
+												   median_i, median_d, p95_i, p95_d);
+	print_pool_send(showpercentiles);
+#endif
 
 	// Send statistics footer message
 	xQueueSend(q_print, &msg_stat_footer, portMAX_DELAY);
 }
 
 /*******************************************************************************************************
- * @brief Calculates the average value of an array of floats.										   *
- * 																									   *
- * This function computes the average of an array of floating-point numbers and stores the result in   *
- * the global variable 'average'.																	   *
- * 																									   *
- * @param data [float[]] Array of float data to calculate the average of.							   *
- * @param len [int] Length of the data array.														   *
- * @return void																						   *
+ * @brief Prints the control loop timing report.                                                       *
+ *                                                                                                     *
+ * This function takes a snapshot of the control loop timing statistics, then resets them so the next  *
+ * report covers a fresh window. It prints the cycle and overrun counts, the worst case latency and    *
+ * jitter, and a histogram of both values.                                                             *
+ *                                                                                                     *
+ * @return void                                                                                        *
  ******************************************************************************************************/
 
-void calculate_average(float data[], int len)
+void print_control_timing_report(void)
 {
-	float sum = 0.0;
-	for(int i = 0; i < len; ++i) {
-		sum += data[i];
+	control_timing_t timing;
+
+	// Snapshot and reset the statistics
+	taskENTER_CRITICAL();
+	timing = control_timing;
+	memset(&control_timing, 0, sizeof(control_timing));
+	taskEXIT_CRITICAL();
+
+	// Send timing header message
+	xQueueSend(q_print, &msg_loop_header, portMAX_DELAY);
+
+	// Print totals and worst case values
+	char *showtiming = print_pool_alloc(portMAX_DELAY);
+	snprintf(showtiming, PRINT_POOL_BLOCK_SIZE, "* Cycles:             %010" PRIu32 "   *"
+											  "\n* Overruns:           %010" PRIu32 "   *"
+											  "\n* Max latency:        %06" PRIu32 " us    *"
+											  "\n* Max jitter:         %06" PRIu32 " us    *"
+											  "\n*                                  *"
+											  "\n*   Bin (us)   Latency   Jitter    *\n",
+											  timing.cycles, timing.overruns, timing.max_latency_us, timing.max_jitter_us);
+	print_pool_send(showtiming);
+
+	// Print one line per histogram bin, the last bin is open ended
+	for(int i = 0; i < CONTROL_HIST_BINS; i++) {
+		char *showbin = print_pool_alloc(portMAX_DELAY);
+		if(i < CONTROL_HIST_BINS - 1) {
+			snprintf(showbin, PRINT_POOL_BLOCK_SIZE, "* %4d - %-4d  %08" PRIu32 "  %08" PRIu32 "  *\n",
+					 i * CONTROL_HIST_BIN_WIDTH_US, (i + 1) * CONTROL_HIST_BIN_WIDTH_US - 1,
+					 timing.latency_hist[i], timing.jitter_hist[i]);
+		}
+		else {
+			snprintf(showbin, PRINT_POOL_BLOCK_SIZE, "* %4d +       %08" PRIu32 "  %08" PRIu32 "  *\n",
+					 i * CONTROL_HIST_BIN_WIDTH_US, timing.latency_hist[i], timing.jitter_hist[i]);
+		}
+		print_pool_send(showbin);
 	}
-	average = sum / len;
-}
-
-/*******************************************************************************************************
- * @brief Calculates the standard deviation of an array of floats.									   *
- * 																									   *
- * This function computes the standard deviation of an array of floating-point numbers and stores the  *
- * result in the global variable 'standard_dev'. The function assumes that the 'calculate_average' 	   *
- * function has been called first to compute the global 'average'.									   *
- * 																									   *
- * @param data [float[]] Array of float data to calculate the standard deviation of.				   *
- * @param len [int] Length of the data array.														   *
- * @return void																						   *
- * 																									   *
- * @note The calculate_average function must be run first, as the average is used in the calculation   *
- * 		 of the standard deviation.																	   *
- ******************************************************************************************************/
 
-void calculate_sd(float data[], int len)
-{
-	for(int i = 0; i < len; i++) {
-		standard_dev += ( (data[i]-average) * (data[i]-average) );
-	}
-	standard_dev = sqrt(standard_dev / len);
+	// Send timing footer message
+	xQueueSend(q_print, &msg_loop_footer, portMAX_DELAY);
 }
 
 /*******************************************************************************************************
@@ -641,7 +1191,7 @@ void split_float_into_ints(int *int_val, int *dec_val, float float_val, int dec_
  * @note This function assumes the timer and channel have already been configured for PWM mode.		   *
  ******************************************************************************************************/
 
-void set_pwm_duty_cycle(TIM_HandleTypeDef *htim, uint32_t channel, uint8_t duty_cycle_percent)
+RAM_FUNC void set_pwm_duty_cycle(TIM_HandleTypeDef *htim, uint32_t channel, uint8_t duty_cycle_percent)
 {
 	// Get timer auto-reload value (i.e. period)
 	uint32_t timer_period = __HAL_TIM_GET_AUTORELOAD(htim);
@@ -668,7 +1218,7 @@ void set_pwm_duty_cycle(TIM_HandleTypeDef *htim, uint32_t channel, uint8_t duty_
  * @note The function ensures that the duty cycle remains within the range of 0 to 100.				   *
  ******************************************************************************************************/
 
-float pid_controller(float setpoint, float measured_value)
+RAM_FUNC float pid_controller(float setpoint, float measured_value)
 {
     if(motor_algo == 1) {
 		float error = setpoint - measured_value;
@@ -691,6 +1241,183 @@ float pid_controller(float setpoint, float measured_value)
     }
 }
 
+/*******************************************************************************************************
+ * @brief Converts the PID parameters to the fixed-point control law format.                           *
+ *                                                                                                     *
+ * This function converts the target speed to the Q format selected by `MOTOR_MATH`, and the PID      *
+ * gains and `dt` to Q31 in both formats. Speeds are normalized to `MOTOR_SPEED_FULL_SCALE` and the    *
+ * duty cycle to 100 %. The derivative gain absorbs `dt`, and all gains are stored divided by          *
+ * 2^`PID_GAIN_SHIFT`.                                                                                 *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Does nothing with `MOTOR_MATH_FLOAT`, where the control law uses the float values directly.   *
+ * @note Gains that do not fit in Q31 after scaling saturate. With the default shift and full scale,   *
+ *       Kp and Ki fit over their whole range, but Kd is limited to `50 * dt`.                         *
+ ******************************************************************************************************/
+
+void pid_update_params(void)
+{
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+	const float gain_scale = MOTOR_SPEED_FULL_SCALE / (100.0f * (float)(1UL << PID_GAIN_SHIFT));
+
+	// Convert outside the critical section, the float to Q conversion is slow
+	q_t target = Q_FROM_FLOAT(target_speed / MOTOR_SPEED_FULL_SCALE);
+	int32_t kp = Q31_FROM_FLOAT(Kp * gain_scale);
+	int32_t ki = Q31_FROM_FLOAT(Ki * gain_scale);
+	int32_t kd = Q31_FROM_FLOAT(Kd * gain_scale / dt);
+	int32_t step = Q31_FROM_FLOAT(dt);
+
+	// Publish all parameters together so the control task never sees a partial update
+	taskENTER_CRITICAL();
+	target_speed_q = target;
+	Kp_q31 = kp;
+	Ki_q31 = ki;
+	Kd_q31 = kd;
+	dt_q31 = step;
+	taskEXIT_CRITICAL();
+#endif
+}
+
+/*******************************************************************************************************
+ * @brief Sets the target speed and the PID gains.                                                     *
+ *                                                                                                     *
+ * @param setpoint [float] Desired motor speed in RPM.                                                 *
+ * @param kp [float] Proportional gain.                                                                *
+ * @param ki [float] Integral gain.                                                                    *
+ * @param kd [float] Derivative gain.                                                                  *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Used by the host benchmark to sweep the gains and by the binary protocol. The user menus      *
+ *       set the same variables.                                                                       *
+ ******************************************************************************************************/
+
+void pid_set_params(float setpoint, float kp, float ki, float kd)
+{
+	target_speed = setpoint;
+	Kp = kp;
+	Ki = ki;
+	Kd = kd;
+	pid_update_params();
+}
+
+/*******************************************************************************************************
+ * @brief Reads the target speed and the PID gains.                                                    *
+ *                                                                                                     *
+ * @param setpoint [float*] Receives the desired motor speed in RPM.                                   *
+ * @param kp [float*] Receives the proportional gain.                                                  *
+ * @param ki [float*] Receives the integral gain.                                                      *
+ * @param kd [float*] Receives the derivative gain.                                                    *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void pid_get_params(float *setpoint, float *kp, float *ki, float *kd)
+{
+	*setpoint = target_speed;
+	*kp = Kp;
+	*ki = Ki;
+	*kd = Kd;
+}
+
+/*******************************************************************************************************
+ * @brief Sets the target speed, limited to `MAX_MOTOR_SPEED`.                                         *
+ *                                                                                                     *
+ * @param rpm [float] Desired motor speed in RPM, not negative.                                        *
+ * @return float Target speed applied, in RPM.                                                         *
+ ******************************************************************************************************/
+
+float motor_set_target_speed(float rpm)
+{
+	target_speed = (rpm > MAX_MOTOR_SPEED) ? MAX_MOTOR_SPEED : rpm;
+	pid_update_params();
+
+	return target_speed;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the target speed.                                                                      *
+ *                                                                                                     *
+ * @return float Target speed in RPM.                                                                  *
+ ******************************************************************************************************/
+
+float motor_get_target_speed(void)
+{
+	return target_speed;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the active speed control algorithm.                                                    *
+ *                                                                                                     *
+ * @return uint8_t `motor_algo_t` value, 0 for none and 1 for PID.                                     *
+ ******************************************************************************************************/
+
+uint8_t motor_get_algo(void)
+{
+	return (uint8_t)motor_algo;
+}
+
+#if (MOTOR_MATH != MOTOR_MATH_FLOAT)
+/*******************************************************************************************************
+ * @brief Converts an encoder count delta to a fixed-point motor speed.                                *
+ *                                                                                                     *
+ * @param delta_count [int32_t] Encoder counts over one control loop period.                           *
+ * @return q_t Motor speed normalized to `MOTOR_SPEED_FULL_SCALE`, saturated to the Q format range.    *
+ ******************************************************************************************************/
+
+static RAM_FUNC q_t speed_estimate_q(int32_t delta_count)
+{
+	return Q_SAT( ((int64_t)delta_count * speed_scale_q31) >> (31 - Q_FRAC_BITS) );
+}
+
+/*******************************************************************************************************
+ * @brief Fixed-point PID controller for motor speed control.                                          *
+ *                                                                                                     *
+ * This function is the Q15 / Q31 counterpart of `pid_controller`, with the same control law. All      *
+ * sums and products saturate, the integral is bounded to the Q format range, and the duty cycle is    *
+ * clamped to 0 - 100 %. The gains and `dt` are Q31 and the integral keeps the full `error * dt`       *
+ * products, so a speed error whose increment is below one LSB at a high loop rate still adds up.      *
+ *                                                                                                     *
+ * @param setpoint [q_t] Desired motor speed, normalized to `MOTOR_SPEED_FULL_SCALE`.                  *
+ * @param measured_value [q_t] Current motor speed, normalized to `MOTOR_SPEED_FULL_SCALE`.            *
+ * @return q_t New duty cycle, normalized to 100 %.                                                    *
+ *                                                                                                     *
+ * @note Call `pid_update_params` after changing the float gains or target speed.                      *
+ * @note The duty cycle starts from `PID_INITIAL_DUTY_CYCLE`, set by `motor_control_reset`.            *
+ ******************************************************************************************************/
+
+static RAM_FUNC q_t pid_controller_q(q_t setpoint, q_t measured_value)
+{
+	if(motor_algo == 1) {
+		q_t error = Q_SUB(setpoint, measured_value);
+
+		// Sum the error * dt products unrounded, bounded to the Q format range. As dt is below 1.0 an
+		// increment is smaller than the bound, so the sum cannot overflow
+		integral_q31 += (int64_t)error * dt_q31;
+		if (integral_q31 > (int64_t)Q_MAX * Q31_ONE) integral_q31 = (int64_t)Q_MAX * Q31_ONE;
+		if (integral_q31 < (int64_t)Q_MIN * Q31_ONE) integral_q31 = (int64_t)Q_MIN * Q31_ONE;
+		q_t integral_q = (q_t)( (integral_q31 + (Q31_ONE >> 1)) >> 31 );
+
+		q_t derivative = Q_SUB(error, last_error_q);
+		last_error_q = error;
+
+		// Sum the terms in 64 bits, restoring the gain shift, then saturate once
+		q_t output = Q_SAT( Q31_MUL_SHL(Kp_q31, error, PID_GAIN_SHIFT)
+						  + Q31_MUL_SHL(Ki_q31, integral_q, PID_GAIN_SHIFT)
+						  + Q31_MUL_SHL(Kd_q31, derivative, PID_GAIN_SHIFT) );
+
+		// Calculate new duty cycle, in the accumulator so that the clamps below see the unsaturated sum
+		q_acc_t new_duty_cycle = (q_acc_t)duty_cycle_q + output;
+
+		// Ensure the duty cycle is within the range of 0 to 100 %, 100 % being the Q full scale
+		if (new_duty_cycle > Q_MAX) new_duty_cycle = Q_MAX;
+		if (new_duty_cycle < 0) new_duty_cycle = 0;
+		duty_cycle_q = (q_t)new_duty_cycle;
+	}
+
+	return duty_cycle_q;
+}
+#endif
+
 /*******************************************************************************************************
  * @brief Checks if a string represents a numeric value.											   *
  * 																									   *
@@ -769,3 +1496,63 @@ int parse_param_string(message_t *msg)
 
     return 0;
 }
+
+/*******************************************************************************************************
+ * @brief Reads the current encoder position.                                                          *
+ *                                                                                                     *
+ * @return int32_t Encoder position in counts, in the same units for both acquisition backends.        *
+ *                                                                                                     *
+ * @note With the timer backend the 32-bit TIM2 counter wraps around, which the signed difference      *
+ *       between two readings handles without special casing.                                          *
+ ******************************************************************************************************/
+
+RAM_FUNC int32_t read_encoder_count(void)
+{
+#if (ENCODER_BACKEND == ENCODER_BACKEND_TIMER)
+	// Mirror the hardware counter so the position stays visible in the debugger
+	encoder_count = (int32_t)__HAL_TIM_GET_COUNTER(&htim2);
+#endif
+
+	return encoder_count;
+}
+
+/*******************************************************************************************************
+ * @brief Adds a sample in CPU cycles to a control loop timing histogram.                              *
+ *                                                                                                     *
+ * @param hist [uint32_t*] Histogram of `CONTROL_HIST_BINS` bins to update.                            *
+ * @param max [uint32_t*] Worst case value in microseconds, updated if the sample is larger.           *
+ * @param cycles [uint32_t] Sample to add, in CPU cycles.                                              *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static RAM_FUNC void control_hist_add(uint32_t *hist, uint32_t *max, uint32_t cycles)
+{
+	// Convert CPU cycles to microseconds
+	uint32_t us = cycles / (SystemCoreClock / 1000000U);
+	uint32_t bin = us / CONTROL_HIST_BIN_WIDTH_US;
+
+	if(bin >= CONTROL_HIST_BINS) {
+		bin = CONTROL_HIST_BINS - 1;
+	}
+	hist[bin]++;
+
+	if(us > *max) {
+		*max = us;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Calculates the control loop period in CPU cycles.                                            *
+ *                                                                                                     *
+ * The period is derived from the TIM7 prescaler and auto-reload values and the APB1 timer clock, so   *
+ * it follows any change to the timer configuration or clock tree.                                     *
+ *                                                                                                     *
+ * @return uint32_t Control loop period in CPU cycles.                                                 *
+ ******************************************************************************************************/
+
+static uint32_t control_period_cycles(void)
+{
+	uint32_t timer_clock = clock_apb1_timer_hz();
+	uint64_t timer_ticks = (uint64_t)(htim7.Instance->PSC + 1) * (htim7.Instance->ARR + 1);
+	return (uint32_t)((timer_ticks * SystemCoreClock) / timer_clock);
+}
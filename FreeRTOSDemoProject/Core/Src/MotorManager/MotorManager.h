@@ -27,9 +27,24 @@
  ****************************************************/
 
 void motor_task(void *param);
+void motor_control_task(void *param);
+float motor_control_step(int32_t encoder_count);
+void motor_control_reset(int32_t encoder_count);
+uint32_t motor_control_step_cycles(void);
+void pid_update_params(void);
+void pid_set_params(float setpoint, float kp, float ki, float kd);
+void pid_get_params(float *setpoint, float *kp, float *ki, float *kd);
+float motor_set_target_speed(float rpm);
+float motor_get_target_speed(void);
+uint8_t motor_get_algo(void);
+void control_timer_init(void);
+void motor_pwm_timer_init(void);
+void encoder_init(void);
+int32_t read_encoder_count(void);
 void motor_gpio_callback(uint16_t GPIO_Pin);
 void motor_timer_callback(TIM_HandleTypeDef *htim);
 void motor_report_callback(void);
+void motor_report_print(void);
 
 /****************************************************
  *  Variables                                       *
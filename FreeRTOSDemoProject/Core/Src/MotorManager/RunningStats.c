@@ -0,0 +1,187 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MotorManager ]                                                          |
+| FILE:       RunningStats.c                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `RunningStats` utility keeps summary statistics of a stream of samples in      |
+|    constant memory. Mean and variance use Welford's online update, so a recording of  |
+|    any length needs one O(1) step per sample and no sample storage. An optional       |
+|    histogram sketch gives approximate percentiles with a fixed bin resolution.        |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "RunningStats.h"
+#include <math.h>
+#include <string.h>
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Clears the running statistics.                                                               *
+ *                                                                                                     *
+ * @param rs [running_stats_t*] Pointer to the statistics to reset.                                    *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void running_stats_reset(running_stats_t *rs)
+{
+	rs->count = 0;
+	rs->mean = 0.0f;
+	rs->m2 = 0.0f;
+	rs->min = 0.0f;
+	rs->max = 0.0f;
+}
+
+/*******************************************************************************************************
+ * @brief Adds a sample to the running statistics.                                                     *
+ *                                                                                                     *
+ * This function updates the count, minimum, maximum, mean and sum of squared deviations with          *
+ * Welford's method. The update is numerically stable and does not keep the samples.                   *
+ *                                                                                                     *
+ * @param rs [running_stats_t*] Pointer to the statistics to update.                                   *
+ * @param x [float] Sample to add.                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void running_stats_add(running_stats_t *rs, float x)
+{
+	// The first sample sets both extremes
+	if(0 == rs->count) {
+		rs->min = x;
+		rs->max = x;
+	}
+	else {
+		if(x < rs->min) rs->min = x;
+		if(x > rs->max) rs->max = x;
+	}
+
+	// Welford update of the mean and the sum of squared deviations
+	rs->count++;
+	float delta = x - rs->mean;
+	rs->mean += delta / (float)rs->count;
+	rs->m2 += delta * (x - rs->mean);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the mean of the samples added so far.                                                *
+ *                                                                                                     *
+ * @param rs [const running_stats_t*] Pointer to the statistics.                                       *
+ * @return float Mean, or 0 if no samples have been added.                                             *
+ ******************************************************************************************************/
+
+float running_stats_mean(const running_stats_t *rs)
+{
+	return rs->mean;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the population standard deviation of the samples added so far.                       *
+ *                                                                                                     *
+ * @param rs [const running_stats_t*] Pointer to the statistics.                                       *
+ * @return float Standard deviation, or 0 if no samples have been added.                               *
+ ******************************************************************************************************/
+
+float running_stats_sd(const running_stats_t *rs)
+{
+	if(0 == rs->count) {
+		return 0.0f;
+	}
+
+	return sqrtf(rs->m2 / (float)rs->count);
+}
+
+/*******************************************************************************************************
+ * @brief Initializes a histogram quantile sketch over caller-provided storage.                        *
+ *                                                                                                     *
+ * @param qs [quantile_sketch_t*] Pointer to the sketch to initialize.                                 *
+ * @param bins [uint32_t*] Storage for the bin counts, `num_bins` entries.                             *
+ * @param num_bins [uint32_t] Number of bins.                                                          *
+ * @param bin_width [float] Width of each bin. The sketch covers 0 to `num_bins * bin_width`.          *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void quantile_sketch_init(quantile_sketch_t *qs, uint32_t *bins, uint32_t num_bins, float bin_width)
+{
+	qs->bins = bins;
+	qs->num_bins = num_bins;
+	qs->bin_width = bin_width;
+	quantile_sketch_reset(qs);
+}
+
+/*******************************************************************************************************
+ * @brief Clears all bins of a quantile sketch.                                                        *
+ *                                                                                                     *
+ * @param qs [quantile_sketch_t*] Pointer to the sketch to reset.                                      *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void quantile_sketch_reset(quantile_sketch_t *qs)
+{
+	memset(qs->bins, 0, qs->num_bins * sizeof(qs->bins[0]));
+	qs->count = 0;
+}
+
+/*******************************************************************************************************
+ * @brief Adds a sample to a quantile sketch.                                                          *
+ *                                                                                                     *
+ * @param qs [quantile_sketch_t*] Pointer to the sketch to update.                                     *
+ * @param x [float] Sample to add. Samples outside the covered range go to the first or last bin.      *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void quantile_sketch_add(quantile_sketch_t *qs, float x)
+{
+	uint32_t bin = 0;
+
+	// Clamp to the covered range before converting to an index
+	if(x > 0.0f) {
+		bin = (uint32_t)(x / qs->bin_width);
+		if(bin >= qs->num_bins) {
+			bin = qs->num_bins - 1;
+		}
+	}
+
+	qs->bins[bin]++;
+	qs->count++;
+}
+
+/*******************************************************************************************************
+ * @brief Estimates a quantile from a quantile sketch.                                                 *
+ *                                                                                                     *
+ * This function walks the bins until the cumulative count reaches the requested fraction of the       *
+ * samples, and returns the center of that bin.                                                        *
+ *                                                                                                     *
+ * @param qs [const quantile_sketch_t*] Pointer to the sketch.                                         *
+ * @param q [float] Quantile to estimate, from 0.0 to 1.0 (e.g. 0.5 for the median).                   *
+ * @return float Estimated quantile, accurate to half a bin width, or 0 if the sketch is empty.        *
+ ******************************************************************************************************/
+
+float quantile_sketch_get(const quantile_sketch_t *qs, float q)
+{
+	if(0 == qs->count) {
+		return 0.0f;
+	}
+
+	// Rank of the requested sample, at least the first one
+	uint32_t rank = (uint32_t)ceilf(q * (float)qs->count);
+	if(0 == rank) {
+		rank = 1;
+	}
+
+	uint32_t cumulative = 0;
+	for(uint32_t i = 0; i < qs->num_bins; i++) {
+		cumulative += qs->bins[i];
+		if(cumulative >= rank) {
+			return ((float)i + 0.5f) * qs->bin_width;
+		}
+	}
+
+	return ((float)qs->num_bins - 0.5f) * qs->bin_width;
+}
@@ -0,0 +1,58 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MotorManager ]                                                          |
+| FILE:       RunningStats.h                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `RunningStats` utility keeps summary statistics of a stream of samples in      |
+|    constant memory. Mean and variance use Welford's online update, so a recording of  |
+|    any length needs one O(1) step per sample and no sample storage. An optional       |
+|    histogram sketch gives approximate percentiles with a fixed bin resolution.        |
+\*=====================================================================================*/
+
+#ifndef RUNNINGSTATS_H_
+#define RUNNINGSTATS_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	uint32_t count;		// Number of samples added since the last reset
+	float mean;			// Running mean
+	float m2;			// Running sum of squared deviations from the mean
+	float min;			// Smallest sample
+	float max;			// Largest sample
+} running_stats_t;
+
+typedef struct
+{
+	uint32_t *bins;		// Sample count per bin, storage provided by the caller
+	uint32_t num_bins;	// Number of bins, covering 0 to num_bins * bin_width
+	float bin_width;	// Width of each bin, which is also the percentile resolution
+	uint32_t count;		// Number of samples added since the last reset
+} quantile_sketch_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void running_stats_reset(running_stats_t *rs);
+void running_stats_add(running_stats_t *rs, float x);
+float running_stats_mean(const running_stats_t *rs);
+float running_stats_sd(const running_stats_t *rs);
+void quantile_sketch_init(quantile_sketch_t *qs, uint32_t *bins, uint32_t num_bins, float bin_width);
+void quantile_sketch_reset(quantile_sketch_t *qs);
+void quantile_sketch_add(quantile_sketch_t *qs, float x);
+float quantile_sketch_get(const quantile_sketch_t *qs, float q);
+
+#endif /* RUNNINGSTATS_H_ */
@@ -0,0 +1,150 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MotorManager ]                                                          |
+| FILE:       Telemetry.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Telemetry` module streams one packed binary frame per control cycle (time,    |
+|    encoder count, speed, error and duty cycle) over a dedicated SEGGER RTT channel.   |
+|    Each frame carries a sequence number and a CRC-16, so the host decoder in          |
+|    `Tools/telemetry_decode.py` can resynchronize and count dropped frames.            |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Telemetry.h"
+#include "Config_MotorManager.h"
+#include "SEGGER_RTT.h"
+#include <stddef.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static int16_t scale_to_int16(float value, float scale);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static uint8_t telemetry_rtt_buf[TELEMETRY_RTT_BUFFER_SIZE];
+static int telemetry_channel = -1;
+static uint16_t telemetry_seq = 0;
+volatile uint32_t telemetry_dropped = 0; // Frames skipped because the RTT buffer was full
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Allocates the RTT up buffer used for telemetry frames.                                       *
+ *                                                                                                     *
+ * The buffer is opened in `SEGGER_RTT_MODE_NO_BLOCK_SKIP` mode. When the host does not read fast      *
+ * enough, whole frames are skipped instead of blocking the control loop. The host sees the skipped    *
+ * frames as gaps in the sequence numbers.                                                             *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called after `SEGGER_SYSVIEW_Conf`, which initializes RTT and takes its own channel.  *
+ ******************************************************************************************************/
+
+void telemetry_init(void)
+{
+	telemetry_channel = SEGGER_RTT_AllocUpBuffer("Telemetry", telemetry_rtt_buf, sizeof(telemetry_rtt_buf),
+												  SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+}
+
+/*******************************************************************************************************
+ * @brief Sends one control cycle sample as a telemetry frame.                                         *
+ *                                                                                                     *
+ * This function packs the sample into a `telemetry_frame_t`, appends the CRC and writes the frame     *
+ * to the telemetry RTT channel. Speed, error and duty cycle are scaled by 100 and saturated to        *
+ * 16 bits.                                                                                            *
+ *                                                                                                     *
+ * @param timestamp [uint32_t] DWT cycle counter at the sample capture.                                *
+ * @param encoder_count [int32_t] Encoder position at the sample capture.                              *
+ * @param speed [float] Motor speed in RPM.                                                            *
+ * @param error [float] Target speed minus motor speed in RPM.                                         *
+ * @param duty [float] PWM duty cycle in percent.                                                      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Only the motor control task may call this function, as the RTT write does not take a lock.    *
+ ******************************************************************************************************/
+
+void telemetry_send(uint32_t timestamp, int32_t encoder_count, float speed, float error, float duty)
+{
+	telemetry_frame_t frame;
+
+	if(telemetry_channel < 0) {
+		return;
+	}
+
+	// Pack the sample
+	frame.sync[0] = TELEMETRY_SYNC_0;
+	frame.sync[1] = TELEMETRY_SYNC_1;
+	frame.seq = telemetry_seq++;
+	frame.timestamp = timestamp;
+	frame.encoder_count = encoder_count;
+	frame.speed = scale_to_int16(speed, 100.0f);
+	frame.error = scale_to_int16(error, 100.0f);
+	frame.duty = (uint16_t)scale_to_int16(duty, 100.0f);
+	frame.crc = telemetry_crc16((const uint8_t *)&frame.seq, offsetof(telemetry_frame_t, crc) - offsetof(telemetry_frame_t, seq));
+
+	// The frame is either written whole or skipped
+	if(0 == SEGGER_RTT_WriteNoLock((unsigned)telemetry_channel, &frame, sizeof(frame))) {
+		telemetry_dropped++;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Calculates a CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).                   *
+ *                                                                                                     *
+ * The calculation uses a 16-entry table and processes one nibble at a time, which keeps the table     *
+ * small while needing only two lookups per byte.                                                      *
+ *                                                                                                     *
+ * @param data [const uint8_t*] Pointer to the data.                                                   *
+ * @param len [uint32_t] Number of bytes.                                                              *
+ * @return uint16_t CRC of the data.                                                                   *
+ ******************************************************************************************************/
+
+uint16_t telemetry_crc16(const uint8_t *data, uint32_t len)
+{
+	static const uint16_t crc_table[16] = {
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+	};
+	uint16_t crc = 0xFFFF;
+
+	while(len--) {
+		crc = (uint16_t)((crc << 4) ^ crc_table[(crc >> 12) ^ (*data >> 4)]);
+		crc = (uint16_t)((crc << 4) ^ crc_table[(crc >> 12) ^ (*data & 0x0F)]);
+		data++;
+	}
+
+	return crc;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Scales a float and converts it to a saturated 16-bit integer.                                *
+ *                                                                                                     *
+ * @param value [float] Value to convert.                                                              *
+ * @param scale [float] Scale factor applied before rounding.                                          *
+ * @return int16_t Rounded value, clamped to the int16_t range.                                        *
+ ******************************************************************************************************/
+
+static int16_t scale_to_int16(float value, float scale)
+{
+	float scaled = value * scale;
+
+	if(scaled > 32767.0f) return 32767;
+	if(scaled < -32768.0f) return -32768;
+
+	return (int16_t)((scaled >= 0.0f) ? (scaled + 0.5f) : (scaled - 0.5f));
+}
@@ -0,0 +1,50 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MotorManager ]                                                          |
+| FILE:       Telemetry.h                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Telemetry` module streams one packed binary frame per control cycle (time,    |
+|    encoder count, speed, error and duty cycle) over a dedicated SEGGER RTT channel.   |
+|    Each frame carries a sequence number and a CRC-16, so the host decoder in          |
+|    `Tools/telemetry_decode.py` can resynchronize and count dropped frames.            |
+\*=====================================================================================*/
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct __attribute__((packed))
+{
+	uint8_t sync[2];		// TELEMETRY_SYNC_0, TELEMETRY_SYNC_1
+	uint16_t seq;			// Sequence number, increments by one per frame generated (sent or dropped)
+	uint32_t timestamp;		// DWT cycle counter at the TIM7 sample capture
+	int32_t encoder_count;	// Encoder position at the sample capture
+	int16_t speed;			// Motor speed in 0.01 RPM
+	int16_t error;			// Target speed minus motor speed in 0.01 RPM
+	uint16_t duty;			// PWM duty cycle in 0.01 %
+	uint16_t crc;			// CRC-16/CCITT-FALSE over `seq` to `duty`
+} telemetry_frame_t;
+
+extern volatile uint32_t telemetry_dropped;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void telemetry_init(void);
+void telemetry_send(uint32_t timestamp, int32_t encoder_count, float speed, float error, float duty);
+uint16_t telemetry_crc16(const uint8_t *data, uint32_t len);
+
+#endif /* TELEMETRY_H_ */
@@ -23,6 +23,8 @@
 #include "RtcManager.h"
 #include "Config_RtcManager.h"
 #include "UartManager.h"
+#include "Config_UartManager.h"
+#include "Command.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -31,10 +33,11 @@
  ****************************************************/
 
 uint8_t getnumber(uint8_t *p, int len);
-int validate_rtc_information(RTC_TimeTypeDef *time, RTC_DateTypeDef *date);
-void rtc_configure_time(RTC_TimeTypeDef *time);
-void rtc_configure_date(RTC_DateTypeDef *date);
 void show_time_date(void);
+static void rtc_cmd_date(const char *args);
+static void rtc_cmd_time(const char *args);
+static void rtc_cmd_rfsh(const char *args);
+static void rtc_cmd_main(const char *args);
 
 /****************************************************
  *  Messages                                        *
@@ -74,6 +77,15 @@ static int curr_rtc_state = HH_CONFIG;
 RTC_TimeTypeDef time;
 RTC_DateTypeDef date;
 
+// RTC menu commands
+static const command_t rtc_commands[] = {
+	{ "Date",	rtc_cmd_date,	0 },	// Configure date
+	{ "Time",	rtc_cmd_time,	0 },	// Configure time
+	{ "Rfsh",	rtc_cmd_rfsh,	0 },	// Refresh the date and time
+	{ "Main",	rtc_cmd_main,	0 },	// Back to main menu
+};
+static command_table_t rtc_command_table = COMMAND_TABLE(rtc_commands);
+
 /****************************************************
  *  Public functions                                *
  ****************************************************/
@@ -96,9 +108,12 @@ RTC_DateTypeDef date;
 
 void rtc_task(void *param)
 {
-	uint32_t msg_addr;
 	message_t *msg;
 
+	// Build the hash index of the command table
+	int status = command_table_init(&rtc_command_table);
+	configASSERT(0 == status);
+
 	while(1) {
 
 		// Wait for notification from another task
@@ -110,55 +125,28 @@ void rtc_task(void *param)
 				/***** RTC main menu state *****/
 				case sRtcMenu:
 					// Display RTC menu for the user, show current time and date
-					xQueueSend(q_print, &msg_rtc_menu_1, portMAX_DELAY);
-					show_time_date();
-					xQueueSend(q_print, &msg_rtc_menu_2, portMAX_DELAY);
+					print_interactive(msg_rtc_menu_1);
+					if(!uart_batch_active()) {
+						show_time_date();
+					}
+					print_interactive(msg_rtc_menu_2);
 
 					// Wait for the user to select their desired RTC configuration option
-					xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-					msg = (message_t*)msg_addr;
+					msg = uart_wait_message();
 
 					// Process command, update date / time accordingly
-					if(msg->len <= 4) {
-						if(!strcmp((char*)msg->payload, "Date")) {			// Configure date
-							// Update the system state
-							curr_sys_state = sRtcDateConfig;
-							xQueueSend(q_print, &msg_rtc_mo, portMAX_DELAY);
-						}
-						else if (!strcmp((char*)msg->payload, "Time")) {	// Configure time
-							// Update the system state
-							curr_sys_state = sRtcTimeConfig;
-							xQueueSend(q_print, &msg_rtc_hh, portMAX_DELAY);
-						}
-						else if (!strcmp((char*)msg->payload, "Rfsh")) {	// Refresh the date and time
-							// Update the system state
-							curr_sys_state = sRtcMenu;
-						}
-						else if (!strcmp((char*)msg->payload, "Main")) {	// Back to main menu
-							// Update the system state
-							curr_sys_state = sMainMenu;
-							// Give semaphore for led_task to turn LEDs off
-							xSemaphoreGive(ledOffSemaphore);
-						}
-						else {												// Invalid response
-							// Update the system state
-							curr_sys_state = sMainMenu;
-							xQueueSend(q_print, &msg_inv_rtc, portMAX_DELAY);
-							// Give semaphore for led_task to turn LEDs off
-							xSemaphoreGive(ledOffSemaphore);
-						}
-					}
-					else {
-						// If user input is longer than 4 characters, notify user of invalid response
+					if(!command_dispatch(&rtc_command_table, (char*)msg->payload)) {
+						// Update the system state
 						curr_sys_state = sMainMenu;
-						xQueueSend(q_print, &msg_inv_rtc, portMAX_DELAY);
+						print_error(msg_inv_rtc);
+						// Give semaphore for led_task to turn LEDs off
+						xSemaphoreGive(ledOffSemaphore);
 					}
 					break;
 				/***** RTC date configuration state *****/
 				case sRtcDateConfig:
 					// Wait for the user to select their desired RTC configuration option
-					xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-					msg = (message_t*)msg_addr;
+					msg = uart_wait_message();
 
 					// Configure month, date, year, or day of week accordingly
 					switch(curr_rtc_state) {
@@ -166,19 +154,19 @@ void rtc_task(void *param)
 							uint8_t m = getnumber(msg->payload, msg->len);
 							date.Month = m;
 							curr_rtc_state = DATE_CONFIG;
-							xQueueSend(q_print, &msg_rtc_dd, portMAX_DELAY);
+							print_interactive(msg_rtc_dd);
 							break;
 						case DATE_CONFIG:									// Date config
 							uint8_t d = getnumber(msg->payload, msg->len);
 							date.Date = d;
 							curr_rtc_state = YEAR_CONFIG;
-							xQueueSend(q_print, &msg_rtc_yr, portMAX_DELAY);
+							print_interactive(msg_rtc_yr);
 							break;
 						case YEAR_CONFIG:									// Year config
 							uint8_t y = getnumber(msg->payload, msg->len);
 							date.Year = y;
 							curr_rtc_state = DAY_CONFIG;
-							xQueueSend(q_print, &msg_rtc_dow, portMAX_DELAY);
+							print_interactive(msg_rtc_dow);
 							break;
 						case DAY_CONFIG:									// Day of week config
 							uint8_t day = getnumber(msg->payload, msg->len);
@@ -187,11 +175,11 @@ void rtc_task(void *param)
 							// Check that the user entered a valid date entry, configure date
 							if(!validate_rtc_information(NULL, &date)) {
 								rtc_configure_date(&date); // Configure date
-								xQueueSend(q_print, &msg_conf, portMAX_DELAY); // Send confirmation to print queue
+								print_interactive(msg_conf); // Send confirmation to print queue
 								xSemaphoreGive(rtcSemaphore); // Give rtcSemaphore for led_task to light LED
 							}
 							else {
-								xQueueSend(q_print, &msg_inv_rtc, portMAX_DELAY);
+								print_error(msg_inv_rtc);
 								// Give semaphore for led_task to turn LEDs off
 								xSemaphoreGive(ledOffSemaphore);
 							}
@@ -205,8 +193,7 @@ void rtc_task(void *param)
 				/***** RTC time configuration state *****/
 				case sRtcTimeConfig:
 					// Wait for the user to select their desired RTC configuration option
-					xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-					msg = (message_t*)msg_addr;
+					msg = uart_wait_message();
 
 					// Configure hours, minutes, or seconds accordingly
 					switch(curr_rtc_state) {
@@ -214,19 +201,19 @@ void rtc_task(void *param)
 							uint8_t hour = getnumber(msg->payload, msg->len);
 							time.Hours = hour;
 							curr_rtc_state = MM_CONFIG;
-							xQueueSend(q_print, &msg_rtc_mm, portMAX_DELAY);
+							print_interactive(msg_rtc_mm);
 							break;
 						case MM_CONFIG:
 							uint8_t min = getnumber(msg->payload, msg->len);
 							time.Minutes = min;
 							curr_rtc_state = SS_CONFIG;
-							xQueueSend(q_print, &msg_rtc_ss, portMAX_DELAY);
+							print_interactive(msg_rtc_ss);
 							break;
 						case SS_CONFIG:
 							uint8_t sec = getnumber(msg->payload, msg->len);
 							time.Seconds = sec;
 							curr_rtc_state = AMPM_CONFIG;
-							xQueueSend(q_print, &msg_rtc_ampm, portMAX_DELAY);
+							print_interactive(msg_rtc_ampm);
 							break;
 						case AMPM_CONFIG:
 							uint8_t opt = getnumber(msg->payload, msg->len);
@@ -235,11 +222,11 @@ void rtc_task(void *param)
 							// Check that the user entered a valid date entry, configure time
 							if(!validate_rtc_information(&time, NULL)) {
 								rtc_configure_time(&time); // Configure time
-								xQueueSend(q_print, &msg_conf, portMAX_DELAY); // Send confirmation to print queue
+								print_interactive(msg_conf); // Send confirmation to print queue
 								xSemaphoreGive(rtcSemaphore); // Give rtcSemaphore for led_task to light LED
 							}
 							else {
-								xQueueSend(q_print, &msg_inv_rtc, portMAX_DELAY);
+								print_error(msg_inv_rtc);
 								// Give semaphore for led_task to turn LEDs off
 								xSemaphoreGive(ledOffSemaphore);
 							}
@@ -252,7 +239,7 @@ void rtc_task(void *param)
 				default:
 					// Return control to the main menu task
 					curr_sys_state = sMainMenu;
-					xQueueSend(q_print, &msg_inv_rtc, portMAX_DELAY);
+					print_error(msg_inv_rtc);
 					// Give semaphore for led_task to turn LEDs off
 					xSemaphoreGive(ledOffSemaphore);
 					break;
@@ -270,6 +257,62 @@ void rtc_task(void *param)
  *  Private functions                               *
  ****************************************************/
 
+/*******************************************************************************************************
+ * @brief RTC menu `Date` command: starts the date configuration.                                      *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void rtc_cmd_date(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sRtcDateConfig;
+	print_interactive(msg_rtc_mo);
+}
+
+/*******************************************************************************************************
+ * @brief RTC menu `Time` command: starts the time configuration.                                      *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void rtc_cmd_time(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sRtcTimeConfig;
+	print_interactive(msg_rtc_hh);
+}
+
+/*******************************************************************************************************
+ * @brief RTC menu `Rfsh` command: shows the menu again with the current date and time.                *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void rtc_cmd_rfsh(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sRtcMenu;
+}
+
+/*******************************************************************************************************
+ * @brief RTC menu `Main` command: returns to the main menu.                                           *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void rtc_cmd_main(const char *args)
+{
+	// Update the system state
+	curr_sys_state = sMainMenu;
+	// Give semaphore for led_task to turn LEDs off
+	xSemaphoreGive(ledOffSemaphore);
+}
+
 /*******************************************************************************************************
  * @brief Converts an array of one- or two-digit string into a number.								   *
  * 																									   *
@@ -366,6 +409,25 @@ void rtc_configure_date(RTC_DateTypeDef *date)
 	HAL_RTC_SetDate(&hrtc, date, RTC_FORMAT_BIN);
 }
 
+/*******************************************************************************************************
+ * @brief Reads the current RTC time and date.                                                         *
+ *                                                                                                     *
+ * @param time [RTC_TimeTypeDef*] Receives the current time.                                           *
+ * @param date [RTC_DateTypeDef*] Receives the current date.                                           *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note The date is read after the time, which unlocks the shadow registers for the next read.        *
+ ******************************************************************************************************/
+
+void rtc_read(RTC_TimeTypeDef *time, RTC_DateTypeDef *date)
+{
+	memset(time, 0, sizeof(*time));
+	memset(date, 0, sizeof(*date));
+
+	HAL_RTC_GetTime(&hrtc, time, RTC_FORMAT_BIN);
+	HAL_RTC_GetDate(&hrtc, date, RTC_FORMAT_BIN);
+}
+
 /*******************************************************************************************************
  * @brief Displays the current RTC time and date.													   *
  * 																									   *
@@ -382,32 +444,24 @@ void rtc_configure_date(RTC_DateTypeDef *date)
 
 void show_time_date(void)
 {
-	static char showtime[40];
-	static char showdate[40];
+	char *showtime;
+	char *showdate;
 	char* weekday;
 
 	RTC_DateTypeDef rtc_date;
 	RTC_TimeTypeDef rtc_time;
 
-	static char *time = showtime;
-	static char *date = showdate;
-
-	memset(&rtc_date, 0, sizeof(rtc_date));
-	memset(&rtc_time, 0, sizeof(rtc_time));
-
-	// Get the RTC current time
-	HAL_RTC_GetTime(&hrtc, &rtc_time, RTC_FORMAT_BIN);
-
-	// Get the RTC current date
-	HAL_RTC_GetDate(&hrtc, &rtc_date, RTC_FORMAT_BIN);
+	// Get the RTC current time and date
+	rtc_read(&rtc_time, &rtc_date);
 
 	// Get AM / PM
 	char *format;
 	format = (rtc_time.TimeFormat == RTC_HOURFORMAT12_AM) ? "AM" : "PM";
 
 	// Display time format: hh:mm:ss [AM/PM]
-	sprintf((char*)showtime, "%s:\t%02d:%02d:%02d [%s]", "\nCurrent Time & Date", rtc_time.Hours, rtc_time.Minutes, rtc_time.Seconds, format);
-	xQueueSend(q_print, &time, portMAX_DELAY);
+	showtime = print_pool_alloc(portMAX_DELAY);
+	snprintf(showtime, PRINT_POOL_BLOCK_SIZE, "%s:\t%02d:%02d:%02d [%s]", "\nCurrent Time & Date", rtc_time.Hours, rtc_time.Minutes, rtc_time.Seconds, format);
+	print_pool_send(showtime);
 
 	// Convert the user input day of the week from a number to a string
 	switch(rtc_date.WeekDay) {
@@ -435,6 +489,7 @@ void show_time_date(void)
 	}
 	
 	// Display date format: day, month-date-year
-	sprintf((char*)showdate, "\t%s, %02d-%02d-%02d\n", weekday, rtc_date.Month, rtc_date.Date, rtc_date.Year + 2000);
-	xQueueSend(q_print, &date, portMAX_DELAY);
+	showdate = print_pool_alloc(portMAX_DELAY);
+	snprintf(showdate, PRINT_POOL_BLOCK_SIZE, "\t%s, %02d-%02d-%02d\n", weekday, rtc_date.Month, rtc_date.Date, rtc_date.Year + 2000);
+	print_pool_send(showdate);
 }
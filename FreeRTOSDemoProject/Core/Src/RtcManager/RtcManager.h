@@ -20,11 +20,16 @@
  ****************************************************/
 
 #include "FreeRTOS.h"
+#include "main.h"
 
 /****************************************************
  *  Public functions                                *
  ****************************************************/
 
 void rtc_task(void *param);
+int validate_rtc_information(RTC_TimeTypeDef *time, RTC_DateTypeDef *date);
+void rtc_configure_time(RTC_TimeTypeDef *time);
+void rtc_configure_date(RTC_DateTypeDef *date);
+void rtc_read(RTC_TimeTypeDef *time, RTC_DateTypeDef *date);
 
 #endif /* RTCMANAGER_H_ */
@@ -0,0 +1,30 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ StatsManager ]                                                          |
+| FILE:       Config_StatsManager.h                                                     |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `StatsManager` module profiles the CPU with the DWT cycle counter. It          |
+|    accumulates the cycles spent in each task and each interrupt handler, counts       |
+|    context switches, and prints the CPU usage with the `Stats` command. It also       |
+|    monitors the stack headroom of each task and the FreeRTOS heap, printed with       |
+|    the `Mem` command.                                                                 |
+\*=====================================================================================*/
+
+#ifndef CONFIG_STATSMANAGER_H_
+#define CONFIG_STATSMANAGER_H_
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define STATS_MAX_TASKS				16 // Status array size, must cover every task; tasks numbered STATS_MAX_TASKS or above are not reported
+#define STATS_SAMPLE_MS				1000 // Period the 32-bit counters are folded into the report totals, must be well below the CYCCNT wrap time
+
+// Memory monitor
+#define STATS_MEM_REPORT_S			0 // Period of the automatic stack and heap report from startup (s), 0 to print it only with the `Mem` command
+#define STATS_MEM_REPORT_MAX_S		3600 // Longest report period accepted by the `Mem` command (s)
+#define STATS_STACK_LOW_WORDS		32 // Stack headroom below which a task is flagged with `!` in the report (words)
+
+#endif /* CONFIG_STATSMANAGER_H_ */
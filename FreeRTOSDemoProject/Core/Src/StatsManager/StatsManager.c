@@ -0,0 +1,589 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ StatsManager ]                                                          |
+| FILE:       StatsManager.c                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `StatsManager` module profiles the CPU with the DWT cycle counter. It          |
+|    accumulates the cycles spent in each task and each interrupt handler, counts       |
+|    context switches, and prints the CPU usage with the `Stats` command. It also       |
+|    monitors the stack headroom of each task and the FreeRTOS heap, printed with       |
+|    the `Mem` command.                                                                 |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_StatsManager.h"
+#include "Config_UartManager.h"
+#include "StatsManager.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "main.h"
+#include "Config_Resources.h"
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Interrupt handler counters, each entry is only written by its own handler
+typedef struct
+{
+	uint32_t cycles;			// Cycles spent in the handler, wraps around
+	uint32_t count;				// Handler executions, wraps around
+	uint32_t max_cycles;		// Longest execution since the last report
+	uint32_t start;				// Cycle counter at the handler entry
+} stats_isr_counter_t;
+
+// Totals since the last report
+typedef struct
+{
+	uint64_t elapsed;							// Cycles covered by the window
+	uint64_t task_cycles[STATS_MAX_TASKS];		// Cycles spent in each task, by task number
+	uint32_t task_switches[STATS_MAX_TASKS];	// Times each task was switched out, by task number
+	uint64_t isr_cycles[STATS_ISR_COUNT];		// Cycles spent in each interrupt handler
+	uint32_t isr_count[STATS_ISR_COUNT];		// Executions of each interrupt handler
+	uint32_t isr_max[STATS_ISR_COUNT];			// Longest execution of each interrupt handler
+	char task_name[STATS_MAX_TASKS][configMAX_TASK_NAME_LEN];
+} stats_window_t;
+
+// Counter values at the previous sample
+typedef struct
+{
+	uint32_t cycles;
+	uint32_t task_cycles[STATS_MAX_TASKS];
+	uint32_t task_switches[STATS_MAX_TASKS];
+	uint32_t isr_cycles[STATS_ISR_COUNT];
+	uint32_t isr_count[STATS_ISR_COUNT];
+} stats_snapshot_t;
+
+// Stack headroom of a task, by task number
+typedef struct
+{
+	TaskHandle_t task;							// Task handle, NULL for unused task numbers
+	uint32_t free;								// Least free stack ever, in words
+	char name[configMAX_TASK_NAME_LEN];
+} stats_stack_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void stats_sample(void);
+static void stats_sample_callback(TimerHandle_t xTimer);
+static uint32_t stats_permille(uint64_t cycles, uint64_t elapsed);
+static void stats_mem_callback(TimerHandle_t xTimer);
+static uint32_t stats_stack_depth(TaskHandle_t task);
+
+/****************************************************
+ *  Messages                                        *
+ ****************************************************/
+
+const char *msg_stats_header = "\n************************************\n"
+							   "*       CPU USAGE STATISTICS       *\n"
+							   "*                                  *\n";
+const char *msg_stats_isr = "*                                  *\n"
+							"* Handler   CPU (%)  Count  Max us *\n";
+const char *msg_stats_footer = "*                                  *\n"
+							   "************************************\n";
+const char *msg_mem_header = "\n************************************\n"
+							 "*       STACK AND HEAP USAGE       *\n"
+							 "*                                  *\n"
+							 "* Stack words   Size  Peak  Free   *\n";
+const char *msg_mem_heap_unused = "* Heap unused since reset          *\n";
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *const stats_isr_name[STATS_ISR_COUNT] = {
+	"TIM6", "TIM7", "EXTI4", "EXTI9_5", "USART2", "DMA RX", "DMA TX", "EXTI0", "SPI RX", "SPI TX"
+};
+
+// Raw counters, updated from the interrupt handlers and the context switch hook
+static stats_isr_counter_t stats_isr[STATS_ISR_COUNT];
+static volatile uint32_t stats_isr_cycles = 0;		// Cycles spent in interrupt handlers, nested handlers counted once
+static uint32_t stats_isr_depth = 0;				// Interrupt handler nesting depth
+static uint32_t stats_isr_outer_start = 0;			// Cycle counter at the outermost handler entry
+static uint32_t stats_clock_base = 0;				// Cycle counter when the scheduler started
+static uint32_t stats_task_switches[STATS_MAX_TASKS];
+static uint32_t stats_last_task = 0;
+
+// Report state, only accessed with the scheduler suspended
+static TaskStatus_t stats_task_status[STATS_MAX_TASKS];
+static stats_snapshot_t stats_last;
+static stats_window_t stats_window;
+static stats_window_t stats_report;
+static TimerHandle_t stats_timer;
+static CCM_BSS StaticTimer_t stats_timer_buffer;
+
+// Memory monitor, sampled with the counters
+static stats_stack_t stats_stack[STATS_MAX_TASKS];
+static stats_stack_t stats_stack_report[STATS_MAX_TASKS];
+static size_t stats_heap_min_largest = SIZE_MAX;	// Smallest largest free block seen by a sample, in bytes
+static TimerHandle_t stats_mem_timer;
+static CCM_BSS StaticTimer_t stats_mem_timer_buffer;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Starts the statistics sampling timer.                                                        *
+ *                                                                                                     *
+ * The per-task run time counters and the interrupt handler counters are 32-bit cycle counts, which    *
+ * wrap after a few minutes. This function starts a software timer that folds them into 64-bit totals  *
+ * every `STATS_SAMPLE_MS`, so a report can cover any window. The same samples record the stack        *
+ * headroom of each task and the heap fragmentation. The memory report timer is also created, and      *
+ * started if `STATS_MEM_REPORT_S` is not 0.                                                           *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from `main` after the kernel objects are created and before the scheduler starts.      *
+ ******************************************************************************************************/
+
+void stats_init(void)
+{
+	stats_timer = xTimerCreateStatic("stats_timer", pdMS_TO_TICKS(STATS_SAMPLE_MS), pdTRUE, NULL, stats_sample_callback, &stats_timer_buffer);
+	configASSERT(NULL != stats_timer);
+	xTimerStart(stats_timer, 0);
+
+	stats_mem_timer = xTimerCreateStatic("mem_timer", pdMS_TO_TICKS(1000), pdTRUE, NULL, stats_mem_callback, &stats_mem_timer_buffer);
+	configASSERT(NULL != stats_mem_timer);
+#if (STATS_MEM_REPORT_S > 0)
+	xTimerChangePeriod(stats_mem_timer, pdMS_TO_TICKS(STATS_MEM_REPORT_S * 1000U), 0);
+#endif
+}
+
+/*******************************************************************************************************
+ * @brief Enables the cycle counter used as the run time statistics clock.                             *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called by the kernel through `portCONFIGURE_TIMER_FOR_RUN_TIME_STATS` when the scheduler      *
+ *       starts.                                                                                       *
+ ******************************************************************************************************/
+
+void stats_clock_init(void)
+{
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	stats_clock_base = DWT->CYCCNT;
+	stats_last.cycles = stats_clock_base;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the run time statistics clock.                                                       *
+ *                                                                                                     *
+ * The clock counts the cycles since the scheduler started, minus the cycles spent in interrupt        *
+ * handlers, so the time a handler preempts a task is not charged to that task. The kernel takes its   *
+ * first switch-in time as zero, so the clock must also start from zero.                               *
+ *                                                                                                     *
+ * @return uint32_t Task cycles, wraps around.                                                         *
+ *                                                                                                     *
+ * @note Called by the kernel through `portGET_RUN_TIME_COUNTER_VALUE` on every context switch.        *
+ ******************************************************************************************************/
+
+uint32_t stats_run_time(void)
+{
+	return DWT->CYCCNT - stats_clock_base - stats_isr_cycles;
+}
+
+/*******************************************************************************************************
+ * @brief Counts a context switch.                                                                     *
+ *                                                                                                     *
+ * A switch is counted each time a task other than the last one gives up the CPU, so a task that is    *
+ * selected again after a yield is not counted twice.                                                  *
+ *                                                                                                     *
+ * @param task_number [uint32_t] FreeRTOS task number of the task being switched out.                  *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called by the kernel through `traceTASK_SWITCHED_OUT` with interrupts masked.                 *
+ ******************************************************************************************************/
+
+void stats_task_switched_out(uint32_t task_number)
+{
+	if(task_number != stats_last_task) {
+		stats_last_task = task_number;
+		if(task_number < STATS_MAX_TASKS) {
+			stats_task_switches[task_number]++;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Marks the entry of an interrupt handler.                                                     *
+ *                                                                                                     *
+ * @param isr [stats_isr_t] Interrupt handler.                                                         *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Interrupts are masked while the nesting depth is updated, a higher priority handler can       *
+ *       preempt the handler between the entry and exit calls.                                         *
+ ******************************************************************************************************/
+
+void stats_isr_enter(stats_isr_t isr)
+{
+	uint32_t primask = __get_PRIMASK();
+	__set_PRIMASK(1);
+
+	uint32_t now = DWT->CYCCNT;
+	stats_isr[isr].start = now;
+	if(0 == stats_isr_depth++) {
+		stats_isr_outer_start = now;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/*******************************************************************************************************
+ * @brief Marks the exit of an interrupt handler.                                                      *
+ *                                                                                                     *
+ * This function adds the handler duration to its counters. The time spent in nested handlers is       *
+ * included in the outer handler, but only counted once towards the total interrupt time.              *
+ *                                                                                                     *
+ * @param isr [stats_isr_t] Interrupt handler.                                                         *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void stats_isr_exit(stats_isr_t isr)
+{
+	uint32_t primask = __get_PRIMASK();
+	__set_PRIMASK(1);
+
+	uint32_t now = DWT->CYCCNT;
+	uint32_t cycles = now - stats_isr[isr].start;
+	stats_isr[isr].cycles += cycles;
+	stats_isr[isr].count++;
+	if(cycles > stats_isr[isr].max_cycles) {
+		stats_isr[isr].max_cycles = cycles;
+	}
+	if(0 == --stats_isr_depth) {
+		stats_isr_cycles += now - stats_isr_outer_start;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/*******************************************************************************************************
+ * @brief Prints the CPU usage statistics.                                                             *
+ *                                                                                                     *
+ * This function samples the counters, then resets the totals so the next report covers a fresh window.*
+ * It prints the share of the CPU used by each task and each interrupt handler, the context switch     *
+ * count of each task, and the longest execution of each handler.                                      *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void print_stats_report(void)
+{
+	// Snapshot and reset the totals
+	vTaskSuspendAll();
+	stats_sample();
+	stats_report = stats_window;
+	memset(&stats_window, 0, sizeof(stats_window));
+	memcpy(stats_window.task_name, stats_report.task_name, sizeof(stats_window.task_name));
+	for(int i = 0; i < STATS_ISR_COUNT; i++) {
+		stats_report.isr_max[i] = stats_isr[i].max_cycles;
+		stats_isr[i].max_cycles = 0;
+	}
+	xTaskResumeAll();
+
+	uint64_t elapsed = stats_report.elapsed;
+	uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+	uint64_t isr_total = 0;
+	uint32_t switches = 0;
+	for(int i = 0; i < STATS_ISR_COUNT; i++) {
+		isr_total += stats_report.isr_cycles[i];
+	}
+	for(int i = 0; i < STATS_MAX_TASKS; i++) {
+		switches += stats_report.task_switches[i];
+	}
+	uint32_t isr_permille = stats_permille(isr_total, elapsed);
+
+	// Send statistics header message
+	xQueueSend(q_print, &msg_stats_header, portMAX_DELAY);
+
+	// Print the window and the totals
+	char *showtotals = print_pool_alloc(portMAX_DELAY);
+	snprintf(showtotals, PRINT_POOL_BLOCK_SIZE, "* Window:             %08" PRIu32 " ms  *"
+											  "\n* Context switches:   %08" PRIu32 "     *"
+											  "\n* Interrupts:         %3" PRIu32 ".%" PRIu32 " %%      *"
+											  "\n*                                  *"
+											  "\n* Task         CPU (%%)   Switches  *\n",
+											  (uint32_t)(elapsed / cycles_per_us / 1000U), switches,
+											  isr_permille / 10, isr_permille % 10);
+	print_pool_send(showtotals);
+
+	// Print one line per task, by task number
+	for(int i = 0; i < STATS_MAX_TASKS; i++) {
+		if('\0' == stats_report.task_name[i][0]) {
+			continue;
+		}
+		uint32_t permille = stats_permille(stats_report.task_cycles[i], elapsed);
+		char *showtask = print_pool_alloc(portMAX_DELAY);
+		snprintf(showtask, PRINT_POOL_BLOCK_SIZE, "* %-12.12s %3" PRIu32 ".%" PRIu32 " %%   %08" PRIu32 "  *\n",
+				 stats_report.task_name[i], permille / 10, permille % 10, stats_report.task_switches[i]);
+		print_pool_send(showtask);
+	}
+
+	// Print one line per interrupt handler
+	xQueueSend(q_print, &msg_stats_isr, portMAX_DELAY);
+	for(int i = 0; i < STATS_ISR_COUNT; i++) {
+		uint32_t permille = stats_permille(stats_report.isr_cycles[i], elapsed);
+		uint32_t max_tenths = stats_report.isr_max[i] * 10U / cycles_per_us;
+		char *showisr = print_pool_alloc(portMAX_DELAY);
+		snprintf(showisr, PRINT_POOL_BLOCK_SIZE, "* %-9s %3" PRIu32 ".%" PRIu32 " %% %07" PRIu32 " %4" PRIu32 ".%" PRIu32 " *\n",
+				 stats_isr_name[i], permille / 10, permille % 10, stats_report.isr_count[i],
+				 max_tenths / 10, max_tenths % 10);
+		print_pool_send(showisr);
+	}
+
+	// Send statistics footer message
+	xQueueSend(q_print, &msg_stats_footer, portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Prints the stack and heap usage.                                                             *
+ *                                                                                                     *
+ * For each task, this function prints its stack depth, the most stack it has ever used and the least  *
+ * it has had left, in words, from the high-water mark the kernel keeps by painting the stacks. Tasks  *
+ * with less than `STATS_STACK_LOW_WORDS` left are flagged with `!`. For the heap, it prints the free  *
+ * space now and at its lowest, and the free block distribution: the number of free blocks, the        *
+ * largest and smallest, and the share of the free space outside the largest block (fragmentation).    *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called by the `Mem` command, and by the message handler task when the memory report timer     *
+ *       expires. Unlike the CPU usage, nothing is reset: every figure covers the time since reset.    *
+ * @note Must be called from task context, other than the timer service task.                          *
+ ******************************************************************************************************/
+
+void print_mem_report(void)
+{
+	HeapStats_t heap;
+
+	// Take a fresh sample of the stacks
+	vTaskSuspendAll();
+	stats_sample();
+	memcpy(stats_stack_report, stats_stack, sizeof(stats_stack_report));
+	xTaskResumeAll();
+	vPortGetHeapStats(&heap);
+
+	// Send memory header message
+	xQueueSend(q_print, &msg_mem_header, portMAX_DELAY);
+
+	// Print one line per task, by task number; depth and peak are not known for tasks outside of the resource table
+	for(int i = 0; i < STATS_MAX_TASKS; i++) {
+		if(NULL == stats_stack_report[i].task) {
+			continue;
+		}
+		uint32_t depth = stats_stack_depth(stats_stack_report[i].task);
+		uint32_t free = stats_stack_report[i].free;
+		char flag = (free < STATS_STACK_LOW_WORDS) ? '!' : ' ';
+		char *showstack = print_pool_alloc(portMAX_DELAY);
+		if(depth > 0) {
+			snprintf(showstack, PRINT_POOL_BLOCK_SIZE, "* %-12.12s %5" PRIu32 " %5" PRIu32 " %5" PRIu32 " %c *\n",
+					 stats_stack_report[i].name, depth, depth - free, free, flag);
+		}
+		else {
+			snprintf(showstack, PRINT_POOL_BLOCK_SIZE, "* %-12.12s     -     - %5" PRIu32 " %c *\n",
+					 stats_stack_report[i].name, free, flag);
+		}
+		print_pool_send(showstack);
+	}
+
+	// Heap usage; heap_4 only initializes the heap on the first allocation
+	char *showheap = print_pool_alloc(portMAX_DELAY);
+	snprintf(showheap, PRINT_POOL_BLOCK_SIZE, "*                                  *"
+											"\n* Heap size:          %08" PRIu32 " B   *\n",
+											(uint32_t)configTOTAL_HEAP_SIZE);
+	print_pool_send(showheap);
+	if(0 == heap.xNumberOfSuccessfulAllocations) {
+		xQueueSend(q_print, &msg_mem_heap_unused, portMAX_DELAY);
+		xQueueSend(q_print, &msg_stats_footer, portMAX_DELAY);
+		return;
+	}
+
+	uint32_t fragmentation = 0;
+	if(heap.xAvailableHeapSpaceInBytes > 0) {
+		fragmentation = (uint32_t)((heap.xAvailableHeapSpaceInBytes - heap.xSizeOfLargestFreeBlockInBytes) * 100U
+								   / heap.xAvailableHeapSpaceInBytes);
+	}
+	showheap = print_pool_alloc(portMAX_DELAY);
+	snprintf(showheap, PRINT_POOL_BLOCK_SIZE, "* Free now:           %08" PRIu32 " B   *"
+											"\n* Minimum ever free:  %08" PRIu32 " B   *"
+											"\n* Allocations:        %08" PRIu32 "     *"
+											"\n* Frees:              %08" PRIu32 "     *\n",
+											(uint32_t)heap.xAvailableHeapSpaceInBytes, (uint32_t)heap.xMinimumEverFreeBytesRemaining,
+											(uint32_t)heap.xNumberOfSuccessfulAllocations, (uint32_t)heap.xNumberOfSuccessfulFrees);
+	print_pool_send(showheap);
+	showheap = print_pool_alloc(portMAX_DELAY);
+	snprintf(showheap, PRINT_POOL_BLOCK_SIZE, "* Free blocks:        %08" PRIu32 "     *"
+											"\n* Largest free block: %08" PRIu32 " B   *"
+											"\n* Smallest block:     %08" PRIu32 " B   *"
+											"\n* Lowest largest:     %08" PRIu32 " B   *"
+											"\n* Fragmentation:      %3" PRIu32 " %%        *\n",
+											(uint32_t)heap.xNumberOfFreeBlocks, (uint32_t)heap.xSizeOfLargestFreeBlockInBytes,
+											(uint32_t)heap.xSizeOfSmallestFreeBlockInBytes,
+											(uint32_t)((SIZE_MAX == stats_heap_min_largest) ? heap.xSizeOfLargestFreeBlockInBytes : stats_heap_min_largest),
+											fragmentation);
+	print_pool_send(showheap);
+
+	// Send memory footer message
+	xQueueSend(q_print, &msg_stats_footer, portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Sets the period of the automatic memory report.                                              *
+ *                                                                                                     *
+ * @param seconds [uint32_t] Report period in seconds, 0 to stop the automatic report.                 *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called from task context, other than the timer service task.                          *
+ ******************************************************************************************************/
+
+void stats_mem_report_period(uint32_t seconds)
+{
+	if(0 == seconds) {
+		xTimerStop(stats_mem_timer, portMAX_DELAY);
+	}
+	else {
+		// Changing the period also starts the timer
+		xTimerChangePeriod(stats_mem_timer, pdMS_TO_TICKS(seconds * 1000U), portMAX_DELAY);
+	}
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Folds the 32-bit counters into the report totals.                                            *
+ *                                                                                                     *
+ * This function adds the counter increments since the previous sample to the totals. The increments   *
+ * are computed with unsigned arithmetic, so a counter that wrapped once in between is still correct.  *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called with the scheduler suspended, at least once per wrap of the cycle counter.     *
+ ******************************************************************************************************/
+
+static void stats_sample(void)
+{
+	UBaseType_t tasks = uxTaskGetSystemState(stats_task_status, STATS_MAX_TASKS, NULL);
+	uint32_t now = DWT->CYCCNT;
+
+	stats_window.elapsed += now - stats_last.cycles;
+	stats_last.cycles = now;
+
+	// Task counters are indexed by task number, which stays stable while the array order does not
+	for(UBaseType_t i = 0; i < tasks; i++) {
+		UBaseType_t n = stats_task_status[i].xTaskNumber;
+		if(n >= STATS_MAX_TASKS) {
+			continue;
+		}
+		uint32_t run_time = stats_task_status[i].ulRunTimeCounter;
+		uint32_t switches = stats_task_switches[n];
+		stats_window.task_cycles[n] += run_time - stats_last.task_cycles[n];
+		stats_window.task_switches[n] += switches - stats_last.task_switches[n];
+		stats_last.task_cycles[n] = run_time;
+		stats_last.task_switches[n] = switches;
+		strncpy(stats_window.task_name[n], stats_task_status[i].pcTaskName, configMAX_TASK_NAME_LEN - 1);
+
+		// The kernel keeps the least free stack ever, computed here by uxTaskGetSystemState
+		stats_stack[n].task = stats_task_status[i].xHandle;
+		stats_stack[n].free = stats_task_status[i].usStackHighWaterMark;
+		strncpy(stats_stack[n].name, stats_task_status[i].pcTaskName, configMAX_TASK_NAME_LEN - 1);
+	}
+
+	// Heap fragmentation, the kernel keeps the minimum free space ever but not the smallest largest block
+	HeapStats_t heap;
+	vPortGetHeapStats(&heap);
+	if((heap.xNumberOfSuccessfulAllocations > 0) && (heap.xSizeOfLargestFreeBlockInBytes < stats_heap_min_largest)) {
+		stats_heap_min_largest = heap.xSizeOfLargestFreeBlockInBytes;
+	}
+
+	// Interrupt handler counters
+	for(int i = 0; i < STATS_ISR_COUNT; i++) {
+		uint32_t cycles = stats_isr[i].cycles;
+		uint32_t count = stats_isr[i].count;
+		stats_window.isr_cycles[i] += cycles - stats_last.isr_cycles[i];
+		stats_window.isr_count[i] += count - stats_last.isr_count[i];
+		stats_last.isr_cycles[i] = cycles;
+		stats_last.isr_count[i] = count;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sampling timer callback.                                                                     *
+ *                                                                                                     *
+ * @param xTimer [TimerHandle_t] Timer handle.                                                         *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void stats_sample_callback(TimerHandle_t xTimer)
+{
+	vTaskSuspendAll();
+	stats_sample();
+	xTaskResumeAll();
+}
+
+/*******************************************************************************************************
+ * @brief Memory report timer callback.                                                                *
+ *                                                                                                     *
+ * The report waits for print pool blocks and queue space, which must not block the timer service      *
+ * task, so the callback only asks the message handler task to print it.                               *
+ *                                                                                                     *
+ * @param xTimer [TimerHandle_t] Timer handle.                                                         *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void stats_mem_callback(TimerHandle_t xTimer)
+{
+	xTaskNotify(handle_message_handler_task, UART_RX_EVT_MEM_REPORT, eSetBits);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the stack depth a task was created with.                                             *
+ *                                                                                                     *
+ * @param task [TaskHandle_t] Task handle.                                                             *
+ * @return uint32_t Stack depth in words, 0 for a task outside of the resource table and the kernel.   *
+ ******************************************************************************************************/
+
+static uint32_t stats_stack_depth(TaskHandle_t task)
+{
+#define TASK_DEPTH(function, name, depth, priority, handle) \
+	if(task == handle) { \
+		return RESOURCE_STACK_DEPTH(depth); \
+	}
+	RESOURCE_TASKS(TASK_DEPTH)
+
+	if(task == xTaskGetIdleTaskHandle()) {
+		return configMINIMAL_STACK_SIZE;
+	}
+	if(task == xTimerGetTimerDaemonTaskHandle()) {
+		return configTIMER_TASK_STACK_DEPTH;
+	}
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Converts a cycle count to a share of the window.                                             *
+ *                                                                                                     *
+ * @param cycles [uint64_t] Cycles spent.                                                              *
+ * @param elapsed [uint64_t] Cycles covered by the window.                                             *
+ * @return uint32_t Share of the window in tenths of a percent, rounded to nearest.                    *
+ ******************************************************************************************************/
+
+static uint32_t stats_permille(uint64_t cycles, uint64_t elapsed)
+{
+	if(0 == elapsed) {
+		return 0;
+	}
+	return (uint32_t)((cycles * 1000U + elapsed / 2U) / elapsed);
+}
@@ -0,0 +1,57 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ StatsManager ]                                                          |
+| FILE:       StatsManager.h                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `StatsManager` module profiles the CPU with the DWT cycle counter. It          |
+|    accumulates the cycles spent in each task and each interrupt handler, counts       |
+|    context switches, and prints the CPU usage with the `Stats` command. It also       |
+|    monitors the stack headroom of each task and the FreeRTOS heap, printed with       |
+|    the `Mem` command.                                                                 |
+\*=====================================================================================*/
+
+#ifndef STATSMANAGER_H_
+#define STATSMANAGER_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef enum {
+	STATS_ISR_TIM6 = 0,		// HAL time base
+	STATS_ISR_TIM7,			// Motor control loop
+	STATS_ISR_EXTI4,		// Encoder A
+	STATS_ISR_EXTI9_5,		// Encoder B
+	STATS_ISR_USART2,		// UART idle line and errors
+	STATS_ISR_DMA_RX,		// UART reception, DMA1 stream 5
+	STATS_ISR_DMA_TX,		// UART transmission, DMA1 stream 6
+	STATS_ISR_EXTI0,		// Accelerometer INT1
+	STATS_ISR_SPI_RX,		// Accelerometer reception, DMA2 stream 0
+	STATS_ISR_SPI_TX,		// Accelerometer transmission, DMA2 stream 3
+	STATS_ISR_COUNT
+} stats_isr_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void stats_init(void);
+void stats_clock_init(void);
+uint32_t stats_run_time(void);
+void stats_task_switched_out(uint32_t task_number);
+void stats_isr_enter(stats_isr_t isr);
+void stats_isr_exit(stats_isr_t isr);
+void print_stats_report(void);
+void print_mem_report(void);
+void stats_mem_report_period(uint32_t seconds);
+
+#endif /* STATSMANAGER_H_ */
@@ -0,0 +1,202 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       Command.c                                                                 |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Command` utility dispatches console input through per-menu command            |
+|    tables. Each table maps command tokens to handlers and is indexed with a           |
+|    perfect hash, so a lookup costs one hash and one string compare.                   |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Command.h"
+#include <string.h>
+
+#if (COMMAND_HASH_SLOTS & (COMMAND_HASH_SLOTS - 1)) || (COMMAND_HASH_SLOTS > 256)
+#error "COMMAND_HASH_SLOTS must be a power of two no larger than 256"
+#endif
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static const command_t *command_match(const command_table_t *table, uint32_t hash, const char *token, uint32_t len);
+static inline uint32_t command_hash_init(uint32_t seed);
+static inline uint32_t command_hash_step(uint32_t hash, char c);
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Builds the hash index of a command table.                                                    *
+ *                                                                                                     *
+ * This function searches for a hash seed that places every token of the command list in its own       *
+ * slot, then fills the slots with the command indices. The command list itself stays constant.        *
+ *                                                                                                     *
+ * @param table [command_table_t*] Table set up with `COMMAND_TABLE`.                                  *
+ * @return int                                                                                         *
+ * @retval 0 if the index was built.                                                                   *
+ * @retval -1 if the list does not fit in `COMMAND_HASH_SLOTS`, or no seed was found within            *
+ *         `COMMAND_SEED_TRIES`.                                                                       *
+ *                                                                                                     *
+ * @note Must be called once before the first lookup, from the task that owns the table.               *
+ ******************************************************************************************************/
+
+int command_table_init(command_table_t *table)
+{
+	if(table->count >= COMMAND_HASH_SLOTS) {
+		return -1;
+	}
+
+	for(uint32_t seed = 0; seed < COMMAND_SEED_TRIES; seed++) {
+		uint32_t i;
+
+		memset(table->slot, 0, sizeof(table->slot));
+		for(i = 0; i < table->count; i++) {
+			const char *name = table->commands[i].name;
+			uint32_t hash = command_hash_init(seed);
+			uint32_t len = 0;
+
+			while('\0' != name[len]) {
+				hash = command_hash_step(hash, name[len++]);
+			}
+
+			uint32_t slot = hash & (COMMAND_HASH_SLOTS - 1);
+			if((0 != table->slot[slot]) || (len > UINT8_MAX)) {
+				break;
+			}
+			table->slot[slot] = (uint8_t)(i + 1);
+			table->slot_len[slot] = (uint8_t)len;
+		}
+
+		// Every token landed in an empty slot
+		if(i == table->count) {
+			table->seed = seed;
+			return 0;
+		}
+	}
+
+	memset(table->slot, 0, sizeof(table->slot));
+	return -1;
+}
+
+/*******************************************************************************************************
+ * @brief Looks up a command token.                                                                    *
+ *                                                                                                     *
+ * @param table [const command_table_t*] Initialized command table.                                    *
+ * @param token [const char*] Token to look up, not necessarily null terminated.                       *
+ * @param len [uint32_t] Length of the token.                                                          *
+ * @return const command_t* Matching command, or NULL if the token is not in the table.                *
+ ******************************************************************************************************/
+
+const command_t *command_find(const command_table_t *table, const char *token, uint32_t len)
+{
+	uint32_t hash = command_hash_init(table->seed);
+
+	for(uint32_t i = 0; i < len; i++) {
+		hash = command_hash_step(hash, token[i]);
+	}
+	return command_match(table, hash, token, len);
+}
+
+/*******************************************************************************************************
+ * @brief Runs the handler of a command line.                                                          *
+ *                                                                                                     *
+ * The first word of the line is the command token, anything after the first space is passed to the    *
+ * handler as its arguments. A line with arguments only matches commands that take arguments. The      *
+ * token is hashed while its end is searched, so the line is scanned once.                             *
+ *                                                                                                     *
+ * @param table [const command_table_t*] Initialized command table.                                    *
+ * @param line [const char*] Null terminated command line.                                             *
+ * @return int                                                                                         *
+ * @retval 1 if a handler was run.                                                                     *
+ * @retval 0 if the line does not match any command.                                                   *
+ ******************************************************************************************************/
+
+int command_dispatch(const command_table_t *table, const char *line)
+{
+	uint32_t hash = command_hash_init(table->seed);
+	uint32_t len = 0;
+
+	while(('\0' != line[len]) && (' ' != line[len])) {
+		hash = command_hash_step(hash, line[len++]);
+	}
+
+	const command_t *cmd = command_match(table, hash, line, len);
+	if(NULL == cmd) {
+		return 0;
+	}
+
+	// Arguments follow the space after the token
+	if('\0' == line[len]) {
+		cmd->handler("");
+	}
+	else if(cmd->takes_args) {
+		cmd->handler(&line[len + 1]);
+	}
+	else {
+		return 0;
+	}
+	return 1;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Compares a token with the only command that can match its hash.                              *
+ *                                                                                                     *
+ * @param table [const command_table_t*] Initialized command table.                                    *
+ * @param hash [uint32_t] Hash of the token.                                                           *
+ * @param token [const char*] Token to look up, not necessarily null terminated.                       *
+ * @param len [uint32_t] Length of the token.                                                          *
+ * @return const command_t* Matching command, or NULL if the token is not in the table.                *
+ ******************************************************************************************************/
+
+static const command_t *command_match(const command_table_t *table, uint32_t hash, const char *token, uint32_t len)
+{
+	uint32_t slot = hash & (COMMAND_HASH_SLOTS - 1);
+	uint8_t index = table->slot[slot];
+
+	if((0 == index) || (table->slot_len[slot] != len)) {
+		return NULL;
+	}
+
+	const command_t *cmd = &table->commands[index - 1];
+	if(0 != memcmp(cmd->name, token, len)) {
+		return NULL;
+	}
+	return cmd;
+}
+
+/*******************************************************************************************************
+ * @brief Starts an FNV-1a hash, with the seed mixed into the offset basis.                            *
+ *                                                                                                     *
+ * @param seed [uint32_t] Hash seed of the table.                                                      *
+ * @return uint32_t Initial hash value.                                                                *
+ ******************************************************************************************************/
+
+static inline uint32_t command_hash_init(uint32_t seed)
+{
+	return 2166136261UL ^ (seed * 16777619UL);
+}
+
+/*******************************************************************************************************
+ * @brief Adds one character to an FNV-1a hash.                                                        *
+ *                                                                                                     *
+ * @param hash [uint32_t] Hash so far.                                                                 *
+ * @param c [char] Next character of the token.                                                        *
+ * @return uint32_t Updated hash value.                                                                *
+ ******************************************************************************************************/
+
+static inline uint32_t command_hash_step(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)c) * 16777619UL;
+}
@@ -0,0 +1,61 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       Command.h                                                                 |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Command` utility dispatches console input through per-menu command            |
+|    tables. Each table maps command tokens to handlers and is indexed with a           |
+|    perfect hash, so a lookup costs one hash and one string compare.                   |
+\*=====================================================================================*/
+
+#ifndef COMMAND_H_
+#define COMMAND_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_UartManager.h"
+#include <stdint.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef void (*command_handler_t)(const char *args); // Called with the text after the token, "" if there is none
+
+typedef struct
+{
+	const char *name;			// Command token, matched exactly
+	command_handler_t handler;	// Function run when the token is entered
+	uint8_t takes_args;			// Non-zero if the token may be followed by a space and arguments
+} command_t;
+
+typedef struct
+{
+	const command_t *commands;			// Constant command list of the menu
+	uint32_t count;						// Number of commands in the list
+	uint32_t seed;						// Hash seed for which no two tokens share a slot
+	uint8_t slot[COMMAND_HASH_SLOTS];	// Command index + 1 for each hash slot, 0 if the slot is empty
+	uint8_t slot_len[COMMAND_HASH_SLOTS];	// Token length of the command in each slot
+} command_table_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+int command_table_init(command_table_t *table);
+const command_t *command_find(const command_table_t *table, const char *token, uint32_t len);
+int command_dispatch(const command_table_t *table, const char *line);
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+// Static initializer for the table of a command list, the hash index is built by command_table_init
+#define COMMAND_TABLE(list)			{ (list), sizeof(list) / sizeof((list)[0]), 0, {0}, {0} }
+
+#endif /* COMMAND_H_ */
@@ -16,14 +16,46 @@
 #ifndef CONFIG_UARTMANAGER_H_
 #define CONFIG_UARTMANAGER_H_
 
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+// UART reception
+#define UART_RX_DMA_BUF_SIZE		64 // Circular DMA buffer for USART2 reception (bytes)
+#define UART_RX_RING_SIZE			256 // Ring buffer between the reception ISR and the message handler task (bytes, power of two)
+#define UART_RX_CHUNK_SIZE			32 // Bytes copied out of the ring buffer per read by the message handler task
+#define UART_TX_DMA_BUF_SIZE		128 // Each of the two transmit buffers used by the print task (bytes)
+#define UART_TX_RETRIES				3 // Further attempts to start a transmission the HAL refused before its bytes are dropped
+#define UART_TX_RETRY_MS			1 // Delay between two attempts to start a transmission (ms)
+#define PRINT_POOL_BLOCK_COUNT		8 // Number of message buffers in the print message pool
+#define PRINT_POOL_BLOCK_SIZE		256 // Size of each print message buffer (bytes, including null terminator)
+#define UART_RX_EVT_DATA			( 1UL << 0 ) // Notification bit: DMA write position advanced (idle line, half or full buffer)
+#define UART_RX_EVT_RESTART			( 1UL << 1 ) // Notification bit: DMA reception restarted after a UART error
+#define UART_RX_EVT_READY			( 1UL << 2 ) // Notification bit: a task waits for the next command of a batch
+#define UART_RX_EVT_MEM_REPORT		( 1UL << 3 ) // Notification bit: the memory report timer expired, see `stats_mem_report_period`
+#define UART_RX_EVT_MOTOR_REPORT	( 1UL << 4 ) // Notification bit: the motor report timer expired, see `motor_report_callback`
+
+// Command tables
+#define COMMAND_HASH_SLOTS			32 // Hash slots per command table (power of two, more than the commands of any menu)
+#define COMMAND_SEED_TRIES			4096 // Hash seeds tried by command_table_init before giving up
+
+// Batch mode
+#define UART_RX_LINE_SIZE			128 // Longest received line and message payload, `;` separated batches included (bytes, including null terminator)
+#define BATCH_SCRIPT_SIZE			256 // Commands collected between `Begin` and `End` (bytes, including null terminator)
+#define BATCH_CMD_TIMEOUT_MS		2000 // Time a batch command may take before the next task is ready for input
+
 /****************************************************
  *  Messages                                        *
  ****************************************************/
 
 // General system messages
 extern const char *msg_inv_uart;
+extern const char *msg_line_too_long;
 
 // Main menu
 extern const char *msg_main_menu;
 
+// Batch mode
+extern const char *msg_batch_overflow;
+
 #endif /* CONFIG_UARTMANAGER_H_ */
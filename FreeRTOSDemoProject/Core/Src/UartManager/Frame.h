@@ -0,0 +1,46 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       Frame.h                                                                   |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Frame` utility implements the byte level framing of the binary protocol:      |
+|    COBS encoding, so that frames can be delimited by zero bytes on the UART,          |
+|    the CRC-16 appended to every frame, and little-endian field access. It has         |
+|    no dependencies and is shared with the host client.                                |
+\*=====================================================================================*/
+
+#ifndef FRAME_H_
+#define FRAME_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+uint16_t frame_crc16(const uint8_t *data, uint32_t len);
+uint32_t frame_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst);
+int32_t frame_cobs_decode(const uint8_t *src, uint32_t len, uint8_t *dst, uint32_t size);
+void frame_put_u16(uint8_t *dst, uint16_t value);
+void frame_put_u32(uint8_t *dst, uint32_t value);
+void frame_put_f32(uint8_t *dst, float value);
+uint16_t frame_get_u16(const uint8_t *src);
+uint32_t frame_get_u32(const uint8_t *src);
+float frame_get_f32(const uint8_t *src);
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define FRAME_DELIMITER				0x00 // Byte separating encoded frames on the wire
+
+// Largest COBS encoding of `len` bytes: one overhead byte per 254 bytes, at least one
+#define FRAME_COBS_MAX(len)			((len) + ((len) / 254) + 1)
+
+#endif /* FRAME_H_ */
@@ -0,0 +1,318 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       Protocol.c                                                                |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Protocol` module answers binary requests received on USART2 next to           |
+|    the text menus. Requests and responses are COBS encoded frames protected by        |
+|    a CRC-16. Requests are executed in the message handler task and answered           |
+|    with a typed response, without going through the menu tasks.                       |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Protocol.h"
+#include "Frame.h"
+#include "UartManager.h"
+#include "Config_UartManager.h"
+#include "MotorManager.h"
+#include "LedManager.h"
+#include "RtcManager.h"
+#include "AccManager.h"
+#include "AccSensor.h"
+#include "main.h"
+#include <string.h>
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Executes a request with a valid length, fills the response payload and returns the response status
+typedef uint8_t (*proto_handler_t)(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+
+typedef struct
+{
+	proto_handler_t handler;	// NULL for unassigned command numbers
+	uint8_t req_len;			// Exact request payload length
+} proto_command_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void proto_respond(uint8_t seq, uint8_t cmd, uint8_t status, const uint8_t *payload, uint32_t len);
+static uint8_t proto_ping(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_get_speed(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_set_speed(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_get_pid(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_set_pid(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_get_led(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_set_led(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_get_rtc(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_set_rtc(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+static uint8_t proto_get_acc(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Commands, indexed by command number
+static const proto_command_t proto_commands[PROTO_CMD_COUNT] = {
+	[PROTO_CMD_PING]		= { proto_ping,			0 },
+	[PROTO_CMD_GET_SPEED]	= { proto_get_speed,	0 },
+	[PROTO_CMD_SET_SPEED]	= { proto_set_speed,	4 },
+	[PROTO_CMD_GET_PID]		= { proto_get_pid,		0 },
+	[PROTO_CMD_SET_PID]		= { proto_set_pid,		12 },
+	[PROTO_CMD_GET_LED]		= { proto_get_led,		0 },
+	[PROTO_CMD_SET_LED]		= { proto_set_led,		1 },
+	[PROTO_CMD_GET_RTC]		= { proto_get_rtc,		0 },
+	[PROTO_CMD_SET_RTC]		= { proto_set_rtc,		sizeof(proto_rtc_t) },
+	[PROTO_CMD_GET_ACC]		= { proto_get_acc,		0 },
+};
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Decodes, executes and answers one binary request.                                            *
+ *                                                                                                     *
+ * This function decodes the COBS frame, checks its CRC and length, runs the command handler and sends *
+ * the response frame to the print task. Frames too short to hold a sequence number and a command, or  *
+ * that are not valid COBS, are dropped without a response.                                            *
+ *                                                                                                     *
+ * @param encoded [const uint8_t*] Pointer to the encoded frame, without delimiters.                   *
+ * @param len [uint32_t] Number of encoded bytes.                                                      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called by the message handler task for every frame received between two zero bytes.           *
+ ******************************************************************************************************/
+void proto_handle_frame(const uint8_t *encoded, uint32_t len)
+{
+	uint8_t frame[PROTO_FRAME_MAX];
+	uint8_t rsp[PROTO_FRAME_MAX - PROTO_RSP_OVERHEAD];
+	uint32_t rsp_len = 0;
+	uint8_t status;
+	int32_t frame_len;
+
+	frame_len = frame_cobs_decode(encoded, len, frame, sizeof(frame));
+	if(frame_len < PROTO_REQ_OVERHEAD) {
+		return;
+	}
+
+	uint8_t seq = frame[0];
+	uint8_t cmd = frame[1];
+	uint32_t req_len = (uint32_t)frame_len - PROTO_REQ_OVERHEAD;
+
+	// Validate the request before running it
+	if(frame_get_u16(&frame[frame_len - 2]) != frame_crc16(frame, (uint32_t)frame_len - 2)) {
+		status = PROTO_ERR_CRC;
+	}
+	else if((cmd >= PROTO_CMD_COUNT) || (NULL == proto_commands[cmd].handler)) {
+		status = PROTO_ERR_CMD;
+	}
+	else if(req_len != proto_commands[cmd].req_len) {
+		status = PROTO_ERR_LEN;
+	}
+	else {
+		status = proto_commands[cmd].handler(&frame[2], rsp, &rsp_len);
+	}
+
+	proto_respond(seq, cmd, status, rsp, (PROTO_OK == status) ? rsp_len : 0);
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Builds a response frame and hands it to the print task.                                      *
+ *                                                                                                     *
+ * @param seq [uint8_t] Sequence number of the request.                                                *
+ * @param cmd [uint8_t] Command number of the request.                                                 *
+ * @param status [uint8_t] Response status.                                                            *
+ * @param payload [const uint8_t*] Pointer to the response payload.                                    *
+ * @param len [uint32_t] Payload length, at most `PROTO_FRAME_MAX - PROTO_RSP_OVERHEAD`.               *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void proto_respond(uint8_t seq, uint8_t cmd, uint8_t status, const uint8_t *payload, uint32_t len)
+{
+	uint8_t frame[PROTO_FRAME_MAX];
+	uint32_t frame_len = 0;
+
+	frame[frame_len++] = seq;
+	frame[frame_len++] = cmd | PROTO_RSP_FLAG;
+	frame[frame_len++] = status;
+	memcpy(&frame[frame_len], payload, len);
+	frame_len += len;
+	frame_put_u16(&frame[frame_len], frame_crc16(frame, frame_len));
+	frame_len += 2;
+
+	// Encode between two delimiters, so that the client can find the frame among menu text
+	char *block = print_pool_alloc(portMAX_DELAY);
+	uint8_t *out = (uint8_t*)block;
+	uint32_t out_len = 0;
+
+	out[out_len++] = FRAME_DELIMITER;
+	out_len += frame_cobs_encode(frame, frame_len, &out[out_len]);
+	out[out_len++] = FRAME_DELIMITER;
+
+	print_pool_send_frame(block, out_len);
+}
+
+/*******************************************************************************************************
+ * @brief Command handlers, called with a request whose length matches the command.                    *
+ *                                                                                                     *
+ * @param req [const uint8_t*] Pointer to the request payload.                                         *
+ * @param rsp [uint8_t*] Pointer to the response payload, `PROTO_FRAME_MAX - PROTO_RSP_OVERHEAD` bytes.*
+ * @param rsp_len [uint32_t*] Set to the response payload length. Left untouched if there is none.     *
+ * @return uint8_t Response status, `PROTO_OK` if the request was executed.                            *
+ ******************************************************************************************************/
+
+// PROTO_CMD_PING: returns the protocol version.
+static uint8_t proto_ping(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	rsp[0] = PROTO_VERSION;
+	*rsp_len = 1;
+	return PROTO_OK;
+}
+
+// PROTO_CMD_GET_SPEED: returns the target and measured speeds and the control algorithm.
+static uint8_t proto_get_speed(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	frame_put_f32(&rsp[0], motor_get_target_speed());
+	frame_put_f32(&rsp[4], motor_speed);
+	rsp[8] = (uint8_t)motor_get_algo();
+	*rsp_len = 9;
+	return PROTO_OK;
+}
+
+// PROTO_CMD_SET_SPEED: sets the target motor speed, limited to `MAX_MOTOR_SPEED`.
+static uint8_t proto_set_speed(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	float rpm = frame_get_f32(&req[0]);
+
+	// Also rejects NaN
+	if(!(rpm >= 0.0f)) {
+		return PROTO_ERR_VALUE;
+	}
+
+	frame_put_f32(&rsp[0], motor_set_target_speed(rpm));
+	*rsp_len = 4;
+	return PROTO_OK;
+}
+
+// PROTO_CMD_GET_PID: returns the PID gains.
+static uint8_t proto_get_pid(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	float setpoint, kp, ki, kd;
+
+	pid_get_params(&setpoint, &kp, &ki, &kd);
+	frame_put_f32(&rsp[0], kp);
+	frame_put_f32(&rsp[4], ki);
+	frame_put_f32(&rsp[8], kd);
+	*rsp_len = 12;
+	return PROTO_OK;
+}
+
+// PROTO_CMD_SET_PID: sets the PID gains, which must not be negative.
+static uint8_t proto_set_pid(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	float setpoint, kp, ki, kd;
+
+	pid_get_params(&setpoint, &kp, &ki, &kd);
+	kp = frame_get_f32(&req[0]);
+	ki = frame_get_f32(&req[4]);
+	kd = frame_get_f32(&req[8]);
+	if(!(kp >= 0.0f) || !(ki >= 0.0f) || !(kd >= 0.0f)) {
+		return PROTO_ERR_VALUE;
+	}
+
+	pid_set_params(setpoint, kp, ki, kd);
+	return PROTO_OK;
+}
+
+// PROTO_CMD_GET_LED: returns the active LED effect.
+static uint8_t proto_get_led(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	led_effect_t effect = led_get_effect();
+
+	rsp[0] = (effectNone == effect) ? 0 : (uint8_t)(effect + 1);
+	*rsp_len = 1;
+	return PROTO_OK;
+}
+
+// PROTO_CMD_SET_LED: starts an LED effect, or turns the LEDs off.
+static uint8_t proto_set_led(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	if(req[0] > 4) {
+		return PROTO_ERR_VALUE;
+	}
+
+	led_set_effect((0 == req[0]) ? effectNone : (led_effect_t)(req[0] - 1));
+	return PROTO_OK;
+}
+
+// PROTO_CMD_GET_RTC: returns the RTC time and date.
+static uint8_t proto_get_rtc(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	RTC_TimeTypeDef time;
+	RTC_DateTypeDef date;
+
+	rtc_read(&time, &date);
+	rsp[0] = time.Hours;
+	rsp[1] = time.Minutes;
+	rsp[2] = time.Seconds;
+	rsp[3] = (RTC_HOURFORMAT12_PM == time.TimeFormat) ? 1 : 0;
+	rsp[4] = date.Month;
+	rsp[5] = date.Date;
+	rsp[6] = date.Year;
+	rsp[7] = date.WeekDay;
+	*rsp_len = sizeof(proto_rtc_t);
+	return PROTO_OK;
+}
+
+// PROTO_CMD_SET_RTC: sets the RTC time and date, after the same checks as the RTC menu.
+static uint8_t proto_set_rtc(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	RTC_TimeTypeDef time;
+	RTC_DateTypeDef date;
+
+	memset(&time, 0, sizeof(time));
+	memset(&date, 0, sizeof(date));
+	time.Hours = req[0];
+	time.Minutes = req[1];
+	time.Seconds = req[2];
+	time.TimeFormat = req[3] ? RTC_HOURFORMAT12_PM : RTC_HOURFORMAT12_AM;
+	date.Month = req[4];
+	date.Date = req[5];
+	date.Year = req[6];
+	date.WeekDay = req[7];
+
+	// The RTC menu does not check the lower bounds, its prompts do
+	if((req[3] > 1) || (0 == time.Hours) || (0 == date.Month) || (0 == date.Date) || (0 == date.WeekDay)
+			|| validate_rtc_information(&time, &date)) {
+		return PROTO_ERR_VALUE;
+	}
+
+	rtc_configure_time(&time);
+	rtc_configure_date(&date);
+	return PROTO_OK;
+}
+
+// PROTO_CMD_GET_ACC: returns one accelerometer sample in milli-g, independent of the full scale.
+static uint8_t proto_get_acc(const uint8_t *req, uint8_t *rsp, uint32_t *rsp_len)
+{
+	int16_t acc_data[3];
+
+	accelerometer_read(acc_data);
+	for(int i = 0; i < 3; i++) {
+		frame_put_u16(&rsp[2 * i], (uint16_t)acc_sensor_to_mg(acc_data[i]));
+	}
+	*rsp_len = 6;
+	return PROTO_OK;
+}
@@ -0,0 +1,87 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       Protocol.h                                                                |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `Protocol` module answers binary requests received on USART2 next to           |
+|    the text menus. Requests and responses are COBS encoded frames protected by        |
+|    a CRC-16. This header defines the wire format and is shared with the host          |
+|    client.                                                                            |
+\*=====================================================================================*/
+
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+/*
+ * Frame layout, before COBS encoding. On the wire every frame is preceded and followed by a zero byte.
+ *
+ *   Request:   seq (1) | cmd (1) | payload (n) | CRC-16 (2)
+ *   Response:  seq (1) | cmd | PROTO_RSP_FLAG (1) | status (1) | payload (n) | CRC-16 (2)
+ *
+ * `seq` is chosen by the client and echoed in the response. The CRC-16/CCITT-FALSE covers every byte
+ * before it. Multi-byte fields are little-endian, floats are IEEE 754 single precision. A response only
+ * carries a payload if its status is PROTO_OK.
+ */
+
+#define PROTO_VERSION				2 // Returned by PROTO_CMD_PING
+#define PROTO_FRAME_MAX				64 // Longest frame before COBS encoding (bytes, including the CRC)
+#define PROTO_RSP_FLAG				0x80 // Set in the command byte of responses
+#define PROTO_REQ_OVERHEAD			4 // seq, cmd and CRC bytes of a request
+#define PROTO_RSP_OVERHEAD			5 // seq, cmd, status and CRC bytes of a response
+
+// Commands                                    Request payload                Response payload
+#define PROTO_CMD_PING				0x00 // -                              u8 protocol version
+#define PROTO_CMD_GET_SPEED			0x01 // -                              f32 target RPM, f32 measured RPM, u8 algorithm
+#define PROTO_CMD_SET_SPEED			0x02 // f32 target RPM                 f32 target RPM applied (limited to the maximum)
+#define PROTO_CMD_GET_PID			0x03 // -                              f32 Kp, f32 Ki, f32 Kd
+#define PROTO_CMD_SET_PID			0x04 // f32 Kp, f32 Ki, f32 Kd         -
+#define PROTO_CMD_GET_LED			0x05 // -                              u8 effect (0 = none, 1 to 4 = E1 to E4)
+#define PROTO_CMD_SET_LED			0x06 // u8 effect                      -
+#define PROTO_CMD_GET_RTC			0x07 // -                              proto_rtc_t fields, 8 x u8
+#define PROTO_CMD_SET_RTC			0x08 // proto_rtc_t fields, 8 x u8     -
+#define PROTO_CMD_GET_ACC			0x09 // -                              i16 X, i16 Y, i16 Z (mg)
+#define PROTO_CMD_COUNT				10
+
+// Response status
+#define PROTO_OK					0x00 // Request executed
+#define PROTO_ERR_CRC				0x01 // CRC mismatch, the request was not executed
+#define PROTO_ERR_CMD				0x02 // Unknown command
+#define PROTO_ERR_LEN				0x03 // Payload length does not match the command
+#define PROTO_ERR_VALUE				0x04 // Payload value out of range
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	uint8_t hours;		// 1 to 12
+	uint8_t minutes;	// 0 to 59
+	uint8_t seconds;	// 0 to 59
+	uint8_t pm;			// 0 = AM, 1 = PM
+	uint8_t month;		// 1 to 12
+	uint8_t date;		// 1 to 31
+	uint8_t year;		// 0 to 99, years since 2000
+	uint8_t weekday;	// 1 to 7, Sunday = 1
+} proto_rtc_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void proto_handle_frame(const uint8_t *encoded, uint32_t len);
+
+#endif /* PROTOCOL_H_ */
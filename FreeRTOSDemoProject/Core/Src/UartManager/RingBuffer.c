@@ -0,0 +1,156 @@
+
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       RingBuffer.c                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `RingBuffer` utility provides a lock-free single-producer / single-consumer    |
+|    byte ring. One context (e.g. an ISR) writes and one context (e.g. a task) reads,   |
+|    both in bulk with memcpy, without entering a critical section.                     |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "RingBuffer.h"
+#include "stm32f4xx.h"
+#include <string.h>
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Initializes a ring buffer over caller-provided storage.                                      *
+ *                                                                                                     *
+ * @param rb [ring_buffer_t*] Pointer to the ring buffer to initialize.                                *
+ * @param buf [uint8_t*] Pointer to the storage backing the ring buffer.                               *
+ * @param size [uint32_t] Size of the storage in bytes. Must be a non-zero power of two.               *
+ * @return int                                                                                         *
+ * @retval 0 if the ring buffer was initialized.                                                       *
+ * @retval -1 if the size is not a power of two.                                                       *
+ *                                                                                                     *
+ * @note Must be called before the producer or consumer starts using the ring buffer.                  *
+ ******************************************************************************************************/
+int ring_buffer_init(ring_buffer_t *rb, uint8_t *buf, uint32_t size)
+{
+	// Free-running indices wrap with a mask, so the size must be a power of two
+	if((0 == size) || (size & (size - 1))) {
+		return -1;
+	}
+
+	rb->buf = buf;
+	rb->mask = size - 1;
+	rb->head = 0;
+	rb->tail = 0;
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Writes bytes into the ring buffer (producer side).                                           *
+ *                                                                                                     *
+ * This function copies as many bytes as fit into the free space of the ring buffer, using at most two *
+ * memcpy calls to handle the wrap-around. The write index is published only after the data has been   *
+ * copied, so the consumer never observes bytes that have not been written yet.                        *
+ *                                                                                                     *
+ * @param rb [ring_buffer_t*] Pointer to the ring buffer.                                              *
+ * @param data [const uint8_t*] Pointer to the bytes to write.                                         *
+ * @param len [uint32_t] Number of bytes to write.                                                     *
+ * @return uint32_t Number of bytes actually written. Less than `len` if the ring buffer is full.      *
+ *                                                                                                     *
+ * @note Safe to call from interrupt context. Only one producer may call this function.                *
+ ******************************************************************************************************/
+uint32_t ring_buffer_write(ring_buffer_t *rb, const uint8_t *data, uint32_t len)
+{
+	uint32_t head = rb->head;
+	uint32_t space = (rb->mask + 1) - (head - rb->tail);
+	uint32_t offset = head & rb->mask;
+	uint32_t first;
+
+	if(len > space) {
+		len = space;
+	}
+
+	// Copy up to the end of the storage, then wrap to the start
+	first = rb->mask + 1 - offset;
+	if(first > len) {
+		first = len;
+	}
+	memcpy(&rb->buf[offset], data, first);
+	memcpy(&rb->buf[0], &data[first], len - first);
+
+	// Make sure the data is in memory before the consumer can see the new write index
+	__DMB();
+	rb->head = head + len;
+
+	return len;
+}
+
+/*******************************************************************************************************
+ * @brief Reads bytes from the ring buffer (consumer side).                                            *
+ *                                                                                                     *
+ * This function copies up to `len` available bytes out of the ring buffer, using at most two memcpy   *
+ * calls to handle the wrap-around. The read index is published only after the data has been copied,   *
+ * so the producer never overwrites bytes that are still being read.                                   *
+ *                                                                                                     *
+ * @param rb [ring_buffer_t*] Pointer to the ring buffer.                                              *
+ * @param data [uint8_t*] Pointer to the destination buffer.                                           *
+ * @param len [uint32_t] Maximum number of bytes to read.                                              *
+ * @return uint32_t Number of bytes actually read. Zero if the ring buffer is empty.                   *
+ *                                                                                                     *
+ * @note Only one consumer may call this function.                                                     *
+ ******************************************************************************************************/
+uint32_t ring_buffer_read(ring_buffer_t *rb, uint8_t *data, uint32_t len)
+{
+	uint32_t tail = rb->tail;
+	uint32_t count = rb->head - tail;
+	uint32_t offset = tail & rb->mask;
+	uint32_t first;
+
+	if(len > count) {
+		len = count;
+	}
+
+	// Make sure the data is read after the write index that made it visible
+	__DMB();
+
+	// Copy up to the end of the storage, then wrap to the start
+	first = rb->mask + 1 - offset;
+	if(first > len) {
+		first = len;
+	}
+	memcpy(data, &rb->buf[offset], first);
+	memcpy(&data[first], &rb->buf[0], len - first);
+
+	// Make sure the data has been copied out before the producer can reuse the space
+	__DMB();
+	rb->tail = tail + len;
+
+	return len;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the number of bytes available to read.                                               *
+ *                                                                                                     *
+ * @param rb [const ring_buffer_t*] Pointer to the ring buffer.                                        *
+ * @return uint32_t Number of bytes stored in the ring buffer.                                         *
+ ******************************************************************************************************/
+uint32_t ring_buffer_count(const ring_buffer_t *rb)
+{
+	return rb->head - rb->tail;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the number of bytes that can be written.                                             *
+ *                                                                                                     *
+ * @param rb [const ring_buffer_t*] Pointer to the ring buffer.                                        *
+ * @return uint32_t Number of free bytes in the ring buffer.                                           *
+ ******************************************************************************************************/
+uint32_t ring_buffer_space(const ring_buffer_t *rb)
+{
+	return (rb->mask + 1) - (rb->head - rb->tail);
+}
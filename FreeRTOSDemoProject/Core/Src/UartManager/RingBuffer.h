@@ -0,0 +1,46 @@
+
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ UartManager ]                                                           |
+| FILE:       RingBuffer.h                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `RingBuffer` utility provides a lock-free single-producer / single-consumer    |
+|    byte ring. One context (e.g. an ISR) writes and one context (e.g. a task) reads,   |
+|    both in bulk with memcpy, without entering a critical section.                     |
+\*=====================================================================================*/
+
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	uint8_t *buf;				// Storage, size must be a power of two
+	uint32_t mask;				// size - 1, used to wrap the free-running indices
+	volatile uint32_t head;		// Free-running write index, only modified by the producer
+	volatile uint32_t tail;		// Free-running read index, only modified by the consumer
+} ring_buffer_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+int ring_buffer_init(ring_buffer_t *rb, uint8_t *buf, uint32_t size);
+uint32_t ring_buffer_write(ring_buffer_t *rb, const uint8_t *data, uint32_t len);
+uint32_t ring_buffer_read(ring_buffer_t *rb, uint8_t *data, uint32_t len);
+uint32_t ring_buffer_count(const ring_buffer_t *rb);
+uint32_t ring_buffer_space(const ring_buffer_t *rb);
+
+#endif /* RINGBUFFER_H_ */
@@ -19,33 +19,139 @@
 
 #include "UartManager.h"
 #include "Config_UartManager.h"
+#include "RingBuffer.h"
+#include "Command.h"
+#include "Frame.h"
+#include "Protocol.h"
+#include "StatsManager.h"
+#include "Config_StatsManager.h"
+#include "ClockManager.h"
+#include "MotorManager.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
 #include "main.h"
 #include <string.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Position in the message currently being copied to the transmit buffer
+typedef struct
+{
+	const char *pos;	// Next character to transmit, NULL if no message is in progress
+	char *block;		// Print pool block holding the message, NULL for constant strings
+	const char *end;	// End of a binary frame, NULL for null terminated text
+} tx_cursor_t;
 
 /****************************************************
  *  Function prototypes                             *
  ****************************************************/
 
 void process_message(message_t *msg);
-int extract_command(message_t *msg);
+static void copy_rx_dma_bytes(const uint8_t *data, uint16_t len);
+static uint32_t fill_tx_buffer(uint8_t *buf, tx_cursor_t *cursor);
+static void frame_rx_bytes(const uint8_t *data, uint16_t len);
+static void process_line(char *line, uint32_t len);
+static void post_message(const char *text, uint32_t len);
+static void batch_append(const char *line, uint32_t len);
+static void batch_run(char *cmds);
+static BaseType_t batch_wait_ready(void);
+static void main_cmd_led(const char *args);
+static void main_cmd_rtc(const char *args);
+static void main_cmd_acc(const char *args);
+static void main_cmd_motor(const char *args);
+static void main_cmd_stats(const char *args);
+static void main_cmd_clock(const char *args);
+static void main_cmd_mem(const char *args);
 
 /****************************************************
  *  Messages                                        *
  ****************************************************/
 
 const char *msg_inv_uart = "\n******** Invalid menu option *********\n";
+const char *msg_line_too_long = "\n******** Input line too long *********\n";
 const char *msg_main_menu = "\n======================================\n"
 							  "|              Main Menu             |\n"
 						      "======================================\n\n"
 							  " 0 --> Start or modify an LED effect\n"
 							  " 1 --> Configure date and/or time\n"
 							  " 2 --> Interface with accelerometer\n"
-							  " 3 --> Interface with DC motor\n\n"
+							  " 3 --> Interface with DC motor\n"
+							  " Stats --> Show CPU usage statistics\n"
+							  " Clock --> Show clock settings and benchmark\n"
+							  " Mem --> Show stack and heap usage (Mem N: every N s, Mem 0: stop)\n\n"
 							  " Enter your selection here: ";
+const char *msg_inv_mem = "\n******* Invalid report period ********\n";
+const char *msg_batch_overflow = "\nBatch ERR: script too long, nothing executed\n";
+const char *msg_rx_stats_header = "\n************************************\n"
+								  "*      UART RECEPTION ERRORS       *\n"
+								  "*                                  *\n";
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Circular DMA reception buffer, written by DMA1 Stream 5
+static uint8_t uart_rx_dma_buf[UART_RX_DMA_BUF_SIZE];
+static uint16_t uart_rx_dma_pos = 0; // Index of the next DMA byte to be copied into the ring buffer
+
+// Ring buffer filled by the reception ISR and drained by the message handler task
+_Static_assert((UART_RX_RING_SIZE > 0) && (0 == (UART_RX_RING_SIZE & (UART_RX_RING_SIZE - 1))), "UART_RX_RING_SIZE must be a power of two");
+static uint8_t uart_rx_ring_buf[UART_RX_RING_SIZE];
+static ring_buffer_t uart_rx_ring;
+static uart_rx_stats_t uart_rx_stats = {0}; // Bytes and lines lost since reset, see `uart_rx_get_stats`
+
+// Double transmit buffer, one is filled by the print task while the other is sent by DMA1 Stream 6
+static uint8_t uart_tx_dma_buf[2][UART_TX_DMA_BUF_SIZE];
+static volatile uint8_t uart_tx_busy = 0; // Set while a DMA transmission is in progress
+
+// Print message pool, free blocks are kept on a queue of block pointers
+static char print_pool[PRINT_POOL_BLOCK_COUNT][PRINT_POOL_BLOCK_SIZE];
+static QueueHandle_t q_print_pool;
+static CCM_BSS StaticQueue_t q_print_pool_buffer;
+static CCM_BSS uint8_t q_print_pool_storage[PRINT_POOL_BLOCK_COUNT * sizeof(char*)];
+static print_pool_stats_t print_pool_stats = {0};
+static uint16_t print_pool_frame_len[PRINT_POOL_BLOCK_COUNT]; // Length of the binary frame in each block, 0 for text
+
+// Line under assembly and the last complete message handed to a consumer task
+static char rx_line[UART_RX_LINE_SIZE];
+static uint32_t rx_line_len = 0;
+static uint8_t rx_line_overflow = 0;	// Set if the line did not fit into `rx_line`, until its end
+static message_t rx_msg;
+static message_t *rx_msg_posted = NULL;	// Message handed to the task notified by `process_message`
+
+// Binary protocol frame under assembly, received between two zero bytes
+static uint8_t rx_frame[FRAME_COBS_MAX(PROTO_FRAME_MAX)];
+static uint32_t rx_frame_len = 0;
+static uint8_t rx_in_frame = 0;			// Set after a frame delimiter, until the closing one
+static uint8_t rx_frame_overflow = 0;	// Set if the frame did not fit into `rx_frame`
+
+// Batch mode, commands of a script are collected between `Begin` and `End`
+static char batch_script[BATCH_SCRIPT_SIZE];
+static uint32_t batch_script_len = 0;
+static uint8_t batch_recording = 0;			// Set while script lines are being collected
+static uint8_t batch_overflow = 0;			// Set if the script did not fit into `batch_script`
+static volatile uint32_t batch_cmd = 0;		// Number of the batch command being executed, 0 outside a batch
+static volatile uint32_t batch_failed = 0;	// Number of the first batch command that reported an error
+static uint8_t batch_ready_sent = 0;		// Set once the waiting task has asked for the next batch command
+
+// Main menu commands
+static const command_t main_commands[] = {
+	{ "0",		main_cmd_led,	0 },	// LED menu
+	{ "1",		main_cmd_rtc,	0 },	// RTC menu
+	{ "2",		main_cmd_acc,	0 },	// Accelerometer menu
+	{ "3",		main_cmd_motor,	0 },	// Motor menu
+	{ "Stats",	main_cmd_stats,	0 },	// CPU usage statistics
+	{ "Clock",	main_cmd_clock,	0 },	// Clock settings and benchmark
+	{ "Mem",	main_cmd_mem,	1 },	// Stack and heap usage, optionally reported every N seconds
+};
+static command_table_t main_command_table = COMMAND_TABLE(main_commands);
 
 /****************************************************
  *  Public functions                                *
@@ -69,48 +175,23 @@ const char *msg_main_menu = "\n======================================\n"
  ******************************************************************************************************/
 void main_menu_task(void *param)
 {
-	uint32_t msg_addr;
 	message_t *msg;
-	int option;
+
+	// Build the hash index of the command table
+	int status = command_table_init(&main_command_table);
+	configASSERT(0 == status);
 
 	while(1) {
 
 		// Present the main menu to the user
-		xQueueSend(q_print, &msg_main_menu, portMAX_DELAY);
+		print_interactive(msg_main_menu);
 
 		// Wait for user to select a menu option
-		xTaskNotifyWait(0, 0, &msg_addr, portMAX_DELAY);
-		msg = (message_t*)msg_addr;
-
-		if(msg->len == 1) {
-			// Get user option, convert from ASCII to number
-			option = msg->payload[0] - 48;
-			switch(option) {
-				case 0:
-					// User selection: LED menu
-					curr_sys_state = sLedMenu;
-					xTaskNotify(handle_led_task, 0, eNoAction);
-					break;
-				case 1:
-					curr_sys_state = sRtcMenu;
-					xTaskNotify(handle_rtc_task, 0, eNoAction);
-					break;
-				case 2:
-					curr_sys_state = sAccMenu;
-					xTaskNotify(handle_acc_task, 0, eNoAction);
-					break;
-				case 3:
-					curr_sys_state = sMotorMenu;
-					xTaskNotify(handle_motor_task, 0, eNoAction);
-					break;
-				default:
-					xQueueSend(q_print, &msg_inv_uart, portMAX_DELAY);
-					continue;
-			}
-		}
+		msg = uart_wait_message();
+
 		// Handle invalid entry
-		else {
-			xQueueSend(q_print, &msg_inv_uart, portMAX_DELAY);
+		if(!command_dispatch(&main_command_table, (char*)msg->payload)) {
+			print_error(msg_inv_uart);
 			continue;
 		}
 
@@ -122,58 +203,466 @@ void main_menu_task(void *param)
 /*******************************************************************************************************
  * @brief Task to handle messages from the user.                                                       *
  *                                                                                                     *
- * This FreeRTOS task waits for notifications indicating that a new message is available in the data   *
- * queue (`q_data`). Upon notification, it processes the message and sends the result to the print     *
- * queue (`q_print`).                                                                                  *
+ * This FreeRTOS task is woken by the UART reception callbacks whenever new bytes have been copied into*
+ * the reception ring buffer. It drains the ring buffer in bulk, assembles complete lines, and         *
+ * forwards each line to the task owning the current state.                                            *
  *                                                                                                     *
  * @param param [void*] Parameter passed during task creation (not used in this task).                 *
  * @return void                                                                                        *
  *                                                                                                     *
- * @note This function is intended to run as a FreeRTOS task. It is notified by the UART receive       *
- *       interrupt handler when a new message is available.                                            *
- * @note The data queue (`q_data`) and print queue (`q_print`) must be initialized. The task must be   *
- *       notified when a new message is available.                                                     *
- * @note The processed message is sent to the print queue (`q_print`).                                 *
+ * @note This function is intended to run as a FreeRTOS task. It is notified by                        *
+ *       `uart_rx_event_callback` and `uart_error_callback`.                                           *
+ * @note DMA reception must be started with `uart_rx_start` before the scheduler starts.               *
+ * @note Notifications may be coalesced; every wake-up drains the ring buffer until it is empty.       *
+ * @note Command batches are executed by this task, see `batch_run`.                                   *
+ * @note The periodic memory report is printed by this task when `stats_mem_callback` notifies it.     *
+ * @note The motor speed report is printed by this task when `motor_report_callback` notifies it.      *
  ******************************************************************************************************/
 void message_handler_task(void *param)
 {
-	BaseType_t ret;
-	message_t msg;
+	uint8_t chunk[UART_RX_CHUNK_SIZE];
+	uint32_t events;
+	uint32_t len;
 
 	while(1) {
 
-		// Wait until task is notified
-		ret = xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+		// Wait until the UART reception callbacks report new data or a restart
+		xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+
+		if(events & UART_RX_EVT_RESTART) {
+			// Reception was restarted after a line error, discard the partial line or frame
+			rx_line_len = 0;
+			rx_line_overflow = 0;
+			rx_in_frame = 0;
+		}
+
+		// Drain the ring buffer in bulk and assemble complete lines
+		while((len = ring_buffer_read(&uart_rx_ring, chunk, sizeof(chunk))) > 0) {
+			frame_rx_bytes(chunk, len);
+		}
 
-		if(pdTRUE == ret) {
-			// Process the message stored in the input data queue
-			process_message(&msg);
+		// Print the periodic memory report on behalf of the timer service task
+		if(events & UART_RX_EVT_MEM_REPORT) {
+			print_mem_report();
 		}
 
+		// Print the motor speed report on behalf of the timer service task
+		if(events & UART_RX_EVT_MOTOR_REPORT) {
+			motor_report_print();
+		}
 	}
 }
 
 /*******************************************************************************************************
  * @brief Task to print messages via UART.                                                             *
  *                                                                                                     *
- * This FreeRTOS task waits for messages to be available in the print queue (`q_print`). When a        *
- * message is received, it is transmitted via UART.                                                    *
+ * This FreeRTOS task waits for messages in the print queue (`q_print`) and transmits them over UART   *
+ * with DMA. While one transmit buffer is being sent, messages already waiting in the queue are        *
+ * coalesced into the other buffer, so that back-to-back messages go out in a single transfer. The     *
+ * task blocks on a notification from the transmit complete interrupt instead of polling the UART.     *
  *                                                                                                     *
  * @param param [void*] Parameter passed during task creation (not used in this task).                 *
  * @return void                                                                                        *
  *                                                                                                     *
  * @note This function is intended to run as a FreeRTOS task.                                          *
  * @note The print queue (`q_print`) must be initialized and contain messages to print.                *
- * @note The received message is transmitted via UART.                                                 *
+ * @note Message text is copied into the transmit buffer when it is dequeued. Print pool blocks are    *
+ *       returned to the pool once copied; constant strings are not owned by the print task.           *
+ * @note A transfer the HAL does not accept is retried `UART_TX_RETRIES` times. If it still fails, the *
+ *       buffer is discarded and its length is added to `tx_dropped_bytes` of `print_pool_get_stats`.  *
  ******************************************************************************************************/
 void print_task(void *param)
 {
-	uint32_t *msg;
+	tx_cursor_t cursor = {NULL, NULL, NULL};
+	uint8_t in_flight = 0;
+	uint8_t idx = 0;
+	uint32_t len;
 
-	// Wait for data in the print queue, then send over UART when available
 	while(1){
-		xQueueReceive(q_print, &msg, portMAX_DELAY);
-		HAL_UART_Transmit(&huart2, (uint8_t*)msg, strlen((char*)msg),HAL_MAX_DELAY);
+		// Coalesce queued messages into the idle buffer while the other one is being sent
+		len = fill_tx_buffer(uart_tx_dma_buf[idx], &cursor);
+
+		// Wait for the previous transmission to complete
+		if(in_flight) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		}
+
+		// Hand the buffer to the DMA and switch to the other one. The HAL refuses the transfer while the
+		// UART is still busy, e.g. after an aborted transmission, so it is retried a few times
+		in_flight = 0;
+		for(uint32_t attempt = 0; (len > 0) && (attempt <= UART_TX_RETRIES); attempt++) {
+			uart_tx_busy = 1;
+			if(HAL_OK == HAL_UART_Transmit_DMA(&huart2, uart_tx_dma_buf[idx], len)) {
+				in_flight = 1;
+				idx ^= 1;
+				break;
+			}
+			uart_tx_busy = 0;
+			vTaskDelay(pdMS_TO_TICKS(UART_TX_RETRY_MS));
+		}
+
+		// The text has already left the queue and the pool, count it as lost and reuse the buffer
+		if(!in_flight) {
+			print_pool_stats.tx_dropped_bytes += len;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Starts UART reception into the circular DMA buffer.                                          *
+ *                                                                                                     *
+ * This function arms USART2 reception in DMA circular mode with idle line detection. The DMA stream   *
+ * fills `uart_rx_dma_buf` continuously without CPU involvement; the HAL reports progress through      *
+ * `HAL_UARTEx_RxEventCallback` on idle line, half buffer and full buffer events.                      *
+ *                                                                                                     *
+ * @param None                                                                                         *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called once from `main` before the scheduler starts, and again from `uart_error_callback`     *
+ *       when a UART error has aborted the transfer.                                                   *
+ ******************************************************************************************************/
+void uart_rx_start(void)
+{
+	// Set up the ring buffer on first start
+	if(NULL == uart_rx_ring.buf) {
+		if(0 != ring_buffer_init(&uart_rx_ring, uart_rx_ring_buf, UART_RX_RING_SIZE)) {
+			Error_Handler();
+		}
+	}
+
+	if(HAL_OK != HAL_UARTEx_ReceiveToIdle_DMA(&huart2, uart_rx_dma_buf, UART_RX_DMA_BUF_SIZE)) {
+		Error_Handler();
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Handles a UART reception event from the HAL.                                                 *
+ *                                                                                                     *
+ * This function is called from `HAL_UARTEx_RxEventCallback` when the line goes idle or the DMA        *
+ * reaches the middle or end of the circular buffer. It copies the bytes written by the DMA since the  *
+ * previous event into the reception ring buffer and wakes the message handler task, which performs    *
+ * the line framing at task level.                                                                     *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] Pointer to the UART handle that raised the event.                *
+ * @param size [uint16_t] Current DMA write position in the circular DMA buffer.                       *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note This function runs in interrupt context. Bytes that do not fit into the ring buffer are       *
+ *       dropped and counted in `uart_rx_stats`.                                                       *
+ ******************************************************************************************************/
+void uart_rx_event_callback(UART_HandleTypeDef *huart, uint16_t size)
+{
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	if(USART2 != huart->Instance) {
+		return;
+	}
+
+	// The DMA wrapped around: copy the end of the buffer first
+	if(size < uart_rx_dma_pos) {
+		copy_rx_dma_bytes(&uart_rx_dma_buf[uart_rx_dma_pos], UART_RX_DMA_BUF_SIZE - uart_rx_dma_pos);
+		uart_rx_dma_pos = 0;
+	}
+
+	// Copy the contiguous bytes up to the DMA write position
+	if(size > uart_rx_dma_pos) {
+		copy_rx_dma_bytes(&uart_rx_dma_buf[uart_rx_dma_pos], size - uart_rx_dma_pos);
+		uart_rx_dma_pos = size % UART_RX_DMA_BUF_SIZE;
+	}
+
+	xTaskNotifyFromISR(handle_message_handler_task, UART_RX_EVT_DATA, eSetBits, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************************************
+ * @brief Recovers UART reception and transmission after an error.                                     *
+ *                                                                                                     *
+ * With DMA reception the HAL aborts the transfer on overrun, framing or noise errors before calling   *
+ * `HAL_UART_ErrorCallback`. This function restarts reception from the start of the buffer and tells   *
+ * the message handler task to discard its partially assembled line. If a DMA error aborted an ongoing *
+ * transmission, the print task is woken so that it does not wait for a completion that never comes.   *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] Pointer to the UART handle that raised the error.                *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note This function runs in interrupt context.                                                      *
+ ******************************************************************************************************/
+void uart_error_callback(UART_HandleTypeDef *huart)
+{
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	if(USART2 != huart->Instance) {
+		return;
+	}
+
+	// Reception was aborted: restart it at the beginning of the buffer
+	if(HAL_UART_STATE_READY == huart->RxState) {
+		uart_rx_dma_pos = 0;
+		uart_rx_start();
+		xTaskNotifyFromISR(handle_message_handler_task, UART_RX_EVT_RESTART, eSetBits, &higher_priority_task_woken);
+	}
+
+	// Transmission was aborted: release the print task
+	if(uart_tx_busy && (HAL_UART_STATE_READY == huart->gState)) {
+		uart_tx_busy = 0;
+		vTaskNotifyGiveFromISR(handle_print_task, &higher_priority_task_woken);
+	}
+
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************************************
+ * @brief Handles the end of a UART DMA transmission.                                                  *
+ *                                                                                                     *
+ * This function is called from `HAL_UART_TxCpltCallback` once the last byte of a DMA transfer has     *
+ * left the shift register. It wakes the print task so that the next coalesced buffer can be sent.     *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] Pointer to the UART handle that completed the transmission.      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note This function runs in interrupt context.                                                      *
+ ******************************************************************************************************/
+void uart_tx_complete_callback(UART_HandleTypeDef *huart)
+{
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	if(USART2 != huart->Instance) {
+		return;
+	}
+
+	uart_tx_busy = 0;
+	vTaskNotifyGiveFromISR(handle_print_task, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************************************
+ * @brief Creates the print message pool.                                                              *
+ *                                                                                                     *
+ * This function places every block of the print message pool on the free list. Blocks are taken from  *
+ * the free list by `print_pool_alloc` and returned to it by the print task once their text has been   *
+ * handed to the UART transmit path.                                                                   *
+ *                                                                                                     *
+ * @param None                                                                                         *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must be called from `main` before the scheduler starts.                                       *
+ ******************************************************************************************************/
+void print_pool_init(void)
+{
+	char *block;
+
+	q_print_pool = xQueueCreateStatic(PRINT_POOL_BLOCK_COUNT, sizeof(char*), q_print_pool_storage, &q_print_pool_buffer);
+	configASSERT(NULL != q_print_pool);
+
+	for(int i=0; i<PRINT_POOL_BLOCK_COUNT; i++) {
+		block = print_pool[i];
+		xQueueSend(q_print_pool, &block, 0);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Borrows a message buffer from the print message pool.                                        *
+ *                                                                                                     *
+ * The caller formats its text into the returned block (at most `PRINT_POOL_BLOCK_SIZE` bytes including*
+ * the null terminator) and passes it to `print_pool_send`. Ownership moves to the print task, which   *
+ * returns the block to the pool after transmission; the caller must not touch the block afterwards.   *
+ *                                                                                                     *
+ * @param timeout [TickType_t] Maximum time to wait for a free block.                                  *
+ * @return char* Pointer to an empty, null terminated block, or NULL if none became free in time.      *
+ *                                                                                                     *
+ * @note Must be called from task context.                                                             *
+ * @note Occupancy, high-water mark and allocation failures are available via `print_pool_get_stats`.  *
+ ******************************************************************************************************/
+char *print_pool_alloc(TickType_t timeout)
+{
+	char *block = NULL;
+
+	if(pdTRUE != xQueueReceive(q_print_pool, &block, timeout)) {
+		taskENTER_CRITICAL();
+		print_pool_stats.alloc_failures++;
+		taskEXIT_CRITICAL();
+		return NULL;
+	}
+
+	// Track occupancy and its high-water mark
+	taskENTER_CRITICAL();
+	print_pool_stats.in_use++;
+	if(print_pool_stats.in_use > print_pool_stats.high_water) {
+		print_pool_stats.high_water = print_pool_stats.in_use;
+	}
+	taskEXIT_CRITICAL();
+
+	block[0] = '\0';
+
+	return block;
+}
+
+/*******************************************************************************************************
+ * @brief Hands a formatted message buffer to the print task.                                          *
+ *                                                                                                     *
+ * @param block [char*] Pointer to a block obtained from `print_pool_alloc`, holding a null terminated *
+ *        string.                                                                                      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Ownership of the block passes to the print task. Must be called from task context.            *
+ ******************************************************************************************************/
+void print_pool_send(char *block)
+{
+	xQueueSend(q_print, &block, portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Hands a binary frame to the print task.                                                      *
+ *                                                                                                     *
+ * @param block [char*] Pointer to a block obtained from `print_pool_alloc`, holding the frame.        *
+ * @param len [uint32_t] Number of bytes to send, at most `PRINT_POOL_BLOCK_SIZE`. Zero bytes are      *
+ *        sent as they are.                                                                            *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Ownership of the block passes to the print task. Must be called from task context.            *
+ ******************************************************************************************************/
+void print_pool_send_frame(char *block, uint32_t len)
+{
+	print_pool_frame_len[(block - &print_pool[0][0]) / PRINT_POOL_BLOCK_SIZE] = (uint16_t)len;
+	xQueueSend(q_print, &block, portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Returns a message buffer to the print message pool.                                          *
+ *                                                                                                     *
+ * @param block [char*] Pointer to a block obtained from `print_pool_alloc`.                           *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called by the print task once the block's text has been copied to the transmit buffer. A      *
+ *       producer may also call it directly to give back a block it decided not to send.               *
+ ******************************************************************************************************/
+void print_pool_free(char *block)
+{
+	taskENTER_CRITICAL();
+	print_pool_stats.in_use--;
+	taskEXIT_CRITICAL();
+
+	xQueueSend(q_print_pool, &block, 0);
+}
+
+/*******************************************************************************************************
+ * @brief Reads the print message pool counters.                                                       *
+ *                                                                                                     *
+ * @param stats [print_pool_stats_t*] Pointer to the structure receiving the counters.                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void print_pool_get_stats(print_pool_stats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = print_pool_stats;
+	taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************************************
+ * @brief Reads the UART reception overflow counters.                                                  *
+ *                                                                                                     *
+ * @param stats [uart_rx_stats_t*] Pointer to the structure receiving the counters.                    *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note The counters accumulate from reset. They are also printed by the `Stats` command.             *
+ ******************************************************************************************************/
+void uart_rx_get_stats(uart_rx_stats_t *stats)
+{
+	// The dropped byte count is written by the reception interrupt
+	taskENTER_CRITICAL();
+	*stats = uart_rx_stats;
+	taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************************************
+ * @brief Waits for the next message from the user.                                                    *
+ *                                                                                                     *
+ * Every task reading user input calls this function. While a batch is being executed it first tells   *
+ * the message handler task that the previous command is complete, so that the next command of the     *
+ * batch is only handed over once a task is ready to process it.                                       *
+ *                                                                                                     *
+ * @param None                                                                                         *
+ * @return message_t* Pointer to the received, null terminated message.                                *
+ *                                                                                                     *
+ * @note Must be called from task context. The message is valid until the next call.                   *
+ ******************************************************************************************************/
+message_t *uart_wait_message(void)
+{
+	return uart_poll_message(portMAX_DELAY);
+}
+
+/*******************************************************************************************************
+ * @brief Waits a bounded time for the next message from the user.                                     *
+ *                                                                                                     *
+ * This is `uart_wait_message` for tasks that have other work to do while the user is idle, such as    *
+ * consuming accelerometer sample blocks. The batch executor is told that the task is ready once per   *
+ * consumed message, not on every call, so that polling cannot report a command that is still pending  *
+ * as complete.                                                                                        *
+ *                                                                                                     *
+ * @param wait [TickType_t] Ticks to wait, 0 to only check for a pending message.                      *
+ * @return message_t* Pointer to the received, null terminated message, or NULL on timeout.            *
+ *                                                                                                     *
+ * @note Must be called from task context. The message is valid until the next call.                   *
+ ******************************************************************************************************/
+message_t *uart_poll_message(TickType_t wait)
+{
+	// Ask the batch executor for the next command, once until a command is received
+	if(uart_batch_active() && !batch_ready_sent) {
+		batch_ready_sent = 1;
+		xTaskNotify(handle_message_handler_task, UART_RX_EVT_READY, eSetBits);
+	}
+
+	if(pdTRUE != xTaskNotifyWait(0, 0, NULL, wait)) {
+		return NULL;
+	}
+
+	// The message is consumed, the next call asks for the command after it
+	batch_ready_sent = 0;
+	return rx_msg_posted;
+}
+
+/*******************************************************************************************************
+ * @brief Tells whether a command batch is being executed.                                             *
+ *                                                                                                     *
+ * @param None                                                                                         *
+ * @return int Non-zero while a batch is being executed, 0 in interactive use.                         *
+ ******************************************************************************************************/
+int uart_batch_active(void)
+{
+	return (0 != batch_cmd);
+}
+
+/*******************************************************************************************************
+ * @brief Prints a menu, prompt or confirmation meant for a user at the terminal.                      *
+ *                                                                                                     *
+ * @param msg [const char*] Constant, null terminated string.                                          *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Nothing is printed while a batch is being executed, the batch ends with one acknowledgement.  *
+ ******************************************************************************************************/
+void print_interactive(const char *msg)
+{
+	if(!uart_batch_active()) {
+		xQueueSend(q_print, &msg, portMAX_DELAY);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Prints an error message, or records the failure of the current batch command.                *
+ *                                                                                                     *
+ * @param msg [const char*] Constant, null terminated string.                                          *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note While a batch is being executed the message is not printed. The batch stops after the current *
+ *       command and its acknowledgement names the command that failed.                                *
+ ******************************************************************************************************/
+void print_error(const char *msg)
+{
+	if(!uart_batch_active()) {
+		xQueueSend(q_print, &msg, portMAX_DELAY);
+	}
+	else if(0 == batch_failed) {
+		batch_failed = batch_cmd;
 	}
 }
 
@@ -182,45 +671,149 @@ void print_task(void *param)
  ****************************************************/
 
 /*******************************************************************************************************
- * @brief Processes a received message from the data queue.                                            *
+ * @brief Main menu `0` to `3` commands: hands control to the LED, RTC, accelerometer or motor task.   *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void main_cmd_led(const char *args)
+{
+	curr_sys_state = sLedMenu;
+	xTaskNotify(handle_led_task, 0, eNoAction);
+}
+
+static void main_cmd_rtc(const char *args)
+{
+	curr_sys_state = sRtcMenu;
+	xTaskNotify(handle_rtc_task, 0, eNoAction);
+}
+
+static void main_cmd_acc(const char *args)
+{
+	curr_sys_state = sAccMenu;
+	xTaskNotify(handle_acc_task, 0, eNoAction);
+}
+
+static void main_cmd_motor(const char *args)
+{
+	curr_sys_state = sMotorMenu;
+	xTaskNotify(handle_motor_task, 0, eNoAction);
+}
+
+/*******************************************************************************************************
+ * @brief Main menu `Stats` command: prints the CPU usage statistics and the UART reception losses.    *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void main_cmd_stats(const char *args)
+{
+	uart_rx_stats_t rx_stats;
+
+	print_stats_report();
+
+	// Reception losses, counted from reset
+	uart_rx_get_stats(&rx_stats);
+	xQueueSend(q_print, &msg_rx_stats_header, portMAX_DELAY);
+	char *showrx = print_pool_alloc(portMAX_DELAY);
+	snprintf(showrx, PRINT_POOL_BLOCK_SIZE, "* Bytes dropped:      %08" PRIu32 "     *"
+										  "\n* Lines too long:     %08" PRIu32 "     *"
+										  "\n* Frames too long:    %08" PRIu32 "     *"
+										  "\n*                                  *"
+										  "\n************************************\n",
+										  rx_stats.dropped_bytes, rx_stats.long_lines, rx_stats.long_frames);
+	print_pool_send(showrx);
+
+	// Stay in the main menu, the task presents it again once notified
+	xTaskNotify(handle_main_menu_task, 0, eNoAction);
+}
+
+/*******************************************************************************************************
+ * @brief Main menu `Clock` command: prints the clock settings and the flash benchmark.                *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void main_cmd_clock(const char *args)
+{
+	print_clock_report();
+
+	// Stay in the main menu, the task presents it again once notified
+	xTaskNotify(handle_main_menu_task, 0, eNoAction);
+}
+
+/*******************************************************************************************************
+ * @brief Main menu `Mem` command: prints the stack and heap usage.                                    *
  *                                                                                                     *
- * This function extracts a message from the data queue and processes it according to the user input.  *
+ * With a number of seconds as argument, the report is also printed with that period from then on;     *
+ * `Mem 0` stops the automatic report.                                                                 *
  *                                                                                                     *
- * @param msg [message_t*] Pointer to a message structure to hold the processed message.               *
+ * @param args [const char*] Report period in seconds, up to `STATS_MEM_REPORT_MAX_S`, or "".          *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void main_cmd_mem(const char *args)
+{
+	char *end;
+
+	if('\0' != args[0]) {
+		unsigned long seconds = strtoul(args, &end, 10);
+		if(('\0' != *end) || (seconds > STATS_MEM_REPORT_MAX_S)) {
+			print_error(msg_inv_mem);
+			xTaskNotify(handle_main_menu_task, 0, eNoAction);
+			return;
+		}
+		stats_mem_report_period(seconds);
+	}
+
+	print_mem_report();
+
+	// Stay in the main menu, the task presents it again once notified
+	xTaskNotify(handle_main_menu_task, 0, eNoAction);
+}
+
+/*******************************************************************************************************
+ * @brief Dispatches a received message to the task owning the current system state.                   *
+ *                                                                                                     *
+ * @param msg [message_t*] Pointer to a complete, null terminated message.                             *
  * @return void                                                                                        *
  *                                                                                                     *
- * @note This function is called by the `message_handler_task` when a notification is received.        *
- * @note The data queue (`q_data`) must be initialized and contain a message to process.               *
+ * @note This function is called by `post_message` for every command, typed or part of a batch.        *
  ******************************************************************************************************/
 void process_message(message_t *msg) {
 
-	extract_command(msg);
+	// Task notification values are 32 bits wide, so the message is handed over by the module and the
+	// notification only wakes the task
+	rx_msg_posted = msg;
 
 	switch(curr_sys_state) {
 		case sMainMenu:
-			// Notify the main menu task and pass the message
-			xTaskNotify(handle_main_menu_task, (uint32_t)msg, eSetValueWithOverwrite);
+			// Notify the main menu task of the message
+			xTaskNotify(handle_main_menu_task, 0, eNoAction);
 			break;
 		case sLedMenu:
-			// Notify the led task and pass the message
-			xTaskNotify(handle_led_task, (uint32_t)msg, eSetValueWithOverwrite);
+			// Notify the led task of the message
+			xTaskNotify(handle_led_task, 0, eNoAction);
 			break;
 		case sAccMenu:
-			// Notify the ACC task and pass the message
-			xTaskNotify(handle_acc_task, (uint32_t)msg, eSetValueWithOverwrite);
+			// Notify the ACC task of the message
+			xTaskNotify(handle_acc_task, 0, eNoAction);
 			break;
 		case sMotorMenu:
 		case sMotorAlgo:
 		case sMotorParam:
 		case sMotorSpeed:
-			// Notify the motor task and pass the message
-			xTaskNotify(handle_motor_task, (uint32_t)msg, eSetValueWithOverwrite);
+			// Notify the motor task of the message
+			xTaskNotify(handle_motor_task, 0, eNoAction);
 			break;
 		case sRtcMenu:
 		case sRtcTimeConfig:
 		case sRtcDateConfig:
-			// Notify the RTC task and pass the message
-			xTaskNotify(handle_rtc_task, (uint32_t)msg, eSetValueWithOverwrite);
+			// Notify the RTC task of the message
+			xTaskNotify(handle_rtc_task, 0, eNoAction);
 			break;
 		default:
 			break;
@@ -228,46 +821,349 @@ void process_message(message_t *msg) {
 }
 
 /*******************************************************************************************************
- * @brief Extracts a command from the data queue.                                                      *
+ * @brief Copies bytes from the circular DMA buffer into the reception ring buffer.                    *
+ *                                                                                                     *
+ * @param data [const uint8_t*] Pointer to the first byte in the DMA buffer.                           *
+ * @param len [uint16_t] Number of bytes to copy.                                                      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note This function runs in interrupt context and is the only producer of the ring buffer.          *
+ ******************************************************************************************************/
+static void copy_rx_dma_bytes(const uint8_t *data, uint16_t len)
+{
+	uint32_t written;
+
+	written = ring_buffer_write(&uart_rx_ring, data, len);
+	uart_rx_stats.dropped_bytes += len - written;
+}
+
+/*******************************************************************************************************
+ * @brief Coalesces queued messages into a transmit buffer.                                            *
+ *                                                                                                     *
+ * This function copies message text into the transmit buffer until the buffer is full or the print    *
+ * queue is empty. It blocks for the first message only; further messages are taken from the queue     *
+ * only if they are already waiting. A message longer than the remaining space is split, and the       *
+ * cursor keeps the unsent remainder for the next buffer. Print pool blocks are returned to the pool   *
+ * as soon as their last character has been copied.                                                    *
+ *                                                                                                     *
+ * @param buf [uint8_t*] Pointer to the transmit buffer to fill.                                       *
+ * @param cursor [tx_cursor_t*] Pointer to the position in the message currently being transmitted.    *
+ * @return uint32_t Number of bytes copied into the transmit buffer.                                   *
+ *                                                                                                     *
+ * @note The text is copied and its length counted in a single pass, so no `strlen` is needed. Binary  *
+ *       frames sent with `print_pool_send_frame` are copied up to their length instead.               *
+ ******************************************************************************************************/
+static uint32_t fill_tx_buffer(uint8_t *buf, tx_cursor_t *cursor)
+{
+	const char *msg = cursor->pos;
+	uint32_t len = 0;
+
+	while(len < UART_TX_DMA_BUF_SIZE) {
+		if(NULL == msg) {
+			// Block for the first message only, then take what is already queued
+			if(pdTRUE != xQueueReceive(q_print, &msg, (0 == len) ? portMAX_DELAY : 0)) {
+				break;
+			}
+
+			// Take ownership of print pool blocks, constant strings are only borrowed
+			cursor->block = NULL;
+			cursor->end = NULL;
+			if((msg >= &print_pool[0][0]) && (msg < &print_pool[PRINT_POOL_BLOCK_COUNT][0])) {
+				uint32_t idx = (msg - &print_pool[0][0]) / PRINT_POOL_BLOCK_SIZE;
+
+				cursor->block = (char*)msg;
+				if(0 != print_pool_frame_len[idx]) {
+					cursor->end = msg + print_pool_frame_len[idx];
+					print_pool_frame_len[idx] = 0;
+				}
+			}
+		}
+
+		// Copy until the end of the message or the end of the buffer
+		if(NULL != cursor->end) {
+			while((len < UART_TX_DMA_BUF_SIZE) && (msg < cursor->end)) {
+				buf[len++] = (uint8_t)*msg++;
+			}
+		}
+		else {
+			while((len < UART_TX_DMA_BUF_SIZE) && ('\0' != *msg)) {
+				buf[len++] = (uint8_t)*msg++;
+			}
+		}
+
+		// Message fully copied: give its block back to the pool
+		if((NULL != cursor->end) ? (msg == cursor->end) : ('\0' == *msg)) {
+			msg = NULL;
+			if(NULL != cursor->block) {
+				print_pool_free(cursor->block);
+				cursor->block = NULL;
+			}
+		}
+	}
+
+	cursor->pos = msg;
+
+	return len;
+}
+
+/*******************************************************************************************************
+ * @brief Assembles received bytes into newline terminated lines and binary protocol frames.           *
+ *                                                                                                     *
+ * This function appends bytes to the line under assembly until a newline character is found, then     *
+ * null terminates the line and hands it to `process_line`. A line longer than `UART_RX_LINE_SIZE` is  *
+ * discarded as a whole when its newline arrives and counted in `uart_rx_stats`, so a truncated command*
+ * is never executed. The user is told, or the script being collected is rejected.                     *
+ *                                                                                                     *
+ * A zero byte, which never appears in text, starts a binary frame and discards any partial line. The  *
+ * bytes up to the next zero byte are handed to `proto_handle_frame`. Repeated zero bytes are allowed  *
+ * between frames, and a frame that does not fit into `rx_frame` is dropped and counted.               *
+ *                                                                                                     *
+ * @param data [const uint8_t*] Pointer to the received bytes.                                         *
+ * @param len [uint16_t] Number of bytes to process.                                                   *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void frame_rx_bytes(const uint8_t *data, uint16_t len)
+{
+	for(uint16_t i = 0; i < len; i++) {
+		if(FRAME_DELIMITER == data[i]) {
+			if(rx_in_frame && (rx_frame_len > 0)) {
+				// Closing delimiter: answer the request, then return to text
+				if(!rx_frame_overflow) {
+					proto_handle_frame(rx_frame, rx_frame_len);
+				}
+				else {
+					uart_rx_stats.long_frames++;
+				}
+				rx_in_frame = 0;
+			}
+			else {
+				// Opening delimiter
+				rx_in_frame = 1;
+				rx_line_len = 0;
+				rx_line_overflow = 0;
+			}
+			rx_frame_len = 0;
+			rx_frame_overflow = 0;
+		}
+		else if(rx_in_frame) {
+			if(rx_frame_len < sizeof(rx_frame)) {
+				rx_frame[rx_frame_len++] = data[i];
+			}
+			else {
+				rx_frame_overflow = 1;
+			}
+		}
+		else if('\n' == data[i]) {
+			if(rx_line_overflow) {
+				// Discard the whole line rather than a part of it
+				uart_rx_stats.long_lines++;
+				rx_line_overflow = 0;
+				if(batch_recording) {
+					batch_overflow = 1;
+				}
+				else {
+					print_error(msg_line_too_long);
+				}
+			}
+			else {
+				// Complete line: terminate it and process it
+				rx_line[rx_line_len] = '\0';
+				process_line(rx_line, rx_line_len);
+			}
+			rx_line_len = 0;
+		}
+		else if(rx_line_len < sizeof(rx_line) - 1) {
+			rx_line[rx_line_len++] = (char)data[i];
+		}
+		else {
+			rx_line_overflow = 1;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Handles a complete line received from the user.                                              *
  *                                                                                                     *
- * This function extracts a complete command message from the data queue (`q_data`). It reads bytes    *
- * from the queue until it encounters a newline character, which signifies the end of the message.     *
- * The extracted message is stored in the provided `message_t` structure.                              *
+ * A line containing `;` is executed as a batch of commands. A `Begin` line starts a script: the       *
+ * following lines are collected until an `End` line, and are then executed as one batch. Any other    *
+ * line is a single command for the task owning the current system state.                              *
+ *                                                                                                     *
+ * @param line [char*] Pointer to the null terminated line.                                            *
+ * @param len [uint32_t] Length of the line.                                                           *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+static void process_line(char *line, uint32_t len)
+{
+	// Collect script lines until `End`
+	if(batch_recording) {
+		if(0 == strcmp(line, "End")) {
+			batch_recording = 0;
+			if(batch_overflow) {
+				xQueueSend(q_print, &msg_batch_overflow, portMAX_DELAY);
+			}
+			else {
+				batch_script[batch_script_len] = '\0';
+				batch_run(batch_script);
+			}
+		}
+		else {
+			batch_append(line, len);
+		}
+		return;
+	}
+
+	if(0 == strcmp(line, "Begin")) {
+		// Start collecting a script
+		batch_recording = 1;
+		batch_overflow = 0;
+		batch_script_len = 0;
+	}
+	else if(NULL != strchr(line, ';')) {
+		// Execute the batch right away
+		batch_run(line);
+	}
+	else {
+		post_message(line, len);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Copies a command into the message handed to the consumer task and dispatches it.             *
  *                                                                                                     *
- * @param msg [message_t*] Pointer to a message structure to hold the extracted command.               *
- * @return int                                                                                         *
- * @retval 0 if the command was successfully extracted.                                                *
- * @retval -1 if the data queue was empty or an error occurred during extraction.                      *
+ * @param text [const char*] Pointer to the command, not necessarily null terminated.                  *
+ * @param len [uint32_t] Length of the command, at most `UART_RX_LINE_SIZE - 1` characters.            *
+ * @return void                                                                                        *
  *                                                                                                     *
- * @note This function is called by `process_message` to parse the incoming command message.           *
- * @note The data queue (`q_data`) must be initialized and contain a message to extract.               *
- * @note The extracted command is stored in the `msg` structure, with its payload and length fields    *
- *       populated.                                                                                    *
+ * @note The message is kept in a separate buffer so that the message last handed to a consumer is not *
+ *       modified while the next line is being received.                                               *
  ******************************************************************************************************/
-int extract_command(message_t *msg) {
+static void post_message(const char *text, uint32_t len)
+{
+	if(len > sizeof(rx_msg.payload) - 1) {
+		len = sizeof(rx_msg.payload) - 1;
+	}
 
-	uint8_t item;
-	BaseType_t status;
+	memcpy(rx_msg.payload, text, len);
+	rx_msg.payload[len] = '\0';
+	rx_msg.len = len;
 
-	// Check if there is data in the data queue
-	status = uxQueueMessagesWaiting(q_data);
-	if(!status) {
-		return -1;
+	process_message(&rx_msg);
+}
+
+/*******************************************************************************************************
+ * @brief Appends a script line to the batch under collection.                                         *
+ *                                                                                                     *
+ * @param line [const char*] Pointer to the line.                                                      *
+ * @param len [uint32_t] Length of the line.                                                           *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Lines are joined with `;`. A script that does not fit is discarded when `End` is received.    *
+ ******************************************************************************************************/
+static void batch_append(const char *line, uint32_t len)
+{
+	// Keep room for the separator and the null terminator
+	if(batch_script_len + len + 2 > sizeof(batch_script)) {
+		batch_overflow = 1;
+		return;
 	}
 
-	// If data is available in the data queue, load it to the msg payload
-	uint8_t i=0;
-	do {
-		status = xQueueReceive(q_data, &item, 0);
-		if(pdTRUE == status) {
-			msg->payload[i++] = item;
+	memcpy(&batch_script[batch_script_len], line, len);
+	batch_script_len += len;
+	batch_script[batch_script_len++] = ';';
+}
+
+/*******************************************************************************************************
+ * @brief Executes a batch of `;` separated commands.                                                  *
+ *                                                                                                     *
+ * Each command is handed to the task owning the current system state, exactly as if it had been       *
+ * typed, and the next one is only handed over once a task waits for input again. Menus, prompts and   *
+ * confirmations are suppressed meanwhile. The batch stops at the first command that fails or does     *
+ * not complete within `BATCH_CMD_TIMEOUT_MS`, and ends with a single acknowledgement line.            *
+ *                                                                                                     *
+ * @param cmds [char*] Pointer to the null terminated commands. Spaces around each command are         *
+ *        ignored.                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Runs in the message handler task, so no further line is processed until the batch is done.    *
+ ******************************************************************************************************/
+static void batch_run(char *cmds)
+{
+	char *cmd = cmds;
+	char *end = cmds;
+	uint32_t len = 0;
+	uint8_t timed_out = 0;
+
+	// Forget a completion reported after the timeout of an earlier batch
+	ulTaskNotifyValueClear(NULL, UART_RX_EVT_READY);
+	batch_failed = 0;
+	batch_cmd = 0;
+
+	while((0 == batch_failed) && ('\0' != *end)) {
+		// Find the next command and strip the surrounding spaces
+		while(' ' == *cmd) {
+			cmd++;
+		}
+		end = cmd;
+		while(('\0' != *end) && (';' != *end)) {
+			end++;
+		}
+		len = end - cmd;
+		while((len > 0) && (' ' == cmd[len - 1])) {
+			len--;
+		}
+
+		if(len > 0) {
+			batch_cmd++;
+			post_message(cmd, len);
+
+			// Wait until the command is complete
+			if(pdTRUE != batch_wait_ready()) {
+				batch_failed = batch_cmd;
+				timed_out = 1;
+			}
+		}
+
+		if((0 == batch_failed) && ('\0' != *end)) {
+			cmd = end + 1;
 		}
-	} while (item != '\n');
+	}
 
-	// Set final character in message payload to null character
-	msg->payload[i-1] = '\0';
-	// Save length of message without null character
-	msg->len = i-1;
+	// Acknowledge the whole batch at once
+	char *ack = print_pool_alloc(portMAX_DELAY);
+	if(0 == batch_failed) {
+		snprintf(ack, PRINT_POOL_BLOCK_SIZE, "\nBatch OK: %" PRIu32 " commands\n", batch_cmd);
+	}
+	else {
+		snprintf(ack, PRINT_POOL_BLOCK_SIZE, "\nBatch ERR: command %" PRIu32 " (%.*s) %s\n", batch_failed, (int)len, cmd,
+				 timed_out ? "timed out" : "failed");
+	}
+	batch_cmd = 0;
+	print_pool_send(ack);
+}
+
+/*******************************************************************************************************
+ * @brief Waits until a task is ready for the next command of a batch.                                 *
+ *                                                                                                     *
+ * @param None                                                                                         *
+ * @return BaseType_t pdTRUE once a task waits for input, pdFALSE after `BATCH_CMD_TIMEOUT_MS`.        *
+ *                                                                                                     *
+ * @note Reception events received meanwhile are left pending, the ring buffer is drained after the    *
+ *       batch.                                                                                        *
+ ******************************************************************************************************/
+static BaseType_t batch_wait_ready(void)
+{
+	const TickType_t timeout = pdMS_TO_TICKS(BATCH_CMD_TIMEOUT_MS);
+	TickType_t start = xTaskGetTickCount();
+	TickType_t elapsed = 0;
+	uint32_t events = 0;
+
+	while(!(events & UART_RX_EVT_READY)) {
+		elapsed = xTaskGetTickCount() - start;
+		if(elapsed >= timeout) {
+			return pdFALSE;
+		}
+		xTaskNotifyWait(0, UART_RX_EVT_READY, &events, timeout - elapsed);
+	}
 
-	return 0;
+	return pdTRUE;
 }
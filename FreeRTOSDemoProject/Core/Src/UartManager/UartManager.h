@@ -21,14 +21,9 @@
  ****************************************************/
 
 #include <stdint.h>
-
-/****************************************************
- *  Public functions                                *
- ****************************************************/
-
-void main_menu_task(void *param);
-void message_handler_task(void *param);
-void print_task(void *param);
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "Config_UartManager.h"
 
 /****************************************************
  *  Variables                                       *
@@ -36,8 +31,47 @@ void print_task(void *param);
 
 typedef struct
 {
-	uint8_t payload[10];
+	uint8_t payload[UART_RX_LINE_SIZE];	// Null terminated command, a message is never longer than a line
 	uint32_t len;
 } message_t;
 
+typedef struct
+{
+	uint32_t in_use;			// Blocks currently owned by a producer or the print task
+	uint32_t high_water;		// Highest number of blocks in use at the same time
+	uint32_t alloc_failures;	// Allocations that timed out with the pool exhausted
+	uint32_t tx_dropped_bytes;	// Bytes discarded because their DMA transmission could not be started
+} print_pool_stats_t;
+
+typedef struct
+{
+	uint32_t dropped_bytes;		// Bytes lost because the reception ring buffer was full
+	uint32_t long_lines;		// Lines discarded because they did not fit into `UART_RX_LINE_SIZE`
+	uint32_t long_frames;		// Binary frames discarded because they did not fit into the frame buffer
+} uart_rx_stats_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void main_menu_task(void *param);
+void message_handler_task(void *param);
+void print_task(void *param);
+void uart_rx_start(void);
+void uart_rx_event_callback(UART_HandleTypeDef *huart, uint16_t size);
+void uart_tx_complete_callback(UART_HandleTypeDef *huart);
+void uart_error_callback(UART_HandleTypeDef *huart);
+void print_pool_init(void);
+char *print_pool_alloc(TickType_t timeout);
+void print_pool_send(char *block);
+void print_pool_send_frame(char *block, uint32_t len);
+void print_pool_free(char *block);
+void print_pool_get_stats(print_pool_stats_t *stats);
+void uart_rx_get_stats(uart_rx_stats_t *stats);
+message_t *uart_wait_message(void);
+message_t *uart_poll_message(TickType_t wait);
+int uart_batch_active(void);
+void print_interactive(const char *msg);
+void print_error(const char *msg);
+
 #endif /* UARTMANAGER_H_ */
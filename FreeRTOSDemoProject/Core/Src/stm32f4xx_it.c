@@ -23,6 +23,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "MotorManager.h"
+#include "StatsManager.h"
+#include "AccStream.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,7 +49,10 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
-
+// Handlers on the motor control path, placed in SRAM with RAM_FUNC
+RAM_FUNC void EXTI4_IRQHandler(void);
+RAM_FUNC void EXTI9_5_IRQHandler(void);
+RAM_FUNC void TIM7_IRQHandler(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -61,7 +66,10 @@ extern UART_HandleTypeDef huart2;
 extern TIM_HandleTypeDef htim6;
 
 /* USER CODE BEGIN EV */
-
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
+extern DMA_HandleTypeDef hdma_spi1_rx;
+extern DMA_HandleTypeDef hdma_spi1_tx;
 /* USER CODE END EV */
 
 /******************************************************************************/
@@ -168,11 +176,11 @@ void DebugMon_Handler(void)
 void EXTI4_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI4_IRQn 0 */
-
+  stats_isr_enter(STATS_ISR_EXTI4);
   /* USER CODE END EXTI4_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(ENCODER_A_Pin);
   /* USER CODE BEGIN EXTI4_IRQn 1 */
-
+  stats_isr_exit(STATS_ISR_EXTI4);
   /* USER CODE END EXTI4_IRQn 1 */
 }
 
@@ -182,11 +190,11 @@ void EXTI4_IRQHandler(void)
 void EXTI9_5_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI9_5_IRQn 0 */
-
+  stats_isr_enter(STATS_ISR_EXTI9_5);
   /* USER CODE END EXTI9_5_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(ENCODER_B_Pin);
   /* USER CODE BEGIN EXTI9_5_IRQn 1 */
-
+  stats_isr_exit(STATS_ISR_EXTI9_5);
   /* USER CODE END EXTI9_5_IRQn 1 */
 }
 
@@ -196,11 +204,11 @@ void EXTI9_5_IRQHandler(void)
 void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
-
+  stats_isr_enter(STATS_ISR_USART2);
   /* USER CODE END USART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_IRQn 1 */
-
+  stats_isr_exit(STATS_ISR_USART2);
   /* USER CODE END USART2_IRQn 1 */
 }
 
@@ -210,11 +218,11 @@ void USART2_IRQHandler(void)
 void TIM6_DAC_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM6_DAC_IRQn 0 */
-
+  stats_isr_enter(STATS_ISR_TIM6);
   /* USER CODE END TIM6_DAC_IRQn 0 */
   HAL_TIM_IRQHandler(&htim6);
   /* USER CODE BEGIN TIM6_DAC_IRQn 1 */
-
+  stats_isr_exit(STATS_ISR_TIM6);
   /* USER CODE END TIM6_DAC_IRQn 1 */
 }
 
@@ -224,14 +232,64 @@ void TIM6_DAC_IRQHandler(void)
 void TIM7_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM7_IRQn 0 */
-
+  stats_isr_enter(STATS_ISR_TIM7);
   /* USER CODE END TIM7_IRQn 0 */
   HAL_TIM_IRQHandler(&htim7);
   /* USER CODE BEGIN TIM7_IRQn 1 */
-
+  stats_isr_exit(STATS_ISR_TIM7);
   /* USER CODE END TIM7_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles DMA1 stream5 global interrupt (USART2 RX).
+  */
+void DMA1_Stream5_IRQHandler(void)
+{
+  stats_isr_enter(STATS_ISR_DMA_RX);
+  HAL_DMA_IRQHandler(&hdma_usart2_rx);
+  stats_isr_exit(STATS_ISR_DMA_RX);
+}
+
+/**
+  * @brief This function handles DMA1 stream6 global interrupt (USART2 TX).
+  */
+void DMA1_Stream6_IRQHandler(void)
+{
+  stats_isr_enter(STATS_ISR_DMA_TX);
+  HAL_DMA_IRQHandler(&hdma_usart2_tx);
+  stats_isr_exit(STATS_ISR_DMA_TX);
+}
+
+/**
+  * @brief This function handles EXTI line0 interrupt (accelerometer INT1).
+  */
+void EXTI0_IRQHandler(void)
+{
+  stats_isr_enter(STATS_ISR_EXTI0);
+  HAL_GPIO_EXTI_IRQHandler(MEMS_INT1_Pin);
+  stats_isr_exit(STATS_ISR_EXTI0);
+}
+
+/**
+  * @brief This function handles DMA2 stream0 global interrupt (SPI1 RX).
+  */
+void DMA2_Stream0_IRQHandler(void)
+{
+  stats_isr_enter(STATS_ISR_SPI_RX);
+  HAL_DMA_IRQHandler(&hdma_spi1_rx);
+  stats_isr_exit(STATS_ISR_SPI_RX);
+}
+
+/**
+  * @brief This function handles DMA2 stream3 global interrupt (SPI1 TX).
+  */
+void DMA2_Stream3_IRQHandler(void)
+{
+  stats_isr_enter(STATS_ISR_SPI_TX);
+  HAL_DMA_IRQHandler(&hdma_spi1_tx);
+  stats_isr_exit(STATS_ISR_SPI_TX);
+}
+
 /* USER CODE END 1 */
@@ -0,0 +1,215 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ CommandBench ]                                                          |
+| FILE:       CommandBench.c                                                            |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `CommandBench` benchmark measures the console command dispatch cost.           |
+|    It times the LED menu commands through the former strcmp chain and through         |
+|    the hashed command table, for every command and a few invalid lines.               |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_Sim.h"
+#include "Command.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_handler(const char *args);
+static int bench_chain(const char *line);
+static double bench_time(int (*dispatch)(const char *line), const char *line, uint32_t iterations);
+static int bench_table(const char *line);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: CommandBench [-n iterations]\n"
+								 "  -n  dispatches timed per command line (default %u)\n";
+
+// LED menu command list, with the handlers replaced by a counter
+static const command_t bench_commands[] = {
+	{ "None",	bench_handler,	0 },
+	{ "E1",		bench_handler,	0 },
+	{ "E2",		bench_handler,	0 },
+	{ "E3",		bench_handler,	0 },
+	{ "E4",		bench_handler,	0 },
+	{ "Tor",	bench_handler,	0 },
+	{ "Tgr",	bench_handler,	0 },
+	{ "Tbl",	bench_handler,	0 },
+	{ "Tre",	bench_handler,	0 },
+	{ "Main",	bench_handler,	0 },
+};
+static command_table_t bench_command_table = COMMAND_TABLE(bench_commands);
+
+// Command lines to time: every command in chain order, then lines that match nothing
+static const char *bench_lines[] = {
+	"None", "E1", "E2", "E3", "E4", "Tor", "Tgr", "Tbl", "Tre", "Main", "Mai", "Quit", "Toggle"
+};
+
+static volatile uint32_t bench_calls = 0; // Handler calls, keeps the dispatch from being optimized out
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments.                                 *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	uint32_t iterations = SIM_BENCH_CMD_ITERATIONS;
+	double chain_total = 0.0;
+	double table_total = 0.0;
+	uint32_t count = sizeof(bench_lines) / sizeof(bench_lines[0]);
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "n:"))) {
+		switch(opt) {
+			case 'n': iterations = strtoul(optarg, NULL, 10); break;
+			default:
+				fprintf(stderr, bench_usage, SIM_BENCH_CMD_ITERATIONS);
+				return EXIT_FAILURE;
+		}
+	}
+	if(0 == iterations) {
+		fprintf(stderr, bench_usage, SIM_BENCH_CMD_ITERATIONS);
+		return EXIT_FAILURE;
+	}
+
+	if(0 != command_table_init(&bench_command_table)) {
+		fprintf(stderr, "CommandBench: no collision-free hash seed for the command list\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("LED menu, %u commands, hash seed %u, %u dispatches per line\n\n",
+		   bench_command_table.count, bench_command_table.seed, iterations);
+	printf("%-8s %12s %12s\n", "line", "chain (ns)", "table (ns)");
+
+	for(uint32_t i = 0; i < count; i++) {
+		double chain_ns = bench_time(bench_chain, bench_lines[i], iterations);
+		double table_ns = bench_time(bench_table, bench_lines[i], iterations);
+
+		// Both dispatchers must agree on which lines are commands
+		if(bench_chain(bench_lines[i]) != bench_table(bench_lines[i])) {
+			fprintf(stderr, "CommandBench: dispatchers disagree on \"%s\"\n", bench_lines[i]);
+			return EXIT_FAILURE;
+		}
+
+		printf("%-8s %12.1f %12.1f\n", bench_lines[i], chain_ns, table_ns);
+		chain_total += chain_ns;
+		table_total += table_ns;
+	}
+
+	printf("%-8s %12.1f %12.1f\n", "mean", chain_total / count, table_total / count);
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Command handler standing in for the LED menu handlers.                                       *
+ *                                                                                                     *
+ * @param args [const char*] Not used.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_handler(const char *args)
+{
+	bench_calls++;
+}
+
+/*******************************************************************************************************
+ * @brief Dispatches a line through the strcmp chain the LED task used before the command tables.      *
+ *                                                                                                     *
+ * @param line [const char*] Null terminated command line.                                             *
+ * @return int 1 if a handler was run, 0 otherwise.                                                    *
+ ******************************************************************************************************/
+
+static int bench_chain(const char *line)
+{
+	if(strlen(line) <= 4) {
+		if(!strcmp(line, "None")) bench_handler("");
+		else if(!strcmp(line, "E1")) bench_handler("");
+		else if(!strcmp(line, "E2")) bench_handler("");
+		else if(!strcmp(line, "E3")) bench_handler("");
+		else if(!strcmp(line, "E4")) bench_handler("");
+		else if(!strcmp(line, "Tor")) bench_handler("");
+		else if(!strcmp(line, "Tgr")) bench_handler("");
+		else if(!strcmp(line, "Tbl")) bench_handler("");
+		else if(!strcmp(line, "Tre")) bench_handler("");
+		else if(!strcmp(line, "Main")) bench_handler("");
+		else return 0;
+		return 1;
+	}
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Dispatches a line through the hashed command table.                                          *
+ *                                                                                                     *
+ * @param line [const char*] Null terminated command line.                                             *
+ * @return int 1 if a handler was run, 0 otherwise.                                                    *
+ ******************************************************************************************************/
+
+static int bench_table(const char *line)
+{
+	return command_dispatch(&bench_command_table, line);
+}
+
+/*******************************************************************************************************
+ * @brief Measures the mean host time of one dispatch.                                                 *
+ *                                                                                                     *
+ * The line is copied to a volatile pointer on every iteration, so the compiler cannot hoist the string*
+ * compares out of the loop.                                                                           *
+ *                                                                                                     *
+ * @param dispatch [int (*)(const char*)] Dispatcher to time.                                          *
+ * @param line [const char*] Command line.                                                             *
+ * @param iterations [uint32_t] Number of dispatches.                                                  *
+ * @return double Mean time per dispatch in nanoseconds.                                               *
+ ******************************************************************************************************/
+
+static double bench_time(int (*dispatch)(const char *line), const char *line, uint32_t iterations)
+{
+	const char *volatile input = line;
+	uint64_t start = bench_now_ns();
+
+	for(uint32_t i = 0; i < iterations; i++) {
+		dispatch(input);
+	}
+
+	return (double)(bench_now_ns() - start) / iterations;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the host monotonic clock.                                                              *
+ *                                                                                                     *
+ * @return uint64_t Time in nanoseconds.                                                               *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
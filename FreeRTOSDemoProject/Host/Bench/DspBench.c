@@ -0,0 +1,461 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ DspBench ]                                                              |
+| FILE:       DspBench.c                                                                |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `DspBench` benchmark times the accelerometer DSP kernels on the host,          |
+|    in their portable C form, against a double precision reference of each.            |
+|    It reports the time per sample, the largest difference from the reference          |
+|    and the low-pass attenuation, on a simulated stream of vibration samples.          |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_Sim.h"
+#include "AccDsp.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define BENCH_BLOCK					32 // Samples per block, as the stream delivers them
+#define BENCH_MAX_BLOCKS			1024 // Blocks of test signal, replayed for longer runs
+#define BENCH_MAX_TAPS				256
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_signal(int16_t *signal, uint32_t count, double fs, double tone_hz, double noise);
+static double bench_fir(const int16_t *signal, uint32_t blocks, uint32_t iterations, int16_t *out);
+static double bench_fir_reference(const int16_t *signal, uint32_t blocks, uint32_t iterations, double *out);
+static double bench_biquad(const int16_t *signal, uint32_t count, uint32_t iterations, double *out);
+static double bench_biquad_reference(const int16_t *signal, uint32_t count, uint32_t iterations, double *out);
+static double bench_window(const int16_t *signal, uint32_t count, uint32_t iterations, double *error);
+static double bench_tilt(uint32_t iterations, double *error);
+static double bench_gain_db(double tone_hz);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: DspBench [-n iterations] [-m decimation] [-t taps] [-r rate] [-l lowpass] [-h highpass]\n"
+								 "  -n  passes over the test signal per kernel (default %u)\n"
+								 "  -m  decimation factor, a divisor of %u (default %u)\n"
+								 "  -t  low-pass taps (default %u)\n"
+								 "  -r  sample rate in Hz (default %u)\n"
+								 "  -l  low-pass cutoff in Hz, 0 for %u %% of the decimated rate (default 0)\n"
+								 "  -h  high-pass cutoff in Hz (default %g)\n";
+
+static uint32_t bench_decimation = ACC_DSP_DEFAULT_DECIMATION;
+static uint32_t bench_taps = ACC_DSP_FIR_TAPS;
+static double bench_fs = SIM_BENCH_DSP_RATE_HZ;
+static int16_t bench_fir_coeffs[BENCH_MAX_TAPS];
+static int32_t bench_hp_coeffs[ACC_DSP_BIQUAD_COEFFS];
+
+static int16_t bench_input[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+static int16_t bench_lowpassed[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+static double bench_lowpassed_ref[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+static double bench_highpassed[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+static int16_t bench_highpassed_counts[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+static double bench_highpassed_ref[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+
+static volatile int32_t bench_sink = 0; // Consumes results, keeps the kernels from being optimized out
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments or a kernel off its reference.   *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	uint32_t iterations = SIM_BENCH_DSP_ITERATIONS;
+	double lowpass_hz = 0.0;
+	double highpass_hz = SIM_BENCH_DSP_HIGHPASS_HZ;
+	uint32_t blocks = BENCH_MAX_BLOCKS;
+	uint32_t outputs;
+	double error[4];
+	double fixed_ns[4];
+	double ref_ns[2];
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "n:m:t:r:l:h:"))) {
+		switch(opt) {
+			case 'n': iterations = strtoul(optarg, NULL, 10); break;
+			case 'm': bench_decimation = strtoul(optarg, NULL, 10); break;
+			case 't': bench_taps = strtoul(optarg, NULL, 10); break;
+			case 'r': bench_fs = strtod(optarg, NULL); break;
+			case 'l': lowpass_hz = strtod(optarg, NULL); break;
+			case 'h': highpass_hz = strtod(optarg, NULL); break;
+			default: iterations = 0; break;
+		}
+	}
+	if((0 == iterations) || (0 == bench_decimation) || (0 != (BENCH_BLOCK % bench_decimation))
+	   || (bench_taps < 2) || (bench_taps > BENCH_MAX_TAPS) || (bench_fs < 1.0)) {
+		fprintf(stderr, bench_usage, SIM_BENCH_DSP_ITERATIONS, BENCH_BLOCK, ACC_DSP_DEFAULT_DECIMATION, ACC_DSP_FIR_TAPS,
+				SIM_BENCH_DSP_RATE_HZ, ACC_DSP_AUTO_LOWPASS_PCT, SIM_BENCH_DSP_HIGHPASS_HZ);
+		return EXIT_FAILURE;
+	}
+	if(0.0 == lowpass_hz) {
+		lowpass_hz = (bench_fs * ACC_DSP_AUTO_LOWPASS_PCT) / (100.0 * bench_decimation);
+	}
+
+	// Same designs as the pipeline, the cutoffs in mHz
+	uint32_t fs_mhz = (uint32_t)lround(bench_fs * 1000.0);
+	if((0 != acc_dsp_design_lowpass(bench_fir_coeffs, bench_taps, (uint32_t)lround(lowpass_hz * 1000.0), fs_mhz))
+	   || (0 != acc_dsp_design_highpass(bench_hp_coeffs, (uint32_t)lround(highpass_hz * 1000.0), fs_mhz / bench_decimation))) {
+		fprintf(stderr, "DspBench: a cutoff does not fit the sample rate\n");
+		return EXIT_FAILURE;
+	}
+
+	bench_signal(bench_input, blocks * BENCH_BLOCK, bench_fs, SIM_BENCH_DSP_TONE_HZ, SIM_BENCH_DSP_NOISE_LSB);
+	outputs = (blocks * BENCH_BLOCK) / bench_decimation;
+
+	fixed_ns[0] = bench_fir(bench_input, blocks, iterations, bench_lowpassed);
+	ref_ns[0] = bench_fir_reference(bench_input, blocks, iterations, bench_lowpassed_ref);
+	fixed_ns[1] = bench_biquad(bench_lowpassed, outputs, iterations, bench_highpassed);
+	ref_ns[1] = bench_biquad_reference(bench_lowpassed, outputs, iterations, bench_highpassed_ref);
+	for(uint32_t n = 0; n < outputs; n++) {
+		bench_highpassed_counts[n] = (int16_t)lround(bench_highpassed[n]);
+	}
+	fixed_ns[2] = bench_window(bench_highpassed_counts, outputs, iterations, &error[2]);
+	fixed_ns[3] = bench_tilt(iterations, &error[3]);
+
+	// The fixed point outputs are compared with the reference run on the same inputs
+	error[0] = 0.0;
+	for(uint32_t n = 0; n < outputs; n++) {
+		error[0] = fmax(error[0], fabs(bench_lowpassed[n] - bench_lowpassed_ref[n]));
+	}
+	error[1] = 0.0;
+	for(uint32_t n = 0; n < outputs; n++) {
+		error[1] = fmax(error[1], fabs(bench_highpassed[n] - bench_highpassed_ref[n]));
+	}
+
+	printf("%.1f Hz in, decimation %u, %u taps, low-pass %.2f Hz, high-pass %.2f Hz, %u passes of %u samples\n\n",
+		   bench_fs, bench_decimation, bench_taps, lowpass_hz, highpass_hz, iterations, blocks * BENCH_BLOCK);
+	printf("%-14s %14s %14s %12s\n", "kernel", "fixed (ns)", "double (ns)", "max error");
+	printf("%-14s %14.2f %14.2f %10.2f %s\n", "fir_decimate", fixed_ns[0], ref_ns[0], error[0], "LSB");
+	printf("%-14s %14.2f %14.2f %10.2f %s\n", "biquad", fixed_ns[1], ref_ns[1], error[1], "LSB");
+	printf("%-14s %14.2f %14s %10.2f %s\n", "rms_p2p", fixed_ns[2], "-", error[2], "LSB");
+	printf("%-14s %14.2f %14s %10.2f %s\n", "tilt", fixed_ns[3], "-", error[3], "cdeg");
+	printf("\nTimes are per input sample of each kernel, and per call for the tilt.\n");
+	printf("Low-pass gain: %.2f dB at %.1f Hz, %.2f dB at %.1f Hz, %.2f dB at %.1f Hz\n",
+		   bench_gain_db(SIM_BENCH_DSP_TONE_HZ), SIM_BENCH_DSP_TONE_HZ,
+		   bench_gain_db(lowpass_hz), lowpass_hz,
+		   bench_gain_db(bench_fs / bench_decimation), bench_fs / bench_decimation);
+
+	// Truncation of the accumulators stays within a few LSB of the exact filters
+	if((error[0] > SIM_BENCH_DSP_MAX_ERROR_LSB) || (error[1] > SIM_BENCH_DSP_MAX_ERROR_LSB)
+	   || (error[2] > SIM_BENCH_DSP_MAX_ERROR_LSB) || (error[3] > SIM_BENCH_DSP_MAX_ERROR_CDEG)) {
+		printf("FAIL: a kernel is off its reference\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("PASS: every kernel matches its reference\n");
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Generates the test signal of one axis.                                                       *
+ *                                                                                                     *
+ * Half of full scale stands for gravity, with a vibration at `SIM_BENCH_DSP_TONE_HZ`, a tone near     *
+ * the sensor Nyquist rate that the low-pass must remove, and pseudo-random noise.                     *
+ *                                                                                                     *
+ * @param signal [int16_t*] Output samples.                                                            *
+ * @param count [uint32_t] Number of samples.                                                          *
+ * @param fs [double] Sample rate (Hz).                                                                *
+ * @param tone_hz [double] Vibration frequency (Hz).                                                   *
+ * @param noise [double] Peak noise (counts).                                                          *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_signal(int16_t *signal, uint32_t count, double fs, double tone_hz, double noise)
+{
+	uint32_t seed = 1;
+
+	for(uint32_t n = 0; n < count; n++) {
+		double t = n / fs;
+		seed = (seed * 1103515245U) + 12345U;
+		double value = 16384.0 + (4000.0 * sin(2.0 * M_PI * tone_hz * t)) + (2000.0 * sin(2.0 * M_PI * 0.45 * fs * t))
+					 + (noise * ((((seed >> 16) & 0x7FFF) / 16384.0) - 1.0));
+		signal[n] = (int16_t)lround(value);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Times the q15 decimating FIR.                                                                *
+ *                                                                                                     *
+ * @param signal [const int16_t*] Input samples.                                                       *
+ * @param blocks [uint32_t] Blocks of `BENCH_BLOCK` input samples.                                     *
+ * @param iterations [uint32_t] Passes over the input.                                                 *
+ * @param out [int16_t*] Output samples of the first pass.                                             *
+ * @return double Mean time per input sample in nanoseconds.                                           *
+ ******************************************************************************************************/
+
+static double bench_fir(const int16_t *signal, uint32_t blocks, uint32_t iterations, int16_t *out)
+{
+	static int16_t state[BENCH_MAX_TAPS + BENCH_BLOCK - 1];
+	int16_t scratch[BENCH_BLOCK];
+	acc_fir_t fir;
+	uint32_t outputs = BENCH_BLOCK / bench_decimation;
+	uint64_t start;
+
+	acc_fir_decimate_init(&fir, bench_fir_coeffs, bench_taps, bench_decimation, state, BENCH_BLOCK);
+	for(uint32_t b = 0; b < blocks; b++) {
+		acc_fir_decimate(&fir, &signal[b * BENCH_BLOCK], &out[b * outputs], BENCH_BLOCK);
+	}
+
+	start = bench_now_ns();
+	for(uint32_t i = 0; i < iterations; i++) {
+		for(uint32_t b = 0; b < blocks; b++) {
+			acc_fir_decimate(&fir, &signal[b * BENCH_BLOCK], scratch, BENCH_BLOCK);
+			bench_sink += scratch[0];
+		}
+	}
+
+	return (double)(bench_now_ns() - start) / ((double)iterations * blocks * BENCH_BLOCK);
+}
+
+/*******************************************************************************************************
+ * @brief Times a double precision decimating FIR with the same taps, and no rounding.                 *
+ *                                                                                                     *
+ * @param signal [const int16_t*] Input samples.                                                       *
+ * @param blocks [uint32_t] Blocks of `BENCH_BLOCK` input samples.                                     *
+ * @param iterations [uint32_t] Passes over the input.                                                 *
+ * @param out [double*] Output samples, in counts.                                                     *
+ * @return double Mean time per input sample in nanoseconds.                                           *
+ ******************************************************************************************************/
+
+static double bench_fir_reference(const int16_t *signal, uint32_t blocks, uint32_t iterations, double *out)
+{
+	uint32_t count = blocks * BENCH_BLOCK;
+	uint64_t start = bench_now_ns();
+
+	for(uint32_t i = 0; i < iterations; i++) {
+		// Output m uses input m * M and the taps - 1 before it, zero before the signal starts
+		for(uint32_t n = 0, m = 0; n < count; n += bench_decimation, m++) {
+			double acc = 0.0;
+			for(uint32_t k = 0; (k < bench_taps) && (k <= n); k++) {
+				acc += signal[n - k] * (bench_fir_coeffs[bench_taps - 1 - k] / 32768.0);
+			}
+			out[m] = acc;
+		}
+		bench_sink += (int32_t)out[0];
+	}
+
+	return (double)(bench_now_ns() - start) / ((double)iterations * count);
+}
+
+/*******************************************************************************************************
+ * @brief Times the q31 biquad.                                                                        *
+ *                                                                                                     *
+ * The samples are scaled to q31 with the headroom the pipeline gives them, outside of the timing.     *
+ *                                                                                                     *
+ * @param signal [const int16_t*] Input samples, the low-pass output.                                  *
+ * @param count [uint32_t] Number of samples, a multiple of `BENCH_BLOCK`.                             *
+ * @param iterations [uint32_t] Passes over the input.                                                 *
+ * @param out [double*] Output samples of the first pass, in counts.                                   *
+ * @return double Mean time per sample in nanoseconds.                                                 *
+ ******************************************************************************************************/
+
+static double bench_biquad(const int16_t *signal, uint32_t count, uint32_t iterations, double *out)
+{
+	static int32_t input[BENCH_MAX_BLOCKS * BENCH_BLOCK];
+	int32_t state[ACC_DSP_BIQUAD_STATE];
+	int32_t scratch[BENCH_BLOCK];
+	acc_biquad_t biquad;
+	uint32_t block = BENCH_BLOCK / bench_decimation;
+	uint64_t start;
+
+	for(uint32_t n = 0; n < count; n++) {
+		input[n] = (int32_t)signal[n] << ACC_DSP_BIQUAD_INPUT_SHIFT;
+	}
+
+	acc_biquad_init(&biquad, bench_hp_coeffs, state);
+	for(uint32_t n = 0; n < count; n += block) {
+		acc_biquad(&biquad, &input[n], scratch, block);
+		for(uint32_t i = 0; i < block; i++) {
+			out[n + i] = scratch[i] / (double)(1 << ACC_DSP_BIQUAD_INPUT_SHIFT);
+		}
+	}
+
+	start = bench_now_ns();
+	for(uint32_t i = 0; i < iterations; i++) {
+		for(uint32_t n = 0; n < count; n += block) {
+			acc_biquad(&biquad, &input[n], scratch, block);
+			bench_sink += scratch[0];
+		}
+	}
+
+	return (double)(bench_now_ns() - start) / ((double)iterations * count);
+}
+
+/*******************************************************************************************************
+ * @brief Times a double precision biquad with the same coefficients, and no rounding.                 *
+ *                                                                                                     *
+ * @param signal [const int16_t*] Input samples, the low-pass output.                                  *
+ * @param count [uint32_t] Number of samples.                                                          *
+ * @param iterations [uint32_t] Passes over the input.                                                 *
+ * @param out [double*] Output samples, in counts.                                                     *
+ * @return double Mean time per sample in nanoseconds.                                                 *
+ ******************************************************************************************************/
+
+static double bench_biquad_reference(const int16_t *signal, uint32_t count, uint32_t iterations, double *out)
+{
+	double c[ACC_DSP_BIQUAD_COEFFS];
+	uint64_t start;
+
+	for(int k = 0; k < ACC_DSP_BIQUAD_COEFFS; k++) {
+		c[k] = bench_hp_coeffs[k] / (double)(1U << (31 - ACC_DSP_BIQUAD_POST_SHIFT));
+	}
+
+	start = bench_now_ns();
+	for(uint32_t i = 0; i < iterations; i++) {
+		double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+		for(uint32_t n = 0; n < count; n++) {
+			double y = (c[0] * signal[n]) + (c[1] * x1) + (c[2] * x2) + (c[3] * y1) + (c[4] * y2);
+			x2 = x1;
+			x1 = signal[n];
+			y2 = y1;
+			y1 = y;
+			out[n] = y;
+		}
+		bench_sink += (int32_t)out[0];
+	}
+
+	return (double)(bench_now_ns() - start) / ((double)iterations * count);
+}
+
+/*******************************************************************************************************
+ * @brief Times the window statistics and checks the RMS and peak-to-peak.                             *
+ *                                                                                                     *
+ * @param signal [const int16_t*] Input samples.                                                       *
+ * @param count [uint32_t] Number of samples, a multiple of `BENCH_BLOCK`.                             *
+ * @param iterations [uint32_t] Passes over the input.                                                 *
+ * @param error [double*] Largest difference from the double precision RMS and peak-to-peak.           *
+ * @return double Mean time per sample in nanoseconds.                                                 *
+ ******************************************************************************************************/
+
+static double bench_window(const int16_t *signal, uint32_t count, uint32_t iterations, double *error)
+{
+	acc_window_t window;
+	double squares = 0.0;
+	int16_t min = INT16_MAX;
+	int16_t max = INT16_MIN;
+	uint64_t start;
+
+	for(uint32_t n = 0; n < count; n++) {
+		squares += (double)signal[n] * signal[n];
+		min = (signal[n] < min) ? signal[n] : min;
+		max = (signal[n] > max) ? signal[n] : max;
+	}
+
+	start = bench_now_ns();
+	for(uint32_t i = 0; i < iterations; i++) {
+		acc_window_reset(&window);
+		for(uint32_t n = 0; n < count; n += BENCH_BLOCK) {
+			acc_window_update(&window, &signal[n], BENCH_BLOCK);
+		}
+		bench_sink += (int32_t)acc_window_rms(&window);
+	}
+	double ns = (double)(bench_now_ns() - start) / ((double)iterations * count);
+
+	*error = fmax(fabs(acc_window_rms(&window) - sqrt(squares / count)), fabs((double)acc_window_p2p(&window) - (max - min)));
+	return ns;
+}
+
+/*******************************************************************************************************
+ * @brief Times the tilt computation and checks it against double precision.                           *
+ *                                                                                                     *
+ * @param iterations [uint32_t] Passes over the test orientations.                                     *
+ * @param error [double*] Largest difference from the double precision angles (cdeg).                  *
+ * @return double Mean time per call in nanoseconds.                                                   *
+ ******************************************************************************************************/
+
+static double bench_tilt(uint32_t iterations, double *error)
+{
+	int32_t axis[360][3];
+	int32_t pitch;
+	int32_t roll;
+	uint64_t start;
+
+	// Orientations around a cone, one per degree
+	*error = 0.0;
+	for(int a = 0; a < 360; a++) {
+		double angle = a * M_PI / 180.0;
+		axis[a][0] = (int32_t)lround(8000.0 * sin(angle));
+		axis[a][1] = (int32_t)lround(8000.0 * cos(angle));
+		axis[a][2] = (int32_t)lround(14000.0 * cos(3.0 * angle));
+
+		acc_dsp_tilt(axis[a], &pitch, &roll);
+		double x = axis[a][0], y = axis[a][1], z = axis[a][2];
+		*error = fmax(*error, fabs(pitch - (atan2(x, sqrt((y * y) + (z * z))) * 18000.0 / M_PI)));
+		*error = fmax(*error, fabs(roll - (atan2(y, z) * 18000.0 / M_PI)));
+	}
+
+	start = bench_now_ns();
+	for(uint32_t i = 0; i < iterations; i++) {
+		for(int a = 0; a < 360; a++) {
+			acc_dsp_tilt(axis[a], &pitch, &roll);
+			bench_sink += pitch + roll;
+		}
+	}
+
+	return (double)(bench_now_ns() - start) / ((double)iterations * 360);
+}
+
+/*******************************************************************************************************
+ * @brief Computes the gain of the q15 low-pass taps at a frequency.                                   *
+ *                                                                                                     *
+ * @param tone_hz [double] Frequency (Hz).                                                             *
+ * @return double Gain (dB).                                                                           *
+ ******************************************************************************************************/
+
+static double bench_gain_db(double tone_hz)
+{
+	double re = 0.0;
+	double im = 0.0;
+
+	for(uint32_t k = 0; k < bench_taps; k++) {
+		re += (bench_fir_coeffs[k] / 32768.0) * cos(2.0 * M_PI * tone_hz * k / bench_fs);
+		im -= (bench_fir_coeffs[k] / 32768.0) * sin(2.0 * M_PI * tone_hz * k / bench_fs);
+	}
+
+	return 20.0 * log10(sqrt((re * re) + (im * im)));
+}
+
+/*******************************************************************************************************
+ * @brief Reads the host monotonic clock.                                                              *
+ *                                                                                                     *
+ * @return uint64_t Time in nanoseconds.                                                               *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,336 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ FrameBench ]                                                            |
+| FILE:       FrameBench.c                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `FrameBench` benchmark loops random frames back through the framing of the     |
+|    binary protocol. Each frame gets its CRC-16, is COBS encoded and decoded again,    |
+|    and must come back unchanged. Corrupted copies check that the CRC catches every    |
+|    bit error and burst it guarantees to. It also reports the cost of each function.   |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_Sim.h"
+#include "Frame.h"
+#include "Protocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define BENCH_FRAME_SIZE			4096 // Longest frame the benchmark accepts, including the CRC
+#define BENCH_CRC_BURST_BITS		16 // Longest error burst a CRC-16 always detects
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Results of the loopback over every frame
+typedef struct
+{
+	uint32_t frames;
+	uint64_t bytes;				// Frame bytes, CRC included
+	uint64_t crc_ns;			// Host time spent in frame_crc16
+	uint64_t encode_ns;			// Host time spent in frame_cobs_encode
+	uint64_t decode_ns;			// Host time spent in frame_cobs_decode
+	uint32_t round_trip_errors;	// Frames not decoded back to the original bytes
+	uint32_t bit_missed;		// Single bit errors with a matching CRC
+	uint32_t burst_missed;		// Bursts of at most BENCH_CRC_BURST_BITS bits with a matching CRC
+	uint32_t wire_missed;		// Corrupted encoded bytes that still decode to a frame with a matching CRC
+} bench_result_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_run(uint32_t frames, uint32_t max_len, bench_result_t *result);
+static void bench_frame(uint8_t *frame, uint32_t len, bench_result_t *result);
+static int bench_crc_ok(const uint8_t *frame, int32_t len);
+static void bench_fill(uint8_t *data, uint32_t len, uint32_t zero_pct);
+static uint32_t bench_random(void);
+static uint64_t bench_elapsed_ns(uint64_t start);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: FrameBench [-n frames] [-l bytes] [-s seed]\n"
+								 "  -n  random frames looped back (default %u)\n"
+								 "  -l  longest frame, including the CRC, at most %u (default %u)\n"
+								 "  -s  seed of the frame generator (default %u)\n";
+
+// Share of zero bytes in the random frames, in turn: none, as random bytes, half and all
+static const uint32_t bench_zero_pct[] = { 0, 0xFFFFFFFF, 50, 100 };
+
+// Frame lengths at the COBS block boundaries, looped back before the random frames
+static const uint32_t bench_edge_lengths[] = { 2, 3, 253, 254, 255, 256, 508, 509, 510 };
+
+static uint32_t bench_seed = SIM_BENCH_FRAME_SEED;
+static uint64_t bench_timer_ns = 0; // Cost of reading the host clock, removed from the function times
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments, a frame that does not loop back *
+ *             or a corruption the CRC must detect going undetected.                                   *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	uint32_t frames = SIM_BENCH_FRAME_COUNT;
+	uint32_t max_len = SIM_BENCH_FRAME_MAX_LEN;
+	bench_result_t result;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "n:l:s:"))) {
+		switch(opt) {
+			case 'n': frames = strtoul(optarg, NULL, 10); break;
+			case 'l': max_len = strtoul(optarg, NULL, 10); break;
+			case 's': bench_seed = strtoul(optarg, NULL, 10); break;
+			default: frames = 0; break;
+		}
+	}
+	if((0 == frames) || (max_len < 2) || (max_len > BENCH_FRAME_SIZE)) {
+		fprintf(stderr, bench_usage, SIM_BENCH_FRAME_COUNT, BENCH_FRAME_SIZE, SIM_BENCH_FRAME_MAX_LEN, SIM_BENCH_FRAME_SEED);
+		return EXIT_FAILURE;
+	}
+
+	// Smallest cost of reading the clock twice
+	bench_timer_ns = UINT64_MAX;
+	for(int i = 0; i < 1000; i++) {
+		uint64_t start = bench_now_ns();
+		uint64_t cost = bench_now_ns() - start;
+		if(cost < bench_timer_ns) {
+			bench_timer_ns = cost;
+		}
+	}
+
+	bench_run(frames, max_len, &result);
+
+	printf("%u frames of 2 to %u bytes, %llu bytes, protocol frames up to %u bytes\n\n", result.frames, max_len,
+		   (unsigned long long)result.bytes, PROTO_FRAME_MAX);
+	printf("%-8s %12s\n", "function", "ns / byte");
+	printf("%-8s %12.2f\n", "crc16", (double)result.crc_ns / result.bytes);
+	printf("%-8s %12.2f\n", "encode", (double)result.encode_ns / result.bytes);
+	printf("%-8s %12.2f\n", "decode", (double)result.decode_ns / result.bytes);
+	printf("\nround trip errors %u, undetected single bit errors %u, undetected bursts %u\n", result.round_trip_errors,
+		   result.bit_missed, result.burst_missed);
+	printf("corrupted wire bytes still accepted %u of %u (about 1 in 65536 expected)\n", result.wire_missed, result.frames);
+
+	// Wire corruptions can turn into any error pattern, so only the guaranteed detections are checked
+	if((0 != result.round_trip_errors) || (0 != result.bit_missed) || (0 != result.burst_missed)) {
+		printf("FAIL: the framing does not loop back or misses a guaranteed error\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("PASS: every frame looped back and every guaranteed error was detected\n");
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Loops the edge lengths and the random frames back through the framing.                       *
+ *                                                                                                     *
+ * The edge lengths are looped back first, with every zero byte share. The random frames then take a   *
+ * random length from 2 to `max_len` bytes and the zero byte shares in turn.                           *
+ *                                                                                                     *
+ * @param frames [uint32_t] Number of random frames.                                                   *
+ * @param max_len [uint32_t] Longest frame, CRC included (bytes).                                      *
+ * @param result [bench_result_t*] Results, cleared first.                                             *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_run(uint32_t frames, uint32_t max_len, bench_result_t *result)
+{
+	const uint32_t shares = sizeof(bench_zero_pct) / sizeof(bench_zero_pct[0]);
+	static uint8_t frame[BENCH_FRAME_SIZE];
+
+	memset(result, 0, sizeof(*result));
+
+	for(uint32_t i = 0; i < sizeof(bench_edge_lengths) / sizeof(bench_edge_lengths[0]); i++) {
+		if(bench_edge_lengths[i] <= max_len) {
+			for(uint32_t z = 0; z < shares; z++) {
+				bench_fill(frame, bench_edge_lengths[i] - 2, bench_zero_pct[z]);
+				bench_frame(frame, bench_edge_lengths[i], result);
+			}
+		}
+	}
+
+	for(uint32_t f = 0; f < frames; f++) {
+		uint32_t len = 2 + (bench_random() % (max_len - 1));
+
+		bench_fill(frame, len - 2, bench_zero_pct[f % shares]);
+		bench_frame(frame, len, result);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Loops one frame back and checks that its corruptions are detected.                           *
+ *                                                                                                     *
+ * The CRC is appended as `Protocol.c` does, then the frame is encoded and decoded again and must come *
+ * back unchanged, without a zero byte on the wire. A corrupted copy is then checked for a random      *
+ * single bit error, for a random burst of at most `BENCH_CRC_BURST_BITS` bits, and for a random       *
+ * encoded byte replaced on the wire.                                                                  *
+ *                                                                                                     *
+ * @param frame [uint8_t*] Frame bytes, without the CRC, with room for it.                             *
+ * @param len [uint32_t] Frame length with the CRC (bytes).                                            *
+ * @param result [bench_result_t*] Results, updated.                                                   *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_frame(uint8_t *frame, uint32_t len, bench_result_t *result)
+{
+	static uint8_t encoded[FRAME_COBS_MAX(BENCH_FRAME_SIZE)];
+	static uint8_t decoded[FRAME_COBS_MAX(BENCH_FRAME_SIZE)];
+	static uint8_t corrupt[BENCH_FRAME_SIZE];
+	uint64_t start;
+
+	// CRC over every byte before it, then COBS encoding
+	start = bench_now_ns();
+	uint16_t crc = frame_crc16(frame, len - 2);
+	result->crc_ns += bench_elapsed_ns(start);
+	frame_put_u16(&frame[len - 2], crc);
+
+	start = bench_now_ns();
+	uint32_t encoded_len = frame_cobs_encode(frame, len, encoded);
+	result->encode_ns += bench_elapsed_ns(start);
+
+	start = bench_now_ns();
+	int32_t decoded_len = frame_cobs_decode(encoded, encoded_len, decoded, sizeof(decoded));
+	result->decode_ns += bench_elapsed_ns(start);
+
+	if((encoded_len > FRAME_COBS_MAX(len)) || (NULL != memchr(encoded, FRAME_DELIMITER, encoded_len))
+	   || (decoded_len != (int32_t)len) || (0 != memcmp(decoded, frame, len)) || !bench_crc_ok(decoded, decoded_len)) {
+		result->round_trip_errors++;
+	}
+
+	// Single bit error anywhere in the frame, CRC included
+	uint32_t bit = bench_random() % (len * 8);
+	memcpy(corrupt, frame, len);
+	corrupt[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+	result->bit_missed += bench_crc_ok(corrupt, (int32_t)len);
+
+	// Burst with its first and last bits flipped, the bits between random
+	uint32_t burst = 1 + (bench_random() % ((len * 8 < BENCH_CRC_BURST_BITS) ? (len * 8) : BENCH_CRC_BURST_BITS));
+	uint32_t pattern = (bench_random() | 1U | (1U << (burst - 1))) & ((1U << burst) - 1);
+	bit = bench_random() % ((len * 8) - burst + 1);
+	memcpy(corrupt, frame, len);
+	for(uint32_t i = 0; i < burst; i++) {
+		if(pattern & (1U << i)) {
+			corrupt[(bit + i) / 8] ^= (uint8_t)(1U << ((bit + i) % 8));
+		}
+	}
+	result->burst_missed += bench_crc_ok(corrupt, (int32_t)len);
+
+	// Encoded byte replaced by another non-zero byte, so the frame still reaches the decoder
+	uint32_t pos = bench_random() % encoded_len;
+	encoded[pos] = (uint8_t)(1 + ((encoded[pos] + (bench_random() % 254)) % 255));
+	decoded_len = frame_cobs_decode(encoded, encoded_len, decoded, sizeof(decoded));
+	result->wire_missed += bench_crc_ok(decoded, decoded_len);
+
+	result->frames++;
+	result->bytes += len;
+}
+
+/*******************************************************************************************************
+ * @brief Checks a decoded frame the way `Protocol.c` does.                                            *
+ *                                                                                                     *
+ * @param frame [const uint8_t*] Decoded frame.                                                        *
+ * @param len [int32_t] Decoded length, negative if the decoder rejected the frame.                    *
+ * @return int 1 if the frame is long enough and its CRC matches, 0 otherwise.                         *
+ ******************************************************************************************************/
+
+static int bench_crc_ok(const uint8_t *frame, int32_t len)
+{
+	if(len < 2) {
+		return 0;
+	}
+
+	return frame_get_u16(&frame[len - 2]) == frame_crc16(frame, (uint32_t)len - 2);
+}
+
+/*******************************************************************************************************
+ * @brief Fills a buffer with random bytes.                                                            *
+ *                                                                                                     *
+ * @param data [uint8_t*] Buffer to fill.                                                              *
+ * @param len [uint32_t] Number of bytes.                                                              *
+ * @param zero_pct [uint32_t] Share of zero bytes (%), or 0xFFFFFFFF for uniformly random bytes.       *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_fill(uint8_t *data, uint32_t len, uint32_t zero_pct)
+{
+	for(uint32_t i = 0; i < len; i++) {
+		if(0xFFFFFFFF == zero_pct) {
+			data[i] = (uint8_t)bench_random();
+		}
+		else {
+			data[i] = ((bench_random() % 100) < zero_pct) ? 0 : (uint8_t)(1 + (bench_random() % 255));
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Returns the next value of the frame generator.                                               *
+ *                                                                                                     *
+ * @return uint32_t Random value (0 - 2^30 - 1).                                                       *
+ ******************************************************************************************************/
+
+static uint32_t bench_random(void)
+{
+	uint32_t value;
+
+	// Two steps of the generator, keeping the upper 15 bits of each
+	bench_seed = (bench_seed * 1103515245U) + 12345U;
+	value = (bench_seed >> 17) << 15;
+	bench_seed = (bench_seed * 1103515245U) + 12345U;
+	return value | (bench_seed >> 17);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the host time since a start time, less the cost of reading the clock.                *
+ *                                                                                                     *
+ * @param start [uint64_t] Start time from `bench_now_ns` (ns).                                        *
+ * @return uint64_t Elapsed time (ns).                                                                 *
+ ******************************************************************************************************/
+
+static uint64_t bench_elapsed_ns(uint64_t start)
+{
+	uint64_t elapsed = bench_now_ns() - start;
+
+	return (elapsed > bench_timer_ns) ? (elapsed - bench_timer_ns) : 0;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the host monotonic clock.                                                            *
+ *                                                                                                     *
+ * @return uint64_t Time (ns).                                                                         *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,383 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ LineBench ]                                                             |
+| FILE:       LineBench.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `LineBench` benchmark feeds synthetic byte streams through the UART            |
+|    reception path: the circular DMA buffer, the reception callback, the ring buffer   |
+|    and the line framing of the message handler task. It checks every line that        |
+|    reaches the consumer and reports the throughput and the reception ISR time.        |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Synthetic stream: line lengths, without the newline, are drawn between the two bounds
+typedef struct
+{
+	const char *name;
+	uint32_t min_len;
+	uint32_t max_len;
+} bench_stream_t;
+
+// Reception cost and outcome of one stream
+typedef struct
+{
+	uint32_t lines;				// Lines received by the consumer
+	uint32_t errors;			// Lines received with a different content than sent
+	uint32_t events;			// Reception callbacks, on idle line, half buffer and full buffer
+	uint64_t isr_ns;			// Host time spent in the reception callback
+	uint64_t max_isr_ns;		// Worst case host time of one reception callback
+	uint64_t elapsed_ns;		// Time from the first byte until the consumer received the last line
+} bench_result_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_producer_task(void *param);
+static void bench_consumer_task(void *param);
+static void bench_run(const bench_stream_t *stream, bench_result_t *result);
+static void bench_dma_receive(const uint8_t *data, uint32_t len, bench_result_t *result);
+static void bench_rx_event(uint16_t size, bench_result_t *result);
+static uint32_t bench_line(uint32_t *seed, const bench_stream_t *stream, char *line);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: LineBench [-n bytes] [-b burst] [-s seed]\n"
+								 "  -n  bytes per stream (default %u)\n"
+								 "  -b  longest burst of back-to-back bytes before the line goes idle (default %u)\n"
+								 "  -s  seed of the line generator (default %u)\n";
+
+static const bench_stream_t bench_streams[] = {
+	{ "short",		1,						8 },
+	{ "commands",	4,						16 },
+	{ "long",		UART_RX_LINE_SIZE - 1,	UART_RX_LINE_SIZE - 1 },
+	{ "mixed",		1,						UART_RX_LINE_SIZE - 1 },
+};
+
+// Characters of the generated lines, without `;` so that no line is taken for a batch
+static const char bench_charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,:-+=";
+
+static uint32_t bench_bytes = SIM_BENCH_LINE_BYTES;
+static uint32_t bench_burst = SIM_BENCH_LINE_BURST;
+static uint32_t bench_seed = SIM_BENCH_LINE_SEED;
+
+static TaskHandle_t bench_producer;
+static uint16_t bench_dma_pos = 0;			// DMA write position in the circular reception buffer
+static uint16_t bench_dma_reported = 0;		// DMA write position passed with the last reception event
+static uint32_t bench_fed = 0;				// Bytes written by the DMA in the current stream
+static volatile uint32_t bench_consumed = 0;	// Bytes of the lines the consumer has received, newlines included
+static volatile uint32_t bench_lines = 0;
+static volatile uint32_t bench_errors = 0;
+static uint32_t bench_consumer_seed;
+static const bench_stream_t *bench_stream;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * USART2 and its DMA reception are set up as in `main`, then the message handler task, a consumer     *
+ * task standing in for the main menu task, and the producer task are started. The producer ends the   *
+ * process once every stream has been received.                                                        *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_FAILURE` on invalid arguments, otherwise the producer task exits the process.     *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "n:b:s:"))) {
+		switch(opt) {
+			case 'n': bench_bytes = strtoul(optarg, NULL, 10); break;
+			case 'b': bench_burst = strtoul(optarg, NULL, 10); break;
+			case 's': bench_seed = strtoul(optarg, NULL, 10); break;
+			default: bench_bytes = 0; break;
+		}
+	}
+	if((0 == bench_bytes) || (0 == bench_burst)) {
+		fprintf(stderr, bench_usage, SIM_BENCH_LINE_BYTES, SIM_BENCH_LINE_BURST, SIM_BENCH_LINE_SEED);
+		return EXIT_FAILURE;
+	}
+
+	// USART2 as in MX_USART2_UART_Init, then DMA reception as in main
+	huart2.Instance = USART2;
+	huart2.Init.BaudRate = 115200;
+	HAL_UART_Init(&huart2);
+	uart_rx_start();
+
+	// The producer plays the DMA and the interrupt, so it preempts both tasks like the reception ISR
+	xTaskCreate(message_handler_task, "msg_task", configMINIMAL_STACK_SIZE, NULL, 2, &handle_message_handler_task);
+	xTaskCreate(bench_consumer_task, "consumer", configMINIMAL_STACK_SIZE, NULL, 3, &handle_main_menu_task);
+	xTaskCreate(bench_producer_task, "producer", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &bench_producer);
+
+	vTaskStartScheduler();
+	return EXIT_FAILURE;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Task feeding every stream and printing the results.                                          *
+ *                                                                                                     *
+ * @param param [void*] Not used.                                                                      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Exits the process with `EXIT_SUCCESS` if every line was received intact and no byte was lost, *
+ *       `EXIT_FAILURE` otherwise.                                                                     *
+ ******************************************************************************************************/
+
+static void bench_producer_task(void *param)
+{
+	uint32_t count = sizeof(bench_streams) / sizeof(bench_streams[0]);
+	uart_rx_stats_t stats;
+	uint32_t errors = 0;
+	(void)param;
+
+	printf("DMA buffer %u B, ring buffer %u B, line %u B, %u bytes per stream in bursts of up to %u bytes\n\n",
+		   UART_RX_DMA_BUF_SIZE, UART_RX_RING_SIZE, UART_RX_LINE_SIZE, bench_bytes, bench_burst);
+	printf("%-10s %8s %8s %12s %10s %14s %14s\n", "stream", "lines", "errors", "bytes/s", "events", "ISR mean (ns)", "ISR max (ns)");
+
+	for(uint32_t i = 0; i < count; i++) {
+		bench_result_t result;
+
+		bench_run(&bench_streams[i], &result);
+		errors += result.errors;
+
+		printf("%-10s %8u %8u %12.0f %10u %14.1f %14llu\n", bench_streams[i].name, result.lines, result.errors,
+			   bench_fed * 1e9 / result.elapsed_ns, result.events, (double)result.isr_ns / result.events,
+			   (unsigned long long)result.max_isr_ns);
+	}
+
+	uart_rx_get_stats(&stats);
+	printf("\nDropped bytes %u, long lines %u. Times are host times; the task switches of the POSIX port\n"
+		   "dominate the throughput, the ISR time is the reception callback alone.\n", stats.dropped_bytes, stats.long_lines);
+
+	// Every line must reach the consumer intact, without a byte dropped by the reception ISR
+	if((0 != errors) || (0 != stats.dropped_bytes) || (0 != stats.long_lines)) {
+		printf("FAIL: the reception path lost or altered bytes\n");
+		fflush(stdout);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("PASS: every line was received intact\n");
+	fflush(stdout);
+	exit(EXIT_SUCCESS);
+}
+
+/*******************************************************************************************************
+ * @brief Task standing in for the main menu task, checking each received line.                        *
+ *                                                                                                     *
+ * The consumer draws the same lines as the producer from its own copy of the generator, compares      *
+ * them with the messages, and tells the producer how many bytes have been consumed.                   *
+ *                                                                                                     *
+ * @param param [void*] Not used.                                                                      *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_consumer_task(void *param)
+{
+	char expected[UART_RX_LINE_SIZE];
+	(void)param;
+
+	while(1) {
+		message_t *msg = uart_wait_message();
+		uint32_t len = bench_line(&bench_consumer_seed, bench_stream, expected);
+
+		if((msg->len != len) || (0 != memcmp(msg->payload, expected, len))) {
+			bench_errors++;
+		}
+		bench_lines++;
+		bench_consumed += len + 1;
+		xTaskNotifyGive(bench_producer);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Feeds one stream through the reception path and waits for its last line.                     *
+ *                                                                                                     *
+ * Lines are sent back to back, cut into bursts of random length that each end with an idle line.      *
+ * The producer keeps at most `UART_RX_RING_SIZE` bytes ahead of the consumer, so that a correct       *
+ * reception path never has to drop a byte.                                                            *
+ *                                                                                                     *
+ * @param stream [const bench_stream_t*] Line lengths of the stream.                                   *
+ * @param result [bench_result_t*] Reception cost and outcome.                                         *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_run(const bench_stream_t *stream, bench_result_t *result)
+{
+	char line[UART_RX_LINE_SIZE + 1];
+	uint32_t seed = bench_seed;
+	uint32_t burst_seed = bench_seed;
+	uint32_t line_len = 0;
+	uint32_t line_pos = 0;
+	uint64_t start;
+
+	memset(result, 0, sizeof(*result));
+	bench_stream = stream;
+	bench_consumer_seed = bench_seed;
+	bench_fed = 0;
+	bench_consumed = 0;
+	bench_lines = 0;
+	bench_errors = 0;
+
+	start = bench_now_ns();
+	while((bench_fed < bench_bytes) || (line_pos < line_len)) {
+		burst_seed = (burst_seed * 1103515245U) + 12345U;
+		uint32_t burst = 1 + ((burst_seed >> 16) % bench_burst);
+
+		while(burst > 0) {
+			// Next line, newline included
+			if(line_pos == line_len) {
+				if(bench_fed >= bench_bytes) {
+					break;
+				}
+				line_len = bench_line(&seed, stream, line);
+				line[line_len++] = '\n';
+				line_pos = 0;
+			}
+
+			// Stay within the ring buffer ahead of the consumer
+			uint32_t room = UART_RX_RING_SIZE - (bench_fed - bench_consumed);
+			uint32_t len = line_len - line_pos;
+			len = (len < burst) ? len : burst;
+			len = (len < room) ? len : room;
+			if(0 == len) {
+				break;
+			}
+
+			bench_dma_receive((const uint8_t *)&line[line_pos], len, result);
+			line_pos += len;
+			burst -= len;
+		}
+
+		// The line goes idle at the end of the burst
+		if(bench_dma_pos != bench_dma_reported) {
+			bench_rx_event(bench_dma_pos, result);
+		}
+		while(UART_RX_RING_SIZE == (bench_fed - bench_consumed)) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		}
+	}
+
+	// Wait for the consumer to receive the last line
+	while(bench_consumed != bench_fed) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+	result->elapsed_ns = bench_now_ns() - start;
+	result->lines = bench_lines;
+	result->errors = bench_errors;
+}
+
+/*******************************************************************************************************
+ * @brief Writes bytes into the circular DMA buffer as the DMA stream does.                            *
+ *                                                                                                     *
+ * The half buffer and full buffer events are raised when the write position crosses them, as with     *
+ * DMA1 Stream 5 in circular mode.                                                                     *
+ *                                                                                                     *
+ * @param data [const uint8_t*] Received bytes.                                                        *
+ * @param len [uint32_t] Number of bytes.                                                              *
+ * @param result [bench_result_t*] Reception cost, updated.                                            *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_dma_receive(const uint8_t *data, uint32_t len, bench_result_t *result)
+{
+	for(uint32_t i = 0; i < len; i++) {
+		huart2.pRxBuffPtr[bench_dma_pos++] = data[i];
+		bench_fed++;
+
+		if((UART_RX_DMA_BUF_SIZE / 2) == bench_dma_pos) {
+			bench_rx_event(bench_dma_pos, result);
+		}
+		else if(UART_RX_DMA_BUF_SIZE == bench_dma_pos) {
+			bench_rx_event(bench_dma_pos, result);
+			bench_dma_pos = 0;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Raises a reception event and times the callback.                                             *
+ *                                                                                                     *
+ * @param size [uint16_t] DMA write position, as passed by the HAL.                                    *
+ * @param result [bench_result_t*] Reception cost, updated.                                            *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_rx_event(uint16_t size, bench_result_t *result)
+{
+	uint64_t start = bench_now_ns();
+	HAL_UARTEx_RxEventCallback(&huart2, size);
+	uint64_t cost = bench_now_ns() - start;
+
+	bench_dma_reported = size % UART_RX_DMA_BUF_SIZE;
+	result->events++;
+	result->isr_ns += cost;
+	result->max_isr_ns = (cost > result->max_isr_ns) ? cost : result->max_isr_ns;
+}
+
+/*******************************************************************************************************
+ * @brief Draws the next line of a stream.                                                             *
+ *                                                                                                     *
+ * @param seed [uint32_t*] State of the generator, updated.                                            *
+ * @param stream [const bench_stream_t*] Line lengths of the stream.                                   *
+ * @param line [char*] Output line, not null terminated, at least `stream->max_len` + 1 bytes.         *
+ * @return uint32_t Length of the line, without a newline.                                             *
+ ******************************************************************************************************/
+
+static uint32_t bench_line(uint32_t *seed, const bench_stream_t *stream, char *line)
+{
+	uint32_t len;
+
+	*seed = (*seed * 1103515245U) + 12345U;
+	len = stream->min_len + ((*seed >> 16) % (stream->max_len - stream->min_len + 1));
+
+	for(uint32_t i = 0; i < len; i++) {
+		*seed = (*seed * 1103515245U) + 12345U;
+		line[i] = bench_charset[(*seed >> 16) % (sizeof(bench_charset) - 1)];
+	}
+
+	return len;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the host monotonic clock.                                                              *
+ *                                                                                                     *
+ * @return uint64_t Time in nanoseconds.                                                               *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,338 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MathBench ]                                                             |
+| FILE:       MathBench.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `MathBench` benchmark measures the speed estimator and PID controller of the   |
+|    `MOTOR_MATH` format it is built with. It runs the control law against the motor    |
+|    plant, shadowed by a double precision copy of the float law fed the same encoder   |
+|    counts, and reports the time per step and the error of the speed and duty cycle.   |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_MotorManager.h"
+#include "Config_Sim.h"
+#include "MotorManager.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define BENCH_MAX_TARGETS			8
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Double precision copy of `pid_controller` and the speed window of `motor_control_step`
+typedef struct
+{
+	int32_t count_history[SPEED_WINDOW_PERIODS];
+	uint32_t history_index;
+	double speed;
+	double duty_cycle;
+	double integral;
+	double last_error;
+} bench_reference_t;
+
+// Cost and error of the control law over the profile
+typedef struct
+{
+	uint32_t steps;
+	double step_ns;				// Mean host time of one control law step
+	double max_step_ns;			// Worst case host time of one control law step
+	double max_speed_error;		// Largest speed difference from the reference (RPM)
+	double max_duty_error;		// Largest duty cycle difference from the reference (%)
+	double rms_duty_error;		// RMS duty cycle difference from the reference (%)
+} bench_result_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_init(void);
+static void bench_run(const float *targets, uint32_t count, uint32_t step_ms, float kp, float ki, float kd, bench_result_t *result);
+static double bench_reference_step(bench_reference_t *ref, int32_t encoder_count, double target, float kp, float ki, float kd);
+static uint32_t bench_parse_targets(const char *list, float *targets);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: MathBench [-s rpm,...] [-t ms] [-p kp] [-i ki] [-d kd]\n"
+								 "  -s  target speeds applied in turn, in RPM (default %s)\n"
+								 "  -t  simulated time per target in ms (default %u)\n"
+								 "  -p  proportional gain (default %g)\n"
+								 "  -i  integral gain (default %g)\n"
+								 "  -d  derivative gain (default %g)\n";
+
+static const char *bench_math_names[] = { "float", "Q15", "Q31" };
+
+static uint64_t bench_timer_ns = 0; // Cost of reading the host clock, removed from the step times
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments or an error above the bounds.    *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *target_list = SIM_BENCH_MATH_TARGETS;
+	float targets[BENCH_MAX_TARGETS];
+	uint32_t count;
+	uint32_t step_ms = SIM_BENCH_MATH_STEP_MS;
+	float kp = SIM_BENCH_MATH_KP;
+	float ki = SIM_BENCH_MATH_KI;
+	float kd = SIM_BENCH_MATH_KD;
+	bench_result_t result;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "s:t:p:i:d:"))) {
+		switch(opt) {
+			case 's': target_list = optarg; break;
+			case 't': step_ms = strtoul(optarg, NULL, 10); break;
+			case 'p': kp = strtof(optarg, NULL); break;
+			case 'i': ki = strtof(optarg, NULL); break;
+			case 'd': kd = strtof(optarg, NULL); break;
+			default: step_ms = 0; break;
+		}
+	}
+	count = bench_parse_targets(target_list, targets);
+	if((0 == count) || (0 == step_ms) || (kp < 0.0f) || (ki < 0.0f) || (kd < 0.0f)) {
+		fprintf(stderr, bench_usage, SIM_BENCH_MATH_TARGETS, SIM_BENCH_MATH_STEP_MS, SIM_BENCH_MATH_KP, SIM_BENCH_MATH_KI,
+				SIM_BENCH_MATH_KD);
+		return EXIT_FAILURE;
+	}
+
+	bench_init();
+	bench_run(targets, count, step_ms, kp, ki, kd, &result);
+
+	printf("%s math, control loop %u Hz, speed window %u ms, Kp %g Ki %g Kd %g, %u steps\n\n",
+		   bench_math_names[MOTOR_MATH], CONTROL_LOOP_RATE_HZ, SPEED_WINDOW_MS, kp, ki, kd, result.steps);
+	printf("%-6s %10s %10s %18s %17s %17s\n", "math", "step (ns)", "max (ns)", "speed error (RPM)", "duty error (%)", "duty RMS (%)");
+	printf("%-6s %10.1f %10.1f %18.4f %17.4f %17.4f\n", bench_math_names[MOTOR_MATH], result.step_ns, result.max_step_ns,
+		   result.max_speed_error, result.max_duty_error, result.rms_duty_error);
+
+	// The fixed-point laws stay within their quantization of the float law
+	if((result.max_speed_error > SIM_BENCH_MATH_MAX_SPEED_ERROR_RPM) || (result.max_duty_error > SIM_BENCH_MATH_MAX_DUTY_ERROR_PCT)) {
+		printf("FAIL: the control law is off the double precision reference\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("PASS: the control law matches the double precision reference\n");
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Sets up the peripherals the control law uses, as `main` does on the target.                  *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_init(void)
+{
+	GPIO_InitTypeDef gpio = {0};
+
+	// PWM timer, as in MX_TIM3_Init
+	htim3.Instance = TIM3;
+	htim3.Init.Prescaler = 24;
+	htim3.Init.Period = 999;
+	HAL_TIM_PWM_Init(&htim3);
+	HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+
+	// Encoder pins and their EXTI lines, as in MX_GPIO_Init, then the selected encoder backend
+	gpio.Pin = ENCODER_A_Pin | ENCODER_B_Pin;
+	gpio.Mode = GPIO_MODE_IT_RISING_FALLING;
+	gpio.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(GPIOE, &gpio);
+	HAL_NVIC_EnableIRQ(ENCODER_A_EXTI_IRQn);
+	HAL_NVIC_EnableIRQ(ENCODER_B_EXTI_IRQn);
+	encoder_init();
+
+	// Smallest cost of reading the clock twice
+	bench_timer_ns = UINT64_MAX;
+	for(int i = 0; i < 1000; i++) {
+		uint64_t start = bench_now_ns();
+		uint64_t cost = bench_now_ns() - start;
+		if(cost < bench_timer_ns) {
+			bench_timer_ns = cost;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Runs the control law over the target profile and compares it with the reference.             *
+ *                                                                                                     *
+ * The motor starts at rest. Each control loop period, `motor_control_step` runs on the encoder count, *
+ * the reference runs on the same count, and the plant then runs for one period with the duty cycle    *
+ * of the control law under test. The reference only shadows the law, so both see the same inputs.     *
+ *                                                                                                     *
+ * @param targets [const float*] Target speeds applied in turn (RPM).                                  *
+ * @param count [uint32_t] Number of target speeds.                                                    *
+ * @param step_ms [uint32_t] Simulated time per target (ms).                                           *
+ * @param kp [float] Proportional gain.                                                                *
+ * @param ki [float] Integral gain.                                                                    *
+ * @param kd [float] Derivative gain.                                                                  *
+ * @param result [bench_result_t*] Cost and error of the control law.                                  *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_run(const float *targets, uint32_t count, uint32_t step_ms, float kp, float ki, float kd, bench_result_t *result)
+{
+	const uint32_t period_us = 1000000U / CONTROL_LOOP_RATE_HZ;
+	const uint32_t periods = (step_ms * 1000U) / period_us;
+	bench_reference_t ref;
+	uint64_t cpu_ns = 0;
+	uint64_t max_cpu_ns = 0;
+	double duty_squares = 0.0;
+
+	memset(result, 0, sizeof(*result));
+
+	// Motor at rest and both laws reset, then start forward as the Start command does
+	sim_motor_reset();
+	int32_t start_count = read_encoder_count();
+	motor_control_reset(start_count);
+	memset(&ref, 0, sizeof(ref));
+	for(uint32_t i = 0; i < SPEED_WINDOW_PERIODS; i++) {
+		ref.count_history[i] = start_count;
+	}
+	ref.duty_cycle = PID_INITIAL_DUTY_CYCLE;
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(MOTOR_IN2_GPIO_Port, MOTOR_IN2_Pin, GPIO_PIN_RESET);
+
+	for(uint32_t t = 0; t < count; t++) {
+		pid_set_params(targets[t], kp, ki, kd);
+
+		for(uint32_t p = 0; p < periods; p++) {
+			// Control law, timed on the host
+			int32_t encoder_count = read_encoder_count();
+			uint64_t start = bench_now_ns();
+			float duty = motor_control_step(encoder_count);
+			uint64_t cost = bench_now_ns() - start;
+
+			cost = (cost > bench_timer_ns) ? (cost - bench_timer_ns) : 0;
+			cpu_ns += cost;
+			max_cpu_ns = (cost > max_cpu_ns) ? cost : max_cpu_ns;
+
+			// Reference on the same encoder count
+			double duty_ref = bench_reference_step(&ref, encoder_count, targets[t], kp, ki, kd);
+			double duty_error = fabs((double)duty - duty_ref);
+
+			result->max_speed_error = fmax(result->max_speed_error, fabs((double)motor_speed - ref.speed));
+			result->max_duty_error = fmax(result->max_duty_error, duty_error);
+			duty_squares += duty_error * duty_error;
+			result->steps++;
+
+			sim_motor_run(period_us);
+		}
+	}
+
+	// Stop the motor, pulling both inputs low as the Stop command does
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin | MOTOR_IN2_Pin, GPIO_PIN_RESET);
+
+	result->step_ns = (double)cpu_ns / result->steps;
+	result->max_step_ns = (double)max_cpu_ns;
+	result->rms_duty_error = sqrt(duty_squares / result->steps);
+}
+
+/*******************************************************************************************************
+ * @brief Runs one step of the double precision reference.                                             *
+ *                                                                                                     *
+ * @param ref [bench_reference_t*] Reference state, updated.                                           *
+ * @param encoder_count [int32_t] Current encoder position.                                            *
+ * @param target [double] Target speed (RPM).                                                          *
+ * @param kp [float] Proportional gain.                                                                *
+ * @param ki [float] Integral gain.                                                                    *
+ * @param kd [float] Derivative gain.                                                                  *
+ * @return double New duty cycle (%).                                                                  *
+ ******************************************************************************************************/
+
+static double bench_reference_step(bench_reference_t *ref, int32_t encoder_count, double target, float kp, float ki, float kd)
+{
+	const double dt = 1.0 / CONTROL_LOOP_RATE_HZ;
+	int32_t delta_count = encoder_count - ref->count_history[ref->history_index];
+
+	ref->count_history[ref->history_index] = encoder_count;
+	ref->history_index = (ref->history_index + 1) % SPEED_WINDOW_PERIODS;
+	ref->speed = delta_count * (60000.0 / ((double)ENCODER_COUNTS_PER_REV * ENCODER_QUADRATURE * SPEED_WINDOW_MS));
+
+	double error = target - ref->speed;
+	ref->integral += error * dt;
+	double derivative = (error - ref->last_error) / dt;
+	ref->last_error = error;
+	ref->duty_cycle += (kp * error) + (ki * ref->integral) + (kd * derivative);
+	ref->duty_cycle = fmin(fmax(ref->duty_cycle, 0.0), 100.0);
+
+	return ref->duty_cycle;
+}
+
+/*******************************************************************************************************
+ * @brief Parses a comma separated list of target speeds.                                              *
+ *                                                                                                     *
+ * @param list [const char*] Speeds, for example "225,100".                                            *
+ * @param targets [float*] Parsed speeds, `BENCH_MAX_TARGETS` at most.                                 *
+ * @return uint32_t Number of speeds, 0 if the list is invalid or a speed exceeds `MAX_MOTOR_SPEED`.   *
+ ******************************************************************************************************/
+
+static uint32_t bench_parse_targets(const char *list, float *targets)
+{
+	const char *ptr = list;
+	uint32_t count = 0;
+	char *end;
+
+	while(count < BENCH_MAX_TARGETS) {
+		float value = strtof(ptr, &end);
+		if((end == ptr) || (value < 0.0f) || (value > MAX_MOTOR_SPEED)) {
+			return 0;
+		}
+		targets[count++] = value;
+
+		if('\0' == *end) {
+			return count;
+		}
+		if(',' != *end) {
+			return 0;
+		}
+		ptr = end + 1;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the host monotonic clock.                                                            *
+ *                                                                                                     *
+ * @return uint64_t Time (ns).                                                                         *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
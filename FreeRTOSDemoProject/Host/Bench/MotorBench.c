@@ -0,0 +1,349 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ MotorBench ]                                                            |
+| FILE:       MotorBench.c                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `MotorBench` benchmark tunes the motor speed controller offline. For each      |
+|    Kp / Ki / Kd combination it runs the MotorManager control law against the          |
+|    motor plant in simulated time, and reports the step response and CPU cost.         |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_MotorManager.h"
+#include "Config_Sim.h"
+#include "MotorManager.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Gain values to sweep
+typedef struct
+{
+	float values[SIM_BENCH_MAX_GAINS];
+	uint32_t count;
+} bench_gain_list_t;
+
+// Step response and CPU cost of one gain set, negative times when the response never got there
+typedef struct
+{
+	double rise_ms;			// Time from SIM_BENCH_RISE_LOW_PCT to SIM_BENCH_RISE_HIGH_PCT of the target
+	double overshoot_pct;	// Peak speed above the target, in percent of the target
+	double settle_ms;		// Time after which the speed stays within SIM_BENCH_SETTLE_BAND_PCT
+	double error_rpm;		// Target minus the mean speed over the last SIM_BENCH_TAIL_MS
+	double step_ns;			// Mean host time of one control law step
+	double max_step_ns;		// Worst case host time of one control law step
+} bench_result_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_init(void);
+static void bench_run(float target, uint32_t run_ms, float kp, float ki, float kd, bench_result_t *result);
+static int bench_parse_gains(const char *list, bench_gain_list_t *gains);
+static void bench_print_time(double ms);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: MotorBench [-s rpm] [-t ms] [-p kp,...] [-i ki,...] [-d kd,...] [-c]\n"
+								 "  -s  target speed in RPM (default %.1f)\n"
+								 "  -t  simulated time per gain set in ms (default %u)\n"
+								 "  -p  proportional gains (default %s)\n"
+								 "  -i  integral gains (default %s)\n"
+								 "  -d  derivative gains (default %s)\n"
+								 "  -c  print comma separated values\n";
+
+static uint64_t bench_timer_ns = 0; // Cost of reading the host clock, removed from the step times
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Runs the gain sweep.                                                                         *
+ *                                                                                                     *
+ * Every combination of the Kp, Ki and Kd lists is run from standstill for the same simulated time,    *
+ * and one line is printed per combination.                                                            *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments.                                 *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	bench_gain_list_t kp, ki, kd;
+	float target = SIM_BENCH_TARGET_RPM;
+	uint32_t run_ms = SIM_BENCH_RUN_MS;
+	const char *kp_list = SIM_BENCH_KP_LIST;
+	const char *ki_list = SIM_BENCH_KI_LIST;
+	const char *kd_list = SIM_BENCH_KD_LIST;
+	int csv = 0;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "s:t:p:i:d:c"))) {
+		switch(opt) {
+			case 's': target = strtof(optarg, NULL); break;
+			case 't': run_ms = strtoul(optarg, NULL, 10); break;
+			case 'p': kp_list = optarg; break;
+			case 'i': ki_list = optarg; break;
+			case 'd': kd_list = optarg; break;
+			case 'c': csv = 1; break;
+			default:
+				fprintf(stderr, bench_usage, SIM_BENCH_TARGET_RPM, SIM_BENCH_RUN_MS, SIM_BENCH_KP_LIST, SIM_BENCH_KI_LIST, SIM_BENCH_KD_LIST);
+				return EXIT_FAILURE;
+		}
+	}
+
+	if(!bench_parse_gains(kp_list, &kp) || !bench_parse_gains(ki_list, &ki) || !bench_parse_gains(kd_list, &kd) ||
+	   (target <= 0.0f) || (run_ms <= SIM_BENCH_TAIL_MS)) {
+		fprintf(stderr, bench_usage, SIM_BENCH_TARGET_RPM, SIM_BENCH_RUN_MS, SIM_BENCH_KP_LIST, SIM_BENCH_KI_LIST, SIM_BENCH_KD_LIST);
+		return EXIT_FAILURE;
+	}
+
+	bench_init();
+
+	if(csv) {
+		printf("kp,ki,kd,rise_ms,overshoot_pct,settle_ms,error_rpm,step_ns,max_step_ns\n");
+	}
+	else {
+		printf("Motor plant: %.1f V bridge, %u CPR encoder, %u:1 gear, control loop %u Hz, %s math\n",
+			   SIM_MOTOR_SUPPLY_V - SIM_MOTOR_BRIDGE_DROP_V, ENCODER_RAW_COUNTS_PER_REV, GEAR_RATIO, CONTROL_LOOP_RATE_HZ,
+			   (MOTOR_MATH == MOTOR_MATH_FLOAT) ? "float" : ((MOTOR_MATH == MOTOR_MATH_Q15) ? "Q15" : "Q31"));
+		printf("Step to %.1f RPM from standstill, %u ms per gain set, settling band +/- %.1f %%\n\n",
+			   target, run_ms, SIM_BENCH_SETTLE_BAND_PCT);
+		printf("     Kp      Ki      Kd   Rise (ms)  Overshoot (%%)  Settling (ms)  Error (RPM)  Step (ns)  Max (ns)\n");
+	}
+
+	for(uint32_t p = 0; p < kp.count; p++) {
+		for(uint32_t i = 0; i < ki.count; i++) {
+			for(uint32_t d = 0; d < kd.count; d++) {
+				bench_result_t result;
+
+				bench_run(target, run_ms, kp.values[p], ki.values[i], kd.values[d], &result);
+
+				if(csv) {
+					printf("%g,%g,%g,%.1f,%.2f,%.1f,%.2f,%.1f,%.1f\n", kp.values[p], ki.values[i], kd.values[d], result.rise_ms,
+						   result.overshoot_pct, result.settle_ms, result.error_rpm, result.step_ns, result.max_step_ns);
+					continue;
+				}
+
+				printf("%7.3f %7.3f %7.3f", kp.values[p], ki.values[i], kd.values[d]);
+				bench_print_time(result.rise_ms);
+				printf("  %13.2f ", result.overshoot_pct);
+				bench_print_time(result.settle_ms);
+				printf("  %11.2f  %9.1f  %8.1f\n", result.error_rpm, result.step_ns, result.max_step_ns);
+			}
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Sets up the peripherals the control law uses, as `main` does on the target.                  *
+ *                                                                                                     *
+ * The scheduler is not started. The benchmark calls the control law directly, in the place of the     *
+ * TIM7 interrupt and the motor control task, so the simulated time does not depend on the host.       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_init(void)
+{
+	GPIO_InitTypeDef gpio = {0};
+
+	// PWM timer, as in MX_TIM3_Init
+	htim3.Instance = TIM3;
+	htim3.Init.Prescaler = 24;
+	htim3.Init.Period = 999;
+	HAL_TIM_PWM_Init(&htim3);
+	HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+
+	// Encoder pins and their EXTI lines, as in MX_GPIO_Init, then the selected encoder backend
+	gpio.Pin = ENCODER_A_Pin | ENCODER_B_Pin;
+	gpio.Mode = GPIO_MODE_IT_RISING_FALLING;
+	gpio.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(GPIOE, &gpio);
+	HAL_NVIC_EnableIRQ(ENCODER_A_EXTI_IRQn);
+	HAL_NVIC_EnableIRQ(ENCODER_B_EXTI_IRQn);
+	encoder_init();
+
+	// Smallest cost of reading the clock twice
+	bench_timer_ns = UINT64_MAX;
+	for(int i = 0; i < 1000; i++) {
+		uint64_t start = bench_now_ns();
+		uint64_t cost = bench_now_ns() - start;
+		if(cost < bench_timer_ns) {
+			bench_timer_ns = cost;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Runs one step response and measures it.                                                      *
+ *                                                                                                     *
+ * The motor starts at rest with the controller reset. Each control loop period, the encoder position  *
+ * is captured as in `motor_timer_callback`, `motor_control_step` runs and updates the PWM, and the    *
+ * plant then runs for one period with the new duty cycle. The plant speed is sampled every            *
+ * `SIM_BENCH_SAMPLE_US` for the step response metrics.                                                *
+ *                                                                                                     *
+ * @param target [float] Target speed (RPM).                                                           *
+ * @param run_ms [uint32_t] Simulated time (ms).                                                       *
+ * @param kp [float] Proportional gain.                                                                *
+ * @param ki [float] Integral gain.                                                                    *
+ * @param kd [float] Derivative gain.                                                                  *
+ * @param result [bench_result_t*] Step response and CPU cost.                                         *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_run(float target, uint32_t run_ms, float kp, float ki, float kd, bench_result_t *result)
+{
+	const uint32_t period_us = 1000000U / CONTROL_LOOP_RATE_HZ;
+	const uint64_t run_us = (uint64_t)run_ms * 1000U;
+	const uint64_t tail_us = run_us - (uint64_t)SIM_BENCH_TAIL_MS * 1000U;
+	const double band = target * SIM_BENCH_SETTLE_BAND_PCT / 100.0;
+	double rise_low_us = -1.0, rise_high_us = -1.0, settle_us = 0.0;
+	double peak = 0.0, tail_sum = 0.0;
+	uint32_t tail_samples = 0, steps = 0;
+	uint64_t cpu_ns = 0, max_cpu_ns = 0;
+
+	// Motor at rest and controller reset, then start forward as the Start command does
+	sim_motor_reset();
+	motor_control_reset(read_encoder_count());
+	pid_set_params(target, kp, ki, kd);
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(MOTOR_IN2_GPIO_Port, MOTOR_IN2_Pin, GPIO_PIN_RESET);
+
+	for(uint64_t now_us = 0; now_us < run_us; now_us += period_us) {
+		// Control law, timed on the host
+		int32_t count = read_encoder_count();
+		uint64_t start = bench_now_ns();
+		motor_control_step(count);
+		uint64_t cost = bench_now_ns() - start;
+
+		cost = (cost > bench_timer_ns) ? (cost - bench_timer_ns) : 0;
+		cpu_ns += cost;
+		max_cpu_ns = (cost > max_cpu_ns) ? cost : max_cpu_ns;
+		steps++;
+
+		// Plant over the control loop period
+		for(uint32_t t_us = 0; t_us < period_us; t_us += SIM_BENCH_SAMPLE_US) {
+			uint32_t slice = ((period_us - t_us) < SIM_BENCH_SAMPLE_US) ? (period_us - t_us) : SIM_BENCH_SAMPLE_US;
+			sim_motor_run(slice);
+
+			double sample_us = (double)(now_us + t_us + slice);
+			double rpm = sim_motor_rpm();
+
+			if((rise_low_us < 0.0) && (rpm >= target * SIM_BENCH_RISE_LOW_PCT / 100.0)) {
+				rise_low_us = sample_us;
+			}
+			if((rise_high_us < 0.0) && (rpm >= target * SIM_BENCH_RISE_HIGH_PCT / 100.0)) {
+				rise_high_us = sample_us;
+			}
+			if(fabs(rpm - target) > band) {
+				settle_us = sample_us;
+			}
+			peak = (rpm > peak) ? rpm : peak;
+			if(sample_us > tail_us) {
+				tail_sum += rpm;
+				tail_samples++;
+			}
+		}
+	}
+
+	// Stop the motor, pulling both inputs low as the Stop command does
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin | MOTOR_IN2_Pin, GPIO_PIN_RESET);
+
+	result->rise_ms = (rise_high_us < 0.0) ? -1.0 : (rise_high_us - rise_low_us) / 1000.0;
+	result->overshoot_pct = (peak > target) ? ((peak - target) * 100.0 / target) : 0.0;
+	result->settle_ms = (settle_us >= (double)run_us) ? -1.0 : settle_us / 1000.0;
+	result->error_rpm = target - tail_sum / tail_samples;
+	result->step_ns = (double)cpu_ns / steps;
+	result->max_step_ns = (double)max_cpu_ns;
+}
+
+/*******************************************************************************************************
+ * @brief Parses a comma separated list of gains.                                                      *
+ *                                                                                                     *
+ * @param list [const char*] Gains, for example "0.1,0.2,0.5".                                         *
+ * @param gains [bench_gain_list_t*] Parsed gains.                                                     *
+ * @return int 1 if the list holds 1 to `SIM_BENCH_MAX_GAINS` non-negative numbers, 0 otherwise.       *
+ ******************************************************************************************************/
+
+static int bench_parse_gains(const char *list, bench_gain_list_t *gains)
+{
+	const char *ptr = list;
+	char *end;
+
+	gains->count = 0;
+
+	while(gains->count < SIM_BENCH_MAX_GAINS) {
+		float value = strtof(ptr, &end);
+		if((end == ptr) || (value < 0.0f)) {
+			return 0;
+		}
+		gains->values[gains->count++] = value;
+
+		if('\0' == *end) {
+			return 1;
+		}
+		if(',' != *end) {
+			return 0;
+		}
+		ptr = end + 1;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Prints a time column, or a dash if the response never got there.                             *
+ *                                                                                                     *
+ * @param ms [double] Time (ms), negative if not reached.                                              *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_print_time(double ms)
+{
+	if(ms < 0.0) {
+		printf("  %10s", "-");
+	}
+	else {
+		printf("  %10.1f", ms);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Returns the host monotonic clock.                                                            *
+ *                                                                                                     *
+ * @return uint64_t Time (ns).                                                                         *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,278 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ RateBench ]                                                             |
+| FILE:       RateBench.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `RateBench` benchmark checks the control loop at the `CONTROL_LOOP_RATE_HZ`    |
+|    it is built with. It derives the loop rate from the TIM7 registers programmed by   |
+|    `control_timer_init`, then holds the motor at a list of duty cycles and compares   |
+|    the speed estimate of `motor_control_step` with the mean plant speed over the      |
+|    same speed window.                                                                 |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_MotorManager.h"
+#include "Config_Sim.h"
+#include "ClockManager.h"
+#include "MotorManager.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define BENCH_MAX_DUTIES			8
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Speed estimate against the plant at one duty cycle
+typedef struct
+{
+	float duty;					// Duty cycle held on TIM3 (%)
+	double plant_rpm;			// Mean plant speed over the tail of the step (RPM)
+	double estimate_rpm;		// Mean speed estimate over the tail of the step (RPM)
+	double max_error_counts;	// Largest estimate difference from the window mean plant speed (encoder counts)
+} bench_result_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void bench_init(void);
+static void bench_run(const float *duties, uint32_t count, uint32_t step_ms, bench_result_t *results);
+static uint32_t bench_parse_duties(const char *list, float *duties);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: RateBench [-u duty,...] [-t ms]\n"
+								 "  -u  duty cycles held in turn, in %% (default %s)\n"
+								 "  -t  simulated time per duty cycle in ms (default %u)\n";
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments, a wrong loop period or an       *
+ *             estimate off the plant speed.                                                           *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *duty_list = SIM_BENCH_RATE_DUTIES;
+	float duties[BENCH_MAX_DUTIES];
+	bench_result_t results[BENCH_MAX_DUTIES];
+	uint32_t count;
+	uint32_t step_ms = SIM_BENCH_RATE_STEP_MS;
+	int pass = 1;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "u:t:"))) {
+		switch(opt) {
+			case 'u': duty_list = optarg; break;
+			case 't': step_ms = strtoul(optarg, NULL, 10); break;
+			default: step_ms = 0; break;
+		}
+	}
+	count = bench_parse_duties(duty_list, duties);
+	if((0 == count) || (step_ms < SIM_BENCH_TAIL_MS)) {
+		fprintf(stderr, bench_usage, SIM_BENCH_RATE_DUTIES, SIM_BENCH_RATE_STEP_MS);
+		return EXIT_FAILURE;
+	}
+
+	bench_init();
+
+	// Loop period programmed by control_timer_init, from the timer clock of the configured clock profile
+	uint32_t timer_hz = clock_apb1_timer_hz();
+	uint32_t timer_ticks = (htim7.Instance->PSC + 1) * (htim7.Instance->ARR + 1);
+	double loop_dt = (double)timer_ticks / timer_hz;
+
+	printf("control loop %u Hz, TIM7 clock %u Hz, PSC %u, ARR %u\n", CONTROL_LOOP_RATE_HZ, timer_hz,
+		   (uint32_t)htim7.Instance->PSC, (uint32_t)htim7.Instance->ARR);
+	printf("loop period %.6f s (CONTROL_LOOP_DT %.6f s), speed window %u periods of %u ms, %.4f RPM per count\n\n",
+		   loop_dt, (double)CONTROL_LOOP_DT, SPEED_WINDOW_PERIODS, SPEED_WINDOW_MS, (double)SPEED_RPM_PER_COUNT);
+
+	if(((timer_hz % timer_ticks) != 0) || ((timer_hz / timer_ticks) != CONTROL_LOOP_RATE_HZ)
+	   || (fabs(loop_dt - CONTROL_LOOP_DT) > (1e-6 * loop_dt))) {
+		printf("FAIL: the TIM7 period does not match CONTROL_LOOP_RATE_HZ\n");
+		pass = 0;
+	}
+
+	bench_run(duties, count, step_ms, results);
+
+	printf("%-9s %12s %15s %12s %20s\n", "duty (%)", "plant (RPM)", "estimate (RPM)", "bias (RPM)", "max error (counts)");
+	for(uint32_t i = 0; i < count; i++) {
+		printf("%-9.1f %12.2f %15.2f %12.3f %20.3f\n", results[i].duty, results[i].plant_rpm, results[i].estimate_rpm,
+			   results[i].estimate_rpm - results[i].plant_rpm, results[i].max_error_counts);
+
+		if(results[i].max_error_counts > SIM_BENCH_RATE_MAX_ERROR_COUNTS) {
+			pass = 0;
+		}
+	}
+
+	// The estimate counts whole encoder edges over the window, so it is within one count of the plant
+	if(!pass) {
+		printf("FAIL: the control loop does not scale to %u Hz\n", CONTROL_LOOP_RATE_HZ);
+		return EXIT_FAILURE;
+	}
+
+	printf("PASS: loop period and speed estimate scale to %u Hz\n", CONTROL_LOOP_RATE_HZ);
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Sets up the clock tree and the peripherals the control loop uses, as `main` does on the      *
+ *        target.                                                                                      *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_init(void)
+{
+	GPIO_InitTypeDef gpio = {0};
+
+	// Clock profile, then the loop timer as in MX_TIM7_Init with the period set from the loop rate
+	clock_init();
+	htim7.Instance = TIM7;
+	htim7.Init.CounterMode = TIM_COUNTERMODE_UP;
+	control_timer_init();
+
+	// PWM timer, as in MX_TIM3_Init with the frequency set from PWM_FREQUENCY_HZ
+	htim3.Instance = TIM3;
+	htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+	motor_pwm_timer_init();
+	HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+
+	// Encoder pins and their EXTI lines, as in MX_GPIO_Init, then the selected encoder backend
+	gpio.Pin = ENCODER_A_Pin | ENCODER_B_Pin;
+	gpio.Mode = GPIO_MODE_IT_RISING_FALLING;
+	gpio.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(GPIOE, &gpio);
+	HAL_NVIC_EnableIRQ(ENCODER_A_EXTI_IRQn);
+	HAL_NVIC_EnableIRQ(ENCODER_B_EXTI_IRQn);
+	encoder_init();
+}
+
+/*******************************************************************************************************
+ * @brief Holds the motor at each duty cycle and compares the speed estimate with the plant speed.     *
+ *                                                                                                     *
+ * The motor starts at rest. Each control loop period, `motor_control_step` runs on the encoder count, *
+ * then the bench overrides the TIM3 compare value with the held duty cycle and runs the plant for one *
+ * period, sampling its speed every `SIM_BENCH_SAMPLE_US`. The estimate is compared with the mean of   *
+ * those samples over the last `SPEED_WINDOW_PERIODS` periods, the interval the estimate covers.       *
+ *                                                                                                     *
+ * @param duties [const float*] Duty cycles held in turn (%).                                          *
+ * @param count [uint32_t] Number of duty cycles.                                                      *
+ * @param step_ms [uint32_t] Simulated time per duty cycle (ms).                                       *
+ * @param results [bench_result_t*] Estimate against the plant, one per duty cycle.                    *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void bench_run(const float *duties, uint32_t count, uint32_t step_ms, bench_result_t *results)
+{
+	const uint32_t period_us = 1000000U / CONTROL_LOOP_RATE_HZ;
+	const uint32_t periods = (step_ms * 1000U) / period_us;
+	const uint32_t tail_periods = (SIM_BENCH_TAIL_MS * 1000U) / period_us;
+	const uint32_t samples = period_us / SIM_BENCH_SAMPLE_US;
+	double period_rpm[SPEED_WINDOW_PERIODS] = {0};
+	uint32_t period_index = 0;
+
+	// Motor at rest, then start forward as the Start command does
+	sim_motor_reset();
+	motor_control_reset(read_encoder_count());
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(MOTOR_IN2_GPIO_Port, MOTOR_IN2_Pin, GPIO_PIN_RESET);
+
+	for(uint32_t d = 0; d < count; d++) {
+		bench_result_t *result = &results[d];
+		uint32_t compare = (uint32_t)((duties[d] / 100.0f) * (htim3.Instance->ARR + 1));
+
+		memset(result, 0, sizeof(*result));
+		result->duty = duties[d];
+
+		for(uint32_t p = 0; p < periods; p++) {
+			// Speed estimate over the window, against the mean plant speed over the same periods
+			(void)motor_control_step(read_encoder_count());
+			double window_rpm = 0.0;
+			for(uint32_t i = 0; i < SPEED_WINDOW_PERIODS; i++) {
+				window_rpm += period_rpm[i];
+			}
+			window_rpm /= SPEED_WINDOW_PERIODS;
+
+			double error_counts = fabs((double)motor_speed - window_rpm) / SPEED_RPM_PER_COUNT;
+			result->max_error_counts = fmax(result->max_error_counts, error_counts);
+			if(p >= (periods - tail_periods)) {
+				result->plant_rpm += window_rpm / tail_periods;
+				result->estimate_rpm += (double)motor_speed / tail_periods;
+			}
+
+			// Plant at the held duty cycle, in place of the control law output
+			__HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, compare);
+			double rpm = 0.0;
+			for(uint32_t s = 0; s < samples; s++) {
+				sim_motor_run(SIM_BENCH_SAMPLE_US);
+				rpm += sim_motor_rpm();
+			}
+			period_rpm[period_index] = rpm / samples;
+			period_index = (period_index + 1) % SPEED_WINDOW_PERIODS;
+		}
+	}
+
+	// Stop the motor, pulling both inputs low as the Stop command does
+	HAL_GPIO_WritePin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin | MOTOR_IN2_Pin, GPIO_PIN_RESET);
+}
+
+/*******************************************************************************************************
+ * @brief Parses a comma separated list of duty cycles.                                                *
+ *                                                                                                     *
+ * @param list [const char*] Duty cycles, for example "40,100".                                        *
+ * @param duties [float*] Parsed duty cycles, `BENCH_MAX_DUTIES` at most.                              *
+ * @return uint32_t Number of duty cycles, 0 if the list is invalid or a value is outside 0 - 100.     *
+ ******************************************************************************************************/
+
+static uint32_t bench_parse_duties(const char *list, float *duties)
+{
+	const char *ptr = list;
+	uint32_t count = 0;
+	char *end;
+
+	while(count < BENCH_MAX_DUTIES) {
+		float value = strtof(ptr, &end);
+		if((end == ptr) || (value < 0.0f) || (value > 100.0f)) {
+			return 0;
+		}
+		duties[count++] = value;
+
+		if('\0' == *end) {
+			return count;
+		}
+		if(',' != *end) {
+			return 0;
+		}
+		ptr = end + 1;
+	}
+
+	return 0;
+}
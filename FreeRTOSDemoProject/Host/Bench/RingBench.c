@@ -0,0 +1,325 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ RingBench ]                                                             |
+| FILE:       RingBench.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `RingBench` benchmark measures the UART reception hand-off on the host.        |
+|    A producer thread stands in for the reception ISR and a consumer thread for        |
+|    the message handler task. The same byte stream goes through the lock-free ring     |
+|    in bulk, and through a locked queue one byte at a time, as `q_data` did.           |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Config_Sim.h"
+#include "Config_UartManager.h"
+#include "RingBuffer.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define BENCH_MAX_RING_SIZE			65536
+#define BENCH_MAX_CHUNK				4096
+#define BENCH_MAX_QUEUE_LENGTH		1024
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Byte queue with the blocking semantics of a FreeRTOS queue
+typedef struct
+{
+	pthread_mutex_t lock;		// Taken for every byte, as the kernel critical section of the queue calls
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+	uint8_t items[BENCH_MAX_QUEUE_LENGTH];
+	uint32_t length;
+	uint32_t head;
+	uint32_t count;
+} bench_queue_t;
+
+// Stream passed through one path
+typedef struct
+{
+	uint32_t bytes;				// Bytes to pass from the producer to the consumer
+	uint32_t errors;			// Bytes the consumer received out of sequence
+	uint64_t producer_stalls;	// Writes that found no room, the ISR would have dropped these bytes
+} bench_run_t;
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static double bench_run(void *(*producer)(void *arg), void *(*consumer)(void *arg), bench_run_t *run);
+static void *bench_ring_producer(void *arg);
+static void *bench_ring_consumer(void *arg);
+static void *bench_queue_producer(void *arg);
+static void *bench_queue_consumer(void *arg);
+static uint8_t bench_byte(uint32_t n);
+static uint64_t bench_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *bench_usage = "usage: RingBench [-n bytes] [-r ring] [-c chunk] [-q length]\n"
+								 "  -n  bytes passed through each path (default %u)\n"
+								 "  -r  ring size in bytes, a power of two up to %u (default %u)\n"
+								 "  -c  bytes per producer write, up to %u (default %u)\n"
+								 "  -q  queue length in bytes, up to %u (default %u)\n";
+
+static uint32_t bench_chunk = SIM_BENCH_RING_CHUNK;
+static uint8_t bench_ring_buf[BENCH_MAX_RING_SIZE];
+static ring_buffer_t bench_ring;
+static bench_queue_t bench_queue = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.not_empty = PTHREAD_COND_INITIALIZER,
+	.not_full = PTHREAD_COND_INITIALIZER,
+};
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Benchmark entry point.                                                                       *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `bench_usage`.                                                 *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments or a corrupted stream.           *
+ ******************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	uint32_t ring_size = SIM_BENCH_RING_SIZE;
+	bench_run_t ring_run = { .bytes = SIM_BENCH_RING_BYTES };
+	bench_run_t queue_run;
+	double ring_ns;
+	double queue_ns;
+	int opt;
+
+	bench_queue.length = SIM_BENCH_RING_QUEUE_LENGTH;
+	while(-1 != (opt = getopt(argc, argv, "n:r:c:q:"))) {
+		switch(opt) {
+			case 'n': ring_run.bytes = strtoul(optarg, NULL, 10); break;
+			case 'r': ring_size = strtoul(optarg, NULL, 10); break;
+			case 'c': bench_chunk = strtoul(optarg, NULL, 10); break;
+			case 'q': bench_queue.length = strtoul(optarg, NULL, 10); break;
+			default: ring_run.bytes = 0; break;
+		}
+	}
+	if((0 == ring_run.bytes) || (ring_size > BENCH_MAX_RING_SIZE) || (0 == bench_chunk) || (bench_chunk > BENCH_MAX_CHUNK)
+	   || (0 == bench_queue.length) || (bench_queue.length > BENCH_MAX_QUEUE_LENGTH)
+	   || (0 != ring_buffer_init(&bench_ring, bench_ring_buf, ring_size))) {
+		fprintf(stderr, bench_usage, SIM_BENCH_RING_BYTES, BENCH_MAX_RING_SIZE, SIM_BENCH_RING_SIZE, BENCH_MAX_CHUNK,
+				SIM_BENCH_RING_CHUNK, BENCH_MAX_QUEUE_LENGTH, SIM_BENCH_RING_QUEUE_LENGTH);
+		return EXIT_FAILURE;
+	}
+	queue_run = (bench_run_t){ .bytes = ring_run.bytes };
+
+	printf("%u bytes, %u byte ring written %u bytes at a time, %u byte queue\n\n",
+		   ring_run.bytes, ring_size, bench_chunk, bench_queue.length);
+
+	ring_ns = bench_run(bench_ring_producer, bench_ring_consumer, &ring_run);
+	queue_ns = bench_run(bench_queue_producer, bench_queue_consumer, &queue_run);
+
+	printf("%-6s %12s %12s %14s %8s\n", "path", "MB/s", "ns/byte", "full stalls", "errors");
+	printf("%-6s %12.1f %12.2f %14llu %8u\n", "ring", ring_run.bytes / (ring_ns / 1000.0), ring_ns / ring_run.bytes,
+		   (unsigned long long)ring_run.producer_stalls, ring_run.errors);
+	printf("%-6s %12.1f %12.2f %14llu %8u\n", "queue", queue_run.bytes / (queue_ns / 1000.0), queue_ns / queue_run.bytes,
+		   (unsigned long long)queue_run.producer_stalls, queue_run.errors);
+	printf("\nThe ring is %.1f times as fast as the queue.\n", queue_ns / ring_ns);
+
+	// Every byte must come out once and in order on both paths
+	if((0 != ring_run.errors) || (0 != queue_run.errors)) {
+		printf("FAIL: a consumer received bytes out of sequence\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("PASS: both paths delivered the stream intact\n");
+	return EXIT_SUCCESS;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Runs a producer and a consumer thread over one stream.                                       *
+ *                                                                                                     *
+ * @param producer [void*(*)(void*)] Producer thread, writing `run->bytes` bytes of `bench_byte`.      *
+ * @param consumer [void*(*)(void*)] Consumer thread, reading and checking them.                       *
+ * @param run [bench_run_t*] Stream length in, stalls and errors out.                                  *
+ * @return double Time from the start of the threads until the consumer has read the last byte (ns).   *
+ ******************************************************************************************************/
+
+static double bench_run(void *(*producer)(void *arg), void *(*consumer)(void *arg), bench_run_t *run)
+{
+	pthread_t producer_thread;
+	pthread_t consumer_thread;
+	uint64_t start = bench_now_ns();
+
+	pthread_create(&consumer_thread, NULL, consumer, run);
+	pthread_create(&producer_thread, NULL, producer, run);
+	pthread_join(producer_thread, NULL);
+	pthread_join(consumer_thread, NULL);
+
+	return (double)(bench_now_ns() - start);
+}
+
+/*******************************************************************************************************
+ * @brief Ring producer, writing the stream in chunks as the reception ISR copies the DMA bytes.       *
+ *                                                                                                     *
+ * @param arg [void*] Pointer to the `bench_run_t` of the run.                                         *
+ * @return void* NULL                                                                                  *
+ *                                                                                                     *
+ * @note The ISR cannot wait for room, so a short write counts as a stall and the rest is retried.     *
+ ******************************************************************************************************/
+
+static void *bench_ring_producer(void *arg)
+{
+	bench_run_t *run = arg;
+	uint8_t chunk[BENCH_MAX_CHUNK];
+	uint32_t n = 0;
+
+	while(n < run->bytes) {
+		uint32_t len = ((run->bytes - n) < bench_chunk) ? (run->bytes - n) : bench_chunk;
+		uint32_t done = 0;
+
+		for(uint32_t i = 0; i < len; i++) {
+			chunk[i] = bench_byte(n + i);
+		}
+		while(done < len) {
+			uint32_t written = ring_buffer_write(&bench_ring, &chunk[done], len - done);
+			if(written < (len - done)) {
+				run->producer_stalls++;
+				sched_yield();
+			}
+			done += written;
+		}
+		n += len;
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************************************
+ * @brief Ring consumer, draining whatever is available in bulk as the message handler task does.      *
+ *                                                                                                     *
+ * @param arg [void*] Pointer to the `bench_run_t` of the run.                                         *
+ * @return void* NULL                                                                                  *
+ ******************************************************************************************************/
+
+static void *bench_ring_consumer(void *arg)
+{
+	bench_run_t *run = arg;
+	uint8_t chunk[BENCH_MAX_RING_SIZE];
+	uint32_t n = 0;
+
+	while(n < run->bytes) {
+		uint32_t len = ring_buffer_read(&bench_ring, chunk, sizeof(chunk));
+		if(0 == len) {
+			sched_yield();
+		}
+		for(uint32_t i = 0; i < len; i++) {
+			run->errors += (chunk[i] != bench_byte(n + i));
+		}
+		n += len;
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************************************
+ * @brief Queue producer, sending the stream one byte per call as the former reception callback did.   *
+ *                                                                                                     *
+ * @param arg [void*] Pointer to the `bench_run_t` of the run.                                         *
+ * @return void* NULL                                                                                  *
+ ******************************************************************************************************/
+
+static void *bench_queue_producer(void *arg)
+{
+	bench_run_t *run = arg;
+
+	for(uint32_t n = 0; n < run->bytes; n++) {
+		pthread_mutex_lock(&bench_queue.lock);
+		if(bench_queue.count == bench_queue.length) {
+			run->producer_stalls++;
+			while(bench_queue.count == bench_queue.length) {
+				pthread_cond_wait(&bench_queue.not_full, &bench_queue.lock);
+			}
+		}
+		bench_queue.items[(bench_queue.head + bench_queue.count) % bench_queue.length] = bench_byte(n);
+		bench_queue.count++;
+		pthread_cond_signal(&bench_queue.not_empty);
+		pthread_mutex_unlock(&bench_queue.lock);
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************************************
+ * @brief Queue consumer, receiving one byte per call as `extract_command` did.                        *
+ *                                                                                                     *
+ * @param arg [void*] Pointer to the `bench_run_t` of the run.                                         *
+ * @return void* NULL                                                                                  *
+ ******************************************************************************************************/
+
+static void *bench_queue_consumer(void *arg)
+{
+	bench_run_t *run = arg;
+
+	for(uint32_t n = 0; n < run->bytes; n++) {
+		pthread_mutex_lock(&bench_queue.lock);
+		while(0 == bench_queue.count) {
+			pthread_cond_wait(&bench_queue.not_empty, &bench_queue.lock);
+		}
+		uint8_t byte = bench_queue.items[bench_queue.head];
+		bench_queue.head = (bench_queue.head + 1) % bench_queue.length;
+		bench_queue.count--;
+		pthread_cond_signal(&bench_queue.not_full);
+		pthread_mutex_unlock(&bench_queue.lock);
+
+		run->errors += (byte != bench_byte(n));
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************************************
+ * @brief Returns byte `n` of the test stream, printable text with a line feed every 64 bytes.         *
+ *                                                                                                     *
+ * @param n [uint32_t] Position in the stream.                                                         *
+ * @return uint8_t Byte at that position.                                                              *
+ ******************************************************************************************************/
+
+static uint8_t bench_byte(uint32_t n)
+{
+	return (63 == (n % 64)) ? '\n' : (uint8_t)(' ' + ((n * 7) % 95));
+}
+
+/*******************************************************************************************************
+ * @brief Reads the host monotonic clock.                                                              *
+ *                                                                                                     *
+ * @return uint64_t Time in nanoseconds.                                                               *
+ ******************************************************************************************************/
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
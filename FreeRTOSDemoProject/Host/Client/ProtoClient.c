@@ -0,0 +1,434 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ ProtoClient ]                                                           |
+| FILE:       ProtoClient.c                                                             |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `ProtoClient` library is the host side of the binary protocol. It sends        |
+|    COBS framed requests to the board over a serial port, or to the host               |
+|    simulation over a pipe, and returns the typed response fields. Menu text           |
+|    received around the frames is skipped.                                             |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "ProtoClient.h"
+#include "Frame.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static int client_read_byte(proto_client_t *client, uint8_t *byte);
+static int client_read_frame(proto_client_t *client, uint8_t *encoded, uint32_t size);
+static int client_write(proto_client_t *client, const uint8_t *data, uint32_t len);
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Opens the serial port of the board.                                                          *
+ *                                                                                                     *
+ * The port is set to raw mode at 115200 baud, 8N1, matching USART2.                                   *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Client to initialize.                                               *
+ * @param device [const char*] Serial device, e.g. /dev/ttyACM0.                                       *
+ * @return int 0 on success, -1 if the port cannot be opened or configured.                            *
+ ******************************************************************************************************/
+int proto_client_open(proto_client_t *client, const char *device)
+{
+	struct termios tio;
+	int fd = open(device, O_RDWR | O_NOCTTY);
+
+	if(fd < 0) return -1;
+
+	if(0 != tcgetattr(fd, &tio)) {
+		close(fd);
+		return -1;
+	}
+	cfmakeraw(&tio);
+	cfsetispeed(&tio, B115200);
+	cfsetospeed(&tio, B115200);
+	tio.c_cflag |= CLOCAL | CREAD;
+	if(0 != tcsetattr(fd, TCSANOW, &tio)) {
+		close(fd);
+		return -1;
+	}
+	tcflush(fd, TCIOFLUSH);
+
+	memset(client, 0, sizeof(*client));
+	client->fd_in = fd;
+	client->fd_out = fd;
+	client->timeout_ms = PROTO_CLIENT_TIMEOUT_MS;
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Starts the host simulation and connects to its console.                                      *
+ *                                                                                                     *
+ * The simulation runs as a child process with its stdin and stdout on pipes, which is the default     *
+ * console of the simulated USART2. It is stopped by `proto_client_close`.                             *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Client to initialize.                                               *
+ * @param sim_path [const char*] Path of the FreeRTOSDemoHost executable.                              *
+ * @return int 0 on success, -1 if the pipes or the process cannot be created.                         *
+ ******************************************************************************************************/
+int proto_client_spawn(proto_client_t *client, const char *sim_path)
+{
+	int to_sim[2];
+	int from_sim[2];
+	pid_t pid;
+
+	if(0 != pipe(to_sim)) return -1;
+	if(0 != pipe(from_sim)) {
+		close(to_sim[0]);
+		close(to_sim[1]);
+		return -1;
+	}
+
+	pid = fork();
+	if(pid < 0) {
+		close(to_sim[0]);
+		close(to_sim[1]);
+		close(from_sim[0]);
+		close(from_sim[1]);
+		return -1;
+	}
+
+	if(0 == pid) {
+		dup2(to_sim[0], STDIN_FILENO);
+		dup2(from_sim[1], STDOUT_FILENO);
+		close(to_sim[0]);
+		close(to_sim[1]);
+		close(from_sim[0]);
+		close(from_sim[1]);
+		execl(sim_path, sim_path, (char *)NULL);
+		_exit(127);
+	}
+
+	close(to_sim[0]);
+	close(from_sim[1]);
+
+	memset(client, 0, sizeof(*client));
+	client->fd_in = from_sim[0];
+	client->fd_out = to_sim[1];
+	client->child = pid;
+	client->timeout_ms = PROTO_CLIENT_TIMEOUT_MS;
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Closes the connection, and stops the simulation if it was started by the client.             *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Client to close.                                                    *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+void proto_client_close(proto_client_t *client)
+{
+	close(client->fd_out);
+	if(client->fd_in != client->fd_out) close(client->fd_in);
+
+	if(0 != client->child) {
+		kill(client->child, SIGTERM);
+		waitpid(client->child, NULL, 0);
+		client->child = 0;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sends a raw frame and waits for the response with the same sequence number.                  *
+ *                                                                                                     *
+ * The frame is sent as is, which lets the caller send frames with a wrong CRC or length. Frames from  *
+ * an earlier request, and frames that fail their CRC, are skipped until the timeout expires.          *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param frame [const uint8_t*] Decoded request frame, including its CRC.                             *
+ * @param len [uint32_t] Length of the request frame (1 to PROTO_FRAME_MAX bytes).                     *
+ * @param rsp [uint8_t*] Output for the decoded response frame.                                        *
+ * @param size [uint32_t] Size of `rsp`, at least PROTO_FRAME_MAX bytes.                               *
+ * @return int Length of the response frame, without its CRC, or a PROTO_CLIENT_ERR_x code.            *
+ ******************************************************************************************************/
+int proto_client_exchange(proto_client_t *client, const uint8_t *frame, uint32_t len, uint8_t *rsp, uint32_t size)
+{
+	uint8_t encoded[FRAME_COBS_MAX(PROTO_FRAME_MAX) + 2];
+	uint32_t encoded_len;
+
+	if((0 == len) || (len > PROTO_FRAME_MAX)) return PROTO_CLIENT_ERR_FRAME;
+
+	encoded[0] = FRAME_DELIMITER;
+	encoded_len = frame_cobs_encode(frame, len, &encoded[1]);
+	encoded[1 + encoded_len] = FRAME_DELIMITER;
+	if(0 != client_write(client, encoded, encoded_len + 2)) return PROTO_CLIENT_ERR_IO;
+
+	for(;;) {
+		int32_t decoded;
+		int received = client_read_frame(client, encoded, sizeof(encoded));
+
+		if(received < 0) return received;
+
+		decoded = frame_cobs_decode(encoded, (uint32_t)received, rsp, size);
+		if(decoded < PROTO_RSP_OVERHEAD) continue;
+		if(frame_get_u16(&rsp[decoded - 2]) != frame_crc16(rsp, (uint32_t)decoded - 2)) continue;
+		if((rsp[0] != frame[0]) || (rsp[1] != (frame[1] | PROTO_RSP_FLAG))) continue;
+
+		return decoded - 2;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sends a request and waits for its response.                                                  *
+ *                                                                                                     *
+ * The sequence number is incremented for every request. The response payload is only copied if the    *
+ * status is PROTO_OK.                                                                                 *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param cmd [uint8_t] Command, one of the PROTO_CMD_x values.                                        *
+ * @param req [const uint8_t*] Request payload, NULL if `req_len` is 0.                                *
+ * @param req_len [uint32_t] Request payload length.                                                   *
+ * @param rsp [uint8_t*] Output for the response payload, NULL if `rsp_len` is 0.                      *
+ * @param rsp_len [uint32_t] Expected response payload length.                                         *
+ * @return int Response status (PROTO_OK or PROTO_ERR_x), or a PROTO_CLIENT_ERR_x code.                *
+ ******************************************************************************************************/
+int proto_client_request(proto_client_t *client, uint8_t cmd, const uint8_t *req, uint32_t req_len,
+						 uint8_t *rsp, uint32_t rsp_len)
+{
+	uint8_t frame[PROTO_FRAME_MAX];
+	uint8_t response[PROTO_FRAME_MAX];
+	int len;
+
+	if(req_len + PROTO_REQ_OVERHEAD > PROTO_FRAME_MAX) return PROTO_CLIENT_ERR_FRAME;
+
+	frame[0] = client->seq++;
+	frame[1] = cmd;
+	if(0 != req_len) memcpy(&frame[2], req, req_len);
+	frame_put_u16(&frame[2 + req_len], frame_crc16(frame, 2 + req_len));
+
+	len = proto_client_exchange(client, frame, req_len + PROTO_REQ_OVERHEAD, response, sizeof(response));
+	if(len < 0) return len;
+
+	// seq, cmd and status, then the payload
+	if(PROTO_OK != response[2]) return (3 == len) ? response[2] : PROTO_CLIENT_ERR_FRAME;
+	if((uint32_t)len != 3 + rsp_len) return PROTO_CLIENT_ERR_FRAME;
+	if(0 != rsp_len) memcpy(rsp, &response[3], rsp_len);
+
+	return PROTO_OK;
+}
+
+/*******************************************************************************************************
+ * @brief PROTO_CMD_PING: checks the connection and reads the protocol version.                        *
+ *                                                                                                     *
+ * The typed functions below convert the fields of one command. They all return the response status    *
+ * (PROTO_OK or PROTO_ERR_x) or a PROTO_CLIENT_ERR_x code, and only write their outputs on PROTO_OK.   *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param version [uint8_t*] Output for the protocol version.                                          *
+ * @return int Response status, or a PROTO_CLIENT_ERR_x code.                                          *
+ ******************************************************************************************************/
+int proto_ping(proto_client_t *client, uint8_t *version)
+{
+	return proto_client_request(client, PROTO_CMD_PING, NULL, 0, version, 1);
+}
+
+// PROTO_CMD_GET_SPEED: target and measured speed in RPM, and the speed control algorithm
+int proto_get_speed(proto_client_t *client, float *target, float *measured, uint8_t *algo)
+{
+	uint8_t rsp[9];
+	int status = proto_client_request(client, PROTO_CMD_GET_SPEED, NULL, 0, rsp, sizeof(rsp));
+
+	if(PROTO_OK == status) {
+		*target = frame_get_f32(&rsp[0]);
+		*measured = frame_get_f32(&rsp[4]);
+		*algo = rsp[8];
+	}
+	return status;
+}
+
+// PROTO_CMD_SET_SPEED: sets the target speed in RPM, `applied` is the target after the speed limit
+int proto_set_speed(proto_client_t *client, float rpm, float *applied)
+{
+	uint8_t req[4];
+	uint8_t rsp[4];
+	int status;
+
+	frame_put_f32(req, rpm);
+	status = proto_client_request(client, PROTO_CMD_SET_SPEED, req, sizeof(req), rsp, sizeof(rsp));
+	if(PROTO_OK == status) *applied = frame_get_f32(rsp);
+	return status;
+}
+
+// PROTO_CMD_GET_PID: PID gains
+int proto_get_pid(proto_client_t *client, float *kp, float *ki, float *kd)
+{
+	uint8_t rsp[12];
+	int status = proto_client_request(client, PROTO_CMD_GET_PID, NULL, 0, rsp, sizeof(rsp));
+
+	if(PROTO_OK == status) {
+		*kp = frame_get_f32(&rsp[0]);
+		*ki = frame_get_f32(&rsp[4]);
+		*kd = frame_get_f32(&rsp[8]);
+	}
+	return status;
+}
+
+// PROTO_CMD_SET_PID: sets the PID gains
+int proto_set_pid(proto_client_t *client, float kp, float ki, float kd)
+{
+	uint8_t req[12];
+
+	frame_put_f32(&req[0], kp);
+	frame_put_f32(&req[4], ki);
+	frame_put_f32(&req[8], kd);
+	return proto_client_request(client, PROTO_CMD_SET_PID, req, sizeof(req), NULL, 0);
+}
+
+// PROTO_CMD_GET_LED: LED effect, 0 = none, 1 to 4 = E1 to E4
+int proto_get_led(proto_client_t *client, uint8_t *effect)
+{
+	return proto_client_request(client, PROTO_CMD_GET_LED, NULL, 0, effect, 1);
+}
+
+// PROTO_CMD_SET_LED: starts an LED effect, 0 = none, 1 to 4 = E1 to E4
+int proto_set_led(proto_client_t *client, uint8_t effect)
+{
+	return proto_client_request(client, PROTO_CMD_SET_LED, &effect, 1, NULL, 0);
+}
+
+// PROTO_CMD_GET_RTC: RTC time and date
+int proto_get_rtc(proto_client_t *client, proto_rtc_t *rtc)
+{
+	uint8_t rsp[8];
+	int status = proto_client_request(client, PROTO_CMD_GET_RTC, NULL, 0, rsp, sizeof(rsp));
+
+	if(PROTO_OK == status) {
+		rtc->hours = rsp[0];
+		rtc->minutes = rsp[1];
+		rtc->seconds = rsp[2];
+		rtc->pm = rsp[3];
+		rtc->month = rsp[4];
+		rtc->date = rsp[5];
+		rtc->year = rsp[6];
+		rtc->weekday = rsp[7];
+	}
+	return status;
+}
+
+// PROTO_CMD_SET_RTC: sets the RTC time and date
+int proto_set_rtc(proto_client_t *client, const proto_rtc_t *rtc)
+{
+	uint8_t req[8] = {
+		rtc->hours, rtc->minutes, rtc->seconds, rtc->pm,
+		rtc->month, rtc->date, rtc->year, rtc->weekday
+	};
+
+	return proto_client_request(client, PROTO_CMD_SET_RTC, req, sizeof(req), NULL, 0);
+}
+
+// PROTO_CMD_GET_ACC: acceleration of the X, Y and Z axes (mg)
+int proto_get_acc(proto_client_t *client, int16_t acc[3])
+{
+	uint8_t rsp[6];
+	int status = proto_client_request(client, PROTO_CMD_GET_ACC, NULL, 0, rsp, sizeof(rsp));
+
+	if(PROTO_OK == status) {
+		for(uint32_t i = 0; i < 3; i++) acc[i] = (int16_t)frame_get_u16(&rsp[2 * i]);
+	}
+	return status;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Reads one byte from the target, refilling the receive buffer when it is empty.               *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param byte [uint8_t*] Output for the byte.                                                         *
+ * @return int 0 on success, or a PROTO_CLIENT_ERR_x code.                                             *
+ ******************************************************************************************************/
+static int client_read_byte(proto_client_t *client, uint8_t *byte)
+{
+	if(client->rx_pos == client->rx_len) {
+		struct pollfd pfd = { .fd = client->fd_in, .events = POLLIN };
+		ssize_t received;
+		int ready = poll(&pfd, 1, client->timeout_ms);
+
+		if(0 == ready) return PROTO_CLIENT_ERR_TIMEOUT;
+		if(ready < 0) return PROTO_CLIENT_ERR_IO;
+
+		received = read(client->fd_in, client->rx_buf, sizeof(client->rx_buf));
+		if(received <= 0) return PROTO_CLIENT_ERR_IO;
+		client->rx_pos = 0;
+		client->rx_len = (uint32_t)received;
+	}
+
+	*byte = client->rx_buf[client->rx_pos++];
+	return 0;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the next encoded frame from the target.                                                *
+ *                                                                                                     *
+ * Text before the opening delimiter is skipped. The closing delimiter of a frame also opens the next  *
+ * one, so consecutive delimiters are skipped as empty frames. Frames longer than `size` are dropped.  *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param encoded [uint8_t*] Output for the encoded frame, without delimiters.                         *
+ * @param size [uint32_t] Size of `encoded`.                                                           *
+ * @return int Length of the encoded frame, or a PROTO_CLIENT_ERR_x code.                              *
+ ******************************************************************************************************/
+static int client_read_frame(proto_client_t *client, uint8_t *encoded, uint32_t size)
+{
+	uint8_t byte;
+	uint32_t len = 0;
+	int status;
+
+	// Skip text up to the opening delimiter
+	do {
+		if(0 != (status = client_read_byte(client, &byte))) return status;
+	} while(FRAME_DELIMITER != byte);
+
+	for(;;) {
+		if(0 != (status = client_read_byte(client, &byte))) return status;
+
+		if(FRAME_DELIMITER == byte) {
+			if((len > 0) && (len <= size)) return (int)len;
+			len = 0;
+		}
+		else {
+			if(len < size) encoded[len] = byte;
+			len++;
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Writes all bytes to the target.                                                              *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param data [const uint8_t*] Bytes to write.                                                        *
+ * @param len [uint32_t] Number of bytes.                                                              *
+ * @return int 0 on success, -1 if the write failed.                                                   *
+ ******************************************************************************************************/
+static int client_write(proto_client_t *client, const uint8_t *data, uint32_t len)
+{
+	while(len > 0) {
+		ssize_t written = write(client->fd_out, data, len);
+
+		if(written <= 0) return -1;
+		data += written;
+		len -= (uint32_t)written;
+	}
+	return 0;
+}
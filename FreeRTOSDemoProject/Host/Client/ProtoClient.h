@@ -0,0 +1,75 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ ProtoClient ]                                                           |
+| FILE:       ProtoClient.h                                                             |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `ProtoClient` library is the host side of the binary protocol. It sends        |
+|    COBS framed requests to the board over a serial port, or to the host               |
+|    simulation over a pipe, and returns the typed response fields. Menu text           |
+|    received around the frames is skipped.                                             |
+\*=====================================================================================*/
+
+#ifndef PROTOCLIENT_H_
+#define PROTOCLIENT_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "Protocol.h"
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define PROTO_CLIENT_TIMEOUT_MS		1000 // Default time to wait for a response
+#define PROTO_CLIENT_RX_SIZE		256 // Bytes read from the target at once
+
+// Transport errors, returned instead of a response status
+#define PROTO_CLIENT_ERR_IO			-1 // Read or write failed, or the target closed the connection
+#define PROTO_CLIENT_ERR_TIMEOUT	-2 // No response within the timeout
+#define PROTO_CLIENT_ERR_FRAME		-3 // Response too short or with an unexpected length
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Typedefs
+typedef struct
+{
+	int fd_in;							// Bytes from the target
+	int fd_out;							// Bytes to the target
+	pid_t child;						// Simulation started by `proto_client_spawn`, 0 otherwise
+	uint8_t seq;						// Sequence number of the next request
+	int timeout_ms;						// Time to wait for a response
+	uint8_t rx_buf[PROTO_CLIENT_RX_SIZE];	// Bytes read but not yet processed
+	uint32_t rx_pos;
+	uint32_t rx_len;
+} proto_client_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+int proto_client_open(proto_client_t *client, const char *device);
+int proto_client_spawn(proto_client_t *client, const char *sim_path);
+void proto_client_close(proto_client_t *client);
+int proto_client_exchange(proto_client_t *client, const uint8_t *frame, uint32_t len, uint8_t *rsp, uint32_t size);
+int proto_client_request(proto_client_t *client, uint8_t cmd, const uint8_t *req, uint32_t req_len,
+						 uint8_t *rsp, uint32_t rsp_len);
+int proto_ping(proto_client_t *client, uint8_t *version);
+int proto_get_speed(proto_client_t *client, float *target, float *measured, uint8_t *algo);
+int proto_set_speed(proto_client_t *client, float rpm, float *applied);
+int proto_get_pid(proto_client_t *client, float *kp, float *ki, float *kd);
+int proto_set_pid(proto_client_t *client, float kp, float ki, float kd);
+int proto_get_led(proto_client_t *client, uint8_t *effect);
+int proto_set_led(proto_client_t *client, uint8_t effect);
+int proto_get_rtc(proto_client_t *client, proto_rtc_t *rtc);
+int proto_set_rtc(proto_client_t *client, const proto_rtc_t *rtc);
+int proto_get_acc(proto_client_t *client, int16_t acc[3]);
+
+#endif /* PROTOCLIENT_H_ */
@@ -0,0 +1,365 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ ProtoClient ]                                                           |
+| FILE:       ProtoMain.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `ProtoClient` tool sends binary protocol requests to the board, or to          |
+|    the host simulation, from the command line. Its loopback command runs every        |
+|    request and the error responses against a target and times the ping round          |
+|    trip.                                                                              |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "ProtoClient.h"
+#include "Frame.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define LOOPBACK_PINGS				100 // Default number of timed pings of the loopback command
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static int cli_check(const char *name, int status, int expected, int ok);
+static int cli_command(proto_client_t *client, int argc, char *argv[]);
+static int cli_loopback(proto_client_t *client, uint32_t pings);
+static int cli_raw(proto_client_t *client, const uint8_t *frame, uint32_t len);
+static const char *cli_status(int status);
+static uint64_t cli_now_ns(void);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static const char *cli_usage =
+	"usage: ProtoClient (-d device | -s simulator) [-n pings] command [arguments]\n"
+	"  -d  serial device of the board, e.g. /dev/ttyACM0 (115200 baud)\n"
+	"  -s  host simulation to start, e.g. build-host/FreeRTOSDemoHost\n"
+	"  -n  timed pings of the loopback command (default %u)\n"
+	"commands:\n"
+	"  ping | get-speed | set-speed RPM | get-pid | set-pid KP KI KD | get-led | set-led 0-4\n"
+	"  get-rtc | set-rtc HH MM SS AM|PM MM DD YY WD | get-acc | loopback\n";
+
+static const char *cli_status_names[] = { "OK", "ERR_CRC", "ERR_CMD", "ERR_LEN", "ERR_VALUE" };
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Client entry point.                                                                          *
+ *                                                                                                     *
+ * @param argc [int] Argument count.                                                                   *
+ * @param argv [char*[]] Arguments, see `cli_usage`.                                                   *
+ * @return int `EXIT_SUCCESS`, or `EXIT_FAILURE` on invalid arguments, a transport error, an error     *
+ *             response or a failed loopback check.                                                    *
+ ******************************************************************************************************/
+int main(int argc, char *argv[])
+{
+	proto_client_t client;
+	const char *device = NULL;
+	const char *simulator = NULL;
+	uint32_t pings = LOOPBACK_PINGS;
+	int result;
+	int opt;
+
+	while(-1 != (opt = getopt(argc, argv, "d:s:n:"))) {
+		switch(opt) {
+			case 'd': device = optarg; break;
+			case 's': simulator = optarg; break;
+			case 'n': pings = strtoul(optarg, NULL, 10); break;
+			default:
+				fprintf(stderr, cli_usage, LOOPBACK_PINGS);
+				return EXIT_FAILURE;
+		}
+	}
+	if(((NULL == device) == (NULL == simulator)) || (optind >= argc) || (0 == pings)) {
+		fprintf(stderr, cli_usage, LOOPBACK_PINGS);
+		return EXIT_FAILURE;
+	}
+
+	if(NULL != device) result = proto_client_open(&client, device);
+	else result = proto_client_spawn(&client, simulator);
+	if(0 != result) {
+		perror("ProtoClient");
+		return EXIT_FAILURE;
+	}
+
+	if(!strcmp(argv[optind], "loopback")) result = cli_loopback(&client, pings);
+	else result = cli_command(&client, argc - optind, &argv[optind]);
+
+	proto_client_close(&client);
+	return result;
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Runs one request given on the command line and prints its response.                          *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param argc [int] Number of command words.                                                          *
+ * @param argv [char*[]] Command name, then its arguments.                                             *
+ * @return int `EXIT_SUCCESS` if the target answered PROTO_OK, `EXIT_FAILURE` otherwise.               *
+ ******************************************************************************************************/
+static int cli_command(proto_client_t *client, int argc, char *argv[])
+{
+	const char *cmd = argv[0];
+	int status = PROTO_CLIENT_ERR_FRAME;
+
+	if(!strcmp(cmd, "ping") && (1 == argc)) {
+		uint8_t version;
+		if(PROTO_OK == (status = proto_ping(client, &version))) printf("protocol version %u\n", version);
+	}
+	else if(!strcmp(cmd, "get-speed") && (1 == argc)) {
+		float target, measured;
+		uint8_t algo;
+		if(PROTO_OK == (status = proto_get_speed(client, &target, &measured, &algo))) {
+			printf("target %.2f RPM, measured %.2f RPM, algorithm %u\n", target, measured, algo);
+		}
+	}
+	else if(!strcmp(cmd, "set-speed") && (2 == argc)) {
+		float applied;
+		if(PROTO_OK == (status = proto_set_speed(client, strtof(argv[1], NULL), &applied))) {
+			printf("target %.2f RPM\n", applied);
+		}
+	}
+	else if(!strcmp(cmd, "get-pid") && (1 == argc)) {
+		float kp, ki, kd;
+		if(PROTO_OK == (status = proto_get_pid(client, &kp, &ki, &kd))) {
+			printf("Kp %.4f, Ki %.4f, Kd %.4f\n", kp, ki, kd);
+		}
+	}
+	else if(!strcmp(cmd, "set-pid") && (4 == argc)) {
+		status = proto_set_pid(client, strtof(argv[1], NULL), strtof(argv[2], NULL), strtof(argv[3], NULL));
+	}
+	else if(!strcmp(cmd, "get-led") && (1 == argc)) {
+		uint8_t effect;
+		if(PROTO_OK == (status = proto_get_led(client, &effect))) printf("effect %u\n", effect);
+	}
+	else if(!strcmp(cmd, "set-led") && (2 == argc)) {
+		status = proto_set_led(client, (uint8_t)strtoul(argv[1], NULL, 10));
+	}
+	else if(!strcmp(cmd, "get-rtc") && (1 == argc)) {
+		proto_rtc_t rtc;
+		if(PROTO_OK == (status = proto_get_rtc(client, &rtc))) {
+			printf("%02u:%02u:%02u %s %02u-%02u-20%02u, weekday %u\n", rtc.hours, rtc.minutes, rtc.seconds,
+				   rtc.pm ? "PM" : "AM", rtc.month, rtc.date, rtc.year, rtc.weekday);
+		}
+	}
+	else if(!strcmp(cmd, "set-rtc") && (9 == argc)) {
+		proto_rtc_t rtc = {
+			.hours = (uint8_t)atoi(argv[1]), .minutes = (uint8_t)atoi(argv[2]),
+			.seconds = (uint8_t)atoi(argv[3]), .pm = !strcmp(argv[4], "PM"),
+			.month = (uint8_t)atoi(argv[5]), .date = (uint8_t)atoi(argv[6]),
+			.year = (uint8_t)atoi(argv[7]), .weekday = (uint8_t)atoi(argv[8]),
+		};
+		status = proto_set_rtc(client, &rtc);
+	}
+	else if(!strcmp(cmd, "get-acc") && (1 == argc)) {
+		int16_t acc[3];
+		if(PROTO_OK == (status = proto_get_acc(client, acc))) printf("X %d mg, Y %d mg, Z %d mg\n", acc[0], acc[1], acc[2]);
+	}
+	else {
+		fprintf(stderr, cli_usage, LOOPBACK_PINGS);
+		return EXIT_FAILURE;
+	}
+
+	if(PROTO_OK != status) {
+		fprintf(stderr, "ProtoClient: %s\n", cli_status(status));
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/*******************************************************************************************************
+ * @brief Runs every request and error response against the target, then times the ping round trip.    *
+ *                                                                                                     *
+ * Each set request is read back. The speed and PID gains of the target are restored at the end, the   *
+ * LED effect is left off and the RTC is left at the time set by the check.                            *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param pings [uint32_t] Number of timed pings.                                                      *
+ * @return int `EXIT_SUCCESS` if every check passed, `EXIT_FAILURE` otherwise.                         *
+ ******************************************************************************************************/
+static int cli_loopback(proto_client_t *client, uint32_t pings)
+{
+	proto_rtc_t rtc_set = { .hours = 11, .minutes = 59, .seconds = 30, .pm = 1,
+							.month = 12, .date = 31, .year = 26, .weekday = 5 };
+	proto_rtc_t rtc;
+	float target, measured, applied, kp, ki, kd, kp_get, ki_get, kd_get;
+	uint8_t frame[PROTO_FRAME_MAX];
+	uint8_t version, algo, effect;
+	int16_t acc[3];
+	int failures = 0;
+	uint64_t start;
+	int status;
+
+	status = proto_ping(client, &version);
+	failures += cli_check("ping", status, PROTO_OK, PROTO_VERSION == version);
+
+	status = proto_get_speed(client, &target, &measured, &algo);
+	failures += cli_check("get speed", status, PROTO_OK, 1);
+	status = proto_set_speed(client, 120.0f, &applied);
+	failures += cli_check("set speed", status, PROTO_OK, 120.0f == applied);
+	status = proto_get_speed(client, &applied, &measured, &algo);
+	failures += cli_check("get speed after set", status, PROTO_OK, 120.0f == applied);
+	status = proto_set_speed(client, 1.0e6f, &applied);
+	failures += cli_check("set speed above the limit", status, PROTO_OK, applied < 1.0e6f);
+	status = proto_set_speed(client, -1.0f, &applied);
+	failures += cli_check("set negative speed", status, PROTO_ERR_VALUE, 1);
+	status = proto_set_speed(client, NAN, &applied);
+	failures += cli_check("set NaN speed", status, PROTO_ERR_VALUE, 1);
+	status = proto_set_speed(client, target, &applied);
+	failures += cli_check("restore speed", status, PROTO_OK, 1);
+
+	status = proto_get_pid(client, &kp, &ki, &kd);
+	failures += cli_check("get PID", status, PROTO_OK, 1);
+	status = proto_set_pid(client, 0.5f, 0.25f, 0.125f);
+	failures += cli_check("set PID", status, PROTO_OK, 1);
+	status = proto_get_pid(client, &kp_get, &ki_get, &kd_get);
+	failures += cli_check("get PID after set", status, PROTO_OK,
+						  (0.5f == kp_get) && (0.25f == ki_get) && (0.125f == kd_get));
+	status = proto_set_pid(client, kp, ki, kd);
+	failures += cli_check("restore PID", status, PROTO_OK, 1);
+
+	status = proto_set_led(client, 2);
+	failures += cli_check("set LED", status, PROTO_OK, 1);
+	status = proto_get_led(client, &effect);
+	failures += cli_check("get LED after set", status, PROTO_OK, 2 == effect);
+	status = proto_set_led(client, 9);
+	failures += cli_check("set invalid LED effect", status, PROTO_ERR_VALUE, 1);
+	status = proto_set_led(client, 0);
+	failures += cli_check("LED off", status, PROTO_OK, 1);
+
+	status = proto_set_rtc(client, &rtc_set);
+	failures += cli_check("set RTC", status, PROTO_OK, 1);
+	status = proto_get_rtc(client, &rtc);
+	failures += cli_check("get RTC after set", status, PROTO_OK,
+						  (rtc.hours == rtc_set.hours) && (rtc.pm == rtc_set.pm) && (rtc.date == rtc_set.date) &&
+						  (rtc.month == rtc_set.month) && (rtc.year == rtc_set.year));
+	rtc = rtc_set;
+	rtc.date = 32;
+	status = proto_set_rtc(client, &rtc);
+	failures += cli_check("set invalid RTC date", status, PROTO_ERR_VALUE, 1);
+
+	// The board lies flat, Z reads about 1 g whatever the full scale
+	status = proto_get_acc(client, acc);
+	failures += cli_check("get accelerometer", status, PROTO_OK, (acc[2] > 500) && (acc[2] < 1500));
+
+	// Hand-built frames for the errors the typed functions cannot produce
+	frame[0] = 0xA0;
+	frame[1] = 0x7F;
+	frame_put_u16(&frame[2], frame_crc16(frame, 2));
+	failures += cli_check("unknown command", cli_raw(client, frame, 4), PROTO_ERR_CMD, 1);
+
+	frame[0] = 0xA1;
+	frame[1] = PROTO_CMD_PING;
+	frame_put_u16(&frame[2], frame_crc16(frame, 2) ^ 0x0001);
+	failures += cli_check("corrupted CRC", cli_raw(client, frame, 4), PROTO_ERR_CRC, 1);
+
+	frame[0] = 0xA2;
+	frame[1] = PROTO_CMD_SET_LED;
+	frame[2] = 1;
+	frame[3] = 1;
+	frame_put_u16(&frame[4], frame_crc16(frame, 4));
+	failures += cli_check("wrong payload length", cli_raw(client, frame, 6), PROTO_ERR_LEN, 1);
+
+	// Frames must still be found between menu lines
+	if(8 != write(client->fd_out, "Main\r\n\0\0", 8)) failures++;
+	status = proto_ping(client, &version);
+	failures += cli_check("ping after text and empty frames", status, PROTO_OK, 1);
+
+	start = cli_now_ns();
+	for(uint32_t i = 0; (i < pings) && (PROTO_OK == status); i++) status = proto_ping(client, &version);
+	failures += cli_check("timed pings", status, PROTO_OK, 1);
+	if(PROTO_OK == status) {
+		printf("ping round trip: %.3f ms mean over %u requests\n", (cli_now_ns() - start) / 1.0e6 / pings, pings);
+	}
+
+	printf("%s: %d check(s) failed\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*******************************************************************************************************
+ * @brief Prints the result of one loopback check.                                                     *
+ *                                                                                                     *
+ * @param name [const char*] Check description.                                                        *
+ * @param status [int] Response status, or a PROTO_CLIENT_ERR_x code.                                  *
+ * @param expected [int] Expected response status.                                                     *
+ * @param ok [int] Non-zero if the response fields are as expected.                                    *
+ * @return int 0 if the check passed, 1 otherwise.                                                     *
+ ******************************************************************************************************/
+static int cli_check(const char *name, int status, int expected, int ok)
+{
+	int passed = (status == expected) && ok;
+
+	printf("%-34s %-9s %s\n", name, cli_status(status), passed ? "pass" : "FAIL");
+	return !passed;
+}
+
+/*******************************************************************************************************
+ * @brief Sends a hand-built request frame and returns the status of its response.                     *
+ *                                                                                                     *
+ * @param client [proto_client_t*] Connected client.                                                   *
+ * @param frame [const uint8_t*] Decoded request frame, including its CRC.                             *
+ * @param len [uint32_t] Frame length.                                                                 *
+ * @return int Response status, or a PROTO_CLIENT_ERR_x code.                                          *
+ ******************************************************************************************************/
+static int cli_raw(proto_client_t *client, const uint8_t *frame, uint32_t len)
+{
+	uint8_t rsp[PROTO_FRAME_MAX];
+	int rsp_len = proto_client_exchange(client, frame, len, rsp, sizeof(rsp));
+
+	if(rsp_len < 0) return rsp_len;
+	return (3 == rsp_len) ? rsp[2] : PROTO_CLIENT_ERR_FRAME;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the name of a response status or transport error.                                    *
+ *                                                                                                     *
+ * @param status [int] Response status, or a PROTO_CLIENT_ERR_x code.                                  *
+ * @return const char* Status name.                                                                    *
+ ******************************************************************************************************/
+static const char *cli_status(int status)
+{
+	switch(status) {
+		case PROTO_CLIENT_ERR_IO: return "I/O error";
+		case PROTO_CLIENT_ERR_TIMEOUT: return "timeout";
+		case PROTO_CLIENT_ERR_FRAME: return "bad response";
+		default: break;
+	}
+	if((status >= 0) && (status < (int)(sizeof(cli_status_names) / sizeof(cli_status_names[0])))) {
+		return cli_status_names[status];
+	}
+	return "unknown status";
+}
+
+/*******************************************************************************************************
+ * @brief Reads the host monotonic clock.                                                              *
+ *                                                                                                     *
+ * @return uint64_t Time in nanoseconds.                                                               *
+ ******************************************************************************************************/
+static uint64_t cli_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
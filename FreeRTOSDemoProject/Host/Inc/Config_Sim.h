@@ -0,0 +1,102 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       Config_Sim.h                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` layer replaces the STM32 HAL with RAM-backed peripherals so the      |
+|    application can run on the FreeRTOS POSIX port. Peripheral events are raised       |
+|    from a simulated interrupt task, paced by the host kernel tick.                    |
+\*=====================================================================================*/
+
+#ifndef CONFIG_SIM_H_
+#define CONFIG_SIM_H_
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+// Simulated interrupt context
+#define SIM_IRQ_TASK_PRIORITY		( configMAX_PRIORITIES - 1 ) // Shares the top priority, the tick always switches to it
+#define SIM_IRQ_TASK_STACK_SIZE		( configMINIMAL_STACK_SIZE )
+
+// Clocks
+#define SIM_HSI_VALUE				16000000U // Internal oscillator feeding the PLL (Hz)
+#define SIM_RESET_CLOCK_HZ			SIM_HSI_VALUE // SystemCoreClock before SystemClock_Config runs
+
+// UART
+#define SIM_UART_ENV				"SIM_UART" // Set to "pty" to attach USART2 to a pseudo terminal instead of stdin/stdout
+#define SIM_UART_RX_RING_SIZE		1024 // Bytes buffered between the host reader thread and the simulated DMA (power of two)
+#define SIM_UART_BITS_PER_BYTE		10 // Start bit, 8 data bits and stop bit, used to pace reception and transmission
+
+// SEGGER RTT
+#define SIM_RTT_FILE_ENV			"SIM_RTT_FILE" // File receiving the bytes written to RTT up channels other than 0
+#define SIM_RTT_MAX_BUFFERS			4 // Up channels that can be allocated, channel 0 is reserved for SystemView
+
+// Accelerometer
+#define SIM_ACC_ENV					"SIM_ACC" // Set to "LIS302DL" to simulate the sensor of MB997B boards instead of the LIS3DSH
+#define SIM_ACC_TILT_MG				300 // Amplitude of the simulated tilt on X and Y (mg)
+#define SIM_ACC_GRAVITY_MG			980 // Static acceleration on Z (mg)
+#define SIM_ACC_PERIOD_MS			10000 // Period of one simulated tilt rotation (ms)
+#define SIM_ACC_VIBRATION_MG		50 // Amplitude of the simulated vibration on Z (mg)
+#define SIM_ACC_VIBRATION_HZ		25 // Frequency of the simulated vibration (Hz)
+
+// Motor plant, a 12 V 30:1 gear motor with a 64 CPR encoder driven through the L298N bridge
+#define SIM_MOTOR_SUPPLY_V			12.0 // H-bridge supply voltage (V)
+#define SIM_MOTOR_BRIDGE_DROP_V		2.0 // Voltage lost across the L298N output transistors (V)
+#define SIM_MOTOR_R_OHM				2.2 // Armature resistance (ohm)
+#define SIM_MOTOR_L_H				1.1e-3 // Armature inductance (H)
+#define SIM_MOTOR_KE				0.0106 // Back-EMF constant (V.s/rad), equal to the torque constant (N.m/A)
+#define SIM_MOTOR_J					4.0e-6 // Rotor and gearbox inertia seen by the motor shaft (kg.m^2)
+#define SIM_MOTOR_B					1.0e-6 // Viscous friction on the motor shaft (N.m.s/rad)
+#define SIM_MOTOR_FRICTION_NM		1.2e-3 // Coulomb friction on the motor shaft (N.m)
+#define SIM_MOTOR_LOAD_NM			0.0 // Constant load on the gearbox output shaft (N.m)
+#define SIM_MOTOR_STEP_US			10 // Integration step, well below the 0.5 ms electrical time constant
+#define SIM_MOTOR_EDGES_PER_REV		( ENCODER_RAW_COUNTS_PER_REV * ENCODER_QUADRATURE ) // Encoder counts per motor revolution, as decoded by MotorManager
+
+// PID benchmark
+#define SIM_BENCH_TARGET_RPM		225.0f // Speed step applied from standstill
+#define SIM_BENCH_RUN_MS			2000 // Simulated time per gain set
+#define SIM_BENCH_SAMPLE_US			100 // Plant speed sampling interval for the step response metrics
+#define SIM_BENCH_RISE_LOW_PCT		10.0 // Rise time is measured from this fraction of the target...
+#define SIM_BENCH_RISE_HIGH_PCT		90.0 // ...to this one
+#define SIM_BENCH_SETTLE_BAND_PCT	2.0 // Settling band around the target
+#define SIM_BENCH_TAIL_MS			200 // Window at the end of each run the steady-state error is averaged over
+#define SIM_BENCH_MAX_GAINS			16 // Values per gain list
+#define SIM_BENCH_KP_LIST			"0.05,0.1,0.2,0.5" // Default gain sweep, each list is comma separated
+#define SIM_BENCH_KI_LIST			"0,0.5,2"
+#define SIM_BENCH_KD_LIST			"0,0.001"
+#define SIM_BENCH_CMD_ITERATIONS	1000000 // Dispatches timed per command line by the command benchmark
+#define SIM_BENCH_DSP_ITERATIONS	200 // Passes over the test signal per kernel by the DSP benchmark
+#define SIM_BENCH_DSP_RATE_HZ		1600 // Sample rate of the DSP benchmark signal, the fastest sensor rate
+#define SIM_BENCH_DSP_HIGHPASS_HZ	1.0 // High-pass cutoff of the DSP benchmark (Hz)
+#define SIM_BENCH_DSP_TONE_HZ		25.0 // Vibration in the DSP benchmark signal, inside the low-pass band (Hz)
+#define SIM_BENCH_DSP_NOISE_LSB		200.0 // Peak noise of the DSP benchmark signal (counts)
+#define SIM_BENCH_DSP_MAX_ERROR_LSB	1.0 // Largest difference from the double precision filters and statistics
+#define SIM_BENCH_DSP_MAX_ERROR_CDEG	1.0 // Largest difference from the double precision tilt (hundredths of a degree)
+#define SIM_BENCH_RING_BYTES		1048576 // Bytes passed through each path by the ring benchmark
+#define SIM_BENCH_RING_SIZE			UART_RX_RING_SIZE // Ring size of the ring benchmark, as configured for the target
+#define SIM_BENCH_RING_CHUNK		32 // Bytes per producer write, a DMA half buffer as the reception ISR copies it
+#define SIM_BENCH_RING_QUEUE_LENGTH	10 // Length of the byte queue the ring replaced
+#define SIM_BENCH_MATH_TARGETS		"225,100,250" // Target speeds the control law benchmark steps through (RPM)
+#define SIM_BENCH_MATH_STEP_MS		1000 // Simulated time per target speed
+#define SIM_BENCH_MATH_KP			0.1f // Gains of the control law benchmark
+#define SIM_BENCH_MATH_KI			0.5f
+#define SIM_BENCH_MATH_KD			0.0f
+#define SIM_BENCH_MATH_MAX_SPEED_ERROR_RPM	0.1 // Largest speed estimate difference from the double precision law
+#define SIM_BENCH_MATH_MAX_DUTY_ERROR_PCT	2.0 // Largest duty cycle difference from the double precision law
+#define SIM_BENCH_LINE_BYTES		65536 // Bytes per stream fed through the UART reception path by the line benchmark
+#define SIM_BENCH_LINE_BURST		96 // Longest burst of back-to-back bytes before the line goes idle
+#define SIM_BENCH_LINE_SEED			1 // Seed of the line generator of the line benchmark
+#define SIM_BENCH_FRAME_COUNT		100000 // Random frames looped back through the framing by the frame benchmark
+#define SIM_BENCH_FRAME_MAX_LEN		600 // Longest random frame, past two full COBS blocks (bytes, including the CRC)
+#define SIM_BENCH_FRAME_SEED		1 // Seed of the frame generator of the frame benchmark
+#define SIM_BENCH_RATE_DUTIES		"40,70,100" // Duty cycles the rate benchmark holds the motor at (%)
+#define SIM_BENCH_RATE_STEP_MS		1000 // Simulated time per duty cycle
+#define SIM_BENCH_RATE_MAX_ERROR_COUNTS	1.05 // Largest speed estimate difference from the window mean plant speed (counts)
+
+// Run control
+#define SIM_RUN_MS_ENV				"SIM_RUN_MS" // Exit after this many milliseconds of kernel time, run forever if unset
+
+#endif /* CONFIG_SIM_H_ */
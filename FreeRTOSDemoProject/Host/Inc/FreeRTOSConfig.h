@@ -0,0 +1,97 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       FreeRTOSConfig.h                                                          |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    Kernel configuration for the host build on the FreeRTOS POSIX port. Task           |
+|    priorities, tick rate and the API selection follow `Core/Inc/FreeRTOSConfig.h`;    |
+|    the Cortex-M interrupt settings and the SystemView trace hooks are left out.       |
+\*=====================================================================================*/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+#include <limits.h>
+
+extern uint32_t SystemCoreClock;
+void vAssertCalled(const char *file, unsigned long line);
+void stats_clock_init(void);
+uint32_t stats_run_time(void);
+void stats_task_switched_out(uint32_t task_number);
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define configUSE_PREEMPTION			1
+#define configUSE_IDLE_HOOK				0
+#define configUSE_TICK_HOOK				0
+#define configCPU_CLOCK_HZ				( SystemCoreClock )
+#define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES			( 5 )
+#define configMINIMAL_STACK_SIZE		( ( unsigned short ) 16384 ) // Each task runs on a pthread; PTHREAD_STACK_MIN may not be a constant expression, as static stacks need
+#define configSUPPORT_STATIC_ALLOCATION	1 // The application tasks and kernel objects, see Config_Resources.h
+#define configSUPPORT_DYNAMIC_ALLOCATION	1 // The simulated interrupt task of SimIrq.c
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 1024 * 1024 ) ) // Holds the pthread sized stack of the simulated interrupt task
+#define configMAX_TASK_NAME_LEN			( 10 )
+#define configUSE_TRACE_FACILITY		1
+#define configUSE_16_BIT_TICKS			0
+#define configIDLE_SHOULD_YIELD			1
+#define configUSE_MUTEXES				1
+#define configQUEUE_REGISTRY_SIZE		8
+#define configCHECK_FOR_STACK_OVERFLOW	0 // Not supported by the POSIX port
+#define configUSE_RECURSIVE_MUTEXES		1
+#define configUSE_MALLOC_FAILED_HOOK	1
+#define configUSE_APPLICATION_TASK_TAG	0
+#define configUSE_COUNTING_SEMAPHORES	1
+#define configGENERATE_RUN_TIME_STATS	1
+
+/* Run time statistics, counted in DWT cycles by the StatsManager module. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	stats_clock_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()			stats_run_time()
+#define traceTASK_SWITCHED_OUT()					stats_task_switched_out( pxCurrentTCB->uxTCBNumber )
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 		0
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		( 2 )
+#define configTIMER_QUEUE_LENGTH		10
+#define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
+
+/* Task stacks of Config_Resources.h, scaled from their target depth so that
+the 130 word target minimum becomes configMINIMAL_STACK_SIZE. The POSIX port
+ignores a stack smaller than PTHREAD_STACK_MIN and runs the task on a stack of
+its own, which the Mem command does not see. */
+#define RESOURCE_STACK_DEPTH( depth )	( ( depth ) * configMINIMAL_STACK_SIZE / 130 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet		1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskCleanUpResources	1
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_vTaskDelayUntil			1
+#define INCLUDE_vTaskDelay				1
+
+#define INCLUDE_xTaskGetIdleTaskHandle  1
+#define INCLUDE_pxTaskGetStackStart		1
+
+#define INCLUDE_xTaskGetHandle 1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle 1
+#define INCLUDE_xTaskGetCurrentTaskHandle 1 // Used by the POSIX port to find the running thread
+
+/* A failed assertion prints its location and aborts the process. */
+#define configASSERT( x ) if( ( x ) == 0 ) { vAssertCalled( __FILE__, __LINE__ ); }
+
+#endif /* FREERTOS_CONFIG_H */
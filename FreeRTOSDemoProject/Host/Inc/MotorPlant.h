@@ -0,0 +1,43 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       MotorPlant.h                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` motor plant models the DC gear motor behind the L298N bridge:        |
+|    a first-order armature circuit, a first-order shaft with viscous and Coulomb       |
+|    friction, and the gearbox, with the encoder position in MotorManager counts.       |
+\*=====================================================================================*/
+
+#ifndef MOTORPLANT_H_
+#define MOTORPLANT_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Typedefs                                        *
+ ****************************************************/
+
+// Motor state, all on the motor side of the gearbox
+typedef struct
+{
+	double current;		// Armature current (A)
+	double speed;		// Shaft speed (rad/s)
+	double angle;		// Shaft angle (rad)
+} motor_plant_t;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void motor_plant_init(motor_plant_t *plant);
+void motor_plant_run(motor_plant_t *plant, double volts, double seconds);
+int32_t motor_plant_encoder_count(const motor_plant_t *plant);
+double motor_plant_output_rpm(const motor_plant_t *plant);
+
+#endif /* MOTORPLANT_H_ */
@@ -0,0 +1,110 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       SimHal.h                                                                  |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` layer replaces the STM32 HAL with RAM-backed peripherals so the      |
+|    application can run on the FreeRTOS POSIX port. Peripheral events are raised       |
+|    from a simulated interrupt task, paced by the host kernel tick.                    |
+\*=====================================================================================*/
+
+#ifndef SIMHAL_H_
+#define SIMHAL_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include <stdint.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Peripheral register blocks, held in RAM instead of the memory mapped addresses
+extern GPIO_TypeDef sim_gpioa, sim_gpiob, sim_gpioc, sim_gpiod, sim_gpioe, sim_gpioh;
+extern TIM_TypeDef sim_tim1, sim_tim2, sim_tim3, sim_tim6, sim_tim7;
+extern SPI_TypeDef sim_spi1;
+extern USART_TypeDef sim_usart2;
+extern RTC_TypeDef sim_rtc;
+extern RCC_TypeDef sim_rcc;
+extern PWR_TypeDef sim_pwr;
+extern FLASH_TypeDef sim_flash;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+void sim_init(void);
+void sim_irq_task(void *param);
+void sim_halt(void);
+DWT_Type *sim_dwt(void);
+uint32_t sim_timer_clock(const TIM_TypeDef *tim);
+void sim_timer_tick(void);
+void sim_gpio_set_input(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+void sim_motor_run(uint32_t us);
+void sim_motor_reset(void);
+double sim_motor_rpm(void);
+void sim_uart_start(void);
+void sim_uart_tick(void);
+void sim_spi_tick(void);
+void sim_rtt_close(void);
+
+// SEGGER SystemView is not part of the host build, only its start-up calls are kept
+void SEGGER_SYSVIEW_Conf(void);
+void SEGGER_SYSVIEW_Start(void);
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+// Peripheral instances
+#undef GPIOA
+#undef GPIOB
+#undef GPIOC
+#undef GPIOD
+#undef GPIOE
+#undef GPIOH
+#undef TIM1
+#undef TIM2
+#undef TIM3
+#undef TIM6
+#undef TIM7
+#undef SPI1
+#undef USART2
+#undef RTC
+#undef RCC
+#undef PWR
+#undef FLASH
+#undef DWT
+
+#define GPIOA						( &sim_gpioa )
+#define GPIOB						( &sim_gpiob )
+#define GPIOC						( &sim_gpioc )
+#define GPIOD						( &sim_gpiod )
+#define GPIOE						( &sim_gpioe )
+#define GPIOH						( &sim_gpioh )
+#define TIM1						( &sim_tim1 )
+#define TIM2						( &sim_tim2 )
+#define TIM3						( &sim_tim3 )
+#define TIM6						( &sim_tim6 )
+#define TIM7						( &sim_tim7 )
+#define SPI1						( &sim_spi1 )
+#define USART2						( &sim_usart2 )
+#define RTC							( &sim_rtc )
+#define RCC							( &sim_rcc )
+#define PWR							( &sim_pwr )
+#define FLASH						( &sim_flash )
+#define DWT							( sim_dwt() ) // CYCCNT follows the host monotonic clock scaled to SystemCoreClock
+
+// Cortex-M intrinsics used by the application
+#define __DMB()						__sync_synchronize()
+#define __DSB()						__sync_synchronize()
+#define __ISB()						__sync_synchronize()
+#define __disable_irq()				sim_halt() // Only reached from Error_Handler, which then spins forever
+#define __get_PRIMASK()				( 0U ) // Simulated interrupts all run in one task and never nest
+#define __set_PRIMASK(x)			( (void)(x) )
+
+#endif /* SIMHAL_H_ */
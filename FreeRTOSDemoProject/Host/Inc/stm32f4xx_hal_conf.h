@@ -0,0 +1,23 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       stm32f4xx_hal_conf.h                                                      |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    Host build replacement for `Core/Inc/stm32f4xx_hal_conf.h`. It keeps the HAL       |
+|    module selection and types of the board configuration, then maps the peripheral    |
+|    instances onto the RAM register blocks of the simulated HAL.                       |
+\*=====================================================================================*/
+
+#ifndef SIM_STM32F4XX_HAL_CONF_H_
+#define SIM_STM32F4XX_HAL_CONF_H_
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "../../Core/Inc/stm32f4xx_hal_conf.h"
+#include "SimHal.h"
+
+#endif /* SIM_STM32F4XX_HAL_CONF_H_ */
@@ -0,0 +1,132 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       MotorPlant.c                                                              |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` motor plant models the DC gear motor behind the L298N bridge:        |
+|    a first-order armature circuit, a first-order shaft with viscous and Coulomb       |
+|    friction, and the gearbox, with the encoder position in MotorManager counts.       |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "MotorPlant.h"
+#include "Config_MotorManager.h"
+#include "Config_Sim.h"
+#include <math.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void motor_plant_step(motor_plant_t *plant, double volts, double step);
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Puts the motor at rest, with no current and the shaft at angle zero.                         *
+ *                                                                                                     *
+ * @param plant [motor_plant_t*] Motor state.                                                          *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void motor_plant_init(motor_plant_t *plant)
+{
+	plant->current = 0.0;
+	plant->speed = 0.0;
+	plant->angle = 0.0;
+}
+
+/*******************************************************************************************************
+ * @brief Advances the motor by a time interval.                                                       *
+ *                                                                                                     *
+ * The interval is split into equal steps of at most `SIM_MOTOR_STEP_US`. The terminal voltage is held *
+ * for the whole interval, so callers pass the bridge output averaged over the PWM period.             *
+ *                                                                                                     *
+ * @param plant [motor_plant_t*] Motor state.                                                          *
+ * @param volts [double] Average voltage across the motor terminals (V), positive to turn forward.     *
+ * @param seconds [double] Interval to simulate (s).                                                   *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void motor_plant_run(motor_plant_t *plant, double volts, double seconds)
+{
+	uint32_t steps = (uint32_t)ceil(seconds / (SIM_MOTOR_STEP_US * 1e-6));
+
+	for(uint32_t i = 0; i < steps; i++) {
+		motor_plant_step(plant, volts, seconds / steps);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Returns the encoder position.                                                                *
+ *                                                                                                     *
+ * @param plant [motor_plant_t*] Motor state.                                                          *
+ * @return int32_t Position in the counts decoded by MotorManager, `ENCODER_COUNTS_PER_REV` times      *
+ *         `ENCODER_QUADRATURE` per output shaft revolution.                                           *
+ ******************************************************************************************************/
+
+int32_t motor_plant_encoder_count(const motor_plant_t *plant)
+{
+	return (int32_t)floor(plant->angle * SIM_MOTOR_EDGES_PER_REV / (2.0 * M_PI));
+}
+
+/*******************************************************************************************************
+ * @brief Returns the speed of the gearbox output shaft.                                               *
+ *                                                                                                     *
+ * @param plant [motor_plant_t*] Motor state.                                                          *
+ * @return double Output shaft speed (RPM), the quantity MotorManager regulates.                       *
+ ******************************************************************************************************/
+
+double motor_plant_output_rpm(const motor_plant_t *plant)
+{
+	return plant->speed * 60.0 / (2.0 * M_PI * GEAR_RATIO);
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Advances the motor by one integration step.                                                  *
+ *                                                                                                     *
+ * The armature current and shaft speed are integrated with semi-implicit Euler, which is stable at    *
+ * the step size used here. Coulomb friction holds a stopped shaft until the motor torque exceeds it,  *
+ * and stops a turning shaft rather than reversing it.                                                 *
+ *                                                                                                     *
+ * @param plant [motor_plant_t*] Motor state.                                                          *
+ * @param volts [double] Voltage across the motor terminals (V).                                       *
+ * @param step [double] Integration step (s).                                                          *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void motor_plant_step(motor_plant_t *plant, double volts, double step)
+{
+	// Armature: L di/dt = V - R i - Ke w
+	plant->current += step * (volts - SIM_MOTOR_R_OHM * plant->current - SIM_MOTOR_KE * plant->speed) / SIM_MOTOR_L_H;
+
+	// Shaft: J dw/dt = Kt i - B w - friction - load reflected through the gearbox
+	double drive = SIM_MOTOR_KE * plant->current - SIM_MOTOR_B * plant->speed - SIM_MOTOR_LOAD_NM / GEAR_RATIO;
+
+	// A stopped shaft stays put until the drive torque overcomes friction
+	if((0.0 == plant->speed) && (fabs(drive) <= SIM_MOTOR_FRICTION_NM)) {
+		return;
+	}
+
+	double direction = (0.0 != plant->speed) ? plant->speed : drive;
+	double speed = plant->speed + step * (drive - copysign(SIM_MOTOR_FRICTION_NM, direction)) / SIM_MOTOR_J;
+
+	// Friction can stop the shaft but not turn it the other way
+	if((speed * plant->speed < 0.0) && (fabs(drive) <= SIM_MOTOR_FRICTION_NM)) {
+		speed = 0.0;
+	}
+
+	plant->speed = speed;
+	plant->angle += step * speed;
+}
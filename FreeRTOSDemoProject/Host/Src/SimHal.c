@@ -0,0 +1,1283 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       SimHal.c                                                                  |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` layer replaces the STM32 HAL with RAM-backed peripherals so the      |
+|    application can run on the FreeRTOS POSIX port. This file implements the HAL       |
+|    calls used by the application for the clock tree, GPIO/EXTI, NVIC, SPI, RTC        |
+|    and timers; UART reception and transmission live in `SimUart.c`.                   |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_Sim.h"
+#include "StatsManager.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/****************************************************
+ *  Macros                                          *
+ ****************************************************/
+
+#define SIM_MAX_TIMERS				8 // Timers that can be started with HAL_TIM_Base_Start_IT
+#define SIM_ACC_REG_COUNT			128 // Register file of the simulated accelerometer
+#define SIM_ACC_REG_WHO_AM_I		0x0F // Identification register of both sensors
+#define SIM_LIS3DSH_WHO_AM_I		0x3F
+#define SIM_LIS3DSH_CTRL4			0x20 // Output data rate in bits 7:4
+#define SIM_LIS3DSH_CTRL3			0x23 // DR_EN (0x80) and INT1_EN (0x08)
+#define SIM_LIS3DSH_CTRL5			0x24 // Full scale in bits 5:3
+#define SIM_LIS3DSH_CTRL6			0x25 // FIFO_EN (0x40), ADD_INC (0x10) and P1_WTM (0x04)
+#define SIM_LIS3DSH_OUT_X_L			0x28 // First output register, followed by X_H, Y_L, Y_H, Z_L, Z_H
+#define SIM_LIS3DSH_FIFO_CTRL		0x2E // FIFO mode in bits 7:5, watermark in bits 4:0
+#define SIM_LIS3DSH_FIFO_DEPTH		32
+#define SIM_LIS302DL_WHO_AM_I		0x3B
+#define SIM_LIS302DL_CTRL1			0x20 // DR (0x80), PD (0x40) and FS (0x20)
+#define SIM_LIS302DL_CTRL3			0x22 // INT1 source in bits 2:0, 4 is data-ready
+#define SIM_LIS302DL_OUT_X			0x29 // X, followed by an unused register, Y, an unused register and Z
+#define SIM_RTC_EPOCH_2000			946684800 // 2000-01-01 00:00:00 UTC, the RTC reset value
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static uint32_t apb_divider(uint32_t ppre);
+static uint32_t ahb_divider(uint32_t hpre);
+static IRQn_Type exti_irqn(uint32_t line);
+static uint32_t spi_acc_odr(void);
+static int spi_acc_fifo_on(void);
+static uint8_t spi_acc_read_byte(void);
+static void spi_acc_sample(void);
+static void spi_acc_update_int1(void);
+static void spi_dma_complete(void);
+static time_t rtc_now(void);
+static void rtc_set(time_t seconds);
+static uint8_t to_bcd(uint8_t value);
+static uint8_t from_bcd(uint8_t value);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Peripheral register blocks
+GPIO_TypeDef sim_gpioa, sim_gpiob, sim_gpioc, sim_gpiod, sim_gpioe, sim_gpioh;
+TIM_TypeDef sim_tim1, sim_tim2, sim_tim3, sim_tim6, sim_tim7;
+SPI_TypeDef sim_spi1;
+USART_TypeDef sim_usart2;
+RTC_TypeDef sim_rtc;
+RCC_TypeDef sim_rcc;
+PWR_TypeDef sim_pwr;
+FLASH_TypeDef sim_flash;
+static DWT_Type sim_dwt_regs;
+
+// Clock tree
+uint32_t SystemCoreClock = SIM_RESET_CLOCK_HZ;
+static uint32_t sim_pll_clock = SIM_HSI_VALUE;
+static uint32_t sim_sysclk = SIM_HSI_VALUE;
+volatile uint32_t uwTick;
+
+// NVIC and EXTI
+static uint32_t sim_nvic_enabled[(FPU_IRQn / 32) + 1];
+static GPIO_TypeDef *sim_exti_port[16];
+static uint16_t sim_exti_rising;
+static uint16_t sim_exti_falling;
+
+// Timers started in interrupt mode and their timer clock accumulators
+static TIM_HandleTypeDef *sim_timers[SIM_MAX_TIMERS];
+static uint64_t sim_timer_acc[SIM_MAX_TIMERS];
+static uint32_t sim_timer_count = 0;
+
+// Accelerometer behind SPI1, a LIS3DSH unless the LIS302DL is selected
+static uint8_t sim_acc_lis302dl = 0;
+static uint8_t sim_acc_regs[SIM_ACC_REG_COUNT];
+static uint8_t sim_acc_addr = 0;
+static uint8_t sim_acc_addressed = 0;
+static uint8_t sim_acc_increment = 0;		// Address increments after each byte of the transaction
+static uint8_t sim_acc_drdy = 0;			// Set when a new sample is loaded, cleared when it is read
+static uint32_t sim_acc_odr_acc = 0;		// Output data rate accumulator, in mHz ticks
+static int16_t sim_acc_fifo[SIM_LIS3DSH_FIFO_DEPTH][3];
+static uint32_t sim_acc_fifo_head = 0;		// Oldest sample in the FIFO
+static uint32_t sim_acc_fifo_count = 0;
+
+// SPI DMA transfer in flight, completed right after the INT1 edge that started it
+static SPI_HandleTypeDef *sim_spi_dma = NULL;
+static uint8_t *sim_spi_dma_tx;
+static uint8_t *sim_spi_dma_rx;
+static uint16_t sim_spi_dma_size;
+
+// RTC, counting host seconds from the last time it was set
+static time_t sim_rtc_base = SIM_RTC_EPOCH_2000;
+static time_t sim_rtc_ref = 0;
+static uint8_t sim_rtc_weekday = RTC_WEEKDAY_MONDAY;
+static time_t sim_rtc_weekday_day = SIM_RTC_EPOCH_2000 / 86400;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Initializes the simulated HAL.                                                               *
+ *                                                                                                     *
+ * This function replaces the HAL start-up: it starts the host UART threads and creates the simulated  *
+ * interrupt task, which raises timer and UART events once the scheduler runs.                         *
+ *                                                                                                     *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+	sim_init();
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Advances the HAL millisecond tick.                                                           *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_IncTick(void)
+{
+	uwTick++;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the HAL millisecond tick.                                                            *
+ *                                                                                                     *
+ * @return uint32_t Milliseconds counted by `HAL_IncTick`.                                             *
+ ******************************************************************************************************/
+
+uint32_t HAL_GetTick(void)
+{
+	return uwTick;
+}
+
+/*******************************************************************************************************
+ * @brief Applies the oscillator and PLL configuration.                                                *
+ *                                                                                                     *
+ * Only the PLL output frequency is modelled; it becomes the system clock when `HAL_RCC_ClockConfig`   *
+ * selects the PLL.                                                                                    *
+ *                                                                                                     *
+ * @param osc [RCC_OscInitTypeDef*] Oscillator configuration, as filled by `SystemClock_Config`.       *
+ * @return HAL_StatusTypeDef `HAL_OK`, or `HAL_ERROR` if the PLL dividers are invalid.                 *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *osc)
+{
+	uint32_t source = (RCC_PLLSOURCE_HSE == osc->PLL.PLLSource) ? HSE_VALUE : SIM_HSI_VALUE;
+
+	if(RCC_PLL_ON != osc->PLL.PLLState) {
+		return HAL_OK;
+	}
+	if((0 == osc->PLL.PLLM) || (0 == osc->PLL.PLLP)) {
+		return HAL_ERROR;
+	}
+
+	sim_pll_clock = (uint32_t)(((uint64_t)source / osc->PLL.PLLM) * osc->PLL.PLLN / osc->PLL.PLLP);
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Selects the system clock and the bus prescalers.                                             *
+ *                                                                                                     *
+ * The prescalers are written to `RCC->CFGR` the same way as on the target, so code that reads the APB1*
+ * prescaler back (for example to find the TIM7 clock) sees the configured value. Only the clocks      *
+ * selected by `ClockType` change, and the flash latency lands in `FLASH->ACR`, which has no timing    *
+ * effect on the host.                                                                                 *
+ *                                                                                                     *
+ * @param clk [RCC_ClkInitTypeDef*] Bus clock configuration.                                           *
+ * @param latency [uint32_t] Flash latency, stored in `FLASH->ACR`.                                    *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *clk, uint32_t latency)
+{
+	MODIFY_REG(FLASH->ACR, FLASH_ACR_LATENCY, latency);
+
+	if(clk->ClockType & RCC_CLOCKTYPE_HCLK) {
+		MODIFY_REG(RCC->CFGR, RCC_CFGR_HPRE, clk->AHBCLKDivider);
+	}
+	if(clk->ClockType & RCC_CLOCKTYPE_PCLK1) {
+		MODIFY_REG(RCC->CFGR, RCC_CFGR_PPRE1, clk->APB1CLKDivider);
+	}
+	if(clk->ClockType & RCC_CLOCKTYPE_PCLK2) {
+		MODIFY_REG(RCC->CFGR, RCC_CFGR_PPRE2, clk->APB2CLKDivider << 3);
+	}
+	if(clk->ClockType & RCC_CLOCKTYPE_SYSCLK) {
+		sim_sysclk = (RCC_SYSCLKSOURCE_PLLCLK == clk->SYSCLKSource) ? sim_pll_clock : SIM_HSI_VALUE;
+	}
+	SystemCoreClock = sim_sysclk / ahb_divider(RCC->CFGR & RCC_CFGR_HPRE);
+
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the APB1 peripheral clock.                                                           *
+ *                                                                                                     *
+ * @return uint32_t PCLK1 in Hz.                                                                       *
+ ******************************************************************************************************/
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return SystemCoreClock / apb_divider((RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the APB2 peripheral clock.                                                           *
+ *                                                                                                     *
+ * @return uint32_t PCLK2 in Hz.                                                                       *
+ ******************************************************************************************************/
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return SystemCoreClock / apb_divider((RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the clock of a simulated timer.                                                      *
+ *                                                                                                     *
+ * APB timers run at twice the bus clock whenever the bus prescaler is not 1, as on the target.        *
+ *                                                                                                     *
+ * @param tim [TIM_TypeDef*] Timer instance.                                                           *
+ * @return uint32_t Timer kernel clock in Hz.                                                          *
+ ******************************************************************************************************/
+
+uint32_t sim_timer_clock(const TIM_TypeDef *tim)
+{
+	uint32_t ppre;
+	uint32_t pclk;
+
+	// TIM1 is on APB2, the other simulated timers on APB1
+	if(TIM1 == tim) {
+		ppre = (RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos;
+		pclk = HAL_RCC_GetPCLK2Freq();
+	}
+	else {
+		ppre = (RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+		pclk = HAL_RCC_GetPCLK1Freq();
+	}
+
+	return (apb_divider(ppre) == 1) ? pclk : (2 * pclk);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the DWT registers with an up to date cycle counter.                                  *
+ *                                                                                                     *
+ * While `DWT_CTRL_CYCCNTENA` is set, `CYCCNT` follows the host monotonic clock scaled to              *
+ * `SystemCoreClock`, so cycle based measurements report host execution time in target cycles.         *
+ *                                                                                                     *
+ * @return DWT_Type* Simulated DWT register block.                                                     *
+ ******************************************************************************************************/
+
+DWT_Type *sim_dwt(void)
+{
+	struct timespec now;
+
+	if(sim_dwt_regs.CTRL & DWT_CTRL_CYCCNTENA_Msk) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		sim_dwt_regs.CYCCNT = (uint32_t)(((uint64_t)now.tv_sec * SystemCoreClock) +
+										 (((uint64_t)now.tv_nsec * SystemCoreClock) / 1000000000ULL));
+	}
+
+	return &sim_dwt_regs;
+}
+
+/*******************************************************************************************************
+ * @brief Configures GPIO pins.                                                                        *
+ *                                                                                                     *
+ * The pin mode is stored in `MODER`. Pins in external interrupt mode are routed to their EXTI line    *
+ * with the requested edges, so `sim_gpio_set_input` can raise `HAL_GPIO_EXTI_Callback`.               *
+ *                                                                                                     *
+ * @param port [GPIO_TypeDef*] GPIO port.                                                              *
+ * @param init [GPIO_InitTypeDef*] Pin mask and mode.                                                  *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init)
+{
+	for(uint32_t line = 0; line < 16; line++) {
+		uint32_t pin = 1U << line;
+
+		if(0 == (init->Pin & pin)) {
+			continue;
+		}
+
+		port->MODER = (port->MODER & ~(GPIO_MODER_MODER0 << (line * 2))) | ((init->Mode & GPIO_MODE) << (line * 2));
+
+		if(init->Mode & EXTI_IT) {
+			sim_exti_port[line] = port;
+			sim_exti_rising = (init->Mode & TRIGGER_RISING) ? (sim_exti_rising | pin) : (sim_exti_rising & ~pin);
+			sim_exti_falling = (init->Mode & TRIGGER_FALLING) ? (sim_exti_falling | pin) : (sim_exti_falling & ~pin);
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sets or clears output pins.                                                                  *
+ *                                                                                                     *
+ * Outputs read back through `IDR`, as on the target. Toggling the accelerometer chip select ends the  *
+ * current SPI transaction.                                                                            *
+ *                                                                                                     *
+ * @param port [GPIO_TypeDef*] GPIO port.                                                              *
+ * @param pin [uint16_t] Pin mask.                                                                     *
+ * @param state [GPIO_PinState] Level to drive.                                                        *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+	if(GPIO_PIN_RESET != state) {
+		port->ODR |= pin;
+		port->IDR |= pin;
+	}
+	else {
+		port->ODR &= ~(uint32_t)pin;
+		port->IDR &= ~(uint32_t)pin;
+	}
+
+	if((CS_I2C_SPI_GPIO_Port == port) && (CS_I2C_SPI_Pin & pin)) {
+		sim_acc_addressed = 0;
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Toggles output pins.                                                                         *
+ *                                                                                                     *
+ * @param port [GPIO_TypeDef*] GPIO port.                                                              *
+ * @param pin [uint16_t] Pin mask.                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *port, uint16_t pin)
+{
+	port->ODR ^= pin;
+	port->IDR = (port->IDR & ~(uint32_t)pin) | (port->ODR & pin);
+}
+
+/*******************************************************************************************************
+ * @brief Reads an input pin.                                                                          *
+ *                                                                                                     *
+ * @param port [GPIO_TypeDef*] GPIO port.                                                              *
+ * @param pin [uint16_t] Pin mask.                                                                     *
+ * @return GPIO_PinState `GPIO_PIN_SET` if any selected pin is high.                                   *
+ ******************************************************************************************************/
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin)
+{
+	return (port->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/*******************************************************************************************************
+ * @brief Drives an input pin from the simulation.                                                     *
+ *                                                                                                     *
+ * This function updates `IDR` and, if the pin is routed to an enabled EXTI line with a matching edge, *
+ * calls `HAL_GPIO_EXTI_Callback` in the same way as the EXTI interrupt handler on the target.         *
+ *                                                                                                     *
+ * @param port [GPIO_TypeDef*] GPIO port.                                                              *
+ * @param pin [uint16_t] Single pin.                                                                   *
+ * @param state [GPIO_PinState] New input level.                                                       *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must only be called from the simulated interrupt task.                                        *
+ ******************************************************************************************************/
+
+void sim_gpio_set_input(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+	uint32_t line = (uint32_t)__builtin_ctz(pin);
+	uint8_t was_set = (port->IDR & pin) ? 1 : 0;
+	uint8_t is_set = (GPIO_PIN_RESET != state) ? 1 : 0;
+	IRQn_Type irqn = exti_irqn(line);
+
+	if(is_set) {
+		port->IDR |= pin;
+	}
+	else {
+		port->IDR &= ~(uint32_t)pin;
+	}
+
+	// Only an edge on the port routed to the EXTI line raises the interrupt
+	if((was_set == is_set) || (sim_exti_port[line] != port)) {
+		return;
+	}
+	if(0 == (sim_nvic_enabled[irqn / 32] & (1UL << (irqn % 32)))) {
+		return;
+	}
+	if((is_set && (sim_exti_rising & pin)) || (!is_set && (sim_exti_falling & pin))) {
+		stats_isr_t isr = STATS_ISR_COUNT;
+		if(EXTI0_IRQn == irqn) {
+			isr = STATS_ISR_EXTI0;
+		}
+		else if((EXTI4_IRQn == irqn) || (EXTI9_5_IRQn == irqn)) {
+			isr = (EXTI4_IRQn == irqn) ? STATS_ISR_EXTI4 : STATS_ISR_EXTI9_5;
+		}
+
+		if(STATS_ISR_COUNT != isr) {
+			stats_isr_enter(isr);
+			HAL_GPIO_EXTI_Callback(pin);
+			stats_isr_exit(isr);
+		}
+		else {
+			HAL_GPIO_EXTI_Callback(pin);
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Sets an interrupt priority. Priorities are not modelled on the host.                         *
+ *                                                                                                     *
+ * @param irqn [IRQn_Type] Interrupt number.                                                           *
+ * @param preempt [uint32_t] Preemption priority.                                                      *
+ * @param sub [uint32_t] Sub-priority.                                                                 *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_NVIC_SetPriority(IRQn_Type irqn, uint32_t preempt, uint32_t sub)
+{
+	(void)irqn;
+	(void)preempt;
+	(void)sub;
+}
+
+/*******************************************************************************************************
+ * @brief Enables an interrupt.                                                                        *
+ *                                                                                                     *
+ * @param irqn [IRQn_Type] Interrupt number.                                                           *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irqn)
+{
+	sim_nvic_enabled[irqn / 32] |= (1UL << (irqn % 32));
+}
+
+/*******************************************************************************************************
+ * @brief Disables an interrupt.                                                                       *
+ *                                                                                                     *
+ * @param irqn [IRQn_Type] Interrupt number.                                                           *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_NVIC_DisableIRQ(IRQn_Type irqn)
+{
+	sim_nvic_enabled[irqn / 32] &= ~(1UL << (irqn % 32));
+}
+
+/*******************************************************************************************************
+ * @brief Initializes the SPI peripheral and the accelerometer behind it.                              *
+ *                                                                                                     *
+ * The accelerometer is a LIS3DSH, as on current boards, or a LIS302DL, as on MB997B boards, when      *
+ * `SIM_ACC_ENV` is set to `LIS302DL`. Its registers hold their reset values.                          *
+ *                                                                                                     *
+ * @param hspi [SPI_HandleTypeDef*] SPI handle.                                                        *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+	const char *model = getenv(SIM_ACC_ENV);
+
+	sim_acc_lis302dl = ((NULL != model) && (0 == strcmp(model, "LIS302DL"))) ? 1 : 0;
+	memset(sim_acc_regs, 0, sizeof(sim_acc_regs));
+	if(sim_acc_lis302dl) {
+		sim_acc_regs[SIM_ACC_REG_WHO_AM_I] = SIM_LIS302DL_WHO_AM_I;
+		sim_acc_regs[SIM_LIS302DL_CTRL1] = 0x07;
+	}
+	else {
+		sim_acc_regs[SIM_ACC_REG_WHO_AM_I] = SIM_LIS3DSH_WHO_AM_I;
+		sim_acc_regs[SIM_LIS3DSH_CTRL4] = 0x07;
+		sim_acc_regs[SIM_LIS3DSH_CTRL6] = 0x10;
+	}
+
+	hspi->State = HAL_SPI_STATE_READY;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Sends bytes to the simulated accelerometer.                                                  *
+ *                                                                                                     *
+ * The first byte after chip select is the register address; the following bytes are written to        *
+ * consecutive registers if address increment is enabled (the MS bit of the address byte on the        *
+ * LIS302DL, ADD_INC on the LIS3DSH). Setting the LIS3DSH FIFO to bypass mode empties it.              *
+ *                                                                                                     *
+ * @param hspi [SPI_HandleTypeDef*] SPI handle.                                                        *
+ * @param data [uint8_t*] Bytes to send.                                                               *
+ * @param size [uint16_t] Number of bytes.                                                             *
+ * @param timeout [uint32_t] Ignored, the transfer completes immediately.                              *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+	(void)hspi;
+	(void)timeout;
+
+	for(uint16_t i = 0; i < size; i++) {
+		if(!sim_acc_addressed) {
+			sim_acc_addr = data[i] & (sim_acc_lis302dl ? 0x3F : 0x7F);
+			sim_acc_increment = sim_acc_lis302dl ? (data[i] & 0x40) : (sim_acc_regs[SIM_LIS3DSH_CTRL6] & 0x10);
+			sim_acc_addressed = 1;
+			continue;
+		}
+
+		sim_acc_regs[sim_acc_addr] = data[i];
+		if(!sim_acc_lis302dl && (SIM_LIS3DSH_FIFO_CTRL == sim_acc_addr) && (0 == (data[i] & 0xE0))) {
+			sim_acc_fifo_count = 0;
+		}
+		if(sim_acc_increment) {
+			sim_acc_addr = (sim_acc_addr + 1) % SIM_ACC_REG_COUNT;
+		}
+	}
+
+	spi_acc_update_int1();
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Reads bytes from the simulated accelerometer.                                                *
+ *                                                                                                     *
+ * Consecutive registers are read from the address sent last, see `spi_acc_read_byte`. INT1 follows    *
+ * the samples left unread.                                                                            *
+ *                                                                                                     *
+ * @param hspi [SPI_HandleTypeDef*] SPI handle.                                                        *
+ * @param data [uint8_t*] Buffer for the received bytes.                                               *
+ * @param size [uint16_t] Number of bytes.                                                             *
+ * @param timeout [uint32_t] Ignored, the transfer completes immediately.                              *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+	(void)hspi;
+	(void)timeout;
+
+	for(uint16_t i = 0; i < size; i++) {
+		data[i] = spi_acc_read_byte();
+	}
+
+	spi_acc_update_int1();
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Starts a full duplex SPI DMA transfer with the simulated accelerometer.                      *
+ *                                                                                                     *
+ * The transfer completes in `sim_spi_tick`, right after the INT1 edge that started it, by             *
+ * calling `HAL_SPI_TxRxCpltCallback` as the DMA interrupt handler does on the target.                 *
+ *                                                                                                     *
+ * @param hspi [SPI_HandleTypeDef*] SPI handle.                                                        *
+ * @param tx [uint8_t*] Bytes to send, the register address first.                                     *
+ * @param rx [uint8_t*] Buffer for the received bytes.                                                 *
+ * @param size [uint16_t] Number of bytes in each direction.                                           *
+ * @return HAL_StatusTypeDef `HAL_BUSY` if a transfer is in progress, `HAL_OK` otherwise.              *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+	if(HAL_SPI_STATE_READY != hspi->State) {
+		return HAL_BUSY;
+	}
+
+	hspi->State = HAL_SPI_STATE_BUSY_TX_RX;
+	sim_spi_dma = hspi;
+	sim_spi_dma_tx = tx;
+	sim_spi_dma_rx = rx;
+	sim_spi_dma_size = size;
+
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Acquires the samples of the simulated accelerometer for one tick.                            *
+ *                                                                                                     *
+ * While the sensor is powered, new samples arrive at the output data rate, so several samples are     *
+ * acquired per tick above 1 kHz. After each sample, INT1 is updated and the SPI DMA reads started by  *
+ * its rising edge complete, including the reads started by the completions themselves.                *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must only be called from the simulated interrupt task.                                        *
+ ******************************************************************************************************/
+
+void sim_spi_tick(void)
+{
+	const uint32_t period = 1000U * configTICK_RATE_HZ;
+	uint32_t odr_mhz = spi_acc_odr();
+
+	if(0 == odr_mhz) {
+		sim_acc_odr_acc = 0;
+		return;
+	}
+
+	sim_acc_odr_acc += odr_mhz;
+	while(sim_acc_odr_acc >= period) {
+		sim_acc_odr_acc -= period;
+		spi_acc_sample();
+		spi_acc_update_int1();
+		while(NULL != sim_spi_dma) {
+			spi_dma_complete();
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Initializes the RTC to its reset value, 2000-01-01 00:00:00 with week day 1.                 *
+ *                                                                                                     *
+ * @param hrtc [RTC_HandleTypeDef*] RTC handle.                                                        *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc)
+{
+	rtc_set(SIM_RTC_EPOCH_2000);
+	sim_rtc_weekday = RTC_WEEKDAY_MONDAY;
+	sim_rtc_weekday_day = SIM_RTC_EPOCH_2000 / 86400;
+	hrtc->State = HAL_RTC_STATE_READY;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Sets the RTC time, keeping the current date.                                                 *
+ *                                                                                                     *
+ * @param hrtc [RTC_HandleTypeDef*] RTC handle.                                                        *
+ * @param time [RTC_TimeTypeDef*] New time, in 12 or 24 hour format as configured.                     *
+ * @param format [uint32_t] `RTC_FORMAT_BIN` or `RTC_FORMAT_BCD`.                                      *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *time, uint32_t format)
+{
+	time_t now = rtc_now();
+	uint8_t hours = (RTC_FORMAT_BCD == format) ? from_bcd(time->Hours) : time->Hours;
+	uint8_t minutes = (RTC_FORMAT_BCD == format) ? from_bcd(time->Minutes) : time->Minutes;
+	uint8_t seconds = (RTC_FORMAT_BCD == format) ? from_bcd(time->Seconds) : time->Seconds;
+
+	// 12 AM is midnight and 12 PM is noon
+	if(RTC_HOURFORMAT_12 == hrtc->Init.HourFormat) {
+		hours = (hours % 12) + ((RTC_HOURFORMAT12_PM == time->TimeFormat) ? 12 : 0);
+	}
+
+	rtc_set(now - (now % 86400) + (hours * 3600) + (minutes * 60) + seconds);
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Sets the RTC date, keeping the current time.                                                 *
+ *                                                                                                     *
+ * The week day is stored as given and advances by one every midnight, as on the target.               *
+ *                                                                                                     *
+ * @param hrtc [RTC_HandleTypeDef*] RTC handle.                                                        *
+ * @param date [RTC_DateTypeDef*] New date, year counted from 2000.                                    *
+ * @param format [uint32_t] `RTC_FORMAT_BIN` or `RTC_FORMAT_BCD`.                                      *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *date, uint32_t format)
+{
+	struct tm tm_date = {0};
+	time_t now = rtc_now();
+	(void)hrtc;
+
+	tm_date.tm_year = 100 + ((RTC_FORMAT_BCD == format) ? from_bcd(date->Year) : date->Year);
+	tm_date.tm_mon = ((RTC_FORMAT_BCD == format) ? from_bcd(date->Month) : date->Month) - 1;
+	tm_date.tm_mday = (RTC_FORMAT_BCD == format) ? from_bcd(date->Date) : date->Date;
+
+	rtc_set(timegm(&tm_date) + (now % 86400));
+	sim_rtc_weekday = date->WeekDay;
+	sim_rtc_weekday_day = rtc_now() / 86400;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the RTC time.                                                                          *
+ *                                                                                                     *
+ * @param hrtc [RTC_HandleTypeDef*] RTC handle.                                                        *
+ * @param time [RTC_TimeTypeDef*] Filled with the current time.                                        *
+ * @param format [uint32_t] `RTC_FORMAT_BIN` or `RTC_FORMAT_BCD`.                                      *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *time, uint32_t format)
+{
+	struct tm tm_now;
+	time_t now = rtc_now();
+
+	gmtime_r(&now, &tm_now);
+	time->Hours = (uint8_t)tm_now.tm_hour;
+	time->Minutes = (uint8_t)tm_now.tm_min;
+	time->Seconds = (uint8_t)tm_now.tm_sec;
+	time->TimeFormat = RTC_HOURFORMAT12_AM;
+
+	if(RTC_HOURFORMAT_12 == hrtc->Init.HourFormat) {
+		time->TimeFormat = (tm_now.tm_hour >= 12) ? RTC_HOURFORMAT12_PM : RTC_HOURFORMAT12_AM;
+		time->Hours = (tm_now.tm_hour % 12) ? (uint8_t)(tm_now.tm_hour % 12) : 12;
+	}
+
+	if(RTC_FORMAT_BCD == format) {
+		time->Hours = to_bcd(time->Hours);
+		time->Minutes = to_bcd(time->Minutes);
+		time->Seconds = to_bcd(time->Seconds);
+	}
+
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Reads the RTC date.                                                                          *
+ *                                                                                                     *
+ * @param hrtc [RTC_HandleTypeDef*] RTC handle.                                                        *
+ * @param date [RTC_DateTypeDef*] Filled with the current date.                                        *
+ * @param format [uint32_t] `RTC_FORMAT_BIN` or `RTC_FORMAT_BCD`.                                      *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *date, uint32_t format)
+{
+	struct tm tm_now;
+	time_t now = rtc_now();
+	time_t days = (now / 86400) - sim_rtc_weekday_day;
+	(void)hrtc;
+
+	gmtime_r(&now, &tm_now);
+	date->Year = (uint8_t)(tm_now.tm_year - 100);
+	date->Month = (uint8_t)(tm_now.tm_mon + 1);
+	date->Date = (uint8_t)tm_now.tm_mday;
+	date->WeekDay = (uint8_t)((((sim_rtc_weekday + 6) + days) % 7) + 1);
+
+	if(RTC_FORMAT_BCD == format) {
+		date->Year = to_bcd(date->Year);
+		date->Month = to_bcd(date->Month);
+		date->Date = to_bcd(date->Date);
+	}
+
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Initializes a timer time base.                                                               *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @return HAL_StatusTypeDef `HAL_OK`, or `HAL_ERROR` without an instance.                             *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+	if(NULL == htim->Instance) {
+		return HAL_ERROR;
+	}
+
+	htim->Instance->PSC = htim->Init.Prescaler;
+	htim->Instance->ARR = htim->Init.Period;
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Starts a timer with its update interrupt.                                                    *
+ *                                                                                                     *
+ * The timer is added to the timers advanced by `sim_timer_tick`.                                      *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @return HAL_StatusTypeDef `HAL_OK`, or `HAL_ERROR` if too many timers are running.                  *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+	if(sim_timer_count >= SIM_MAX_TIMERS) {
+		return HAL_ERROR;
+	}
+
+	htim->Instance->DIER |= TIM_DIER_UIE;
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	sim_timer_acc[sim_timer_count] = 0;
+	sim_timers[sim_timer_count++] = htim;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Advances the running timers by one kernel tick.                                              *
+ *                                                                                                     *
+ * Each timer accumulates its counter clock for one tick and calls `HAL_TIM_PeriodElapsedCallback` for *
+ * every update event that falls into the tick.                                                        *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from the simulated interrupt task. Update events are raised with the resolution of the *
+ *       kernel tick; faster timers raise several callbacks back to back.                              *
+ ******************************************************************************************************/
+
+void sim_timer_tick(void)
+{
+	for(uint32_t i = 0; i < sim_timer_count; i++) {
+		TIM_HandleTypeDef *htim = sim_timers[i];
+		uint64_t period = (uint64_t)(htim->Instance->PSC + 1) * (htim->Instance->ARR + 1);
+
+		sim_timer_acc[i] += sim_timer_clock(htim->Instance) / configTICK_RATE_HZ;
+		while(sim_timer_acc[i] >= period) {
+			sim_timer_acc[i] -= period;
+			htim->Instance->SR |= TIM_SR_UIF;
+			if(TIM6 == htim->Instance) {
+				stats_isr_enter(STATS_ISR_TIM6);
+				HAL_TIM_PeriodElapsedCallback(htim);
+				stats_isr_exit(STATS_ISR_TIM6);
+			}
+			else if(TIM7 == htim->Instance) {
+				stats_isr_enter(STATS_ISR_TIM7);
+				HAL_TIM_PeriodElapsedCallback(htim);
+				stats_isr_exit(STATS_ISR_TIM7);
+			}
+			else {
+				HAL_TIM_PeriodElapsedCallback(htim);
+			}
+		}
+		htim->Instance->CNT = (uint32_t)(sim_timer_acc[i] / (htim->Instance->PSC + 1));
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Initializes a timer for PWM generation.                                                      *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @return HAL_StatusTypeDef Result of `HAL_TIM_Base_Init`.                                            *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+	return HAL_TIM_Base_Init(htim);
+}
+
+/*******************************************************************************************************
+ * @brief Configures a PWM channel by loading its pulse into the compare register.                     *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param config [TIM_OC_InitTypeDef*] Output compare configuration.                                   *
+ * @param channel [uint32_t] `TIM_CHANNEL_1` to `TIM_CHANNEL_4`.                                       *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, const TIM_OC_InitTypeDef *config, uint32_t channel)
+{
+	__HAL_TIM_SET_COMPARE(htim, channel, config->Pulse);
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Enables a PWM channel output.                                                                *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param channel [uint32_t] `TIM_CHANNEL_1` to `TIM_CHANNEL_4`.                                       *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+	htim->Instance->CCER |= (TIM_CCER_CC1E << channel);
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Initializes a timer in encoder interface mode.                                               *
+ *                                                                                                     *
+ * The counter is not driven by the host HAL; a plant model may write `CNT` from the simulated         *
+ * interrupt task.                                                                                     *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param config [TIM_Encoder_InitTypeDef*] Encoder configuration, ignored.                            *
+ * @return HAL_StatusTypeDef Result of `HAL_TIM_Base_Init`.                                            *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_Encoder_Init(TIM_HandleTypeDef *htim, const TIM_Encoder_InitTypeDef *config)
+{
+	(void)config;
+	return HAL_TIM_Base_Init(htim);
+}
+
+/*******************************************************************************************************
+ * @brief Starts the encoder interface counter.                                                        *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param channel [uint32_t] Encoder channels, ignored.                                                *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_Encoder_Start(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+	(void)channel;
+	htim->Instance->CR1 |= TIM_CR1_CEN;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Selects the timer clock source. Only the internal clock is modelled.                         *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param config [TIM_ClockConfigTypeDef*] Clock source configuration.                                 *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, const TIM_ClockConfigTypeDef *config)
+{
+	(void)htim;
+	(void)config;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Configures the timer trigger output. Timer chaining is not modelled.                         *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param config [TIM_MasterConfigTypeDef*] Master mode configuration.                                 *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, const TIM_MasterConfigTypeDef *config)
+{
+	(void)htim;
+	(void)config;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Configures the break and dead time of an advanced timer. Not modelled.                       *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @param config [TIM_BreakDeadTimeConfigTypeDef*] Break and dead time configuration.                  *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_TIMEx_ConfigBreakDeadTime(TIM_HandleTypeDef *htim, const TIM_BreakDeadTimeConfigTypeDef *config)
+{
+	(void)htim;
+	(void)config;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Connects the timer outputs to their pins. Pin muxing is not modelled.                        *
+ *                                                                                                     *
+ * @param htim [TIM_HandleTypeDef*] Timer handle.                                                      *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim)
+{
+	(void)htim;
+}
+
+/*******************************************************************************************************
+ * @brief Stops the simulation after a fatal error.                                                    *
+ *                                                                                                     *
+ * On the target, `Error_Handler` disables interrupts and spins forever. On the host the process exits *
+ * instead, so scripted runs do not hang.                                                              *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void sim_halt(void)
+{
+	fflush(stdout);
+	fprintf(stderr, "sim: Error_Handler reached, stopping\n");
+	exit(EXIT_FAILURE);
+}
+
+/*******************************************************************************************************
+ * @brief Reports a failed `configASSERT` and aborts.                                                  *
+ *                                                                                                     *
+ * @param file [const char*] Source file of the assertion.                                             *
+ * @param line [unsigned long] Source line of the assertion.                                           *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void vAssertCalled(const char *file, unsigned long line)
+{
+	fflush(stdout);
+	fprintf(stderr, "sim: assertion failed at %s:%lu\n", file, line);
+	abort();
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Decodes an APB prescaler field.                                                              *
+ *                                                                                                     *
+ * @param ppre [uint32_t] PPRE1 or PPRE2 field, shifted down to bit 0.                                 *
+ * @return uint32_t Division factor, 1 to 16.                                                          *
+ ******************************************************************************************************/
+
+static uint32_t apb_divider(uint32_t ppre)
+{
+	return (ppre & 0x4) ? (2U << (ppre & 0x3)) : 1U;
+}
+
+/*******************************************************************************************************
+ * @brief Decodes the AHB prescaler field.                                                             *
+ *                                                                                                     *
+ * @param hpre [uint32_t] HPRE field of `RCC->CFGR`, in place.                                         *
+ * @return uint32_t Division factor, 1 to 512.                                                         *
+ ******************************************************************************************************/
+
+static uint32_t ahb_divider(uint32_t hpre)
+{
+	static const uint16_t dividers[8] = {2, 4, 8, 16, 64, 128, 256, 512};
+	uint32_t field = hpre >> RCC_CFGR_HPRE_Pos;
+
+	return (field & 0x8) ? dividers[field & 0x7] : 1U;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the interrupt that serves an EXTI line.                                              *
+ *                                                                                                     *
+ * @param line [uint32_t] EXTI line, 0 to 15.                                                          *
+ * @return IRQn_Type Interrupt number.                                                                 *
+ ******************************************************************************************************/
+
+static IRQn_Type exti_irqn(uint32_t line)
+{
+	if(line <= 4) {
+		return (IRQn_Type)(EXTI0_IRQn + line);
+	}
+	return (line <= 9) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the output data rate of the simulated accelerometer.                                 *
+ *                                                                                                     *
+ * @return uint32_t Output data rate (mHz), 0 while powered down.                                      *
+ ******************************************************************************************************/
+
+static uint32_t spi_acc_odr(void)
+{
+	// LIS3DSH output data rates, indexed by CTRL_REG4 bits 7:4
+	static const uint32_t odr_mhz[16] = { 0, 3125, 6250, 12500, 25000, 50000, 100000, 400000, 800000, 1600000 };
+
+	if(sim_acc_lis302dl) {
+		uint8_t ctrl1 = sim_acc_regs[SIM_LIS302DL_CTRL1];
+		return (ctrl1 & 0x40) ? ((ctrl1 & 0x80) ? 400000 : 100000) : 0;
+	}
+
+	return odr_mhz[sim_acc_regs[SIM_LIS3DSH_CTRL4] >> 4];
+}
+
+/*******************************************************************************************************
+ * @brief Tells whether the LIS3DSH FIFO is enabled and not in bypass mode.                            *
+ *                                                                                                     *
+ * @return int Non-zero if the samples go through the FIFO.                                            *
+ ******************************************************************************************************/
+
+static int spi_acc_fifo_on(void)
+{
+	return !sim_acc_lis302dl && (sim_acc_regs[SIM_LIS3DSH_CTRL6] & 0x40) && (sim_acc_regs[SIM_LIS3DSH_FIFO_CTRL] & 0xE0);
+}
+
+/*******************************************************************************************************
+ * @brief Reads one byte of the current transaction.                                                   *
+ *                                                                                                     *
+ * Reading the first output register takes the oldest sample out of the FIFO, and FIFO reads roll back *
+ * from the last output register to the first, so a burst read returns consecutive samples. Reading    *
+ * an output register clears data-ready.                                                               *
+ *                                                                                                     *
+ * @return uint8_t Register value.                                                                     *
+ ******************************************************************************************************/
+
+static uint8_t spi_acc_read_byte(void)
+{
+	uint8_t first = sim_acc_lis302dl ? SIM_LIS302DL_OUT_X : SIM_LIS3DSH_OUT_X_L;
+	uint8_t value;
+
+	if(spi_acc_fifo_on() && (SIM_LIS3DSH_OUT_X_L == sim_acc_addr) && (0 != sim_acc_fifo_count)) {
+		for(int i = 0; i < 3; i++) {
+			sim_acc_regs[SIM_LIS3DSH_OUT_X_L + (2 * i)] = (uint8_t)(sim_acc_fifo[sim_acc_fifo_head][i] & 0xFF);
+			sim_acc_regs[SIM_LIS3DSH_OUT_X_L + (2 * i) + 1] = (uint8_t)((uint16_t)sim_acc_fifo[sim_acc_fifo_head][i] >> 8);
+		}
+		sim_acc_fifo_head = (sim_acc_fifo_head + 1) % SIM_LIS3DSH_FIFO_DEPTH;
+		sim_acc_fifo_count--;
+	}
+
+	value = sim_acc_regs[sim_acc_addr];
+	if((sim_acc_addr >= first) && (sim_acc_addr < (first + 6))) {
+		sim_acc_drdy = 0;
+	}
+
+	if(sim_acc_increment) {
+		sim_acc_addr = (spi_acc_fifo_on() && ((SIM_LIS3DSH_OUT_X_L + 5) == sim_acc_addr)) ?
+					   SIM_LIS3DSH_OUT_X_L : ((sim_acc_addr + 1) % SIM_ACC_REG_COUNT);
+	}
+
+	return value;
+}
+
+/*******************************************************************************************************
+ * @brief Acquires a new accelerometer sample.                                                         *
+ *                                                                                                     *
+ * The board is tilted slowly in a circle: X and Y follow a sine and cosine of `SIM_ACC_TILT_MG`,      *
+ * and Z reads `SIM_ACC_GRAVITY_MG` plus a vibration of `SIM_ACC_VIBRATION_MG` at                      *
+ * `SIM_ACC_VIBRATION_HZ`. The sample is converted at the selected full scale. It goes to              *
+ * the FIFO when it is on, overwriting the oldest sample when full, and to the output registers        *
+ * otherwise.                                                                                          *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void spi_acc_sample(void)
+{
+	// LIS3DSH sensitivities (ug/digit), indexed by CTRL_REG5 bits 5:3
+	static const double lis3dsh_ug[8] = { 61, 122, 183, 244, 732, 732, 732, 732 };
+	double phase = (2.0 * M_PI * (double)(xTaskGetTickCount() % SIM_ACC_PERIOD_MS)) / SIM_ACC_PERIOD_MS;
+	double vibration = (2.0 * M_PI * SIM_ACC_VIBRATION_HZ * (double)xTaskGetTickCount()) / 1000.0;
+	double mg[3] = { SIM_ACC_TILT_MG * sin(phase), SIM_ACC_TILT_MG * cos(phase),
+					 SIM_ACC_GRAVITY_MG + (SIM_ACC_VIBRATION_MG * sin(vibration)) };
+
+	sim_acc_drdy = 1;
+
+	if(sim_acc_lis302dl) {
+		double mg_per_digit = (sim_acc_regs[SIM_LIS302DL_CTRL1] & 0x20) ? 72.0 : 18.0;
+		for(int i = 0; i < 3; i++) {
+			sim_acc_regs[SIM_LIS302DL_OUT_X + (2 * i)] = (uint8_t)(int8_t)lround(mg[i] / mg_per_digit);
+		}
+		return;
+	}
+
+	int16_t *axis = sim_acc_fifo[(sim_acc_fifo_head + sim_acc_fifo_count) % SIM_LIS3DSH_FIFO_DEPTH];
+	for(int i = 0; i < 3; i++) {
+		axis[i] = (int16_t)lround((mg[i] * 1000.0) / lis3dsh_ug[(sim_acc_regs[SIM_LIS3DSH_CTRL5] >> 3) & 0x07]);
+	}
+
+	if(spi_acc_fifo_on()) {
+		if(SIM_LIS3DSH_FIFO_DEPTH == sim_acc_fifo_count) {
+			sim_acc_fifo_head = (sim_acc_fifo_head + 1) % SIM_LIS3DSH_FIFO_DEPTH;
+		}
+		else {
+			sim_acc_fifo_count++;
+		}
+		return;
+	}
+
+	for(int i = 0; i < 3; i++) {
+		sim_acc_regs[SIM_LIS3DSH_OUT_X_L + (2 * i)] = (uint8_t)(axis[i] & 0xFF);
+		sim_acc_regs[SIM_LIS3DSH_OUT_X_L + (2 * i) + 1] = (uint8_t)((uint16_t)axis[i] >> 8);
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Drives the INT1 pin (PE0) of the simulated accelerometer.                                    *
+ *                                                                                                     *
+ * INT1 is active high and level triggered: on the LIS3DSH it follows the FIFO watermark when P1_WTM   *
+ * is set with the FIFO on, and data-ready otherwise; on the LIS302DL it follows data-ready.           *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void spi_acc_update_int1(void)
+{
+	uint8_t level = 0;
+
+	if(sim_acc_lis302dl) {
+		level = (0x04 == (sim_acc_regs[SIM_LIS302DL_CTRL3] & 0x07)) && sim_acc_drdy;
+	}
+	else if(sim_acc_regs[SIM_LIS3DSH_CTRL3] & 0x08) {
+		if(spi_acc_fifo_on() && (sim_acc_regs[SIM_LIS3DSH_CTRL6] & 0x04)) {
+			level = sim_acc_fifo_count > (sim_acc_regs[SIM_LIS3DSH_FIFO_CTRL] & 0x1F);
+		}
+		else {
+			level = (sim_acc_regs[SIM_LIS3DSH_CTRL3] & 0x80) && sim_acc_drdy;
+		}
+	}
+
+	sim_gpio_set_input(MEMS_INT1_GPIO_Port, MEMS_INT1_Pin, level ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+/*******************************************************************************************************
+ * @brief Completes the SPI DMA transfer in flight, if any.                                            *
+ *                                                                                                     *
+ * The address byte is sent first and the received bytes follow it, the first one being clocked in     *
+ * while the address is sent. Both DMA streams raise their interrupt, only the receive stream has a    *
+ * callback.                                                                                           *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void spi_dma_complete(void)
+{
+	SPI_HandleTypeDef *hspi = sim_spi_dma;
+
+	if(NULL == hspi) {
+		return;
+	}
+	sim_spi_dma = NULL;
+
+	HAL_SPI_Transmit(hspi, sim_spi_dma_tx, 1, 0);
+	sim_spi_dma_rx[0] = 0;
+	HAL_SPI_Receive(hspi, &sim_spi_dma_rx[1], sim_spi_dma_size - 1, 0);
+	hspi->State = HAL_SPI_STATE_READY;
+
+	stats_isr_enter(STATS_ISR_SPI_TX);
+	stats_isr_exit(STATS_ISR_SPI_TX);
+
+	stats_isr_enter(STATS_ISR_SPI_RX);
+	HAL_SPI_TxRxCpltCallback(hspi);
+	stats_isr_exit(STATS_ISR_SPI_RX);
+}
+
+/*******************************************************************************************************
+ * @brief Returns the RTC time in seconds since the Unix epoch.                                        *
+ *                                                                                                     *
+ * @return time_t Current RTC time.                                                                    *
+ ******************************************************************************************************/
+
+static time_t rtc_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return sim_rtc_base + (now.tv_sec - sim_rtc_ref);
+}
+
+/*******************************************************************************************************
+ * @brief Sets the RTC time in seconds since the Unix epoch.                                           *
+ *                                                                                                     *
+ * @param seconds [time_t] New RTC time.                                                               *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void rtc_set(time_t seconds)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	sim_rtc_ref = now.tv_sec;
+	sim_rtc_base = seconds;
+}
+
+/*******************************************************************************************************
+ * @brief Converts a binary value (0 - 99) to BCD.                                                     *
+ *                                                                                                     *
+ * @param value [uint8_t] Binary value.                                                                *
+ * @return uint8_t BCD value.                                                                          *
+ ******************************************************************************************************/
+
+static uint8_t to_bcd(uint8_t value)
+{
+	return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+/*******************************************************************************************************
+ * @brief Converts a BCD value to binary.                                                              *
+ *                                                                                                     *
+ * @param value [uint8_t] BCD value.                                                                   *
+ * @return uint8_t Binary value.                                                                       *
+ ******************************************************************************************************/
+
+static uint8_t from_bcd(uint8_t value)
+{
+	return (uint8_t)(((value >> 4) * 10) + (value & 0x0F));
+}
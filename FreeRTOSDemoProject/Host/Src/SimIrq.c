@@ -0,0 +1,102 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       SimIrq.c                                                                  |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` interrupt task stands in for the interrupt handlers of the           |
+|    target. Once per kernel tick it advances the HAL tick, the motor, the running      |
+|    timers and the UART line, calling the same HAL callbacks as the target handlers.   |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_Sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static TickType_t sim_run_ticks = 0; // Kernel ticks until the simulation exits, 0 to run forever
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Starts the simulated peripherals.                                                            *
+ *                                                                                                     *
+ * This function connects the UART to the host and creates the simulated interrupt task. If            *
+ * `SIM_RUN_MS` is set, the simulation exits after that many milliseconds of kernel time, which lets   *
+ * scripted load tests and benchmarks run unattended.                                                  *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from `HAL_Init`, before the application creates its tasks.                             *
+ ******************************************************************************************************/
+
+void sim_init(void)
+{
+	const char *run_ms = getenv(SIM_RUN_MS_ENV);
+	BaseType_t status;
+
+	if(NULL != run_ms) {
+		sim_run_ticks = pdMS_TO_TICKS(strtoul(run_ms, NULL, 10));
+	}
+
+	sim_uart_start();
+
+	status = xTaskCreate(sim_irq_task, "sim_irq", SIM_IRQ_TASK_STACK_SIZE, NULL, SIM_IRQ_TASK_PRIORITY, NULL);
+	configASSERT(pdPASS == status);
+}
+
+/*******************************************************************************************************
+ * @brief Task raising the simulated interrupts.                                                       *
+ *                                                                                                     *
+ * The task runs once per kernel tick at the highest priority, so the callbacks it calls preempt the   *
+ * application tasks in the same way as interrupt handlers. The callbacks use the `FromISR` kernel API *
+ * exactly as on the target.                                                                           *
+ *                                                                                                     *
+ * @param param [void*] Not used.                                                                      *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note The control loop timer is resolved to one kernel tick; timers faster than the tick rate raise *
+ *       several update callbacks back to back.                                                        *
+ ******************************************************************************************************/
+
+void sim_irq_task(void *param)
+{
+	TickType_t last_wake = xTaskGetTickCount();
+	(void)param;
+
+	while(1) {
+		vTaskDelayUntil(&last_wake, 1);
+
+		// SysTick and TIM6 time base
+		HAL_IncTick();
+
+		// Motor plant and encoder edges, ahead of the TIM7 encoder capture
+		sim_motor_run(1000000U / configTICK_RATE_HZ);
+
+		// Timer update interrupts, including the TIM7 control loop
+		sim_timer_tick();
+
+		// USART2 and its DMA streams
+		sim_uart_tick();
+
+		// Accelerometer INT1 and SPI1 DMA streams
+		sim_spi_tick();
+
+		if((0 != sim_run_ticks) && (last_wake >= sim_run_ticks)) {
+			sim_rtt_close();
+			fflush(stdout);
+			exit(EXIT_SUCCESS);
+		}
+	}
+}
@@ -0,0 +1,133 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       SimMotor.c                                                                |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` motor connects the motor plant to the simulated peripherals. It      |
+|    applies the TIM3 PWM duty cycle and the IN1 / IN2 bridge inputs to the plant,      |
+|    and drives the encoder pins and the TIM2 encoder counter from its position.        |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_MotorManager.h"
+#include "Config_Sim.h"
+#include "MotorPlant.h"
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static double sim_motor_voltage(void);
+static void sim_encoder_output(int32_t position);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static motor_plant_t sim_motor;			// Starts at rest, all zero
+static int32_t sim_encoder_position = 0;	// Encoder position last driven on the pins
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Advances the motor and updates the encoder outputs.                                          *
+ *                                                                                                     *
+ * The bridge output is taken from the current TIM3 channel 1 compare value and the IN1 / IN2 pins.    *
+ * Every encoder count the shaft moves is driven on the A and B pins in quadrature order, so with      *
+ * `ENCODER_BACKEND_EXTI` each edge raises `HAL_GPIO_EXTI_Callback`. TIM2 `CNT` follows the same       *
+ * position for `ENCODER_BACKEND_TIMER`.                                                               *
+ *                                                                                                     *
+ * @param us [uint32_t] Interval to simulate in microseconds.                                          *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Must only be called from the simulated interrupt task, or before the scheduler starts.        *
+ ******************************************************************************************************/
+
+void sim_motor_run(uint32_t us)
+{
+	motor_plant_run(&sim_motor, sim_motor_voltage(), us * 1e-6);
+	sim_encoder_output(motor_plant_encoder_count(&sim_motor));
+}
+
+/*******************************************************************************************************
+ * @brief Brings the motor to rest where it is, keeping the encoder position.                          *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void sim_motor_reset(void)
+{
+	double angle = sim_motor.angle;
+
+	motor_plant_init(&sim_motor);
+	sim_motor.angle = angle;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the speed of the simulated gearbox output shaft.                                     *
+ *                                                                                                     *
+ * @return double Output shaft speed (RPM), without the quantization of the encoder.                   *
+ ******************************************************************************************************/
+
+double sim_motor_rpm(void)
+{
+	return motor_plant_output_rpm(&sim_motor);
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Returns the L298N output voltage, averaged over the PWM period.                              *
+ *                                                                                                     *
+ * IN1 high and IN2 low turn the motor forward, and the reverse turns it backward. Equal inputs brake  *
+ * the motor by shorting its terminals.                                                                *
+ *                                                                                                     *
+ * @return double Voltage across the motor terminals (V).                                              *
+ ******************************************************************************************************/
+
+static double sim_motor_voltage(void)
+{
+	GPIO_PinState in1 = HAL_GPIO_ReadPin(MOTOR_IN1_GPIO_Port, MOTOR_IN1_Pin);
+	GPIO_PinState in2 = HAL_GPIO_ReadPin(MOTOR_IN2_GPIO_Port, MOTOR_IN2_Pin);
+	uint32_t period = TIM3->ARR + 1;
+	double duty = (TIM3->CCR1 >= period) ? 1.0 : ((double)TIM3->CCR1 / period);
+	double volts = duty * (SIM_MOTOR_SUPPLY_V - SIM_MOTOR_BRIDGE_DROP_V);
+
+	if(in1 == in2) {
+		return 0.0;
+	}
+
+	return (GPIO_PIN_SET == in1) ? volts : -volts;
+}
+
+/*******************************************************************************************************
+ * @brief Moves the encoder outputs to a new position, one count at a time.                            *
+ *                                                                                                     *
+ * @param position [int32_t] Encoder position in counts.                                               *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+static void sim_encoder_output(int32_t position)
+{
+	while(sim_encoder_position != position) {
+		sim_encoder_position += (position > sim_encoder_position) ? 1 : -1;
+
+		// Gray code with A leading B when turning forward, only one pin changes per count
+		uint32_t phase = (uint32_t)sim_encoder_position & 3U;
+		sim_gpio_set_input(ENCODER_A_GPIO_Port, ENCODER_A_GPIO_Pin, ((1U == phase) || (2U == phase)) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+		sim_gpio_set_input(ENCODER_B_GPIO_Port, ENCODER_B_GPIO_Pin, (phase >= 2U) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+	}
+
+	// The encoder interface counts the same edges in hardware
+	TIM2->CNT = (uint32_t)position;
+}
@@ -0,0 +1,120 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       SimSegger.c                                                               |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` SEGGER layer keeps the SystemView start-up calls and the RTT up      |
+|    channels of the application. SystemView itself is not recorded on the host;        |
+|    RTT channel data is appended to the file named by `SIM_RTT_FILE`, so the           |
+|    telemetry stream can be decoded with `Tools/telemetry_decode.py`.                  |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_Sim.h"
+#include "SEGGER_RTT.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+static FILE *sim_rtt_file = NULL;
+static unsigned sim_rtt_buffers = 1; // Channel 0 belongs to SystemView on the target
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Configures SystemView. On the host only the RTT output file is opened.                       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void SEGGER_SYSVIEW_Conf(void)
+{
+	const char *path = getenv(SIM_RTT_FILE_ENV);
+
+	if((NULL != path) && (NULL == sim_rtt_file)) {
+		sim_rtt_file = fopen(path, "wb");
+		if(NULL == sim_rtt_file) {
+			perror("sim: " SIM_RTT_FILE_ENV);
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Starts SystemView recording. Not recorded on the host.                                       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void SEGGER_SYSVIEW_Start(void)
+{
+}
+
+/*******************************************************************************************************
+ * @brief Allocates an RTT up channel.                                                                 *
+ *                                                                                                     *
+ * @param name [const char*] Channel name.                                                             *
+ * @param buf [void*] Channel buffer, not used on the host.                                            *
+ * @param size [unsigned] Size of the channel buffer.                                                  *
+ * @param flags [unsigned] Operating mode.                                                             *
+ * @return int Channel index, or -1 if no channel is left.                                             *
+ ******************************************************************************************************/
+
+int SEGGER_RTT_AllocUpBuffer(const char *name, void *buf, unsigned size, unsigned flags)
+{
+	(void)name;
+	(void)buf;
+	(void)size;
+	(void)flags;
+
+	if(sim_rtt_buffers >= SIM_RTT_MAX_BUFFERS) {
+		return -1;
+	}
+	return (int)sim_rtt_buffers++;
+}
+
+/*******************************************************************************************************
+ * @brief Writes to an RTT up channel.                                                                 *
+ *                                                                                                     *
+ * The bytes of every channel go to the `SIM_RTT_FILE` file, or are discarded if it is not set. The    *
+ * host never falls behind, so the write always succeeds.                                              *
+ *                                                                                                     *
+ * @param index [unsigned] Channel index.                                                              *
+ * @param data [const void*] Bytes to write.                                                           *
+ * @param len [unsigned] Number of bytes.                                                              *
+ * @return unsigned Number of bytes written.                                                           *
+ ******************************************************************************************************/
+
+unsigned SEGGER_RTT_WriteNoLock(unsigned index, const void *data, unsigned len)
+{
+	(void)index;
+
+	if(NULL != sim_rtt_file) {
+		return (unsigned)fwrite(data, 1, len, sim_rtt_file);
+	}
+	return len;
+}
+
+/*******************************************************************************************************
+ * @brief Flushes and closes the RTT output file.                                                      *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ ******************************************************************************************************/
+
+void sim_rtt_close(void)
+{
+	if(NULL != sim_rtt_file) {
+		fclose(sim_rtt_file);
+		sim_rtt_file = NULL;
+	}
+}
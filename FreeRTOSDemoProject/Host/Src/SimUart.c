@@ -0,0 +1,336 @@
+/*=====================================================================================*\
+| Date:     October 16th, 2026                                                          |
+| --------------------------------------------------------------------------------------|
+| MODULE:     [ HostSim ]                                                               |
+| FILE:       SimUart.c                                                                 |
+| --------------------------------------------------------------------------------------|
+| DESCRIPTION:                                                                          |
+|    The `HostSim` UART connects USART2 to stdin/stdout or to a pseudo terminal.        |
+|    A host thread feeds received bytes into a ring buffer; the simulated interrupt     |
+|    task moves them into the DMA buffer and completes transmissions, both paced        |
+|    at the configured baud rate.                                                       |
+\*=====================================================================================*/
+
+/****************************************************
+ *  Include files                                   *
+ ****************************************************/
+
+#include "main.h"
+#include "Config_Sim.h"
+#include "RingBuffer.h"
+#include "StatsManager.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/****************************************************
+ *  Function prototypes                             *
+ ****************************************************/
+
+static void *uart_reader_thread(void *param);
+static int uart_open_pty(void);
+static uint32_t uart_bytes_this_tick(UART_HandleTypeDef *huart);
+
+/****************************************************
+ *  Variables                                       *
+ ****************************************************/
+
+// Host side of the UART
+static int sim_uart_fd_in = STDIN_FILENO;
+static int sim_uart_fd_out = STDOUT_FILENO;
+static pthread_t sim_uart_reader;
+
+// Bytes received from the host, waiting to go over the simulated wire
+static uint8_t sim_uart_rx_ring_buf[SIM_UART_RX_RING_SIZE];
+static ring_buffer_t sim_uart_rx_ring;
+
+// Circular DMA reception
+static UART_HandleTypeDef *sim_uart_rx_handle = NULL;
+static uint16_t sim_uart_rx_pos = 0;
+
+// DMA transmission in flight
+static UART_HandleTypeDef *sim_uart_tx_handle = NULL;
+static uint32_t sim_uart_tx_pending = 0;
+
+// Line rate accumulator, in bytes times the tick rate
+static uint32_t sim_uart_rate_acc = 0;
+
+/****************************************************
+ *  Public functions                                *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Connects the simulated UART to the host and starts the reader thread.                        *
+ *                                                                                                     *
+ * By default USART2 uses stdin and stdout. With `SIM_UART=pty` a pseudo terminal is opened instead and*
+ * its device name is printed on stderr, so a terminal emulator or a host tool can attach to it.       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from `sim_init` before the scheduler starts. The reader thread is not a FreeRTOS task; *
+ *       it blocks every signal so that the POSIX port tick is only delivered to task threads.         *
+ ******************************************************************************************************/
+
+void sim_uart_start(void)
+{
+	const char *mode = getenv(SIM_UART_ENV);
+	sigset_t all_signals;
+	sigset_t previous;
+
+	if((NULL != mode) && (0 == strcmp(mode, "pty"))) {
+		sim_uart_fd_in = uart_open_pty();
+		sim_uart_fd_out = sim_uart_fd_in;
+	}
+
+	ring_buffer_init(&sim_uart_rx_ring, sim_uart_rx_ring_buf, SIM_UART_RX_RING_SIZE);
+
+	// The thread inherits the blocked signal mask
+	sigfillset(&all_signals);
+	pthread_sigmask(SIG_BLOCK, &all_signals, &previous);
+	if(0 != pthread_create(&sim_uart_reader, NULL, uart_reader_thread, NULL)) {
+		sim_halt();
+	}
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+/*******************************************************************************************************
+ * @brief Initializes the UART.                                                                        *
+ *                                                                                                     *
+ * The baud rate register is computed from PCLK1 as on the target, so it can be read back.             *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] UART handle.                                                     *
+ * @return HAL_StatusTypeDef Always `HAL_OK`.                                                          *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+	huart->Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK1Freq(), huart->Init.BaudRate);
+	huart->gState = HAL_UART_STATE_READY;
+	huart->RxState = HAL_UART_STATE_READY;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Starts a DMA transmission.                                                                   *
+ *                                                                                                     *
+ * The bytes are written to the host immediately. The transfer completes, and `HAL_UART_TxCpltCallback`*
+ * is called, once the simulated line has had time to shift them out at the configured baud rate.      *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] UART handle.                                                     *
+ * @param data [const uint8_t*] Bytes to send.                                                         *
+ * @param size [uint16_t] Number of bytes.                                                             *
+ * @return HAL_StatusTypeDef `HAL_OK`, or `HAL_BUSY` while a transmission is in flight.                *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+{
+	ssize_t written;
+
+	taskENTER_CRITICAL();
+	if(HAL_UART_STATE_READY != huart->gState) {
+		taskEXIT_CRITICAL();
+		return HAL_BUSY;
+	}
+	huart->gState = HAL_UART_STATE_BUSY_TX;
+	sim_uart_tx_handle = huart;
+	sim_uart_tx_pending = (size > 0) ? size : 1;
+	taskEXIT_CRITICAL();
+
+	while(size > 0) {
+		written = write(sim_uart_fd_out, data, size);
+		if(written < 0) {
+			if(EINTR == errno) {
+				continue;
+			}
+			break;
+		}
+		data += written;
+		size -= (uint16_t)written;
+	}
+
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Starts circular DMA reception with idle line detection.                                      *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] UART handle.                                                     *
+ * @param data [uint8_t*] Circular DMA buffer.                                                         *
+ * @param size [uint16_t] Size of the DMA buffer.                                                      *
+ * @return HAL_StatusTypeDef `HAL_OK`, or `HAL_BUSY` if reception is already running.                  *
+ ******************************************************************************************************/
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+	if(HAL_UART_STATE_READY != huart->RxState) {
+		return HAL_BUSY;
+	}
+
+	huart->RxState = HAL_UART_STATE_BUSY_RX;
+	huart->ReceptionType = HAL_UART_RECEPTION_TOIDLE;
+	huart->pRxBuffPtr = data;
+	huart->RxXferSize = size;
+	sim_uart_rx_pos = 0;
+	sim_uart_rx_handle = huart;
+	return HAL_OK;
+}
+
+/*******************************************************************************************************
+ * @brief Advances the simulated UART line by one kernel tick.                                         *
+ *                                                                                                     *
+ * This function moves up to one tick worth of bytes from the host into the circular DMA buffer and    *
+ * raises `HAL_UARTEx_RxEventCallback` on the full buffer and idle line events, with the DMA write     *
+ * position as size. It also completes the transmission in flight once its bytes have been sent.       *
+ *                                                                                                     *
+ * @return void                                                                                        *
+ *                                                                                                     *
+ * @note Called from the simulated interrupt task.                                                     *
+ ******************************************************************************************************/
+
+void sim_uart_tick(void)
+{
+	UART_HandleTypeDef *huart = (NULL != sim_uart_rx_handle) ? sim_uart_rx_handle : sim_uart_tx_handle;
+	uint32_t budget;
+	uint32_t chunk;
+	uint32_t received = 0;
+
+	if(NULL == huart) {
+		return;
+	}
+	budget = uart_bytes_this_tick(huart);
+
+	// Transmission: complete once the line has sent every byte
+	if((NULL != sim_uart_tx_handle) && (HAL_UART_STATE_BUSY_TX == sim_uart_tx_handle->gState)) {
+		chunk = (sim_uart_tx_pending < budget) ? sim_uart_tx_pending : budget;
+		sim_uart_tx_pending -= chunk;
+		if(0 == sim_uart_tx_pending) {
+			sim_uart_tx_handle->gState = HAL_UART_STATE_READY;
+			stats_isr_enter(STATS_ISR_DMA_TX);
+			HAL_UART_TxCpltCallback(sim_uart_tx_handle);
+			stats_isr_exit(STATS_ISR_DMA_TX);
+		}
+	}
+
+	// Reception: the DMA fills the buffer circularly, reporting the full buffer and the idle line
+	huart = sim_uart_rx_handle;
+	if((NULL == huart) || (HAL_UART_STATE_BUSY_RX != huart->RxState)) {
+		return;
+	}
+	while(budget > 0) {
+		chunk = huart->RxXferSize - sim_uart_rx_pos;
+		chunk = (chunk < budget) ? chunk : budget;
+		chunk = ring_buffer_read(&sim_uart_rx_ring, &huart->pRxBuffPtr[sim_uart_rx_pos], chunk);
+		if(0 == chunk) {
+			break;
+		}
+
+		budget -= chunk;
+		received += chunk;
+		sim_uart_rx_pos += (uint16_t)chunk;
+		if(sim_uart_rx_pos == huart->RxXferSize) {
+			sim_uart_rx_pos = 0;
+			received = 0;
+			stats_isr_enter(STATS_ISR_DMA_RX);
+			HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize);
+			stats_isr_exit(STATS_ISR_DMA_RX);
+		}
+	}
+	if(received > 0) {
+		stats_isr_enter(STATS_ISR_USART2);
+		HAL_UARTEx_RxEventCallback(huart, sim_uart_rx_pos);
+		stats_isr_exit(STATS_ISR_USART2);
+	}
+}
+
+/****************************************************
+ *  Private functions                               *
+ ****************************************************/
+
+/*******************************************************************************************************
+ * @brief Host thread that copies received bytes into the reception ring buffer.                       *
+ *                                                                                                     *
+ * When the ring buffer is full the thread waits for the simulated line to drain it, so the host input *
+ * is delivered at the baud rate. End of input on stdin stops the thread; a pseudo terminal is polled  *
+ * again until a terminal attaches.                                                                    *
+ *                                                                                                     *
+ * @param param [void*] Not used.                                                                      *
+ * @return void* Always NULL.                                                                          *
+ ******************************************************************************************************/
+
+static void *uart_reader_thread(void *param)
+{
+	uint8_t buf[64];
+	ssize_t len;
+	uint32_t written;
+	(void)param;
+
+	while(1) {
+		len = read(sim_uart_fd_in, buf, sizeof(buf));
+		if(len == 0 && (sim_uart_fd_in == STDIN_FILENO)) {
+			return NULL;
+		}
+		if(len <= 0) {
+			usleep(100000);
+			continue;
+		}
+
+		for(written = 0; written < (uint32_t)len; ) {
+			written += ring_buffer_write(&sim_uart_rx_ring, &buf[written], (uint32_t)len - written);
+			if(written < (uint32_t)len) {
+				usleep(1000);
+			}
+		}
+	}
+}
+
+/*******************************************************************************************************
+ * @brief Opens a pseudo terminal for the simulated UART.                                              *
+ *                                                                                                     *
+ * The line is put in raw mode, so that, like a USB serial adapter, it neither echoes the application  *
+ * output back as input nor translates line endings.                                                   *
+ *                                                                                                     *
+ * @return int File descriptor of the pseudo terminal master.                                          *
+ ******************************************************************************************************/
+
+static int uart_open_pty(void)
+{
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+	struct termios tio;
+
+	if((fd < 0) || (0 != grantpt(fd)) || (0 != unlockpt(fd)) || (0 != tcgetattr(fd, &tio))) {
+		perror("sim: posix_openpt");
+		sim_halt();
+	}
+
+	cfmakeraw(&tio);
+	tcsetattr(fd, TCSANOW, &tio);
+
+	fprintf(stderr, "sim: USART2 on %s\n", ptsname(fd));
+	return fd;
+}
+
+/*******************************************************************************************************
+ * @brief Returns the number of bytes the line can carry during the current tick.                      *
+ *                                                                                                     *
+ * The fractional part is carried over, so the long term rate matches the baud rate exactly.           *
+ *                                                                                                     *
+ * @param huart [UART_HandleTypeDef*] UART handle providing the baud rate.                             *
+ * @return uint32_t Bytes for this tick, at least one.                                                 *
+ ******************************************************************************************************/
+
+static uint32_t uart_bytes_this_tick(UART_HandleTypeDef *huart)
+{
+	uint32_t bytes;
+
+	sim_uart_rate_acc += huart->Init.BaudRate / SIM_UART_BITS_PER_BYTE;
+	bytes = sim_uart_rate_acc / configTICK_RATE_HZ;
+	sim_uart_rate_acc %= configTICK_RATE_HZ;
+
+	return (bytes > 0) ? bytes : 1;
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Compare the size and speed of the STM32CubeIDE build configurations.
+
+For every configuration directory that holds a linked FreeRTOSDemoProject.elf
+(Debug, Release and ReleaseSpeed by default), the report lists the flash, SRAM
+and CCM RAM usage, and the size and memory of the functions on the motor
+control path. Functions shown as "-" are not in the image: they were inlined
+into their callers, which is common with link-time optimization, or are not
+used by the selected MOTOR_MATH and ENCODER_BACKEND.
+
+Speed is measured on the board: the `Clock` command of the main menu prints the
+cycles of one motor control step and of one formatted console line. Console
+captures of that command are added with `--log CONFIG=FILE`, and the row of the
+running profile (its wait states and ART setting) is reported.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+ELF_NAME = "FreeRTOSDemoProject.elf"
+CONFIGS = ["Debug", "Release", "ReleaseSpeed"]
+
+# Memory regions of STM32F407VGTX_FLASH.ld
+REGIONS = [
+    ("Flash", 0x08000000, 1024 * 1024),
+    ("SRAM", 0x20000000, 128 * 1024),
+    ("CCM", 0x10000000, 64 * 1024),
+]
+
+# Interrupt to PWM update path of the motor control loop, and the encoder interrupts
+HOT_PATH = [
+    "TIM7_IRQHandler",
+    "HAL_TIM_IRQHandler",
+    "HAL_TIM_PeriodElapsedCallback",
+    "motor_timer_callback",
+    "EXTI4_IRQHandler",
+    "EXTI9_5_IRQHandler",
+    "HAL_GPIO_EXTI_Callback",
+    "motor_gpio_callback",
+    "read_encoder_count",
+    "vTaskNotifyGiveFromISR",
+    "motor_control_task",
+    "motor_control_step",
+    "pid_controller",
+    "pid_controller_q",
+    "speed_estimate_q",
+    "set_pwm_duty_cycle",
+    "control_hist_add",
+    "xQueueGenericSendFromISR",
+    "xQueueReceive",
+]
+
+
+def region_of(address):
+    """Name of the memory region holding an address, or None outside of them."""
+    for name, origin, length in REGIONS:
+        if origin <= address < origin + length:
+            return name
+    return None
+
+
+def section_usage(tools, elf):
+    """Bytes used in each region; initialized RAM sections also count their flash load image."""
+    out = subprocess.run([tools + "objdump", "-h", elf], check=True, capture_output=True, text=True).stdout
+    usage = {name: 0 for name, _, _ in REGIONS}
+    lines = out.splitlines()
+    for i, line in enumerate(lines):
+        fields = line.split()
+        if len(fields) < 6 or not fields[0].isdigit():
+            continue
+        size, vma, lma = int(fields[2], 16), int(fields[3], 16), int(fields[4], 16)
+        flags = lines[i + 1] if i + 1 < len(lines) else ""
+        if "ALLOC" not in flags or size == 0:
+            continue
+        region = region_of(vma)
+        if region:
+            usage[region] += size
+        if region != "Flash" and "LOAD" in flags and region_of(lma) == "Flash":
+            usage["Flash"] += size
+    return usage
+
+
+def symbol_sizes(tools, elf):
+    """Size and region of each function, with clones (.constprop, .lto_priv) added to their origin."""
+    out = subprocess.run([tools + "nm", "-S", elf], check=True, capture_output=True, text=True).stdout
+    symbols = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) != 4 or fields[2] not in "tTwW":
+            continue
+        address, size, name = int(fields[0], 16), int(fields[1], 16), fields[3].split(".")[0]
+        total, region = symbols.get(name, (0, None))
+        symbols[name] = (total + size, region or region_of(address & ~1))
+    return symbols
+
+
+def clock_benchmark(path):
+    """Control step and format cycles of the running profile, from a capture of the Clock command."""
+    with open(path, errors="replace") as f:
+        text = f.read()
+    ws = re.search(r"Flash wait states:\s+(\d+)", text)
+    art = re.search(r"ART accelerator:\s+(on|off)", text)
+    if not ws or not art:
+        return None
+    row = re.search(r"\*\s+\d+ MHz\s+%s\s+%s\s+(\d+)\s+(\d+)\s+\*" % (ws.group(1), art.group(1)), text)
+    return (int(row.group(1)), int(row.group(2))) if row else None
+
+
+def main():
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("configs", nargs="*", default=CONFIGS,
+                        help="build configuration directories (default: %s)" % " ".join(CONFIGS))
+    parser.add_argument("--log", action="append", default=[], metavar="CONFIG=FILE",
+                        help="console capture of the Clock command for a configuration")
+    parser.add_argument("--tools", default="arm-none-eabi-",
+                        help="toolchain prefix for objdump and nm (default: arm-none-eabi-)")
+    args = parser.parse_args()
+
+    builds = []
+    for config in args.configs:
+        elf = os.path.join(root, config, ELF_NAME)
+        if os.path.isfile(elf):
+            builds.append((config, elf))
+        else:
+            print("%s: no %s, skipped" % (config, ELF_NAME), file=sys.stderr)
+    if not builds:
+        sys.exit("no configuration has been built")
+
+    logs = dict(log.split("=", 1) for log in args.log)
+    try:
+        usage = [section_usage(args.tools, elf) for _, elf in builds]
+        symbols = [symbol_sizes(args.tools, elf) for _, elf in builds]
+    except FileNotFoundError as e:
+        sys.exit("%s not found, set --tools to the toolchain prefix" % e.filename)
+
+    width = max(14, max(len(config) for config, _ in builds) + 2)
+    row = "%-30s" + ("%" + str(width) + "s") * len(builds)
+    print(row % (("",) + tuple(config for config, _ in builds)))
+
+    print("\nMemory (bytes)")
+    for name, _, _ in REGIONS:
+        print(row % ((name,) + tuple(u[name] for u in usage)))
+
+    print("\nMotor control path (bytes, memory)")
+    for name in HOT_PATH:
+        cells = []
+        for table in symbols:
+            size, region = table.get(name, (0, None))
+            cells.append("%d %s" % (size, region) if region else "-")
+        print(row % ((name,) + tuple(cells)))
+
+    if logs:
+        print("\nClock benchmark (cycles)")
+        results = [clock_benchmark(logs[config]) if config in logs else None for config, _ in builds]
+        for i, name in enumerate(("Control step", "Format line")):
+            print(row % ((name,) + tuple(str(r[i]) if r else "-" for r in results)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Decode the motor telemetry stream written by Core/Src/MotorManager/Telemetry.c.
+
+The input is the raw byte stream of the "Telemetry" RTT up channel, for example
+captured with `JLinkRTTLogger -RTTChannel <n>` or exported from a memory dump of
+the RTT buffer. Frames are located by their sync bytes and checked with their
+CRC-16, so the decoder recovers from partial frames and corrupted bytes. Gaps in
+the sequence numbers are reported as dropped frames.
+
+Timestamps are DWT cycle counts, converted to seconds with --clock-hz. The
+default matches the default 168 MHz clock profile; pass 84e6 or 25e6 for a
+build with another CLOCK_PROFILE.
+
+Frame layout (little endian, 20 bytes):
+    0xA5 0x5A | seq u16 | timestamp u32 | encoder_count i32 |
+    speed i16 (0.01 RPM) | error i16 (0.01 RPM) | duty u16 (0.01 %) | crc u16
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+FRAME = struct.Struct("<2sHIihhHH")
+CRC_START = 2                    # CRC covers seq up to duty
+CRC_END = FRAME.size - 2
+
+
+def crc16_ccitt_false(data):
+    """CRC-16/CCITT-FALSE, matching telemetry_crc16() on the target."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def decode(stream):
+    """Yield decoded frames as dicts and count CRC failures in decode.crc_errors."""
+    decode.crc_errors = 0
+    pos = 0
+    while True:
+        pos = stream.find(SYNC, pos)
+        if pos < 0 or pos + FRAME.size > len(stream):
+            return
+        raw = stream[pos:pos + FRAME.size]
+        _, seq, timestamp, count, speed, error, duty, crc = FRAME.unpack(raw)
+        if crc16_ccitt_false(raw[CRC_START:CRC_END]) != crc:
+            # Sync pattern inside the payload or a corrupted frame, resync one byte later
+            decode.crc_errors += 1
+            pos += 1
+            continue
+        yield {
+            "seq": seq,
+            "timestamp": timestamp,
+            "encoder_count": count,
+            "speed_rpm": speed / 100.0,
+            "error_rpm": error / 100.0,
+            "duty_pct": duty / 100.0,
+        }
+        pos += FRAME.size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="raw telemetry capture (binary)")
+    parser.add_argument("-o", "--output", help="CSV file to write (default: stdout)")
+    parser.add_argument("--clock-hz", type=float, default=168e6,
+                        help="CPU clock used to convert DWT timestamps to seconds; must match "
+                             "CLOCK_PROFILE in Config_ClockManager.h (default: 168 MHz)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        stream = f.read()
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["seq", "time_s", "encoder_count", "speed_rpm", "error_rpm", "duty_pct"])
+
+    frames = dropped = 0
+    last_seq = None
+    time_s = 0.0
+    last_timestamp = None
+    for frame in decode(stream):
+        if last_seq is not None:
+            dropped += (frame["seq"] - last_seq - 1) & 0xFFFF
+        # Unwrap the 32-bit cycle counter into a running time
+        if last_timestamp is not None:
+            time_s += ((frame["timestamp"] - last_timestamp) & 0xFFFFFFFF) / args.clock_hz
+        last_seq = frame["seq"]
+        last_timestamp = frame["timestamp"]
+        frames += 1
+        writer.writerow([frame["seq"], "%.6f" % time_s, frame["encoder_count"],
+                         frame["speed_rpm"], frame["error_rpm"], frame["duty_pct"]])
+
+    if out is not sys.stdout:
+        out.close()
+
+    total = frames + dropped
+    print("frames: %d, dropped: %d (%.2f %%), crc errors: %d"
+          % (frames, dropped, (100.0 * dropped / total) if total else 0.0, decode.crc_errors),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()